@@ -23,6 +23,7 @@
 #include "cmemory.h"
 #include "bmpset.h"
 #include "uassert.h"
+#include "usimd.h"
 
 U_NAMESPACE_BEGIN
 
@@ -48,6 +49,7 @@ BMPSet::BMPSet(const int32_t *parentList, int32_t parentListLength) :
     containsFFFD=containsSlow(0xfffd, list4kStarts[0xf], list4kStarts[0x10]);
 
     initBits();
+    initSpanRanges();
     overrideIllegal();
 }
 
@@ -58,6 +60,8 @@ BMPSet::BMPSet(const BMPSet &otherBMPSet, const int32_t *newParentList, int32_t
     uprv_memcpy(table7FF, otherBMPSet.table7FF, sizeof(table7FF));
     uprv_memcpy(bmpBlockBits, otherBMPSet.bmpBlockBits, sizeof(bmpBlockBits));
     uprv_memcpy(list4kStarts, otherBMPSet.list4kStarts, sizeof(list4kStarts));
+    uprv_memcpy(asciiRanges, otherBMPSet.asciiRanges, sizeof(asciiRanges));
+    asciiRangesLength=otherBMPSet.asciiRangesLength;
 }
 
 BMPSet::~BMPSet() {
@@ -218,6 +222,47 @@ void BMPSet::initBits() {
     }
 }
 
+/*
+ * Collect the ranges of latin1Contains[] in U+0000..U+007F for block-wise spans.
+ * Sets with too many ranges get a length of -1 and use only the per-character loops.
+ */
+void BMPSet::initSpanRanges() {
+    asciiRangesLength=0;
+    int32_t c=0;
+    while(c<0x80) {
+        if(!latin1Contains[c]) {
+            ++c;
+            continue;
+        }
+        int32_t start=c;
+        do {
+            ++c;
+        } while(c<0x80 && latin1Contains[c]);
+        if(asciiRangesLength==UPRV_LENGTHOF(asciiRanges)) {
+            asciiRangesLength=-1;
+            break;
+        }
+        asciiRanges[asciiRangesLength++]=(uint8_t)start;
+        asciiRanges[asciiRangesLength++]=(uint8_t)(c-1);
+    }
+}
+
+const UChar *
+BMPSet::spanASCIIBlocks(const UChar *s, const UChar *limit, UBool contained) const {
+    if(asciiRangesLength>=0) {
+        s+=usimd_spanASCIIRangesUTF16(s, (int32_t)(limit-s), asciiRanges, asciiRangesLength, contained);
+    }
+    return s;
+}
+
+const uint8_t *
+BMPSet::spanASCIIBlocks(const uint8_t *s, const uint8_t *limit, UBool contained) const {
+    if(asciiRangesLength>=0) {
+        s+=usimd_spanASCIIRangesUTF8(s, (int32_t)(limit-s), asciiRanges, asciiRangesLength, contained);
+    }
+    return s;
+}
+
 /*
  * Override some bits and bytes to the result of contains(FFFD)
  * for faster validity checking at runtime.
@@ -321,6 +366,8 @@ BMPSet::contains(UChar32 c) const {
  */
 const UChar *
 BMPSet::span(const UChar *s, const UChar *limit, USetSpanCondition spanCondition) const {
+    // Where a long span switches to block-wise skipping of ASCII characters.
+    const UChar *blockStart=(limit-s)>=32 ? s+15 : nullptr;
     UChar c, c2;
 
     if(spanCondition) {
@@ -331,6 +378,9 @@ BMPSet::span(const UChar *s, const UChar *limit, USetSpanCondition spanCondition
                 if(!latin1Contains[c]) {
                     break;
                 }
+                if(s==blockStart) {
+                    s=spanASCIIBlocks(s+1, limit, TRUE)-1;
+                }
             } else if(c<=0x7ff) {
                 if((table7FF[c&0x3f]&((uint32_t)1<<(c>>6)))==0) {
                     break;
@@ -371,6 +421,9 @@ BMPSet::span(const UChar *s, const UChar *limit, USetSpanCondition spanCondition
                 if(latin1Contains[c]) {
                     break;
                 }
+                if(s==blockStart) {
+                    s=spanASCIIBlocks(s+1, limit, FALSE)-1;
+                }
             } else if(c<=0x7ff) {
                 if((table7FF[c&0x3f]&((uint32_t)1<<(c>>6)))!=0) {
                     break;
@@ -512,17 +565,25 @@ BMPSet::spanUTF8(const uint8_t *s, int32_t length, USetSpanCondition spanConditi
     uint8_t b=*s;
     if(U8_IS_SINGLE(b)) {
         // Initial all-ASCII span.
+        // A long span continues with block-wise skipping after runLimit.
+        const uint8_t *runLimit=s+(length>=32 ? 16 : length);
         if(spanCondition) {
             do {
-                if(!latin1Contains[b] || ++s==limit) {
-                    return s;
+                if(!latin1Contains[b] || ++s==runLimit) {
+                    if(s!=runLimit || s==limit || (s=spanASCIIBlocks(s, limit, TRUE))==limit) {
+                        return s;
+                    }
+                    runLimit=limit;
                 }
                 b=*s;
             } while(U8_IS_SINGLE(b));
         } else {
             do {
-                if(latin1Contains[b] || ++s==limit) {
-                    return s;
+                if(latin1Contains[b] || ++s==runLimit) {
+                    if(s!=runLimit || s==limit || (s=spanASCIIBlocks(s, limit, FALSE))==limit) {
+                        return s;
+                    }
+                    runLimit=limit;
                 }
                 b=*s;
             } while(U8_IS_SINGLE(b));
@@ -577,13 +638,17 @@ BMPSet::spanUTF8(const uint8_t *s, int32_t length, USetSpanCondition spanConditi
     while(s<limit) {
         b=*s;
         if(U8_IS_SINGLE(b)) {
-            // ASCII
+            // ASCII, with block-wise skipping after runLimit as above
+            const uint8_t *runLimit=(limit-s)>=32 ? s+16 : limit;
             if(spanCondition) {
                 do {
                     if(!latin1Contains[b]) {
                         return s;
-                    } else if(++s==limit) {
-                        return limit0;
+                    } else if(++s==runLimit) {
+                        if(s==limit || (s=spanASCIIBlocks(s, limit, TRUE))==limit) {
+                            return limit0;
+                        }
+                        runLimit=limit;
                     }
                     b=*s;
                 } while(U8_IS_SINGLE(b));
@@ -591,8 +656,11 @@ BMPSet::spanUTF8(const uint8_t *s, int32_t length, USetSpanCondition spanConditi
                 do {
                     if(latin1Contains[b]) {
                         return s;
-                    } else if(++s==limit) {
-                        return limit0;
+                    } else if(++s==runLimit) {
+                        if(s==limit || (s=spanASCIIBlocks(s, limit, FALSE))==limit) {
+                            return limit0;
+                        }
+                        runLimit=limit;
                     }
                     b=*s;
                 } while(U8_IS_SINGLE(b));
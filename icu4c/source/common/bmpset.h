@@ -73,6 +73,7 @@ class BMPSet : public UMemory {
 
 private:
     void initBits();
+    void initSpanRanges();
     void overrideIllegal();
 
     /**
@@ -96,6 +97,14 @@ class BMPSet : public UMemory {
 
     inline UBool containsSlow(UChar32 c, int32_t lo, int32_t hi) const;
 
+    /*
+     * Skip blocks of ASCII characters whose contains() value is the same as contained,
+     * and return the new start of the span.
+     * Called only for long spans, and not inline, to keep the span loops small.
+     */
+    const UChar *spanASCIIBlocks(const UChar *s, const UChar *limit, UBool contained) const;
+    const uint8_t *spanASCIIBlocks(const uint8_t *s, const uint8_t *limit, UBool contained) const;
+
     /*
      * One byte 0 or 1 per Latin-1 character.
      */
@@ -104,6 +113,15 @@ class BMPSet : public UMemory {
     /* TRUE if contains(U+FFFD). */
     UBool containsFFFD;
 
+    /*
+     * The set's ranges in U+0000..U+007F as pairs of inclusive start/end
+     * code points, for block-wise spans over long runs of ASCII text.
+     * asciiRangesLength is the number of array elements used,
+     * or -1 if the set has too many ranges there.
+     */
+    uint8_t asciiRanges[8];
+    int8_t asciiRangesLength;
+
     /*
      * One bit per code point from U+0000..U+07FF.
      * The bits are organized vertically; consecutive code points
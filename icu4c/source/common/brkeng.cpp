@@ -32,6 +32,8 @@
 #include "umutex.h"
 #include "uresimp.h"
 #include "ubrkimpl.h"
+#include "umapfile.h"
+#include "uvectr32.h"
 
 U_NAMESPACE_BEGIN
 
@@ -223,6 +225,22 @@ ICULanguageBreakFactory::loadEngineFor(UChar32 c) {
     return NULL;
 }
 
+// Open the dictionary data named by an entry of the brkitr "dictionaries" table,
+// like "thaidict.dict".
+static UDataMemory *
+openDictionaryData(const UChar *dictfname, int32_t dictnlength, UErrorCode &status) {
+    CharString dictnbuf;
+    CharString ext;
+    const UChar *extStart = u_memrchr(dictfname, 0x002e, dictnlength);  // last dot
+    if (extStart != NULL) {
+        int32_t len = (int32_t)(extStart - dictfname);
+        ext.appendInvariantChars(UnicodeString(FALSE, extStart + 1, dictnlength - len - 1), status);
+        dictnlength = len;
+    }
+    dictnbuf.appendInvariantChars(UnicodeString(FALSE, dictfname, dictnlength), status);
+    return udata_open(U_ICUDATA_BRKITR, ext.data(), dictnbuf.data(), &status);
+}
+
 DictionaryMatcher *
 ICULanguageBreakFactory::loadDictionaryMatcherFor(UScriptCode script) { 
     UErrorCode status = U_ZERO_ERROR;
@@ -236,18 +254,9 @@ ICULanguageBreakFactory::loadDictionaryMatcherFor(UScriptCode script) {
         ures_close(b);
         return NULL;
     }
-    CharString dictnbuf;
-    CharString ext;
-    const UChar *extStart = u_memrchr(dictfname, 0x002e, dictnlength);  // last dot
-    if (extStart != NULL) {
-        int32_t len = (int32_t)(extStart - dictfname);
-        ext.appendInvariantChars(UnicodeString(FALSE, extStart + 1, dictnlength - len - 1), status);
-        dictnlength = len;
-    }
-    dictnbuf.appendInvariantChars(UnicodeString(FALSE, dictfname, dictnlength), status);
+    UDataMemory *file = openDictionaryData(dictfname, dictnlength, status);
     ures_close(b);
 
-    UDataMemory *file = udata_open(U_ICUDATA_BRKITR, ext.data(), dictnbuf.data(), &status);
     if (U_SUCCESS(status)) {
         // build trie
         const uint8_t *data = (const uint8_t *)udata_getMemory(file);
@@ -279,6 +288,43 @@ ICULanguageBreakFactory::loadDictionaryMatcherFor(UScriptCode script) {
     return NULL;
 }
 
+void
+ICULanguageBreakFactory::prefetchDictionaries(UVector32 &scripts, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return;
+    }
+    LocalUResourceBundlePointer b(ures_open(U_ICUDATA_BRKITR, "", &status));
+    LocalUResourceBundlePointer dictionaries(
+        ures_getByKey(b.getAlias(), "dictionaries", NULL, &status));
+    if (U_FAILURE(status)) {
+        return;
+    }
+    while (ures_hasNext(dictionaries.getAlias())) {
+        const char *scriptName = NULL;
+        int32_t dictnlength = 0;
+        const UChar *dictfname =
+            ures_getNextString(dictionaries.getAlias(), &dictnlength, &scriptName, &status);
+        if (U_FAILURE(status)) {
+            return;
+        }
+        int32_t script = u_getPropertyValueEnum(UCHAR_SCRIPT, scriptName);
+        UErrorCode dataStatus = U_ZERO_ERROR;
+        UDataMemory *file = openDictionaryData(dictfname, dictnlength, dataStatus);
+        if (U_FAILURE(dataStatus)) {
+            // Missing from this data build, as in loadDictionaryMatcherFor().
+            continue;
+        }
+        // The data is typically part of the memory-mapped common data, so the pages
+        // stay resident after this UDataMemory is closed.
+        const int32_t *indexes = (const int32_t *)udata_getMemory(file);
+        uprv_prefetchData(indexes, indexes[DictionaryData::IX_TOTAL_SIZE]);
+        udata_close(file);
+        if (script != UCHAR_INVALID_CODE) {
+            scripts.addElement(script, status);
+        }
+    }
+}
+
 U_NAMESPACE_END
 
 #endif /* #if !UCONFIG_NO_BREAK_ITERATION */
@@ -245,6 +245,16 @@ class ICULanguageBreakFactory : public LanguageBreakFactory {
   */
   virtual const LanguageBreakEngine *getEngineFor(UChar32 c);
 
+ /**
+  * <p>Open each of the dictionaries listed in the break iterator data and
+  * make its pages resident, so that first use of the dictionary does not
+  * stall on page faults.</p>
+  *
+  * @param scripts Receives the script code of each dictionary.
+  * @param status Information on any errors encountered.
+  */
+  static void prefetchDictionaries(UVector32 &scripts, UErrorCode &status);
+
 protected:
  /**
   * <p>Create a LanguageBreakEngine for the set of characters to which
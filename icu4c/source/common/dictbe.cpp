@@ -17,6 +17,7 @@
 #include "dictbe.h"
 #include "unicode/uniset.h"
 #include "unicode/chariter.h"
+#include "unicode/localpointer.h"
 #include "unicode/ubrk.h"
 #include "uvectr32.h"
 #include "uvector.h"
@@ -24,9 +25,104 @@
 #include "unicode/normlzr.h"
 #include "cmemory.h"
 #include "dictionarydata.h"
+#include "mutex.h"
+#include "ucln_cmn.h"
+#include "uhash.h"
+#include "umutex.h"
 
 U_NAMESPACE_BEGIN
 
+/*
+ ******************************************************************
+ * Run cache: Results of divideUpDictionaryRange() for recently segmented
+ * runs of text, shared by all engines and all break iterators.
+ * Off unless enabled with RuleBasedBreakIterator::setDictionaryCacheCapacity().
+ */
+
+namespace {
+
+struct RunCacheKey {
+    const DictionaryBreakEngine *engine;
+    UnicodeString run;
+};
+
+struct RunCacheEntry : public UMemory {
+    RunCacheEntry(const RunCacheKey &k, int32_t r, UErrorCode &status) :
+            key(k), result(r), breaks(status), older(nullptr), newer(nullptr) {}
+
+    RunCacheKey key;
+    int32_t result;             // The return value of divideUpDictionaryRange().
+    UVector32 breaks;           // The breaks it found, relative to the start of the run.
+    RunCacheEntry *older;       // Least recently used order.
+    RunCacheEntry *newer;
+};
+
+UMutex gRunCacheMutex;
+UHashtable *gRunCache = nullptr;        // RunCacheKey * -> RunCacheEntry *
+RunCacheEntry *gNewestRunCacheEntry = nullptr;
+RunCacheEntry *gOldestRunCacheEntry = nullptr;
+u_atomic_int32_t gRunCacheCapacity(0);
+int64_t gRunCacheHits = 0;
+int64_t gRunCacheMisses = 0;
+
+int32_t U_CALLCONV hashRunCacheKey(const UHashTok key) {
+    const RunCacheKey *k = static_cast<const RunCacheKey *>(key.pointer);
+    return k->run.hashCode() * 37 + (int32_t)(reinterpret_cast<uintptr_t>(k->engine) >> 4);
+}
+
+UBool U_CALLCONV compareRunCacheKeys(const UHashTok key1, const UHashTok key2) {
+    const RunCacheKey *k1 = static_cast<const RunCacheKey *>(key1.pointer);
+    const RunCacheKey *k2 = static_cast<const RunCacheKey *>(key2.pointer);
+    return k1->engine == k2->engine && k1->run == k2->run;
+}
+
+// The following functions require gRunCacheMutex to be locked.
+
+void unlinkRunCacheEntry(RunCacheEntry *entry) {
+    if (entry->newer != nullptr) {
+        entry->newer->older = entry->older;
+    } else {
+        gNewestRunCacheEntry = entry->older;
+    }
+    if (entry->older != nullptr) {
+        entry->older->newer = entry->newer;
+    } else {
+        gOldestRunCacheEntry = entry->newer;
+    }
+    entry->older = entry->newer = nullptr;
+}
+
+void linkNewestRunCacheEntry(RunCacheEntry *entry) {
+    entry->older = gNewestRunCacheEntry;
+    if (gNewestRunCacheEntry != nullptr) {
+        gNewestRunCacheEntry->newer = entry;
+    } else {
+        gOldestRunCacheEntry = entry;
+    }
+    gNewestRunCacheEntry = entry;
+}
+
+void trimRunCache(int32_t capacity) {
+    while (gRunCache != nullptr && uhash_count(gRunCache) > capacity) {
+        RunCacheEntry *oldest = gOldestRunCacheEntry;
+        unlinkRunCacheEntry(oldest);
+        uhash_remove(gRunCache, &oldest->key);
+        delete oldest;
+    }
+}
+
+UBool U_CALLCONV dictbe_cleanup() {
+    trimRunCache(0);
+    uhash_close(gRunCache);
+    gRunCache = nullptr;
+    umtx_storeRelease(gRunCacheCapacity, 0);
+    gRunCacheHits = 0;
+    gRunCacheMisses = 0;
+    return TRUE;
+}
+
+}  // namespace
+
 /*
  ******************************************************************
  */
@@ -65,12 +161,103 @@ DictionaryBreakEngine::findBreaks( UText *text,
     }
     rangeStart = start;
     rangeEnd = current;
-    result = divideUpDictionaryRange(text, rangeStart, rangeEnd, foundBreaks);
+    // The run cache keeps breaks as offsets into the run's UTF-16 text, so it is only
+    // used for text with UTF-16 native indexes, which has no index mapping function.
+    if (umtx_loadAcquire(gRunCacheCapacity) > 0 && (rangeEnd - rangeStart) > 1 &&
+            text->pFuncs->mapNativeIndexToUTF16 == nullptr) {
+        result = divideUpDictionaryRangeCached(text, rangeStart, rangeEnd, foundBreaks);
+    } else {
+        result = divideUpDictionaryRange(text, rangeStart, rangeEnd, foundBreaks);
+    }
     utext_setNativeIndex(text, current);
     
     return result;
 }
 
+int32_t
+DictionaryBreakEngine::divideUpDictionaryRangeCached( UText *text,
+                                                      int32_t rangeStart,
+                                                      int32_t rangeEnd,
+                                                      UVector32 &foundBreaks ) const {
+    // The cached breaks are relative to the start of the run. The caller checks that
+    // the native indexes are UTF-16 indexes, so that they map back.
+    UErrorCode status = U_ZERO_ERROR;
+    int32_t rangeLength = rangeEnd - rangeStart;
+    RunCacheKey key;
+    key.engine = this;
+    UChar *buffer = key.run.getBuffer(rangeLength);
+    int32_t length = 0;
+    if (buffer != nullptr) {
+        length = utext_extract(text, rangeStart, rangeEnd, buffer, rangeLength, &status);
+        key.run.releaseBuffer(U_SUCCESS(status) ? length : 0);
+    }
+    if (U_FAILURE(status) || length != rangeLength) {
+        return divideUpDictionaryRange(text, rangeStart, rangeEnd, foundBreaks);
+    }
+
+    {
+        Mutex lock(&gRunCacheMutex);
+        RunCacheEntry *entry = gRunCache != nullptr ?
+            static_cast<RunCacheEntry *>(uhash_get(gRunCache, &key)) : nullptr;
+        if (entry != nullptr) {
+            ++gRunCacheHits;
+            unlinkRunCacheEntry(entry);
+            linkNewestRunCacheEntry(entry);
+            for (int32_t i = 0; i < entry->breaks.size(); ++i) {
+                foundBreaks.push(rangeStart + entry->breaks.elementAti(i), status);
+            }
+            return entry->result;
+        }
+        ++gRunCacheMisses;
+    }
+
+    int32_t oldSize = foundBreaks.size();
+    int32_t result = divideUpDictionaryRange(text, rangeStart, rangeEnd, foundBreaks);
+
+    LocalPointer<RunCacheEntry> newEntry(new RunCacheEntry(key, result, status), status);
+    for (int32_t i = oldSize; i < foundBreaks.size(); ++i) {
+        newEntry->breaks.addElement(foundBreaks.elementAti(i) - rangeStart, status);
+    }
+    if (U_FAILURE(status)) {
+        return result;
+    }
+    Mutex lock(&gRunCacheMutex);
+    int32_t capacity = umtx_loadAcquire(gRunCacheCapacity);
+    if (capacity == 0) {
+        return result;
+    }
+    if (gRunCache == nullptr) {
+        gRunCache = uhash_open(hashRunCacheKey, compareRunCacheKeys, nullptr, &status);
+        if (U_FAILURE(status)) {
+            gRunCache = nullptr;
+            return result;
+        }
+        ucln_common_registerCleanup(UCLN_COMMON_DICTBE, dictbe_cleanup);
+    }
+    if (uhash_get(gRunCache, &newEntry->key) == nullptr) {  // Not added by another thread meanwhile.
+        uhash_put(gRunCache, &newEntry->key, newEntry.getAlias(), &status);
+        if (U_SUCCESS(status)) {
+            linkNewestRunCacheEntry(newEntry.orphan());
+            trimRunCache(capacity);
+        }
+    }
+    return result;
+}
+
+void
+DictionaryBreakEngine::setRunCacheCapacity( int32_t capacity ) {
+    Mutex lock(&gRunCacheMutex);
+    umtx_storeRelease(gRunCacheCapacity, capacity);
+    trimRunCache(capacity);
+}
+
+void
+DictionaryBreakEngine::getRunCacheStatistics( int64_t &hits, int64_t &misses ) {
+    Mutex lock(&gRunCacheMutex);
+    hits = gRunCacheHits;
+    misses = gRunCacheMisses;
+}
+
 void
 DictionaryBreakEngine::setCharacters( const UnicodeSet &set ) {
     fSet = set;
@@ -80,6 +80,20 @@ class DictionaryBreakEngine : public LanguageBreakEngine {
                               int32_t endPos,
                               UVector32 &foundBreaks ) const;
 
+  /**
+   * <p>Set the maximum number of runs in the cache of divideUpDictionaryRange()
+   * results that is shared by all dictionary break engines. 0 turns off caching
+   * and empties the cache.</p>
+   *
+   * @param capacity The maximum number of cached runs, >= 0
+   */
+  static void setRunCacheCapacity( int32_t capacity );
+
+  /**
+   * <p>Get the number of runs found in, and not found in, the run cache.</p>
+   */
+  static void getRunCacheStatistics( int64_t &hits, int64_t &misses );
+
  protected:
 
  /**
@@ -103,6 +117,17 @@ class DictionaryBreakEngine : public LanguageBreakEngine {
                                            int32_t rangeEnd,
                                            UVector32 &foundBreaks ) const = 0;
 
+ private:
+
+ /**
+  * <p>divideUpDictionaryRange(), with the results looked up in and added to the run cache.
+  * Only for text whose native indexes are UTF-16 indexes.</p>
+  */
+  int32_t divideUpDictionaryRangeCached( UText *text,
+                                         int32_t rangeStart,
+                                         int32_t rangeEnd,
+                                         UVector32 &foundBreaks ) const;
+
 };
 
 /*******************************************************************
@@ -165,6 +165,34 @@ class Normalizer2WithImpl : public Normalizer2 {
         return Normalizer2WithImpl::isNormalized(s, errorCode) ? UNORM_YES : UNORM_NO;
     }
     virtual int32_t
+    isNormalizedBatch(const char16_t *text, const int32_t offsets[], int32_t count,
+                      uint8_t results[], UErrorCode &errorCode) const {
+        if(U_FAILURE(errorCode)) {
+            return 0;
+        }
+        if(count<0 || (count>0 && (text==NULL || offsets==NULL || results==NULL))) {
+            errorCode=U_ILLEGAL_ARGUMENT_ERROR;
+            return 0;
+        }
+        uprv_memset(results, 0, (count+7)>>3);
+        int32_t numNormalized=0;
+        for(int32_t i=0; i<count && U_SUCCESS(errorCode); ++i) {
+            int32_t start=offsets[i], limit=offsets[i+1];
+            if(start<0 || limit<start) {
+                errorCode=U_ILLEGAL_ARGUMENT_ERROR;
+                break;
+            }
+            // Without "maybe" results, the string is normalized
+            // iff its "yes" span is the whole string. (ComposeNormalizer2 overrides this.)
+            const UChar *sLimit=text+limit;
+            if(sLimit==spanQuickCheckYes(text+start, sLimit, errorCode)) {
+                results[i>>3]|=(uint8_t)(1<<(i&7));
+                ++numNormalized;
+            }
+        }
+        return numNormalized;
+    }
+    virtual int32_t
     spanQuickCheckYes(const UnicodeString &s, UErrorCode &errorCode) const {
         if(U_FAILURE(errorCode)) {
             return 0;
@@ -278,6 +306,64 @@ class ComposeNormalizer2 : public Normalizer2WithImpl {
         const uint8_t *s = reinterpret_cast<const uint8_t *>(sp.data());
         return impl.composeUTF8(0, onlyContiguous, s, s + sp.length(), nullptr, nullptr, errorCode);
     }
+    virtual int32_t
+    isNormalizedBatch(const char16_t *text, const int32_t offsets[], int32_t count,
+                      uint8_t results[], UErrorCode &errorCode) const U_OVERRIDE {
+        if(U_FAILURE(errorCode)) {
+            return 0;
+        }
+        if(count<0 || (count>0 && (text==NULL || offsets==NULL || results==NULL))) {
+            errorCode=U_ILLEGAL_ARGUMENT_ERROR;
+            return 0;
+        }
+        UnicodeString temp;
+        ReorderingBuffer buffer(impl, temp);
+        if(!buffer.init(5, errorCode)) {  // small destCapacity for substring normalization
+            return 0;
+        }
+        uprv_memset(results, 0, (count+7)>>3);
+        int32_t numNormalized=0;
+        for(int32_t i=0; i<count && U_SUCCESS(errorCode); ++i) {
+            int32_t start=offsets[i], limit=offsets[i+1];
+            if(start<0 || limit<start) {
+                errorCode=U_ILLEGAL_ARGUMENT_ERROR;
+                break;
+            }
+            // Check like isNormalized(), reusing one buffer for all strings.
+            buffer.remove();
+            if(impl.compose(text+start, text+limit, onlyContiguous, FALSE, buffer, errorCode)) {
+                results[i>>3]|=(uint8_t)(1<<(i&7));
+                ++numNormalized;
+            }
+        }
+        return numNormalized;
+    }
+    virtual int32_t
+    isNormalizedBatchUTF8(const char *text, const int32_t offsets[], int32_t count,
+                          uint8_t results[], UErrorCode &errorCode) const U_OVERRIDE {
+        if(U_FAILURE(errorCode)) {
+            return 0;
+        }
+        if(count<0 || (count>0 && (text==NULL || offsets==NULL || results==NULL))) {
+            errorCode=U_ILLEGAL_ARGUMENT_ERROR;
+            return 0;
+        }
+        uprv_memset(results, 0, (count+7)>>3);
+        const uint8_t *s = reinterpret_cast<const uint8_t *>(text);
+        int32_t numNormalized=0;
+        for(int32_t i=0; i<count && U_SUCCESS(errorCode); ++i) {
+            int32_t start=offsets[i], limit=offsets[i+1];
+            if(start<0 || limit<start) {
+                errorCode=U_ILLEGAL_ARGUMENT_ERROR;
+                break;
+            }
+            if(impl.composeUTF8(0, onlyContiguous, s+start, s+limit, nullptr, nullptr, errorCode)) {
+                results[i>>3]|=(uint8_t)(1<<(i&7));
+                ++numNormalized;
+            }
+        }
+        return numNormalized;
+    }
     virtual UNormalizationCheckResult
     quickCheck(const UnicodeString &s, UErrorCode &errorCode) const U_OVERRIDE {
         if(U_FAILURE(errorCode)) {
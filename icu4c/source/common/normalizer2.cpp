@@ -25,6 +25,7 @@
 #include "unicode/stringoptions.h"
 #include "unicode/unistr.h"
 #include "unicode/unorm.h"
+#include "cmemory.h"
 #include "cstring.h"
 #include "mutex.h"
 #include "norm2allmodes.h"
@@ -80,6 +81,58 @@ Normalizer2::isNormalizedUTF8(StringPiece s, UErrorCode &errorCode) const {
     return U_SUCCESS(errorCode) && isNormalized(UnicodeString::fromUTF8(s), errorCode);
 }
 
+int32_t
+Normalizer2::isNormalizedBatch(const char16_t *text, const int32_t offsets[], int32_t count,
+                               uint8_t results[], UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) {
+        return 0;
+    }
+    if(count<0 || (count>0 && (text==NULL || offsets==NULL || results==NULL))) {
+        errorCode=U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    uprv_memset(results, 0, (count+7)>>3);
+    int32_t numNormalized=0;
+    for(int32_t i=0; i<count && U_SUCCESS(errorCode); ++i) {
+        int32_t start=offsets[i], limit=offsets[i+1];
+        if(start<0 || limit<start) {
+            errorCode=U_ILLEGAL_ARGUMENT_ERROR;
+            break;
+        }
+        if(isNormalized(UnicodeString(FALSE, text+start, limit-start), errorCode)) {
+            results[i>>3]|=(uint8_t)(1<<(i&7));
+            ++numNormalized;
+        }
+    }
+    return numNormalized;
+}
+
+int32_t
+Normalizer2::isNormalizedBatchUTF8(const char *text, const int32_t offsets[], int32_t count,
+                                   uint8_t results[], UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) {
+        return 0;
+    }
+    if(count<0 || (count>0 && (text==NULL || offsets==NULL || results==NULL))) {
+        errorCode=U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    uprv_memset(results, 0, (count+7)>>3);
+    int32_t numNormalized=0;
+    for(int32_t i=0; i<count && U_SUCCESS(errorCode); ++i) {
+        int32_t start=offsets[i], limit=offsets[i+1];
+        if(start<0 || limit<start) {
+            errorCode=U_ILLEGAL_ARGUMENT_ERROR;
+            break;
+        }
+        if(isNormalizedUTF8(StringPiece(text+start, limit-start), errorCode)) {
+            results[i>>3]|=(uint8_t)(1<<(i&7));
+            ++numNormalized;
+        }
+    }
+    return numNormalized;
+}
+
 // Normalizer2 implementation for the old UNORM_NONE.
 class NoopNormalizer2 : public Normalizer2 {
     virtual ~NoopNormalizer2();
@@ -500,6 +553,14 @@ unorm2_isNormalized(const UNormalizer2 *norm2,
     return ((const Normalizer2 *)norm2)->isNormalized(sString, *pErrorCode);
 }
 
+U_CAPI int32_t U_EXPORT2
+unorm2_isNormalizedBatch(const UNormalizer2 *norm2,
+                         const UChar *text, const int32_t *offsets, int32_t count,
+                         uint8_t *results,
+                         UErrorCode *pErrorCode) {
+    return ((const Normalizer2 *)norm2)->isNormalizedBatch(text, offsets, count, results, *pErrorCode);
+}
+
 U_CAPI UNormalizationCheckResult U_EXPORT2
 unorm2_quickCheck(const UNormalizer2 *norm2,
                   const UChar *s, int32_t length,
@@ -40,6 +40,7 @@
 #include "uassert.h"
 #include "ucptrie_impl.h"
 #include "uset_imp.h"
+#include "usimd.h"
 #include "uvector.h"
 
 U_NAMESPACE_BEGIN
@@ -547,6 +548,16 @@ Normalizer2Impl::copyLowPrefixFromNulTerminated(const UChar *src,
     return src;
 }
 
+USIMD_NOINLINE const UChar *
+Normalizer2Impl::skipLowBlocks(const UChar *src, const UChar *limit, UChar minNeedDataCP) {
+    return src+usimd_spanBelowUTF16(src, (int32_t)(limit-src), minNeedDataCP);
+}
+
+USIMD_NOINLINE const uint8_t *
+Normalizer2Impl::skipLowBlocks(const uint8_t *src, const uint8_t *limit, uint8_t minNeedDataLead) {
+    return src+usimd_spanBelowUTF8(src, (int32_t)(limit-src), minNeedDataLead);
+}
+
 UnicodeString &
 Normalizer2Impl::decompose(const UnicodeString &src, UnicodeString &dest,
                            UErrorCode &errorCode) const {
@@ -1326,6 +1337,10 @@ Normalizer2Impl::compose(const UChar *src, const UChar *limit,
         }
     }
 
+    // Skip an initial run of code units below minNoMaybeCP block by block.
+    // Only done once, as in composeUTF8().
+    src = skipLowBlocks(src, limit, (UChar)minNoMaybeCP);
+
     for (;;) {
         // Fast path: Scan over a sequence of characters below the minimum "no or maybe" code point,
         // or with (compYes && ccc==0) properties.
@@ -1590,6 +1605,10 @@ Normalizer2Impl::composeQuickCheck(const UChar *src, const UChar *limit,
         }
     }
 
+    // Skip an initial run of code units below minNoMaybeCP block by block.
+    // Only done once, as in composeUTF8().
+    src = skipLowBlocks(src, limit, (UChar)minNoMaybeCP);
+
     for(;;) {
         // Fast path: Scan over a sequence of characters below the minimum "no or maybe" code point,
         // or with (compYes && ccc==0) properties.
@@ -1737,6 +1756,10 @@ Normalizer2Impl::composeUTF8(uint32_t options, UBool onlyContiguous,
     UnicodeString s16;
     uint8_t minNoMaybeLead = leadByteForCP(minCompNoMaybeCP);
     const uint8_t *prevBoundary = src;
+    // Skip an initial run of bytes below minNoMaybeLead block by block.
+    // Only done once: a call at the top of the loop slows down text
+    // where each such run is short (Cyrillic, Greek).
+    src = skipLowBlocks(src, limit, minNoMaybeLead);
 
     for (;;) {
         // Fast path: Scan over a sequence of characters below the minimum "no or maybe" code point,
@@ -2171,8 +2194,14 @@ Normalizer2Impl::makeFCD(const UChar *src, const UChar *limit,
     uint16_t fcd16=0;
 
     for(;;) {
-        // count code units with lccc==0
-        for(prevSrc=src; src!=limit;) {
+        // count code units with lccc==0,
+        // skipping a run of code units below minLcccCP block by block
+        prevSrc=src;
+        src=skipLowBlocks(src, limit, minLcccCP);
+        if(src!=prevSrc) {
+            prevFCD16=~*(src-1);
+        }
+        while(src!=limit) {
             if((c=*src)<minLcccCP) {
                 prevFCD16=~c;
                 ++src;
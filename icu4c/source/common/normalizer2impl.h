@@ -649,6 +649,10 @@ class U_COMMON_API Normalizer2Impl : public UObject {
                                                 UChar32 minNeedDataCP,
                                                 ReorderingBuffer *buffer,
                                                 UErrorCode &errorCode) const;
+    // Skip the initial run of code units below minNeedDataCP, or of bytes below
+    // minNeedDataLead, in blocks. Kept out of the hot per-character loops.
+    static const UChar *skipLowBlocks(const UChar *src, const UChar *limit, UChar minNeedDataCP);
+    static const uint8_t *skipLowBlocks(const uint8_t *src, const uint8_t *limit, uint8_t minNeedDataLead);
     const UChar *decomposeShort(const UChar *src, const UChar *limit,
                                 UBool stopAtCompBoundary, UBool onlyContiguous,
                                 ReorderingBuffer &buffer, UErrorCode &errorCode) const;
@@ -25,11 +25,15 @@
 #include "unicode/uchriter.h"
 #include "unicode/uclean.h"
 #include "unicode/udata.h"
+#include "unicode/uscript.h"
+#include "unicode/utf16.h"
+#include "unicode/utf8.h"
 
 #include "brkeng.h"
 #include "ucln_cmn.h"
 #include "cmemory.h"
 #include "cstring.h"
+#include "dictbe.h"
 #include "localsvc.h"
 #include "rbbidata.h"
 #include "rbbi_cache.h"
@@ -227,6 +231,7 @@ RuleBasedBreakIterator::operator=(const RuleBasedBreakIterator& that) {
     // TODO: clone fLanguageBreakEngines from "that"
     UErrorCode status = U_ZERO_ERROR;
     utext_clone(&fText, &that.fText, FALSE, TRUE, &status);
+    initUTF8Text();
 
     if (fCharIter != &fSCharIter) {
         delete fCharIter;
@@ -276,6 +281,8 @@ RuleBasedBreakIterator::operator=(const RuleBasedBreakIterator& that) {
 //-----------------------------------------------------------------------------
 void RuleBasedBreakIterator::init(UErrorCode &status) {
     fCharIter             = NULL;
+    fUTF8Text             = NULL;
+    fUTF8Length           = 0;
     fData                 = NULL;
     fPosition             = 0;
     fRuleStatusIndex      = 0;
@@ -389,6 +396,7 @@ void RuleBasedBreakIterator::setText(UText *ut, UErrorCode &status) {
     fBreakCache->reset();
     fDictionaryCache->reset();
     utext_clone(&fText, ut, FALSE, TRUE, &status);
+    initUTF8Text();
 
     // Set up a dummy CharacterIterator to be returned if anyone
     //   calls getText().  With input from UText, there is no reasonable
@@ -408,6 +416,14 @@ void RuleBasedBreakIterator::setText(UText *ut, UErrorCode &status) {
 }
 
 
+void RuleBasedBreakIterator::initUTF8Text() {
+    fUTF8Text = (const uint8_t *)utext_getUTF8(&fText, &fUTF8Length);
+    if (fUTF8Text == NULL) {
+        fUTF8Length = 0;
+    }
+}
+
+
 UText *RuleBasedBreakIterator::getUText(UText *fillIn, UErrorCode &status) const {
     UText *result = utext_clone(fillIn, &fText, FALSE, TRUE, &status);
     return result;
@@ -450,6 +466,7 @@ RuleBasedBreakIterator::adoptText(CharacterIterator* newText) {
     } else {
         utext_openCharacterIterator(&fText, newText, &status);
     }
+    initUTF8Text();
     this->first();
 }
 
@@ -464,6 +481,7 @@ RuleBasedBreakIterator::setText(const UnicodeString& newText) {
     fBreakCache->reset();
     fDictionaryCache->reset();
     utext_openConstUnicodeString(&fText, &newText, &status);
+    initUTF8Text();
 
     // Set up a character iterator on the string.
     //   Needed in case someone calls getText().
@@ -501,6 +519,7 @@ RuleBasedBreakIterator &RuleBasedBreakIterator::refreshInputText(UText *input, U
     if (U_FAILURE(status)) {
         return *this;
     }
+    initUTF8Text();
     utext_setNativeIndex(&fText, pos);
     if (utext_getNativeIndex(&fText) != pos) {
         // Sanity check.  The new input utext is supposed to have the exact same
@@ -746,18 +765,94 @@ struct LookAheadResults {
 };
 
 
+//-----------------------------------------------------------------------------------
+//
+//  Text readers for the state machine loops of handleNext() and handleSafePrevious().
+//
+//     UTextReader goes through fText. UTF8TextReader reads the bytes of a UTF-8
+//     string directly, saving the UText chunk handling and native index mapping.
+//     Both report native indexes, which for UTF-8 text are byte offsets, and
+//     both read an ill-formed UTF-8 sequence as a single U+FFFD.
+//
+//-----------------------------------------------------------------------------------
+namespace {
+
+class UTextReader {
+public:
+    UTextReader(UText *ut) : fUT(ut) {}
+    void setIndex(int32_t index) { UTEXT_SETNATIVEINDEX(fUT, index); }
+    int32_t getIndex() const { return (int32_t)UTEXT_GETNATIVEINDEX(fUT); }
+    UChar32 next32() { return UTEXT_NEXT32(fUT); }
+    UChar32 previous32() { return UTEXT_PREVIOUS32(fUT); }
+private:
+    UText *fUT;
+};
+
+class UTF8TextReader {
+public:
+    UTF8TextReader(const uint8_t *s, int32_t length) : fS(s), fLength(length), fIndex(0) {}
+    void setIndex(int32_t index) {
+        // Pin to the text, and back up to the start of a code point, as the UText would.
+        if (index < 0) {
+            index = 0;
+        } else if (index > fLength) {
+            index = fLength;
+        }
+        U8_SET_CP_START(fS, 0, index);
+        fIndex = index;
+    }
+    int32_t getIndex() const { return fIndex; }
+    UChar32 next32() {
+        if (fIndex >= fLength) {
+            return U_SENTINEL;
+        }
+        UChar32 c;
+        U8_NEXT_OR_FFFD(fS, fIndex, fLength, c);
+        return c;
+    }
+    UChar32 previous32() {
+        if (fIndex <= 0) {
+            return U_SENTINEL;
+        }
+        UChar32 c;
+        U8_PREV_OR_FFFD(fS, 0, fIndex, c);
+        return c;
+    }
+private:
+    const uint8_t *fS;
+    int32_t fLength;
+    int32_t fIndex;
+};
+
+}  // namespace
+
+
 //-----------------------------------------------------------------------------------
 //
 //  handleNext()
-//     Run the state machine to find a boundary
+//     Run the state machine to find a boundary.
+//     Dispatches on the width of the state table rows and on the kind of text;
+//     the loop itself is instantiated for each combination.
 //
 //-----------------------------------------------------------------------------------
 int32_t RuleBasedBreakIterator::handleNext() {
+    UBool use8BitsRows = (fData->fForwardTable->fFlags & RBBI_8BITS_ROWS) != 0;
+    if (fUTF8Text != NULL) {
+        UTF8TextReader text(fUTF8Text, fUTF8Length);
+        return use8BitsRows ? handleNext<RBBIStateTableRow8>(text) : handleNext<RBBIStateTableRow16>(text);
+    } else {
+        UTextReader text(&fText);
+        return use8BitsRows ? handleNext<RBBIStateTableRow8>(text) : handleNext<RBBIStateTableRow16>(text);
+    }
+}
+
+template <typename RowType, typename TextReader>
+int32_t RuleBasedBreakIterator::handleNext(TextReader &text) {
     int32_t             state;
     uint16_t            category        = 0;
     RBBIRunMode         mode;
 
-    RBBIStateTableRow  *row;
+    const RowType      *row;
     UChar32             c;
     LookAheadResults    lookAheadMatches;
     int32_t             result             = 0;
@@ -779,9 +874,9 @@ int32_t RuleBasedBreakIterator::handleNext() {
 
     // if we're already at the end of the text, return DONE.
     initialPosition = fPosition;
-    UTEXT_SETNATIVEINDEX(&fText, initialPosition);
+    text.setIndex(initialPosition);
     result          = initialPosition;
-    c               = UTEXT_NEXT32(&fText);
+    c               = text.next32();
     if (c==U_SENTINEL) {
         fDone = TRUE;
         return UBRK_DONE;
@@ -789,7 +884,7 @@ int32_t RuleBasedBreakIterator::handleNext() {
 
     //  Set the initial state for the state machine
     state = START_STATE;
-    row = (RBBIStateTableRow *)
+    row = (const RowType *)
             //(statetable->fTableData + (statetable->fRowLen * state));
             (tableData + tableRowLen * state);
 
@@ -844,7 +939,7 @@ int32_t RuleBasedBreakIterator::handleNext() {
 
        #ifdef RBBI_DEBUG
             if (gTrace) {
-                RBBIDebugPrintf("             %4" PRId64 "   ", utext_getNativeIndex(&fText));
+                RBBIDebugPrintf("             %4d   ", text.getIndex());
                 if (0x20<=c && c<0x7f) {
                     RBBIDebugPrintf("\"%c\"  ", c);
                 } else {
@@ -860,22 +955,20 @@ int32_t RuleBasedBreakIterator::handleNext() {
         // fNextState is a variable-length array.
         U_ASSERT(category<fData->fHeader->fCatCount);
         state = row->fNextState[category];  /*Not accessing beyond memory*/
-        row = (RBBIStateTableRow *)
+        row = (const RowType *)
             // (statetable->fTableData + (statetable->fRowLen * state));
             (tableData + tableRowLen * state);
 
 
-        if (row->fAccepting == -1) {
+        if (row->fAccepting == RowType::kAcceptingUnconditional) {
             // Match found, common case.
             if (mode != RBBI_START) {
-                result = (int32_t)UTEXT_GETNATIVEINDEX(&fText);
+                result = text.getIndex();
             }
             fRuleStatusIndex = row->fTagIdx;   // Remember the break status (tag) values.
-        }
-
-        int16_t completedRule = row->fAccepting;
-        if (completedRule > 0) {
+        } else if (row->fAccepting != 0) {
             // Lookahead match is completed.
+            int16_t completedRule = row->fAccepting;
             int32_t lookaheadResult = lookAheadMatches.getPosition(completedRule);
             if (lookaheadResult >= 0) {
                 fRuleStatusIndex = row->fTagIdx;
@@ -892,7 +985,7 @@ int32_t RuleBasedBreakIterator::handleNext() {
         //       Issue ICU-20837
         int16_t rule = row->fLookAhead;
         if (rule != 0) {
-            int32_t  pos = (int32_t)UTEXT_GETNATIVEINDEX(&fText);
+            int32_t  pos = text.getIndex();
             lookAheadMatches.setPosition(rule, pos);
         }
 
@@ -908,7 +1001,7 @@ int32_t RuleBasedBreakIterator::handleNext() {
         //    the input position.  The next iteration will be processing the
         //    first real input character.
         if (mode == RBBI_RUN) {
-            c = UTEXT_NEXT32(&fText);
+            c = text.next32();
         } else {
             if (mode == RBBI_START) {
                 mode = RBBI_RUN;
@@ -922,9 +1015,9 @@ int32_t RuleBasedBreakIterator::handleNext() {
     //   (This really indicates a defect in the break rules.  They should always match
     //    at least one character.)
     if (result == initialPosition) {
-        utext_setNativeIndex(&fText, initialPosition);
-        utext_next32(&fText);
-        result = (int32_t)utext_getNativeIndex(&fText);
+        text.setIndex(initialPosition);
+        text.next32();
+        result = text.getIndex();
         fRuleStatusIndex = 0;
     }
 
@@ -949,14 +1042,28 @@ int32_t RuleBasedBreakIterator::handleNext() {
 //
 //-----------------------------------------------------------------------------------
 int32_t RuleBasedBreakIterator::handleSafePrevious(int32_t fromPosition) {
+    UBool use8BitsRows = (fData->fReverseTable->fFlags & RBBI_8BITS_ROWS) != 0;
+    if (fUTF8Text != NULL) {
+        UTF8TextReader text(fUTF8Text, fUTF8Length);
+        return use8BitsRows ? handleSafePrevious<RBBIStateTableRow8>(text, fromPosition) :
+                              handleSafePrevious<RBBIStateTableRow16>(text, fromPosition);
+    } else {
+        UTextReader text(&fText);
+        return use8BitsRows ? handleSafePrevious<RBBIStateTableRow8>(text, fromPosition) :
+                              handleSafePrevious<RBBIStateTableRow16>(text, fromPosition);
+    }
+}
+
+template <typename RowType, typename TextReader>
+int32_t RuleBasedBreakIterator::handleSafePrevious(TextReader &text, int32_t fromPosition) {
     int32_t             state;
     uint16_t            category        = 0;
-    RBBIStateTableRow  *row;
+    const RowType      *row;
     UChar32             c;
     int32_t             result          = 0;
 
     const RBBIStateTable *stateTable = fData->fReverseTable;
-    UTEXT_SETNATIVEINDEX(&fText, fromPosition);
+    text.setIndex(fromPosition);
     #ifdef RBBI_DEBUG
         if (gTrace) {
             RBBIDebugPuts("Handle Previous   pos   char  state category");
@@ -964,19 +1071,19 @@ int32_t RuleBasedBreakIterator::handleSafePrevious(int32_t fromPosition) {
     #endif
 
     // if we're already at the start of the text, return DONE.
-    if (fData == NULL || UTEXT_GETNATIVEINDEX(&fText)==0) {
+    if (fData == NULL || text.getIndex()==0) {
         return BreakIterator::DONE;
     }
 
     //  Set the initial state for the state machine
-    c = UTEXT_PREVIOUS32(&fText);
+    c = text.previous32();
     state = START_STATE;
-    row = (RBBIStateTableRow *)
+    row = (const RowType *)
             (stateTable->fTableData + (stateTable->fRowLen * state));
 
     // loop until we reach the start of the text or transition to state 0
     //
-    for (; c != U_SENTINEL; c = UTEXT_PREVIOUS32(&fText)) {
+    for (; c != U_SENTINEL; c = text.previous32()) {
 
         // look up the current character's character category, which tells us
         // which column in the state table to look at.
@@ -989,7 +1096,7 @@ int32_t RuleBasedBreakIterator::handleSafePrevious(int32_t fromPosition) {
 
         #ifdef RBBI_DEBUG
             if (gTrace) {
-                RBBIDebugPrintf("             %4d   ", (int32_t)utext_getNativeIndex(&fText));
+                RBBIDebugPrintf("             %4d   ", text.getIndex());
                 if (0x20<=c && c<0x7f) {
                     RBBIDebugPrintf("\"%c\"  ", c);
                 } else {
@@ -1004,7 +1111,7 @@ int32_t RuleBasedBreakIterator::handleSafePrevious(int32_t fromPosition) {
         // fNextState is a variable-length array.
         U_ASSERT(category<fData->fHeader->fCatCount);
         state = row->fNextState[category];  /*Not accessing beyond memory*/
-        row = (RBBIStateTableRow *)
+        row = (const RowType *)
             (stateTable->fTableData + (stateTable->fRowLen * state));
 
         if (state == STOP_STATE) {
@@ -1015,7 +1122,7 @@ int32_t RuleBasedBreakIterator::handleSafePrevious(int32_t fromPosition) {
     }
 
     // The state machine is done.  Check whether it found a match...
-    result = (int32_t)UTEXT_GETNATIVEINDEX(&fText);
+    result = text.getIndex();
     #ifdef RBBI_DEBUG
         if (gTrace) {
             RBBIDebugPrintf("result = %d\n\n", result);
@@ -1065,6 +1172,287 @@ int32_t RuleBasedBreakIterator::getRuleStatusVec(
 }
 
 
+//-------------------------------------------------------------------------------
+//
+//   getBoundaries     All boundaries in a range of the text.
+//                     following() positions the iterator via the safe reverse rules,
+//                     so the result does not depend on the text before the range
+//                     having been iterated over, and ranges can be done in parallel.
+//                     From there, the state machine runs directly, as in
+//                     BreakCache::populateFollowing(), but without going through
+//                     the BreakCache ring buffer for every boundary.
+//
+//-------------------------------------------------------------------------------
+int32_t RuleBasedBreakIterator::getBoundaries(int32_t start, int32_t limit,
+                                              int32_t *boundaries, int32_t *ruleStatuses,
+                                              int32_t capacity, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (start < 0 || limit < start || capacity < 0 || (boundaries == nullptr && capacity > 0)) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    int32_t textLength = static_cast<int32_t>(utext_nativeLength(&fText));
+    if (limit >= textLength) {
+        // Include the end of the text.
+        limit = textLength + 1;
+    }
+    int32_t pos = start == 0 ? first() : following(start - 1);
+    int32_t ruleStatusIdx = fRuleStatusIndex;
+    const int32_t *ruleStatusTable = fData->fRuleStatusTable;
+    int32_t length = 0;
+    while (pos != UBRK_DONE && pos < limit) {
+        if (length < capacity) {
+            boundaries[length] = pos;
+            if (ruleStatuses != nullptr) {
+                // Same as getRuleStatus().
+                ruleStatuses[length] = ruleStatusTable[ruleStatusIdx + ruleStatusTable[ruleStatusIdx]];
+            }
+        }
+        ++length;
+
+        int32_t next = 0;
+        int32_t nextRuleStatusIdx = 0;
+        if (pos < fDictionaryCache->fLimit &&
+                fDictionaryCache->following(pos, &next, &nextRuleStatusIdx)) {
+            pos = next;
+            ruleStatusIdx = nextRuleStatusIdx;
+            continue;
+        }
+        fPosition = pos;
+        next = handleNext();
+        if (next == UBRK_DONE) {
+            break;
+        }
+        nextRuleStatusIdx = fRuleStatusIndex;
+        if (fDictionaryCharCount > 0) {
+            // Subdivide a segment with dictionary characters, as in populateFollowing().
+            fDictionaryCache->populateDictionary(pos, next, ruleStatusIdx, nextRuleStatusIdx);
+            if (fDictionaryCache->following(pos, &next, &nextRuleStatusIdx)) {
+                pos = next;
+                ruleStatusIdx = nextRuleStatusIdx;
+                continue;
+            }
+        }
+        pos = next;
+        ruleStatusIdx = nextRuleStatusIdx;
+    }
+    // Leave the iterator on a boundary, with a cache consistent with it.
+    if (pos != UBRK_DONE) {
+        fBreakCache->reset(pos, ruleStatusIdx);
+        fPosition = pos;
+        fRuleStatusIndex = ruleStatusIdx;
+    } else {
+        last();
+    }
+    fDone = FALSE;
+    if (length > capacity) {
+        status = U_BUFFER_OVERFLOW_ERROR;
+    }
+    return length;
+}
+
+
+//-------------------------------------------------------------------------------
+//
+//   updateBoundaries     Re-segment an edited text near its changes only.
+//
+//-------------------------------------------------------------------------------
+// True if the code point before index is one handled by a dictionary.
+// Dictionary boundaries depend on the whole run of such characters, so they are not
+// stable points from which to re-segment, or at which to resume the old boundaries.
+static UBool isDictionaryCharBefore(UText *text, const UTrie2 *trie, int32_t index) {
+    UTEXT_SETNATIVEINDEX(text, index);
+    UChar32 c = UTEXT_PREVIOUS32(text);
+    return c != U_SENTINEL && (UTRIE2_GET16(trie, c) & 0x4000) != 0;
+}
+
+int32_t RuleBasedBreakIterator::updateBoundaries(const int32_t *oldBoundaries, int32_t oldLength,
+                                                 const Edits &edits,
+                                                 int32_t *boundaries, int32_t capacity,
+                                                 UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (oldBoundaries == nullptr || oldLength < 1 || oldBoundaries[0] != 0 ||
+            capacity < 0 || (boundaries == nullptr && capacity > 0) ||
+            (boundaries != nullptr && boundaries < oldBoundaries + oldLength &&
+                oldBoundaries < boundaries + capacity)) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    int32_t oldTextLength = oldBoundaries[oldLength - 1];
+    int32_t textLength = static_cast<int32_t>(utext_nativeLength(&fText));
+    if (oldTextLength + edits.lengthDelta() != textLength) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+
+    int32_t length = 0;
+    int32_t last = -1;      // The last boundary written, in the new text.
+    int32_t oi = 0;         // The next old boundary not yet reused or passed.
+    int32_t delta = 0;      // New text index minus old text index, after the last change seen.
+    UBool done = FALSE;     // True once the new text has been segmented up to its end.
+    Edits::Iterator ei = edits.getCoarseChangesIterator();
+    UBool hasChange = ei.next(status);
+    while (hasChange && !done && U_SUCCESS(status)) {
+        int32_t changeStart = ei.destinationIndex();
+        if (ei.sourceIndex() + ei.oldLength() > oldTextLength) {
+            status = U_ILLEGAL_ARGUMENT_ERROR;
+            break;
+        }
+
+        // Back up to a boundary before the change, and before any dictionary run that
+        // reaches it; preceding() finds it via the safe reverse rules.
+        // The old boundaries before it are unaffected by the change.
+        int32_t pos = changeStart == 0 ? UBRK_DONE : preceding(changeStart);
+        while (pos > last && isDictionaryCharBefore(&fText, fData->fTrie, pos)) {
+            pos = preceding(pos);
+        }
+        if (pos == UBRK_DONE) {
+            pos = 0;
+        }
+        int32_t ruleStatusIdx = fRuleStatusIndex;
+        while (oi < oldLength && oldBoundaries[oi] + delta <= pos) {
+            int32_t b = oldBoundaries[oi++] + delta;
+            if (b > last) {
+                if (length < capacity) {
+                    boundaries[length] = b;
+                }
+                ++length;
+                last = b;
+            }
+        }
+        if (pos < last) {
+            // The previous change was re-segmented beyond this boundary; continue from there.
+            pos = last;
+        } else if (pos > last) {
+            if (length < capacity) {
+                boundaries[length] = pos;
+            }
+            ++length;
+            last = pos;
+        }
+
+        // Re-segment through the change, and through any later ones reached on the way,
+        // until a rule-based boundary after them is also an old boundary.
+        int32_t changeLimit = 0;
+        while (hasChange && ei.destinationIndex() <= pos) {
+            changeLimit = ei.destinationIndex() + ei.newLength();
+            delta = changeLimit - (ei.sourceIndex() + ei.oldLength());
+            hasChange = ei.next(status);
+        }
+        for (;;) {
+            int32_t next = 0;
+            int32_t nextRuleStatusIdx = 0;
+            UBool isRuleBoundary = FALSE;
+            if (pos < fDictionaryCache->fLimit &&
+                    fDictionaryCache->following(pos, &next, &nextRuleStatusIdx)) {
+                // Within a range subdivided by a dictionary.
+            } else {
+                fPosition = pos;
+                next = handleNext();
+                if (next == UBRK_DONE) {
+                    done = TRUE;
+                    break;
+                }
+                nextRuleStatusIdx = fRuleStatusIndex;
+                if (fDictionaryCharCount > 0) {
+                    // Dictionary boundaries depend on the whole run, so they never count as converged.
+                    fDictionaryCache->populateDictionary(pos, next, ruleStatusIdx, nextRuleStatusIdx);
+                    int32_t dictNext = 0;
+                    int32_t dictRuleStatusIdx = 0;
+                    if (fDictionaryCache->following(pos, &dictNext, &dictRuleStatusIdx)) {
+                        next = dictNext;
+                        nextRuleStatusIdx = dictRuleStatusIdx;
+                    }
+                } else {
+                    isRuleBoundary = TRUE;
+                }
+            }
+            pos = next;
+            ruleStatusIdx = nextRuleStatusIdx;
+            if (length < capacity) {
+                boundaries[length] = pos;
+            }
+            ++length;
+            last = pos;
+
+            while (hasChange && ei.destinationIndex() <= pos) {
+                changeLimit = ei.destinationIndex() + ei.newLength();
+                delta = changeLimit - (ei.sourceIndex() + ei.oldLength());
+                if (changeLimit - delta > oldTextLength) {
+                    status = U_ILLEGAL_ARGUMENT_ERROR;
+                    break;
+                }
+                hasChange = ei.next(status);
+            }
+            if (U_FAILURE(status)) {
+                break;
+            }
+            if (isRuleBoundary && pos >= changeLimit &&
+                    !isDictionaryCharBefore(&fText, fData->fTrie, pos)) {
+                int32_t oldPos = pos - delta;
+                while (oi < oldLength && oldBoundaries[oi] < oldPos) {
+                    ++oi;
+                }
+                if (oi < oldLength && oldBoundaries[oi] == oldPos) {
+                    // Converged: the text after pos is unchanged up to the next change,
+                    // and segmenting it from a rule-based boundary gives the old boundaries.
+                    ++oi;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Reuse the old boundaries after the last change.
+    while (!done && U_SUCCESS(status) && oi < oldLength) {
+        int32_t b = oldBoundaries[oi++] + delta;
+        if (b > last) {
+            if (length < capacity) {
+                boundaries[length] = b;
+            }
+            ++length;
+            last = b;
+        }
+    }
+    first();
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (length > capacity) {
+        status = U_BUFFER_OVERFLOW_ERROR;
+    }
+    return length;
+}
+
+
+//-------------------------------------------------------------------------------
+//
+//   setDictionaryCacheCapacity, getDictionaryCacheStatistics
+//                     The cache itself lives with the dictionary break engines.
+//
+//-------------------------------------------------------------------------------
+void U_EXPORT2
+RuleBasedBreakIterator::setDictionaryCacheCapacity(int32_t capacity, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return;
+    }
+    if (capacity < 0) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    DictionaryBreakEngine::setRunCacheCapacity(capacity);
+}
+
+void U_EXPORT2
+RuleBasedBreakIterator::getDictionaryCacheStatistics(int64_t &hits, int64_t &misses) {
+    DictionaryBreakEngine::getRunCacheStatistics(hits, misses);
+}
+
+
 
 //-------------------------------------------------------------------------------
 //
@@ -1179,6 +1567,33 @@ getLanguageBreakEngineFromFactory(UChar32 c)
 }
 
 
+//-------------------------------------------------------------------------------
+//
+//  preloadDictionaries  Create the engines for all of the dictionaries up front.
+//                       The factories keep the engines they create.
+//
+//-------------------------------------------------------------------------------
+void U_EXPORT2
+RuleBasedBreakIterator::preloadDictionaries(UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return;
+    }
+    UVector32 scripts(status);
+    ICULanguageBreakFactory::prefetchDictionaries(scripts, status);
+    for (int32_t i = 0; U_SUCCESS(status) && i < scripts.size(); ++i) {
+        UChar sample[8];
+        UErrorCode sampleStatus = U_ZERO_ERROR;
+        int32_t length = uscript_getSampleString((UScriptCode)scripts.elementAti(i),
+                                                 sample, UPRV_LENGTHOF(sample), &sampleStatus);
+        if (U_SUCCESS(sampleStatus) && length > 0) {
+            UChar32 c;
+            U16_GET(sample, 0, 0, length, c);
+            getLanguageBreakEngineFromFactory(c);
+        }
+    }
+}
+
+
 //-------------------------------------------------------------------------------
 //
 //  getLanguageBreakEngine  Find an appropriate LanguageBreakEngine for the
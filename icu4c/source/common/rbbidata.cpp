@@ -67,7 +67,8 @@ RBBIDataWrapper::RBBIDataWrapper(UDataMemory* udm, UErrorCode &status) {
 }
 
 UBool RBBIDataWrapper::isDataVersionAcceptable(const UVersionInfo version) {
-    return RBBI_DATA_FORMAT_VERSION[0] == version[0];
+    // Format version 5 differs from 6 only in not having tables with 8-bit rows.
+    return RBBI_DATA_FORMAT_VERSION[0] == version[0] || version[0] == 5;
 }
 
 
@@ -239,9 +240,16 @@ void  RBBIDataWrapper::printTable(const char *heading, const RBBIStateTable *tab
     for (s=0; s<table->fNumStates; s++) {
         RBBIStateTableRow *row = (RBBIStateTableRow *)
                                   (table->fTableData + (table->fRowLen * s));
-        RBBIDebugPrintf("%4d  |  %3d %3d %3d ", s, row->fAccepting, row->fLookAhead, row->fTagIdx);
-        for (c=0; c<fHeader->fCatCount; c++)  {
-            RBBIDebugPrintf("%3d ", row->fNextState[c]);
+        if (table->fFlags & RBBI_8BITS_ROWS) {
+            RBBIDebugPrintf("%4d  |  %3d %3d %3d ", s, row->r8.fAccepting, row->r8.fLookAhead, row->r8.fTagIdx);
+            for (c=0; c<fHeader->fCatCount; c++)  {
+                RBBIDebugPrintf("%3d ", row->r8.fNextState[c]);
+            }
+        } else {
+            RBBIDebugPrintf("%4d  |  %3d %3d %3d ", s, row->r16.fAccepting, row->r16.fLookAhead, row->r16.fTagIdx);
+            for (c=0; c<fHeader->fCatCount; c++)  {
+                RBBIDebugPrintf("%3d ", row->r16.fNextState[c]);
+            }
         }
         RBBIDebugPrintf("\n");
     }
@@ -382,10 +390,19 @@ ubrk_swap(const UDataSwapper *ds, const void *inData, int32_t length, void *outD
     tableLength      = ds->readUInt32(rbbiDH->fFTableLen);
 
     if (tableLength > 0) {
+        const RBBIStateTable *inTable = (const RBBIStateTable *)(inBytes+tableStartOffset);
+        UBool use8Bits = (ds->readUInt32(inTable->fFlags) & RBBI_8BITS_ROWS) != 0;
         ds->swapArray32(ds, inBytes+tableStartOffset, topSize, 
                             outBytes+tableStartOffset, status);
-        ds->swapArray16(ds, inBytes+tableStartOffset+topSize, tableLength-topSize,
-                            outBytes+tableStartOffset+topSize, status);
+        if (use8Bits) {
+            if (inBytes != outBytes) {
+                uprv_memmove(outBytes+tableStartOffset+topSize, inBytes+tableStartOffset+topSize,
+                             tableLength-topSize);
+            }
+        } else {
+            ds->swapArray16(ds, inBytes+tableStartOffset+topSize, tableLength-topSize,
+                                outBytes+tableStartOffset+topSize, status);
+        }
     }
     
     // Reverse state table.  Same layout as forward table, above.
@@ -393,10 +410,19 @@ ubrk_swap(const UDataSwapper *ds, const void *inData, int32_t length, void *outD
     tableLength      = ds->readUInt32(rbbiDH->fRTableLen);
 
     if (tableLength > 0) {
+        const RBBIStateTable *inTable = (const RBBIStateTable *)(inBytes+tableStartOffset);
+        UBool use8Bits = (ds->readUInt32(inTable->fFlags) & RBBI_8BITS_ROWS) != 0;
         ds->swapArray32(ds, inBytes+tableStartOffset, topSize, 
                             outBytes+tableStartOffset, status);
-        ds->swapArray16(ds, inBytes+tableStartOffset+topSize, tableLength-topSize,
-                            outBytes+tableStartOffset+topSize, status);
+        if (use8Bits) {
+            if (inBytes != outBytes) {
+                uprv_memmove(outBytes+tableStartOffset+topSize, inBytes+tableStartOffset+topSize,
+                             tableLength-topSize);
+            }
+        } else {
+            ds->swapArray16(ds, inBytes+tableStartOffset+topSize, tableLength-topSize,
+                                outBytes+tableStartOffset+topSize, status);
+        }
     }
 
     // Trie table for character categories
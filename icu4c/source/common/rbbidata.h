@@ -58,7 +58,9 @@ ubrk_swap(const UDataSwapper *ds,
 U_NAMESPACE_BEGIN
 
 // The current RBBI data format version.
-static const uint8_t RBBI_DATA_FORMAT_VERSION[] = {5, 0, 0, 0};
+// Version 6 added state tables with 8-bit rows. Version 5 data, where all rows
+// are 16 bits wide, can still be read.
+static const uint8_t RBBI_DATA_FORMAT_VERSION[] = {6, 0, 0, 0};
 
 /*  
  *   The following structs map exactly onto the raw data from ICU common data file. 
@@ -94,30 +96,45 @@ struct RBBIDataHeader {
 
 
 
-struct  RBBIStateTableRow {
-    int16_t          fAccepting;    /*  Non-zero if this row is for an accepting state.   */
+template <typename T>
+struct RBBIStateTableRowT {
+    T               fAccepting;     /*  Non-zero if this row is for an accepting state.   */
                                     /*  Value 0: not an accepting state.                  */
-                                    /*       -1: Unconditional Accepting state.           */
-                                    /*    positive:  Look-ahead match has completed.      */
+                                    /*  kAcceptingUnconditional (all bits set, -1 in the  */
+                                    /*      signed fields of format version 5):           */
+                                    /*      Unconditional Accepting state.                */
+                                    /*    other:  Look-ahead match has completed.         */
                                     /*           Actual boundary position happened earlier */
                                     /*           Value here == fLookAhead in earlier      */
                                     /*              state, at actual boundary pos.        */
-    int16_t          fLookAhead;    /*  Non-zero if this row is for a state that          */
+    T               fLookAhead;     /*  Non-zero if this row is for a state that          */
                                     /*    corresponds to a '/' in the rule source.        */
                                     /*    Value is the same as the fAccepting             */
                                     /*      value for the rule (which will appear         */
                                     /*      in a different state.                         */
-    int16_t          fTagIdx;       /*  Non-zero if this row covers a {tagged} position   */
+    T               fTagIdx;        /*  Non-zero if this row covers a {tagged} position   */
                                     /*     from a rule.  Value is the index in the        */
                                     /*     StatusTable of the set of matching             */
                                     /*     tags (rule status values)                      */
-    int16_t          fReserved;
-    uint16_t         fNextState[1]; /*  Next State, indexed by char category.             */
+    T               fReserved;
+    T               fNextState[1];  /*  Next State, indexed by char category.             */
                                     /*    Variable-length array declared with length 1    */
                                     /*    to disable bounds checkers.                     */
                                     /*    Array Size is actually fData->fHeader->fCatCount*/
                                     /*    CAUTION:  see RBBITableBuilder::getTableSize()  */
                                     /*              before changing anything here.        */
+
+    static constexpr T kAcceptingUnconditional = static_cast<T>(-1);
+};
+
+/*  Rows of tables with the RBBI_8BITS_ROWS flag; for up to 256 states.  */
+typedef RBBIStateTableRowT<uint8_t>  RBBIStateTableRow8;
+/*  Rows of all other tables.  */
+typedef RBBIStateTableRowT<uint16_t> RBBIStateTableRow16;
+
+union RBBIStateTableRow {
+    RBBIStateTableRow16 r16;
+    RBBIStateTableRow8  r8;
 };
 
 
@@ -135,7 +152,8 @@ struct RBBIStateTable {
 
 typedef enum {
     RBBI_LOOKAHEAD_HARD_BREAK = 1,
-    RBBI_BOF_REQUIRED = 2
+    RBBI_BOF_REQUIRED = 2,
+    RBBI_8BITS_ROWS = 4         /*  Rows are RBBIStateTableRow8. Format version 6 and later. */
 } RBBIStateTableFlags;
 
 
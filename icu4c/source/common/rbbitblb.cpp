@@ -1335,12 +1335,39 @@ int32_t  RBBITableBuilder::getTableSize() const {
     numRows = fDStates->size();
     numCols = fRB->fSetBuilder->getNumCharCategories();
 
-    rowSize = offsetof(RBBIStateTableRow, fNextState) + sizeof(uint16_t)*numCols;
+    if (use8BitsForTable()) {
+        rowSize = offsetof(RBBIStateTableRow8, fNextState) + sizeof(uint8_t)*numCols;
+    } else {
+        rowSize = offsetof(RBBIStateTableRow16, fNextState) + sizeof(uint16_t)*numCols;
+    }
     size   += numRows * rowSize;
     return size;
 }
 
 
+//-----------------------------------------------------------------------------
+//
+//   use8BitsForTable()    Check whether the state numbers and the per-state
+//                         values fit into the 8-bit row format.
+//                         An fAccepting value of -1 is stored as all-ones.
+//
+//-----------------------------------------------------------------------------
+bool RBBITableBuilder::use8BitsForTable() const {
+    if (fDStates->size() > 0x100) {
+        return false;
+    }
+    for (int32_t state = 0; state < fDStates->size(); state++) {
+        const RBBIStateDescriptor *sd = (const RBBIStateDescriptor *)fDStates->elementAt(state);
+        if (sd->fAccepting < -1 || sd->fAccepting >= 0xff ||
+                sd->fLookAhead < 0 || sd->fLookAhead >= 0xff ||
+                sd->fTagsIdx < 0 || sd->fTagsIdx > 0xff) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
 //-----------------------------------------------------------------------------
 //
 //   exportTable()    export the state transition table in the format required
@@ -1364,9 +1391,15 @@ void RBBITableBuilder::exportTable(void *where) {
         return;
     }
 
-    table->fRowLen    = offsetof(RBBIStateTableRow, fNextState) + sizeof(uint16_t) * catCount;
+    bool use8Bits = use8BitsForTable();
     table->fNumStates = fDStates->size();
     table->fFlags     = 0;
+    if (use8Bits) {
+        table->fRowLen = offsetof(RBBIStateTableRow8, fNextState) + sizeof(uint8_t) * catCount;
+        table->fFlags  |= RBBI_8BITS_ROWS;
+    } else {
+        table->fRowLen = offsetof(RBBIStateTableRow16, fNextState) + sizeof(uint16_t) * catCount;
+    }
     if (fRB->fLookAheadHardBreak) {
         table->fFlags  |= RBBI_LOOKAHEAD_HARD_BREAK;
     }
@@ -1378,13 +1411,24 @@ void RBBITableBuilder::exportTable(void *where) {
     for (state=0; state<table->fNumStates; state++) {
         RBBIStateDescriptor *sd = (RBBIStateDescriptor *)fDStates->elementAt(state);
         RBBIStateTableRow   *row = (RBBIStateTableRow *)(table->fTableData + state*table->fRowLen);
-        U_ASSERT (-32768 < sd->fAccepting && sd->fAccepting <= 32767);
-        U_ASSERT (-32768 < sd->fLookAhead && sd->fLookAhead <= 32767);
-        row->fAccepting = (int16_t)sd->fAccepting;
-        row->fLookAhead = (int16_t)sd->fLookAhead;
-        row->fTagIdx    = (int16_t)sd->fTagsIdx;
-        for (col=0; col<catCount; col++) {
-            row->fNextState[col] = (uint16_t)sd->fDtran->elementAti(col);
+        if (use8Bits) {
+            row->r8.fAccepting = (uint8_t)sd->fAccepting;
+            row->r8.fLookAhead = (uint8_t)sd->fLookAhead;
+            row->r8.fTagIdx    = (uint8_t)sd->fTagsIdx;
+            row->r8.fReserved  = 0;
+            for (col=0; col<catCount; col++) {
+                row->r8.fNextState[col] = (uint8_t)sd->fDtran->elementAti(col);
+            }
+        } else {
+            U_ASSERT (-32768 < sd->fAccepting && sd->fAccepting <= 32767);
+            U_ASSERT (-32768 < sd->fLookAhead && sd->fLookAhead <= 32767);
+            row->r16.fAccepting = (uint16_t)sd->fAccepting;
+            row->r16.fLookAhead = (uint16_t)sd->fLookAhead;
+            row->r16.fTagIdx    = (uint16_t)sd->fTagsIdx;
+            row->r16.fReserved  = 0;
+            for (col=0; col<catCount; col++) {
+                row->r16.fNextState[col] = (uint16_t)sd->fDtran->elementAti(col);
+            }
         }
     }
 }
@@ -1520,12 +1564,26 @@ int32_t  RBBITableBuilder::getSafeTableSize() const {
     numRows = fSafeTable->size();
     numCols = fRB->fSetBuilder->getNumCharCategories();
 
-    rowSize = offsetof(RBBIStateTableRow, fNextState) + sizeof(uint16_t)*numCols;
+    if (use8BitsForSafeTable()) {
+        rowSize = offsetof(RBBIStateTableRow8, fNextState) + sizeof(uint8_t)*numCols;
+    } else {
+        rowSize = offsetof(RBBIStateTableRow16, fNextState) + sizeof(uint16_t)*numCols;
+    }
     size   += numRows * rowSize;
     return size;
 }
 
 
+//-----------------------------------------------------------------------------
+//
+//   use8BitsForSafeTable()    The safe table rows hold only next states.
+//
+//-----------------------------------------------------------------------------
+bool RBBITableBuilder::use8BitsForSafeTable() const {
+    return fSafeTable->size() <= 0x100;
+}
+
+
 //-----------------------------------------------------------------------------
 //
 //   exportSafeTable()   export the state transition table in the format required
@@ -1549,20 +1607,36 @@ void RBBITableBuilder::exportSafeTable(void *where) {
         return;
     }
 
-    table->fRowLen    = offsetof(RBBIStateTableRow, fNextState) + sizeof(uint16_t) * catCount;
+    bool use8Bits = use8BitsForSafeTable();
     table->fNumStates = fSafeTable->size();
     table->fFlags     = 0;
+    if (use8Bits) {
+        table->fRowLen = offsetof(RBBIStateTableRow8, fNextState) + sizeof(uint8_t) * catCount;
+        table->fFlags  |= RBBI_8BITS_ROWS;
+    } else {
+        table->fRowLen = offsetof(RBBIStateTableRow16, fNextState) + sizeof(uint16_t) * catCount;
+    }
     table->fReserved  = 0;
 
     for (state=0; state<table->fNumStates; state++) {
         UnicodeString *rowString = (UnicodeString *)fSafeTable->elementAt(state);
         RBBIStateTableRow   *row = (RBBIStateTableRow *)(table->fTableData + state*table->fRowLen);
-        row->fAccepting = 0;
-        row->fLookAhead = 0;
-        row->fTagIdx    = 0;
-        row->fReserved  = 0;
-        for (col=0; col<catCount; col++) {
-            row->fNextState[col] = rowString->charAt(col);
+        if (use8Bits) {
+            row->r8.fAccepting = 0;
+            row->r8.fLookAhead = 0;
+            row->r8.fTagIdx    = 0;
+            row->r8.fReserved  = 0;
+            for (col=0; col<catCount; col++) {
+                row->r8.fNextState[col] = (uint8_t)rowString->charAt(col);
+            }
+        } else {
+            row->r16.fAccepting = 0;
+            row->r16.fLookAhead = 0;
+            row->r16.fTagIdx    = 0;
+            row->r16.fReserved  = 0;
+            for (col=0; col<catCount; col++) {
+                row->r16.fNextState[col] = rowString->charAt(col);
+            }
         }
     }
 }
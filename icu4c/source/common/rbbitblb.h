@@ -53,6 +53,9 @@ class RBBITableBuilder : public UMemory {
      */
     void     exportTable(void *where);
 
+    /** Return true if the runtime state table fits into 8-bit rows (RBBIStateTableRow8). */
+    bool     use8BitsForTable() const;
+
     /**
      *  Find duplicate (redundant) character classes. Begin looking with categories.first.
      *  Duplicate, if found are returned in the categories parameter.
@@ -85,6 +88,9 @@ class RBBITableBuilder : public UMemory {
      */
     void     exportSafeTable(void *where);
 
+    /** Return true if the runtime safe reverse state table fits into 8-bit rows. */
+    bool     use8BitsForSafeTable() const;
+
 
 private:
     void     calcNullable(RBBINode *n);
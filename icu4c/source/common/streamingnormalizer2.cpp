@@ -0,0 +1,221 @@
+// © 2019 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+/*
+*******************************************************************************
+*   file name:  streamingnormalizer2.cpp
+*   encoding:   UTF-8
+*   tab size:   8 (not used)
+*   indentation:4
+*
+*   created on: 2019dec12
+*
+* Normalization of text that arrives in chunks.
+* Each chunk is normalized up to its last normalization boundary;
+* the rest is retained and prepended to the next chunk.
+* Where text is retained, only the part of the next chunk up to its first
+* boundary is copied; the rest of the chunk is normalized in place.
+*/
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_NORMALIZATION
+
+#include "unicode/appendable.h"
+#include "unicode/bytestream.h"
+#include "unicode/normalizer2.h"
+#include "unicode/unistr.h"
+#include "unicode/utf8.h"
+#include "unicode/utf16.h"
+#include "cmemory.h"
+
+U_NAMESPACE_BEGIN
+
+namespace {
+
+/**
+ * Returns the index of the first character in s[start..length[
+ * which has a normalization boundary before it, or length if there is none.
+ * Ill-formed sequences do not count as boundaries, so that a character
+ * split across chunks stays together with the retained text.
+ */
+int32_t firstBoundary8(const Normalizer2 &norm2, const uint8_t *s, int32_t start, int32_t length) {
+    for (int32_t i = start; i < length;) {
+        int32_t prev = i;
+        UChar32 c;
+        U8_NEXT(s, i, length, c);
+        if (c >= 0 && norm2.hasBoundaryBefore(c)) {
+            return prev;
+        }
+    }
+    return length;
+}
+
+/**
+ * Returns the index of the last character in s[start..length[
+ * which has a normalization boundary before it, or start if there is none.
+ * An incomplete sequence at the end does not count as a boundary.
+ */
+int32_t lastBoundary8(const Normalizer2 &norm2, const uint8_t *s, int32_t start, int32_t length) {
+    for (int32_t i = length; i > start;) {
+        UChar32 c;
+        U8_PREV(s, start, i, c);
+        if (c >= 0 && norm2.hasBoundaryBefore(c)) {
+            return i;
+        }
+    }
+    return start;
+}
+
+// Lone surrogates are normalization-inert, but a lead surrogate at the end
+// or a trail surrogate at the start of a chunk may be half of a split pair.
+
+int32_t firstBoundary16(const Normalizer2 &norm2, const UChar *s, int32_t length) {
+    for (int32_t i = 0; i < length;) {
+        int32_t prev = i;
+        UChar32 c;
+        U16_NEXT(s, i, length, c);
+        if (norm2.hasBoundaryBefore(c) && !(prev == 0 && U16_IS_TRAIL(c))) {
+            return prev;
+        }
+    }
+    return length;
+}
+
+int32_t lastBoundary16(const Normalizer2 &norm2, const UChar *s, int32_t start, int32_t length) {
+    for (int32_t i = length; i > start;) {
+        UChar32 c;
+        U16_PREV(s, start, i, c);
+        if (norm2.hasBoundaryBefore(c) && !(i == length - 1 && U16_IS_LEAD(c))) {
+            return i;
+        }
+    }
+    return start;
+}
+
+}  // namespace
+
+StreamingNormalizer2::StreamingNormalizer2(const Normalizer2 &n2) :
+        norm2(n2), pending8(nullptr), pending8Length(0), pending8Capacity(0) {}
+
+StreamingNormalizer2::~StreamingNormalizer2() {
+    uprv_free(pending8);
+}
+
+UBool
+StreamingNormalizer2::appendPending8(const char *s, int32_t length, UErrorCode &errorCode) {
+    if (length > pending8Capacity - pending8Length) {
+        int32_t newCapacity = pending8Length + length;
+        newCapacity = newCapacity < 64 ? 64 : 2 * newCapacity;
+        char *newPending = static_cast<char *>(uprv_realloc(pending8, newCapacity));
+        if (newPending == nullptr) {
+            errorCode = U_MEMORY_ALLOCATION_ERROR;
+            return FALSE;
+        }
+        pending8 = newPending;
+        pending8Capacity = newCapacity;
+    }
+    uprv_memcpy(pending8 + pending8Length, s, length);
+    pending8Length += length;
+    return TRUE;
+}
+
+void
+StreamingNormalizer2::normalizeUTF8(StringPiece chunk, ByteSink &sink, UErrorCode &errorCode) {
+    if (U_FAILURE(errorCode)) {
+        return;
+    }
+    if (!pending16.isEmpty()) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    const char *s = chunk.data();
+    const uint8_t *s8 = reinterpret_cast<const uint8_t *>(s);
+    int32_t length = chunk.length();
+    int32_t start = 0;
+    if (pending8Length > 0) {
+        // Complete the retained text up to the first boundary in this chunk.
+        start = firstBoundary8(norm2, s8, 0, length);
+        if (!appendPending8(s, start, errorCode)) {
+            return;
+        }
+        if (start == length) {
+            return;
+        }
+        norm2.normalizeUTF8(0, StringPiece(pending8, pending8Length), sink, nullptr, errorCode);
+        pending8Length = 0;
+        if (U_FAILURE(errorCode)) {
+            return;
+        }
+    }
+    int32_t limit = lastBoundary8(norm2, s8, start, length);
+    if (start < limit) {
+        norm2.normalizeUTF8(0, StringPiece(s + start, limit - start), sink, nullptr, errorCode);
+    }
+    appendPending8(s + limit, length - limit, errorCode);
+}
+
+void
+StreamingNormalizer2::finishUTF8(ByteSink &sink, UErrorCode &errorCode) {
+    if (U_SUCCESS(errorCode) && pending8Length > 0) {
+        norm2.normalizeUTF8(0, StringPiece(pending8, pending8Length), sink, nullptr, errorCode);
+    }
+    pending8Length = 0;
+}
+
+void
+StreamingNormalizer2::normalize(const UnicodeString &chunk, Appendable &dest, UErrorCode &errorCode) {
+    if (U_FAILURE(errorCode)) {
+        return;
+    }
+    if (pending8Length > 0 || chunk.isBogus()) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    const UChar *s = chunk.getBuffer();
+    int32_t length = chunk.length();
+    int32_t start = 0;
+    if (!pending16.isEmpty()) {
+        // Complete the retained text up to the first boundary in this chunk.
+        start = firstBoundary16(norm2, s, length);
+        pending16.append(s, 0, start);
+        if (start == length) {
+            return;
+        }
+        norm2.normalize(pending16, result16, errorCode);
+        pending16.remove();
+        if (U_FAILURE(errorCode)) {
+            return;
+        }
+        dest.appendString(result16.getBuffer(), result16.length());
+    }
+    int32_t limit = lastBoundary16(norm2, s, start, length);
+    if (start < limit) {
+        norm2.normalize(UnicodeString(FALSE, s + start, limit - start), result16, errorCode);
+        if (U_FAILURE(errorCode)) {
+            return;
+        }
+        dest.appendString(result16.getBuffer(), result16.length());
+    }
+    pending16.append(s, limit, length - limit);
+}
+
+void
+StreamingNormalizer2::finish(Appendable &dest, UErrorCode &errorCode) {
+    if (U_SUCCESS(errorCode) && !pending16.isEmpty()) {
+        norm2.normalize(pending16, result16, errorCode);
+        if (U_SUCCESS(errorCode)) {
+            dest.appendString(result16.getBuffer(), result16.length());
+        }
+    }
+    pending16.remove();
+}
+
+void
+StreamingNormalizer2::reset() {
+    pending8Length = 0;
+    pending16.remove();
+}
+
+U_NAMESPACE_END
+
+#endif  // !UCONFIG_NO_NORMALIZATION
@@ -33,6 +33,7 @@
 #include "ucnv_cnv.h"
 #include "cmemory.h"
 #include "ustr_imp.h"
+#include "usimd.h"
 
 /* Prototypes --------------------------------------------------------------- */
 
@@ -94,6 +95,30 @@ static void  U_CALLCONV ucnv_toUnicode_UTF8 (UConverterToUnicodeArgs * args,
         if (U8_IS_SINGLE(ch))        /* Simple case */
         {
             *(myTarget++) = (UChar) ch;
+            if (mySource < sourceLimit && U8_IS_SINGLE(*mySource))
+            {
+                /* Copy the rest of an ASCII run in blocks. */
+                int32_t count = (int32_t)(sourceLimit - mySource);
+                if (count > (targetLimit - myTarget))
+                {
+                    count = (int32_t)(targetLimit - myTarget);
+                }
+                count = usimd_asciiFromUTF8(myTarget, mySource, count);
+                myTarget += count;
+                mySource += count;
+            }
+        }
+        else if (ch >= 0xe0 && ch < 0xf0 && (sourceLimit - mySource) >= 2 &&
+                 U8_IS_VALID_LEAD3_AND_T1(ch, mySource[0]) && U8_IS_TRAIL(mySource[1]))
+        {
+            /* complete and well-formed U+0800..U+FFFF sequence */
+            *(myTarget++) = (UChar) ((ch << 12) | ((mySource[0] & 0x3f) << 6) | (mySource[1] & 0x3f));
+            mySource += 2;
+        }
+        else if (ch >= 0xc2 && ch < 0xe0 && mySource < sourceLimit && U8_IS_TRAIL(*mySource))
+        {
+            /* complete and well-formed U+0080..U+07FF sequence */
+            *(myTarget++) = (UChar) (((ch & 0x1f) << 6) | (*(mySource++) & 0x3f));
         }
         else
         {
@@ -212,6 +237,38 @@ static void  U_CALLCONV ucnv_toUnicode_UTF8_OFFSETS_LOGIC (UConverterToUnicodeAr
         {
             *(myTarget++) = (UChar) ch;
             *(myOffsets++) = offsetNum++;
+            if (mySource < sourceLimit && U8_IS_SINGLE(*mySource))
+            {
+                /* Copy the rest of an ASCII run in blocks. */
+                int32_t count = (int32_t)(sourceLimit - mySource);
+                if (count > (targetLimit - myTarget))
+                {
+                    count = (int32_t)(targetLimit - myTarget);
+                }
+                count = usimd_asciiFromUTF8(myTarget, mySource, count);
+                myTarget += count;
+                mySource += count;
+                while (count-- > 0)
+                {
+                    *(myOffsets++) = offsetNum++;
+                }
+            }
+        }
+        else if (ch >= 0xe0 && ch < 0xf0 && (sourceLimit - mySource) >= 2 &&
+                 U8_IS_VALID_LEAD3_AND_T1(ch, mySource[0]) && U8_IS_TRAIL(mySource[1]))
+        {
+            /* complete and well-formed U+0800..U+FFFF sequence */
+            *(myTarget++) = (UChar) ((ch << 12) | ((mySource[0] & 0x3f) << 6) | (mySource[1] & 0x3f));
+            *(myOffsets++) = offsetNum;
+            offsetNum += 3;
+            mySource += 2;
+        }
+        else if (ch >= 0xc2 && ch < 0xe0 && mySource < sourceLimit && U8_IS_TRAIL(*mySource))
+        {
+            /* complete and well-formed U+0080..U+07FF sequence */
+            *(myTarget++) = (UChar) (((ch & 0x1f) << 6) | (*(mySource++) & 0x3f));
+            *(myOffsets++) = offsetNum;
+            offsetNum += 2;
         }
         else
         {
@@ -325,6 +382,18 @@ U_CFUNC void  U_CALLCONV ucnv_fromUnicode_UTF8 (UConverterFromUnicodeArgs * args
         if (ch < 0x80)        /* Single byte */
         {
             *(myTarget++) = (uint8_t) ch;
+            if (mySource < sourceLimit && *mySource < 0x80)
+            {
+                /* Copy the rest of an ASCII run in blocks. */
+                int32_t count = (int32_t)(sourceLimit - mySource);
+                if (count > (targetLimit - myTarget))
+                {
+                    count = (int32_t)(targetLimit - myTarget);
+                }
+                count = usimd_asciiToUTF8(myTarget, mySource, count);
+                myTarget += count;
+                mySource += count;
+            }
         }
         else if (ch < 0x800)  /* Double byte */
         {
@@ -446,6 +515,22 @@ U_CFUNC void  U_CALLCONV ucnv_fromUnicode_UTF8_OFFSETS_LOGIC (UConverterFromUnic
         {
             *(myOffsets++) = offsetNum++;
             *(myTarget++) = (char) ch;
+            if (mySource < sourceLimit && *mySource < 0x80)
+            {
+                /* Copy the rest of an ASCII run in blocks. */
+                int32_t count = (int32_t)(sourceLimit - mySource);
+                if (count > (targetLimit - myTarget))
+                {
+                    count = (int32_t)(targetLimit - myTarget);
+                }
+                count = usimd_asciiToUTF8(myTarget, mySource, count);
+                myTarget += count;
+                mySource += count;
+                while (count-- > 0)
+                {
+                    *(myOffsets++) = offsetNum++;
+                }
+            }
         }
         else if (ch < 0x800)  /* Double byte */
         {
@@ -723,9 +808,14 @@ ucnv_UTF8FromUTF8(UConverterFromUnicodeArgs *pFromUArgs,
     while(count>0) {
         b=*source++;
         if(U8_IS_SINGLE(b)) {
-            /* convert ASCII */
+            /* convert ASCII, and copy the rest of an ASCII run in blocks */
             *target++=b;
             --count;
+            int32_t length=usimd_asciiPrefixUTF8(source, count);
+            uprv_memcpy(target, source, length);
+            source+=length;
+            target+=length;
+            count-=length;
             continue;
         } else {
             if(b>=0xe0) {
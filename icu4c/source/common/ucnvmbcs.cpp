@@ -60,6 +60,7 @@
 #include "cstring.h"
 #include "umutex.h"
 #include "ustr_imp.h"
+#include "usimd.h"
 
 /* control optimizations according to the platform */
 #define MBCS_UNROLL_SINGLE_TO_BMP 1
@@ -5132,6 +5133,18 @@ ucnv_SBCSFromUTF8(UConverterFromUnicodeArgs *pFromUArgs,
                 if(IS_ASCII_ROUNDTRIP(b, asciiRoundtrips)) {
                     *target++=(uint8_t)b;
                     --targetCapacity;
+                    if(asciiRoundtrips==0xffffffff) {
+                        /* all of ASCII round-trips: copy the rest of an ASCII run in blocks */
+                        int32_t length=(int32_t)(sourceLimit-source);
+                        if(length>targetCapacity) {
+                            length=targetCapacity;
+                        }
+                        length=usimd_asciiPrefixUTF8(source, length);
+                        uprv_memcpy(target, source, length);
+                        source+=length;
+                        target+=length;
+                        targetCapacity-=length;
+                    }
                     continue;
                 } else {
                     c=b;
@@ -5410,6 +5423,18 @@ ucnv_DBCSFromUTF8(UConverterFromUnicodeArgs *pFromUArgs,
                 if(IS_ASCII_ROUNDTRIP(b, asciiRoundtrips)) {
                     *target++=b;
                     --targetCapacity;
+                    if(asciiRoundtrips==0xffffffff) {
+                        /* all of ASCII round-trips: copy the rest of an ASCII run in blocks */
+                        int32_t length=(int32_t)(sourceLimit-source);
+                        if(length>targetCapacity) {
+                            length=targetCapacity;
+                        }
+                        length=usimd_asciiPrefixUTF8(source, length);
+                        uprv_memcpy(target, source, length);
+                        source+=length;
+                        target+=length;
+                        targetCapacity-=length;
+                    }
                     continue;
                 } else {
                     value=DBCS_RESULT_FROM_UTF8(mbcsIndex, results, 0, b);
@@ -528,3 +528,31 @@ typedef HANDLE MemoryMap;
 #else
 #   error MAP_IMPLEMENTATION is set incorrectly
 #endif
+
+/*----------------------------------------------------------------------------*
+ *                                                                            *
+ *   Prefetching of data pages.                                               *
+ *     Asks the OS to read ahead where that is possible, then reads one byte  *
+ *     per page so that later accesses do not fault.                          *
+ *                                                                            *
+ *----------------------------------------------------------------------------*/
+U_CFUNC void
+uprv_prefetchData(const void *data, int32_t length) {
+    if (data == nullptr || length <= 0) {
+        return;
+    }
+#if MAP_IMPLEMENTATION==MAP_POSIX && defined(POSIX_MADV_WILLNEED)
+    // posix_madvise() wants a page-aligned start address.
+    long pageSize = sysconf(_SC_PAGESIZE);
+    if (pageSize > 0) {
+        uintptr_t start = (uintptr_t)data & ~(uintptr_t)(pageSize - 1);
+        posix_madvise((void *)start, (size_t)((uintptr_t)data + length - start), POSIX_MADV_WILLNEED);
+    }
+#endif
+    // 4kB is the smallest common page size.
+    const volatile uint8_t *p = (const volatile uint8_t *)data;
+    for (int32_t i = 0; i < length; i += 4096) {
+        (void)p[i];
+    }
+    (void)p[length - 1];
+}
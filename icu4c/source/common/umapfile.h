@@ -32,6 +32,12 @@
 U_CFUNC UBool uprv_mapFile(UDataMemory *pdm, const char *path, UErrorCode *status);
 U_CFUNC void  uprv_unmapFile(UDataMemory *pData);
 
+/**
+ * Makes the pages of some data resident, for example of a memory-mapped data item
+ * that is about to be used, so that the first accesses do not stall on page faults.
+ */
+U_CFUNC void  uprv_prefetchData(const void *data, int32_t length);
+
 /* MAP_NONE: no memory mapping, no file access at all */
 #define MAP_NONE        0
 #define MAP_WIN32       1
@@ -37,6 +37,7 @@
 
 U_NAMESPACE_BEGIN
 
+class Appendable;
 class ByteSink;
 
 /**
@@ -398,6 +399,56 @@ class U_COMMON_API Normalizer2 : public UObject {
     virtual UBool
     isNormalizedUTF8(StringPiece s, UErrorCode &errorCode) const;
 
+    // Do not enclose the batch functions with #ifndef U_HIDE_DRAFT_API because they are virtual.
+
+    /**
+     * Tests whether each of many strings is normalized.
+     * The strings are stored back to back in one buffer:
+     * String i is text[offsets[i]..offsets[i+1]-1], so there are count+1 offsets.
+     * Sets bit i of the results bit set,
+     * <code>(results[i>>3]>>(i&7))&1</code>, to 1 if string i is normalized, else to 0.
+     *
+     * This is equivalent to count calls to isNormalized()
+     * but avoids the per-call overhead when there are many short strings.
+     * It may be called concurrently on the same Normalizer2 from multiple threads:
+     * To check strings in parallel, give each thread a range of strings
+     * starting at a multiple of 8, and the corresponding parts of offsets and results.
+     *
+     * @param text buffer with the concatenated strings
+     * @param offsets array of count+1 non-decreasing offsets into text
+     * @param count the number of strings
+     * @param results bit set of (count+7)/8 bytes to be filled in
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @return the number of normalized strings
+     * @draft ICU 67
+     */
+    virtual int32_t
+    isNormalizedBatch(const char16_t *text, const int32_t offsets[], int32_t count,
+                      uint8_t results[], UErrorCode &errorCode) const;
+
+    /**
+     * Tests whether each of many UTF-8 strings is normalized.
+     * Same as isNormalizedBatch() but for UTF-8 input.
+     * Currently optimized only for "compose" modes, as for isNormalizedUTF8().
+     *
+     * @param text buffer with the concatenated UTF-8 strings
+     * @param offsets array of count+1 non-decreasing offsets into text
+     * @param count the number of strings
+     * @param results bit set of (count+7)/8 bytes to be filled in
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @return the number of normalized strings
+     * @draft ICU 67
+     */
+    virtual int32_t
+    isNormalizedBatchUTF8(const char *text, const int32_t offsets[], int32_t count,
+                          uint8_t results[], UErrorCode &errorCode) const;
+
 
     /**
      * Tests if the string is normalized.
@@ -770,6 +821,123 @@ class U_COMMON_API FilteredNormalizer2 : public Normalizer2 {
     const UnicodeSet &set;
 };
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Normalizes text that arrives in arbitrary chunks, for example a large file
+ * read block by block, without requiring the whole text in memory.
+ *
+ * Each chunk is normalized up to the last normalization boundary in it
+ * (see Normalizer2::hasBoundaryBefore()) and the result is written to the sink;
+ * only the text after that boundary is retained until more input arrives.
+ * The concatenation of all output equals normalizing the concatenation of
+ * all chunks in one call. Chunks may split a character anywhere,
+ * including between a surrogate pair or inside a UTF-8 byte sequence.
+ *
+ * Memory use is bounded by the chunk size plus the longest stretch of text
+ * without a boundary, which is very short for normal text.
+ * (Text in the UAX #15 Stream-Safe Text Format bounds it in any case.)
+ *
+ * One object handles one stream of either UTF-8 or UTF-16 text;
+ * call finish...() or reset() before switching between them.
+ * This class is not thread-safe.
+ * @draft ICU 67
+ */
+class U_COMMON_API StreamingNormalizer2 : public UMemory {
+public:
+    /**
+     * Constructs a streaming normalizer for the given Normalizer2,
+     * which is aliased and must not be deleted while this object is used.
+     * @param n2 wrapped Normalizer2 instance
+     * @draft ICU 67
+     */
+    explicit StreamingNormalizer2(const Normalizer2 &n2);
+
+    /**
+     * Destructor.
+     * @draft ICU 67
+     */
+    ~StreamingNormalizer2();
+
+    /**
+     * Normalizes the next chunk of UTF-8 text as far as possible
+     * and writes the normalized UTF-8 result to the sink.
+     * @param chunk next piece of the UTF-8 input
+     * @param sink receives the normalized UTF-8 output
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     *                  Set to U_ILLEGAL_ARGUMENT_ERROR if UTF-16 text is pending.
+     * @draft ICU 67
+     */
+    void normalizeUTF8(StringPiece chunk, ByteSink &sink, UErrorCode &errorCode);
+
+    /**
+     * Normalizes and writes out the retained end of the UTF-8 text,
+     * after which the object is ready for a new stream.
+     * @param sink receives the normalized UTF-8 output
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @draft ICU 67
+     */
+    void finishUTF8(ByteSink &sink, UErrorCode &errorCode);
+
+    /**
+     * Normalizes the next chunk of UTF-16 text as far as possible
+     * and appends the normalized result to dest.
+     * @param chunk next piece of the UTF-16 input
+     * @param dest receives the normalized output
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     *                  Set to U_ILLEGAL_ARGUMENT_ERROR if UTF-8 text is pending.
+     * @draft ICU 67
+     */
+    void normalize(const UnicodeString &chunk, Appendable &dest, UErrorCode &errorCode);
+
+    /**
+     * Normalizes and appends the retained end of the UTF-16 text,
+     * after which the object is ready for a new stream.
+     * @param dest receives the normalized output
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @draft ICU 67
+     */
+    void finish(Appendable &dest, UErrorCode &errorCode);
+
+    /**
+     * Discards any retained text.
+     * @draft ICU 67
+     */
+    void reset();
+
+    /**
+     * Returns the number of code units retained for the next chunk or finish...().
+     * @return the number of pending bytes (UTF-8) or UChars (UTF-16)
+     * @draft ICU 67
+     */
+    int32_t getPendingLength() const { return pending8Length + pending16.length(); }
+
+private:
+    StreamingNormalizer2(const StreamingNormalizer2 &) = delete;
+    StreamingNormalizer2 &operator=(const StreamingNormalizer2 &) = delete;
+
+    UBool appendPending8(const char *s, int32_t length, UErrorCode &errorCode);
+
+    const Normalizer2 &norm2;
+    char *pending8;
+    int32_t pending8Length;
+    int32_t pending8Capacity;
+    UnicodeString pending16;
+    UnicodeString result16;  // Don't throw away the output buffer between chunks.
+};
+#endif  // U_HIDE_DRAFT_API
+
 U_NAMESPACE_END
 
 #endif  // !UCONFIG_NO_NORMALIZATION
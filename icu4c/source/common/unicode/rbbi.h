@@ -28,6 +28,7 @@
 #if !UCONFIG_NO_BREAK_ITERATION
 
 #include "unicode/brkiter.h"
+#include "unicode/edits.h"
 #include "unicode/udata.h"
 #include "unicode/parseerr.h"
 #include "unicode/schriter.h"
@@ -61,6 +62,19 @@ class U_COMMON_API RuleBasedBreakIterator /*U_FINAL*/ : public BreakIterator {
      */
     UText  fText;
 
+    /**
+     * The bytes of the text when fText wraps a UTF-8 string, otherwise NULL.
+     * The state machine then reads the text directly rather than through fText.
+     * @internal (private)
+     */
+    const uint8_t *fUTF8Text;
+
+    /**
+     * The length in bytes of fUTF8Text.
+     * @internal (private)
+     */
+    int32_t fUTF8Length;
+
 #ifndef U_HIDE_INTERNAL_API
 public:
 #endif /* U_HIDE_INTERNAL_API */
@@ -512,6 +526,121 @@ class U_COMMON_API RuleBasedBreakIterator /*U_FINAL*/ : public BreakIterator {
     */
     virtual int32_t getRuleStatusVec(int32_t *fillInVec, int32_t capacity, UErrorCode &status);
 
+#ifndef U_HIDE_DRAFT_API
+    /**
+     * Finds the boundaries in the range [start, limit) of the text,
+     * plus the end of the text if limit is the text length,
+     * and optionally their rule status values.
+     * The results are the same as those from iterating over the whole text with next()
+     * and calling getRuleStatus() at each boundary.
+     *
+     * The work is proportional to the length of the range:
+     * Iteration starts from a safe point shortly before start,
+     * found with the safe reverse rules, not from the start of the text.
+     * Therefore, a large text can be segmented in parallel:
+     * Split it into adjacent ranges, call this function for each range on a separate
+     * thread with its own clone() of this iterator, and concatenate the results.
+     *
+     * The iteration position afterwards is unspecified.
+     *
+     * @param start start of the range, a text index
+     * @param limit end of the range, a text index >= start
+     * @param boundaries array to be filled in with the boundaries in ascending order;
+     *                   can be nullptr if capacity==0
+     * @param ruleStatuses array to be filled in with the getRuleStatus() values
+     *                     of the boundaries; can be nullptr
+     * @param capacity the length of the boundaries array, and of the ruleStatuses array if not nullptr
+     * @param status receives error codes; U_BUFFER_OVERFLOW_ERROR if there are
+     *               more than capacity boundaries in the range
+     * @return the number of boundaries in the range
+     * @draft ICU 67
+     */
+    int32_t getBoundaries(int32_t start, int32_t limit,
+                          int32_t *boundaries, int32_t *ruleStatuses, int32_t capacity,
+                          UErrorCode &status);
+
+    /**
+     * Updates the boundaries of a text after it has been edited,
+     * recomputing only those near the changes.
+     * The iterator must have been set to the new text, and oldBoundaries must be
+     * all of the boundaries of the old text, as returned by iterating over it with next()
+     * or by getBoundaries() over the whole text. The results are the same as those
+     * from iterating over the whole new text.
+     *
+     * Before each change, iteration backs up to a boundary found with the safe reverse rules.
+     * After the change, it stops as soon as a rule-based boundary coincides with
+     * an old boundary again; the rest of the old boundaries are reused, shifted by the
+     * change in length. The work is therefore proportional to the size of the changes
+     * rather than to the length of the text, apart from copying the boundaries.
+     *
+     * The iteration position afterwards is unspecified.
+     *
+     * @param oldBoundaries all of the boundaries of the old text, in ascending order,
+     *                      starting with 0 and ending with the old text length
+     * @param oldLength the number of old boundaries
+     * @param edits the changes from the old text to the new text,
+     *              for example as recorded by a case mapping or normalization function
+     * @param boundaries array to be filled in with the boundaries of the new text in
+     *                   ascending order; can be nullptr if capacity==0; must not overlap oldBoundaries
+     * @param capacity the length of the boundaries array
+     * @param status receives error codes; U_BUFFER_OVERFLOW_ERROR if the new text
+     *               has more than capacity boundaries
+     * @return the number of boundaries of the new text
+     * @draft ICU 67
+     */
+    int32_t updateBoundaries(const int32_t *oldBoundaries, int32_t oldLength, const Edits &edits,
+                             int32_t *boundaries, int32_t capacity, UErrorCode &status);
+
+    /**
+     * Sets the capacity of the process-wide cache of dictionary-based segmentation results.
+     *
+     * Runs of text in languages like Thai, Lao, Khmer, Burmese, Chinese and Japanese
+     * are segmented with dictionaries, which is much slower than rule-based segmentation.
+     * With a positive capacity, the boundaries found in up to that many distinct runs
+     * are kept, and the least recently used ones are evicted. Segmenting a cached run
+     * again, with any break iterator in the process, only copies its boundaries.
+     * This helps where the same short texts, such as popular search queries,
+     * are segmented over and over.
+     *
+     * The cache is used for text set as a UnicodeString or with UTF-16 UText,
+     * and is shared by all threads. The default capacity is 0: no caching.
+     * Setting the capacity to 0 also empties the cache.
+     *
+     * @param capacity the maximum number of cached runs, >= 0
+     * @param status receives U_ILLEGAL_ARGUMENT_ERROR if capacity < 0
+     * @draft ICU 67
+     */
+    static void U_EXPORT2 setDictionaryCacheCapacity(int32_t capacity, UErrorCode &status);
+
+    /**
+     * Gets the number of dictionary-segmented runs that were found in
+     * the cache (hits) and that were not (misses), since the process started.
+     * Runs are counted only while the cache is on.
+     * @see setDictionaryCacheCapacity
+     *
+     * @param hits receives the number of cache hits
+     * @param misses receives the number of cache misses
+     * @draft ICU 67
+     */
+    static void U_EXPORT2 getDictionaryCacheStatistics(int64_t &hits, int64_t &misses);
+
+    /**
+     * Loads the dictionaries used for segmenting text in languages like Thai, Lao, Khmer,
+     * Burmese, Chinese and Japanese, and creates the break engines that use them,
+     * so that the first iterator to meet such text does not pay for that.
+     *
+     * The dictionaries are used in place in the ICU data, which is normally memory-mapped
+     * as one read-only region, so that processes using the same data share its pages.
+     * This function also makes the pages of the dictionaries resident, with a read-ahead
+     * hint to the OS where available.
+     * Call it once at startup; the engines are kept until u_cleanup().
+     *
+     * @param status receives error codes
+     * @draft ICU 67
+     */
+    static void U_EXPORT2 preloadDictionaries(UErrorCode &status);
+#endif  /* U_HIDE_DRAFT_API */
+
     /**
      * Returns a unique class ID POLYMORPHICALLY.  Pure virtual override.
      * This method is to implement a simple version of RTTI, since not all
@@ -645,6 +774,14 @@ class U_COMMON_API RuleBasedBreakIterator /*U_FINAL*/ : public BreakIterator {
      */
     int32_t handleSafePrevious(int32_t fromPosition);
 
+    /**
+     * handleSafePrevious() for one width of state table rows,
+     * reading the text through a UText or directly from UTF-8.
+     * @internal (private)
+     */
+    template <typename RowType, typename TextReader>
+    int32_t handleSafePrevious(TextReader &text, int32_t fromPosition);
+
     /**
      * Find a rule-based boundary by running the state machine.
      * Input
@@ -659,6 +796,20 @@ class U_COMMON_API RuleBasedBreakIterator /*U_FINAL*/ : public BreakIterator {
      */
     int32_t handleNext();
 
+    /**
+     * handleNext() for one width of state table rows,
+     * reading the text through a UText or directly from UTF-8.
+     * @internal (private)
+     */
+    template <typename RowType, typename TextReader>
+    int32_t handleNext(TextReader &text);
+
+    /**
+     * Set fUTF8Text and fUTF8Length according to the current fText.
+     * @internal (private)
+     */
+    void initUTF8Text();
+
 
     /**
      * This function returns the appropriate LanguageBreakEngine for a
@@ -441,6 +441,35 @@ unorm2_isNormalized(const UNormalizer2 *norm2,
                     const UChar *s, int32_t length,
                     UErrorCode *pErrorCode);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Tests whether each of many strings is normalized.
+ * The strings are stored back to back in one buffer:
+ * String i is text[offsets[i]..offsets[i+1]-1], so there are count+1 offsets.
+ * Sets bit i of the results bit set, (results[i>>3]>>(i&7))&1,
+ * to 1 if string i is normalized, else to 0.
+ * This avoids the per-call overhead of unorm2_isNormalized()
+ * when there are many short strings.
+ * @param norm2 UNormalizer2 instance
+ * @param text buffer with the concatenated strings
+ * @param offsets array of count+1 non-decreasing offsets into text
+ * @param count the number of strings
+ * @param results bit set of (count+7)/8 bytes to be filled in
+ * @param pErrorCode Standard ICU error code. Its input value must
+ *                   pass the U_SUCCESS() test, or else the function returns
+ *                   immediately. Check for U_FAILURE() on output or use with
+ *                   function chaining. (See User Guide for details.)
+ * @return the number of normalized strings
+ * @see unorm2_isNormalized
+ * @draft ICU 67
+ */
+U_DRAFT int32_t U_EXPORT2
+unorm2_isNormalizedBatch(const UNormalizer2 *norm2,
+                         const UChar *text, const int32_t *offsets, int32_t count,
+                         uint8_t *results,
+                         UErrorCode *pErrorCode);
+#endif  /* U_HIDE_DRAFT_API */
+
 /**
  * Tests if the string is normalized.
  * For the two COMPOSE modes, the result could be "maybe" in cases that
@@ -1178,6 +1178,7 @@
 #define unorm2_hasBoundaryBefore U_ICU_ENTRY_POINT_RENAME(unorm2_hasBoundaryBefore)
 #define unorm2_isInert U_ICU_ENTRY_POINT_RENAME(unorm2_isInert)
 #define unorm2_isNormalized U_ICU_ENTRY_POINT_RENAME(unorm2_isNormalized)
+#define unorm2_isNormalizedBatch U_ICU_ENTRY_POINT_RENAME(unorm2_isNormalizedBatch)
 #define unorm2_normalize U_ICU_ENTRY_POINT_RENAME(unorm2_normalize)
 #define unorm2_normalizeSecondAndAppend U_ICU_ENTRY_POINT_RENAME(unorm2_normalizeSecondAndAppend)
 #define unorm2_openFiltered U_ICU_ENTRY_POINT_RENAME(unorm2_openFiltered)
@@ -1582,6 +1583,7 @@
 #define ures_openNoDefault U_ICU_ENTRY_POINT_RENAME(ures_openNoDefault)
 #define ures_openU U_ICU_ENTRY_POINT_RENAME(ures_openU)
 #define ures_resetIterator U_ICU_ENTRY_POINT_RENAME(ures_resetIterator)
+#define ures_setFallbackIndexEnabled U_ICU_ENTRY_POINT_RENAME(ures_setFallbackIndexEnabled)
 #define ures_swap U_ICU_ENTRY_POINT_RENAME(ures_swap)
 #define uscript_breaksBetweenLetters U_ICU_ENTRY_POINT_RENAME(uscript_breaksBetweenLetters)
 #define uscript_closeRun U_ICU_ENTRY_POINT_RENAME(uscript_closeRun)
@@ -1752,6 +1754,7 @@
 #define utext_freeze U_ICU_ENTRY_POINT_RENAME(utext_freeze)
 #define utext_getNativeIndex U_ICU_ENTRY_POINT_RENAME(utext_getNativeIndex)
 #define utext_getPreviousNativeIndex U_ICU_ENTRY_POINT_RENAME(utext_getPreviousNativeIndex)
+#define utext_getUTF8 U_ICU_ENTRY_POINT_RENAME(utext_getUTF8)
 #define utext_hasMetaData U_ICU_ENTRY_POINT_RENAME(utext_hasMetaData)
 #define utext_isLengthExpensive U_ICU_ENTRY_POINT_RENAME(utext_isLengthExpensive)
 #define utext_isWritable U_ICU_ENTRY_POINT_RENAME(utext_isWritable)
@@ -226,6 +226,22 @@ U_NAMESPACE_END
 U_STABLE UText * U_EXPORT2
 utext_openUTF8(UText *ut, const char *s, int64_t length, UErrorCode *status);
 
+#ifndef U_HIDE_INTERNAL_API
+/**
+ * Get the UTF-8 string underlying a UText that was opened with utext_openUTF8()
+ * (or is a clone of one), so that performance-critical code can read the bytes
+ * directly. The native indexes of such a UText are byte offsets into the string.
+ * If the string was zero terminated, its length is determined first.
+ *
+ * @param ut      The UText.
+ * @param pLength Receives the length of the string in bytes, if ut wraps a UTF-8 string.
+ * @return        The UTF-8 string, or NULL if ut is not a UTF-8 UText.
+ * @internal
+ */
+U_INTERNAL const char * U_EXPORT2
+utext_getUTF8(UText *ut, int32_t *pLength);
+#endif  /* U_HIDE_INTERNAL_API */
+
 
 /**
  * Open a read-only UText for UChar * string.
@@ -15,13 +15,23 @@
 #include <algorithm>      // For std::max()
 #include <mutex>
 
+#include "putilimp.h"
 #include "uassert.h"
 #include "uhash.h"
 #include "ucln_cmn.h"
 
+namespace {
+
+// Synchronization for the cache shards, shared by all UnifiedCache instances.
+struct CacheShardLocks {
+    std::mutex mutexes[icu::UnifiedCache::NUM_SHARDS];
+    std::condition_variable inProgressValueAddedConds[icu::UnifiedCache::NUM_SHARDS];
+};
+
+}  // namespace
+
 static icu::UnifiedCache *gCache = NULL;
-static std::mutex *gCacheMutex = nullptr;
-static std::condition_variable *gInProgressValueAddedCond;
+static CacheShardLocks *gCacheLocks = nullptr;
 static icu::UInitOnce gCacheInitOnce = U_INITONCE_INITIALIZER;
 
 static const int32_t MAX_EVICT_ITERATIONS = 10;
@@ -34,10 +44,8 @@ static UBool U_CALLCONV unifiedcache_cleanup() {
     gCacheInitOnce.reset();
     delete gCache;
     gCache = nullptr;
-    gCacheMutex->~mutex();
-    gCacheMutex = nullptr;
-    gInProgressValueAddedCond->~condition_variable();
-    gInProgressValueAddedCond = nullptr;
+    gCacheLocks->~CacheShardLocks();
+    gCacheLocks = nullptr;
     return TRUE;
 }
 U_CDECL_END
@@ -67,13 +75,34 @@ ucache_deleteKey(void *obj) {
 CacheKeyBase::~CacheKeyBase() {
 }
 
+namespace {
+
+// Holds the mutexes of all shards, locked in index order.
+class AllShardsLock : public UMemory {
+public:
+    AllShardsLock() {
+        for (int32_t i = 0; i < UnifiedCache::NUM_SHARDS; ++i) {
+            gCacheLocks->mutexes[i].lock();
+        }
+    }
+    ~AllShardsLock() {
+        for (int32_t i = UnifiedCache::NUM_SHARDS; i > 0;) {
+            gCacheLocks->mutexes[--i].unlock();
+        }
+    }
+private:
+    AllShardsLock(const AllShardsLock &other);  // not implemented
+    AllShardsLock &operator=(const AllShardsLock &other);  // not implemented
+};
+
+}  // namespace
+
 static void U_CALLCONV cacheInit(UErrorCode &status) {
     U_ASSERT(gCache == NULL);
     ucln_common_registerCleanup(
             UCLN_COMMON_UNIFIED_CACHE, unifiedcache_cleanup);
 
-    gCacheMutex = STATIC_NEW(std::mutex);
-    gInProgressValueAddedCond = STATIC_NEW(std::condition_variable);
+    gCacheLocks = STATIC_NEW(CacheShardLocks);
     gCache = new UnifiedCache(status);
     if (gCache == NULL) {
         status = U_MEMORY_ALLOCATION_ERROR;
@@ -95,14 +124,20 @@ UnifiedCache *UnifiedCache::getInstance(UErrorCode &status) {
 }
 
 UnifiedCache::UnifiedCache(UErrorCode &status) :
-        fHashtable(NULL),
+        fEvictShard(0),
         fEvictPos(UHASH_FIRST),
+        fNumKeys(0),
         fNumValuesTotal(0),
         fNumValuesInUse(0),
         fMaxUnused(DEFAULT_MAX_UNUSED),
         fMaxPercentageOfInUse(DEFAULT_PERCENTAGE_OF_IN_USE),
         fAutoEvictedCount(0),
-        fNoValue(nullptr) {
+        fNoValue(nullptr),
+        fEvictionsByType(nullptr) {
+    for (int32_t i = 0; i < NUM_SHARDS; ++i) {
+        fHashtables[i] = nullptr;
+    }
+    uprv_memset(fShardStatistics, 0, sizeof(fShardStatistics));
     if (U_FAILURE(status)) {
         return;
     }
@@ -115,15 +150,24 @@ UnifiedCache::UnifiedCache(UErrorCode &status) :
     fNoValue->hardRefCount = 1;  // when other references to it are removed.
     fNoValue->cachePtr = this;
 
-    fHashtable = uhash_open(
-            &ucache_hashKeys,
-            &ucache_compareKeys,
-            NULL,
-            &status);
-    if (U_FAILURE(status)) {
-        return;
+    for (int32_t i = 0; i < NUM_SHARDS; ++i) {
+        fHashtables[i] = uhash_open(
+                &ucache_hashKeys,
+                &ucache_compareKeys,
+                NULL,
+                &status);
+        if (U_FAILURE(status)) {
+            return;
+        }
+        uhash_setKeyDeleter(fHashtables[i], &ucache_deleteKey);
     }
-    uhash_setKeyDeleter(fHashtable, &ucache_deleteKey);
+    fEvictionsByType = uhash_open(uhash_hashChars, uhash_compareChars, NULL, &status);
+}
+
+int32_t UnifiedCache::_shardIndex(const CacheKeyBase &key) {
+    // Fold in the high bits: many keys differ only in a few bits of their hash codes.
+    uint32_t hash = (uint32_t)key.hashCode();
+    return (int32_t)((hash ^ (hash >> 16)) % NUM_SHARDS);
 }
 
 void UnifiedCache::setEvictionPolicy(
@@ -135,28 +179,27 @@ void UnifiedCache::setEvictionPolicy(
         status = U_ILLEGAL_ARGUMENT_ERROR;
         return;
     }
-    std::lock_guard<std::mutex> lock(*gCacheMutex);
-    fMaxUnused = count;
-    fMaxPercentageOfInUse = percentageOfInUseItems;
+    umtx_storeRelease(fMaxUnused, count);
+    umtx_storeRelease(fMaxPercentageOfInUse, percentageOfInUseItems);
 }
 
 int32_t UnifiedCache::unusedCount() const {
-    std::lock_guard<std::mutex> lock(*gCacheMutex);
-    return uhash_count(fHashtable) - fNumValuesInUse;
+    AllShardsLock lock;
+    return umtx_loadAcquire(fNumKeys) - umtx_loadAcquire(fNumValuesInUse);
 }
 
 int64_t UnifiedCache::autoEvictedCount() const {
-    std::lock_guard<std::mutex> lock(*gCacheMutex);
+    AllShardsLock lock;
     return fAutoEvictedCount;
 }
 
 int32_t UnifiedCache::keyCount() const {
-    std::lock_guard<std::mutex> lock(*gCacheMutex);
-    return uhash_count(fHashtable);
+    AllShardsLock lock;
+    return umtx_loadAcquire(fNumKeys);
 }
 
 void UnifiedCache::flush() const {
-    std::lock_guard<std::mutex> lock(*gCacheMutex);
+    AllShardsLock lock;
 
     // Use a loop in case cache items that are flushed held hard references to
     // other cache items making those additional cache items eligible for
@@ -164,9 +207,84 @@ void UnifiedCache::flush() const {
     while (_flush(FALSE));
 }
 
+UnifiedCacheTypeStatistics *
+UnifiedCache::_getTypeStatistics(UnifiedCacheStatistics &stats, const char *typeName) {
+    for (int32_t i = 0; i < stats.typeCount; ++i) {
+        if (uprv_strcmp(stats.types[i].typeName, typeName) == 0) {
+            return &stats.types[i];
+        }
+    }
+    if (stats.typeCount == stats.types.getCapacity() &&
+            stats.types.resize(2 * stats.typeCount, stats.typeCount) == NULL) {
+        return NULL;
+    }
+    UnifiedCacheTypeStatistics *typeStats = &stats.types[stats.typeCount++];
+    typeStats->typeName = typeName;
+    typeStats->keyCount = 0;
+    typeStats->valueCount = 0;
+    typeStats->autoEvictedCount = 0;
+    typeStats->memoryEstimate = 0;
+    return typeStats;
+}
+
+void UnifiedCache::getStatistics(UnifiedCacheStatistics &stats, UErrorCode &status) const {
+    if (U_FAILURE(status)) {
+        return;
+    }
+    stats.hits = 0;
+    stats.misses = 0;
+    stats.inProgressWaits = 0;
+    stats.inProgressWaitMillis = 0;
+    stats.autoEvictedCount = 0;
+    stats.typeCount = 0;
+    AllShardsLock lock;
+    for (int32_t shard = 0; shard < NUM_SHARDS; ++shard) {
+        const ShardStatistics &shardStats = fShardStatistics[shard];
+        stats.hits += shardStats.hits;
+        stats.misses += shardStats.misses;
+        stats.inProgressWaits += shardStats.inProgressWaits;
+        stats.inProgressWaitMillis += shardStats.inProgressWaitMillis;
+        int32_t pos = UHASH_FIRST;
+        const UHashElement *element;
+        while ((element = uhash_nextElement(fHashtables[shard], &pos)) != NULL) {
+            const CacheKeyBase *key = (const CacheKeyBase *) element->key.pointer;
+            UnifiedCacheTypeStatistics *typeStats =
+                    _getTypeStatistics(stats, key->getValueTypeName());
+            if (typeStats == NULL) {
+                status = U_MEMORY_ALLOCATION_ERROR;
+                return;
+            }
+            ++typeStats->keyCount;
+            if (key->fIsMaster) {
+                ++typeStats->valueCount;
+                typeStats->memoryEstimate += key->getValueSize();
+            }
+        }
+    }
+    int32_t pos = UHASH_FIRST;
+    const UHashElement *element;
+    while ((element = uhash_nextElement(fEvictionsByType, &pos)) != NULL) {
+        UnifiedCacheTypeStatistics *typeStats =
+                _getTypeStatistics(stats, (const char *) element->key.pointer);
+        if (typeStats == NULL) {
+            status = U_MEMORY_ALLOCATION_ERROR;
+            return;
+        }
+        typeStats->autoEvictedCount += element->value.integer;
+        stats.autoEvictedCount += element->value.integer;
+    }
+    stats.keyCount = umtx_loadAcquire(fNumKeys);
+    stats.unusedCount = stats.keyCount - umtx_loadAcquire(fNumValuesInUse);
+}
+
+void UnifiedCache::resetStatistics() const {
+    AllShardsLock lock;
+    uprv_memset(fShardStatistics, 0, sizeof(fShardStatistics));
+    uhash_removeAll(fEvictionsByType);
+}
+
 void UnifiedCache::handleUnreferencedObject() const {
-    std::lock_guard<std::mutex> lock(*gCacheMutex);
-    --fNumValuesInUse;
+    umtx_atomic_dec(&fNumValuesInUse);
     _runEvictionSlice();
 }
 
@@ -184,36 +302,38 @@ void UnifiedCache::dump() {
 }
 
 void UnifiedCache::dumpContents() const {
-    std::lock_guard<std::mutex> lock(*gCacheMutex);
+    AllShardsLock lock;
     _dumpContents();
 }
 
 // Dumps content of cache.
-// On entry, gCacheMutex must be held.
+// On entry, the mutexes of all shards must be held.
 // On exit, cache contents dumped to stderr.
 void UnifiedCache::_dumpContents() const {
-    int32_t pos = UHASH_FIRST;
-    const UHashElement *element = uhash_nextElement(fHashtable, &pos);
     char buffer[256];
     int32_t cnt = 0;
-    for (; element != NULL; element = uhash_nextElement(fHashtable, &pos)) {
-        const SharedObject *sharedObject =
-                (const SharedObject *) element->value.pointer;
-        const CacheKeyBase *key =
-                (const CacheKeyBase *) element->key.pointer;
-        if (sharedObject->hasHardReferences()) {
-            ++cnt;
-            fprintf(
-                    stderr,
-                    "Unified Cache: Key '%s', error %d, value %p, total refcount %d, soft refcount %d\n",
-                    key->writeDescription(buffer, 256),
-                    key->creationStatus,
-                    sharedObject == fNoValue ? NULL :sharedObject,
-                    sharedObject->getRefCount(),
-                    sharedObject->getSoftRefCount());
+    for (int32_t shard = 0; shard < NUM_SHARDS; ++shard) {
+        int32_t pos = UHASH_FIRST;
+        const UHashElement *element;
+        while ((element = uhash_nextElement(fHashtables[shard], &pos)) != NULL) {
+            const SharedObject *sharedObject =
+                    (const SharedObject *) element->value.pointer;
+            const CacheKeyBase *key =
+                    (const CacheKeyBase *) element->key.pointer;
+            if (sharedObject->hasHardReferences()) {
+                ++cnt;
+                fprintf(
+                        stderr,
+                        "Unified Cache: Key '%s', error %d, value %p, total refcount %d, soft refcount %d\n",
+                        key->writeDescription(buffer, 256),
+                        key->creationStatus,
+                        sharedObject == fNoValue ? NULL :sharedObject,
+                        sharedObject->getRefCount(),
+                        (int32_t)sharedObject->softRefCount);
+            }
         }
     }
-    fprintf(stderr, "Unified Cache: %d out of a total of %d still have hard references\n", cnt, uhash_count(fHashtable));
+    fprintf(stderr, "Unified Cache: %d out of a total of %d still have hard references\n", cnt, (int32_t)fNumKeys);
 }
 #endif
 
@@ -224,28 +344,38 @@ UnifiedCache::~UnifiedCache() {
         // Now all that should be left in the cache are entries that refer to
         // each other and entries with hard references from outside the cache.
         // Nothing we can do about these so proceed to wipe out the cache.
-        std::lock_guard<std::mutex> lock(*gCacheMutex);
+        AllShardsLock lock;
         _flush(TRUE);
     }
-    uhash_close(fHashtable);
-    fHashtable = nullptr;
+    for (int32_t i = 0; i < NUM_SHARDS; ++i) {
+        uhash_close(fHashtables[i]);
+        fHashtables[i] = nullptr;
+    }
+    uhash_close(fEvictionsByType);
+    fEvictionsByType = nullptr;
     delete fNoValue;
     fNoValue = nullptr;
 }
 
 const UHashElement *
 UnifiedCache::_nextElement() const {
-    const UHashElement *element = uhash_nextElement(fHashtable, &fEvictPos);
-    if (element == NULL) {
+    // Continue in the current shard, then in the following ones,
+    // and finally from the start of the current shard again.
+    for (int32_t i = 0; i <= NUM_SHARDS; ++i) {
+        const UHashElement *element =
+                uhash_nextElement(fHashtables[fEvictShard], &fEvictPos);
+        if (element != NULL) {
+            return element;
+        }
+        fEvictShard = (fEvictShard + 1) % NUM_SHARDS;
         fEvictPos = UHASH_FIRST;
-        return uhash_nextElement(fHashtable, &fEvictPos);
     }
-    return element;
+    return NULL;
 }
 
 UBool UnifiedCache::_flush(UBool all) const {
     UBool result = FALSE;
-    int32_t origSize = uhash_count(fHashtable);
+    int32_t origSize = umtx_loadAcquire(fNumKeys);
     for (int32_t i = 0; i < origSize; ++i) {
         const UHashElement *element = _nextElement();
         if (element == nullptr) {
@@ -255,7 +385,8 @@ UBool UnifiedCache::_flush(UBool all) const {
             const SharedObject *sharedObject =
                     (const SharedObject *) element->value.pointer;
             U_ASSERT(sharedObject->cachePtr == this);
-            uhash_removeElement(fHashtable, element);
+            uhash_removeElement(fHashtables[fEvictShard], element);
+            umtx_atomic_dec(&fNumKeys);
             removeSoftRef(sharedObject);    // Deletes the sharedObject when softRefCount goes to zero.
             result = TRUE;
         }
@@ -264,16 +395,23 @@ UBool UnifiedCache::_flush(UBool all) const {
 }
 
 int32_t UnifiedCache::_computeCountOfItemsToEvict() const {
-    int32_t totalItems = uhash_count(fHashtable);
-    int32_t evictableItems = totalItems - fNumValuesInUse;
+    int32_t totalItems = umtx_loadAcquire(fNumKeys);
+    int32_t numValuesInUse = umtx_loadAcquire(fNumValuesInUse);
+    int32_t evictableItems = totalItems - numValuesInUse;
 
-    int32_t unusedLimitByPercentage = fNumValuesInUse * fMaxPercentageOfInUse / 100;
-    int32_t unusedLimit = std::max(unusedLimitByPercentage, fMaxUnused);
+    int32_t unusedLimitByPercentage =
+            numValuesInUse * umtx_loadAcquire(fMaxPercentageOfInUse) / 100;
+    int32_t unusedLimit = std::max(unusedLimitByPercentage, umtx_loadAcquire(fMaxUnused));
     int32_t countOfItemsToEvict = std::max(0, evictableItems - unusedLimit);
     return countOfItemsToEvict;
 }
 
 void UnifiedCache::_runEvictionSlice() const {
+    // Usually there is nothing to evict; check that before taking the locks.
+    if (_computeCountOfItemsToEvict() <= 0) {
+        return;
+    }
+    AllShardsLock lock;
     int32_t maxItemsToEvict = _computeCountOfItemsToEvict();
     if (maxItemsToEvict <= 0) {
         return;
@@ -286,7 +424,9 @@ void UnifiedCache::_runEvictionSlice() const {
         if (_isEvictable(element)) {
             const SharedObject *sharedObject =
                     (const SharedObject *) element->value.pointer;
-            uhash_removeElement(fHashtable, element);
+            _countEviction(element);
+            uhash_removeElement(fHashtables[fEvictShard], element);
+            umtx_atomic_dec(&fNumKeys);
             removeSoftRef(sharedObject);   // Deletes sharedObject when SoftRefCount goes to zero.
             ++fAutoEvictedCount;
             if (--maxItemsToEvict == 0) {
@@ -297,6 +437,7 @@ void UnifiedCache::_runEvictionSlice() const {
 }
 
 void UnifiedCache::_putNew(
+        int32_t shard,
         const CacheKeyBase &key,
         const SharedObject *value,
         const UErrorCode creationStatus,
@@ -310,14 +451,15 @@ void UnifiedCache::_putNew(
         return;
     }
     keyToAdopt->fCreationStatus = creationStatus;
-    if (value->softRefCount == 0) {
+    if (umtx_loadAcquire(value->softRefCount) == 0) {
         _registerMaster(keyToAdopt, value);
     }
-    void *oldValue = uhash_put(fHashtable, keyToAdopt, (void *) value, &status);
+    void *oldValue = uhash_put(fHashtables[shard], keyToAdopt, (void *) value, &status);
     U_ASSERT(oldValue == nullptr);
     (void)oldValue;
     if (U_SUCCESS(status)) {
-        value->softRefCount++;
+        umtx_atomic_inc(&fNumKeys);
+        umtx_atomic_inc(&value->softRefCount);
     }
 }
 
@@ -325,18 +467,21 @@ void UnifiedCache::_putIfAbsentAndGet(
         const CacheKeyBase &key,
         const SharedObject *&value,
         UErrorCode &status) const {
-    std::lock_guard<std::mutex> lock(*gCacheMutex);
-    const UHashElement *element = uhash_find(fHashtable, &key);
-    if (element != NULL && !_inProgress(element)) {
-        _fetch(element, value, status);
-        return;
-    }
-    if (element == NULL) {
-        UErrorCode putError = U_ZERO_ERROR;
-        // best-effort basis only.
-        _putNew(key, value, status, putError);
-    } else {
-        _put(element, value, status);
+    int32_t shard = _shardIndex(key);
+    {
+        std::lock_guard<std::mutex> lock(gCacheLocks->mutexes[shard]);
+        const UHashElement *element = uhash_find(fHashtables[shard], &key);
+        if (element != NULL && !_inProgress(element)) {
+            _fetch(element, value, status);
+            return;
+        }
+        if (element == NULL) {
+            UErrorCode putError = U_ZERO_ERROR;
+            // best-effort basis only.
+            _putNew(shard, key, value, status, putError);
+        } else {
+            _put(shard, element, value, status);
+        }
     }
     // Run an eviction slice. This will run even if we added a master entry
     // which doesn't increase the unused count, but that is still o.k
@@ -350,28 +495,37 @@ UBool UnifiedCache::_poll(
         UErrorCode &status) const {
     U_ASSERT(value == NULL);
     U_ASSERT(status == U_ZERO_ERROR);
-    std::unique_lock<std::mutex> lock(*gCacheMutex);
-    const UHashElement *element = uhash_find(fHashtable, &key);
+    int32_t shard = _shardIndex(key);
+    std::unique_lock<std::mutex> lock(gCacheLocks->mutexes[shard]);
+    ShardStatistics &shardStats = fShardStatistics[shard];
+    const UHashElement *element = uhash_find(fHashtables[shard], &key);
 
     // If the hash table contains an inProgress placeholder entry for this key,
     // this means that another thread is currently constructing the value object.
     // Loop, waiting for that construction to complete.
-     while (element != NULL && _inProgress(element)) {
-         gInProgressValueAddedCond->wait(lock);
-         element = uhash_find(fHashtable, &key);
+    if (element != NULL && _inProgress(element)) {
+        UDate waitStart = uprv_getUTCtime();
+        do {
+            gCacheLocks->inProgressValueAddedConds[shard].wait(lock);
+            element = uhash_find(fHashtables[shard], &key);
+        } while (element != NULL && _inProgress(element));
+        ++shardStats.inProgressWaits;
+        shardStats.inProgressWaitMillis += uprv_getUTCtime() - waitStart;
     }
 
     // If the hash table contains an entry for the key,
     // fetch out the contents and return them.
     if (element != NULL) {
-         _fetch(element, value, status);
+        ++shardStats.hits;
+        _fetch(element, value, status);
         return TRUE;
     }
 
     // The hash table contained nothing for this key.
     // Insert an inProgress place holder value.
     // Our caller will create the final value and update the hash table.
-    _putNew(key, fNoValue, U_ZERO_ERROR, status);
+    ++shardStats.misses;
+    _putNew(shard, key, fNoValue, U_ZERO_ERROR, status);
     return FALSE;
 }
 
@@ -407,11 +561,12 @@ void UnifiedCache::_registerMaster(
             const CacheKeyBase *theKey, const SharedObject *value) const {
     theKey->fIsMaster = true;
     value->cachePtr = this;
-    ++fNumValuesTotal;
-    ++fNumValuesInUse;
+    umtx_atomic_inc(&fNumValuesTotal);
+    umtx_atomic_inc(&fNumValuesInUse);
 }
 
 void UnifiedCache::_put(
+        int32_t shard,
         const UHashElement *element,
         const SharedObject *value,
         const UErrorCode status) const {
@@ -419,10 +574,10 @@ void UnifiedCache::_put(
     const CacheKeyBase *theKey = (const CacheKeyBase *) element->key.pointer;
     const SharedObject *oldValue = (const SharedObject *) element->value.pointer;
     theKey->fCreationStatus = status;
-    if (value->softRefCount == 0) {
+    if (umtx_loadAcquire(value->softRefCount) == 0) {
         _registerMaster(theKey, value);
     }
-    value->softRefCount++;
+    umtx_atomic_inc(&value->softRefCount);
     UHashElement *ptr = const_cast<UHashElement *>(element);
     ptr->value.pointer = (void *) value;
     U_ASSERT(oldValue == fNoValue);
@@ -430,7 +585,7 @@ void UnifiedCache::_put(
 
     // Tell waiting threads that we replace in-progress status with
     // an error.
-    gInProgressValueAddedCond->notify_all();
+    gCacheLocks->inProgressValueAddedConds[shard].notify_all();
 }
 
 void UnifiedCache::_fetch(
@@ -440,7 +595,7 @@ void UnifiedCache::_fetch(
     const CacheKeyBase *theKey = (const CacheKeyBase *) element->key.pointer;
     status = theKey->fCreationStatus;
 
-    // Since we have the cache lock, calling regular SharedObject add/removeRef
+    // Since we have the shard lock, calling regular SharedObject add/removeRef
     // could cause us to deadlock on ourselves since they may need to lock
     // the cache mutex.
     removeHardRef(value);
@@ -476,14 +631,23 @@ UBool UnifiedCache::_isEvictable(const UHashElement *element) const
 
     // We can evict entries that are either not a master or have just
     // one reference (The one reference being from the cache itself).
-    return (!theKey->fIsMaster || (theValue->softRefCount == 1 && theValue->noHardReferences()));
+    return (!theKey->fIsMaster ||
+            (umtx_loadAcquire(theValue->softRefCount) == 1 && theValue->noHardReferences()));
+}
+
+void UnifiedCache::_countEviction(const UHashElement *element) const {
+    const CacheKeyBase *theKey = (const CacheKeyBase *) element->key.pointer;
+    void *typeName = const_cast<char *>(theKey->getValueTypeName());
+    // Best effort: a failure to count does not affect the eviction.
+    UErrorCode status = U_ZERO_ERROR;
+    uhash_puti(fEvictionsByType, typeName, uhash_geti(fEvictionsByType, typeName) + 1, &status);
 }
 
 void UnifiedCache::removeSoftRef(const SharedObject *value) const {
     U_ASSERT(value->cachePtr == this);
-    U_ASSERT(value->softRefCount > 0);
-    if (--value->softRefCount == 0) {
-        --fNumValuesTotal;
+    U_ASSERT(umtx_loadAcquire(value->softRefCount) > 0);
+    if (umtx_atomic_dec(&value->softRefCount) == 0) {
+        umtx_atomic_dec(&fNumValuesTotal);
         if (value->noHardReferences()) {
             delete value;
         } else {
@@ -501,7 +665,7 @@ int32_t UnifiedCache::removeHardRef(const SharedObject *value) const {
         refCount = umtx_atomic_dec(&value->hardRefCount);
         U_ASSERT(refCount >= 0);
         if (refCount == 0) {
-            --fNumValuesInUse;
+            umtx_atomic_dec(&fNumValuesInUse);
         }
     }
     return refCount;
@@ -513,7 +677,7 @@ int32_t UnifiedCache::addHardRef(const SharedObject *value) const {
         refCount = umtx_atomic_inc(&value->hardRefCount);
         U_ASSERT(refCount >= 1);
         if (refCount == 1) {
-            fNumValuesInUse++;
+            umtx_atomic_inc(&fNumValuesInUse);
         }
     }
     return refCount;
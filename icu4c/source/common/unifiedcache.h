@@ -19,6 +19,7 @@
 #include "unicode/locid.h"
 #include "sharedobject.h"
 #include "unicode/unistr.h"
+#include "cmemory.h"
 #include "cstring.h"
 #include "ustr_imp.h"
 
@@ -80,6 +81,17 @@ class U_COMMON_API CacheKeyBase : public UObject {
     */
    virtual char *writeDescription(char *buffer, int32_t bufSize) const = 0;
 
+   /**
+    * Returns the name of the type of the values for this key, for statistics.
+    * The string is static.
+    */
+   virtual const char *getValueTypeName() const = 0;
+
+   /**
+    * Returns the size of the type of the values for this key, for statistics.
+    */
+   virtual int32_t getValueSize() const = 0;
+
    /**
     * Inequality operator.
     */
@@ -126,6 +138,16 @@ class CacheKey : public CacheKeyBase {
    virtual UBool operator == (const CacheKeyBase &other) const {
        return typeid(*this) == typeid(other);
    }
+
+   /**
+    * Returns a name for T that does not depend on the compiler.
+    * Defined for each T along with LocaleCacheKey<T>::createObject().
+    */
+   virtual const char *getValueTypeName() const;
+
+   virtual int32_t getValueSize() const {
+       return static_cast<int32_t>(sizeof(T));
+   }
 };
 
 /**
@@ -175,10 +197,61 @@ class LocaleCacheKey : public CacheKey<T> {
 
 };
 
+/**
+ * Statistics for the cache entries with one type of values.
+ * See UnifiedCache::getStatistics().
+ */
+struct UnifiedCacheTypeStatistics {
+    /** The value type name from CacheKey<T>::getValueTypeName(). Static, not owned. */
+    const char *typeName;
+    /** The number of keys with this value type in the cache. */
+    int32_t keyCount;
+    /** The number of distinct values of this type in the cache. */
+    int32_t valueCount;
+    /** The number of auto evicted keys with this value type since the last reset. */
+    int64_t autoEvictedCount;
+    /**
+     * Shallow estimate of the memory used by the values: valueCount * sizeof(T).
+     * Memory owned by the values, for example their strings and tables, is not included.
+     */
+    int64_t memoryEstimate;
+};
+
+/**
+ * A snapshot of UnifiedCache statistics.
+ * The activity counters cover the time since the cache was created or
+ * since the last UnifiedCache::resetStatistics().
+ */
+struct UnifiedCacheStatistics : public UMemory {
+    /** Lookups that found a value or a cached creation error. */
+    int64_t hits;
+    /** Lookups that found nothing, so that the caller created the value. */
+    int64_t misses;
+    /** Lookups that waited for another thread to finish creating the value. */
+    int64_t inProgressWaits;
+    /** Total time spent in those waits, in milliseconds. */
+    double inProgressWaitMillis;
+    /** Auto evicted keys, the sum over all types. */
+    int64_t autoEvictedCount;
+    /** The current number of keys, as in UnifiedCache::keyCount(). */
+    int32_t keyCount;
+    /** The current number of unused keys, as in UnifiedCache::unusedCount(). */
+    int32_t unusedCount;
+    /** The number of elements in types. */
+    int32_t typeCount;
+    /** Statistics by value type, in no particular order. */
+    MaybeStackArray<UnifiedCacheTypeStatistics, 16> types;
+};
+
 /**
  * The unified cache. A singleton type.
  * Design doc here:
  * https://docs.google.com/document/d/1RwGQJs4N4tawNbf809iYDRCvXoMKqDJihxzYt1ysmd8/edit?usp=sharing
+ *
+ * The cache is split into NUM_SHARDS shards. A lookup locks only the shard
+ * of its key, so that hits on existing entries from different threads do not
+ * serialize on one global mutex. Operations that look at all entries,
+ * eviction and flushing, lock all shards in index order.
  */
 class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
  public:
@@ -341,27 +414,69 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
     */
    int32_t unusedCount() const;
 
+   /**
+    * Fills in a snapshot of the cache statistics. Looks at all cache entries,
+    * so this is meant for monitoring and tuning, not for frequent calls.
+    * Sets status to U_MEMORY_ALLOCATION_ERROR if stats.types cannot grow.
+    */
+   void getStatistics(UnifiedCacheStatistics &stats, UErrorCode &status) const;
+
+   /**
+    * Resets the activity counters: hits, misses, in-progress waits and
+    * the auto eviction counts by type. autoEvictedCount() is not affected.
+    */
+   void resetStatistics() const;
+
    virtual void handleUnreferencedObject() const;
    virtual ~UnifiedCache();
+
+   /**
+    * The number of shards. Keys are distributed over the shards by hash code;
+    * each shard has its own hash table, mutex and condition variable, so that
+    * lookups of different keys rarely contend for the same lock.
+    */
+   static const int32_t NUM_SHARDS = 16;
    
  private:
-   UHashtable *fHashtable;
+   UHashtable *fHashtables[NUM_SHARDS];
+   mutable int32_t fEvictShard;
    mutable int32_t fEvictPos;
-   mutable int32_t fNumValuesTotal;
-   mutable int32_t fNumValuesInUse;
-   int32_t fMaxUnused;
-   int32_t fMaxPercentageOfInUse;
+   mutable u_atomic_int32_t fNumKeys;
+   mutable u_atomic_int32_t fNumValuesTotal;
+   mutable u_atomic_int32_t fNumValuesInUse;
+   mutable u_atomic_int32_t fMaxUnused;
+   mutable u_atomic_int32_t fMaxPercentageOfInUse;
    mutable int64_t fAutoEvictedCount;
    SharedObject *fNoValue;
+
+   /** Lookup counters of one shard. */
+   struct ShardStatistics {
+       int64_t hits;
+       int64_t misses;
+       int64_t inProgressWaits;
+       double inProgressWaitMillis;
+   };
+   /** Guarded by the mutexes of the respective shards. */
+   mutable ShardStatistics fShardStatistics[NUM_SHARDS];
+   /**
+    * Auto eviction counts keyed by value type name.
+    * Guarded by the mutexes of all shards.
+    */
+   UHashtable *fEvictionsByType;
    
    UnifiedCache(const UnifiedCache &other);
    UnifiedCache &operator=(const UnifiedCache &other);
+
+   /**
+    * Returns the index of the shard that holds the given key.
+    */
+   static int32_t _shardIndex(const CacheKeyBase &key);
    
    /**
     * Flushes the contents of the cache. If cache values hold references to other
     * cache values then _flush should be called in a loop until it returns FALSE.
     * 
-    * On entry, gCacheMutex must be held.
+    * On entry, the mutexes of all shards must be held.
     * On exit, those values with are evictable are flushed.
     * 
     *  @param all if false flush evictable items only, which are those with no external
@@ -376,7 +491,7 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
    
    /**
     * Gets value out of cache.
-    * On entry. gCacheMutex must not be held. value must be NULL. status
+    * On entry. no shard mutex may be held. value must be NULL. status
     * must be U_ZERO_ERROR.
     * On exit. value and status set to what is in cache at key or on cache
     * miss the key's createObject() is called and value and status are set to
@@ -393,7 +508,7 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
 
     /**
      * Attempts to fetch value and status for key from cache.
-     * On entry, gCacheMutex must not be held value must be NULL and status must
+     * On entry, no shard mutex may be held value must be NULL and status must
      * be U_ZERO_ERROR.
      * On exit, either returns FALSE (In this
      * case caller should try to create the object) or returns TRUE with value
@@ -409,11 +524,13 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
     
     /**
      * Places a new value and creationStatus in the cache for the given key.
-     * On entry, gCacheMutex must be held. key must not exist in the cache. 
+     * On entry, the mutex of the key's shard must be held. key must not exist
+     * in the cache. 
      * On exit, value and creation status placed under key. Soft reference added
      * to value on successful add. On error sets status.
      */
     void _putNew(
+        int32_t shard,
         const CacheKeyBase &key,
         const SharedObject *value,
         const UErrorCode creationStatus,
@@ -424,7 +541,7 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
      * entry for key is in progress. Otherwise, it leaves the current value and
      * status there.
      * 
-     * On entry. gCacheMutex must not be held. Value must be
+     * On entry. no shard mutex may be held. Value must be
      * included in the reference count of the object to which it points.
      * 
      * On exit, value and status are changed to what was already in the cache if
@@ -438,9 +555,10 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
            UErrorCode &status) const;
 
     /**
-     * Returns the next element in the cache round robin style.
+     * Returns the next element in the cache round robin style,
+     * visiting the shards in turn. The element is in fHashtables[fEvictShard].
      * Returns nullptr if the cache is empty.
-     * On entry, gCacheMutex must be held.
+     * On entry, the mutexes of all shards must be held.
      */
     const UHashElement *_nextElement() const;
    
@@ -450,14 +568,16 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
     * 
     * An item corresponds to an entry in the hash table, a hash table element.
     * 
-    * On entry, gCacheMutex must be held.
+    * Reads only atomic counters, so no lock is needed; without the locks
+    * the result is a snapshot that concurrent threads may change.
     */
    int32_t _computeCountOfItemsToEvict() const;
    
    /**
     * Run an eviction slice.
-    * On entry, gCacheMutex must be held.
-    * _runEvictionSlice runs a slice of the evict pipeline by examining the next
+    * On entry, no shard mutex may be held.
+    * If there are items to evict, _runEvictionSlice locks all shards and
+    * runs a slice of the evict pipeline by examining the next
     * 10 entries in the cache round robin style evicting them if they are eligible.
     */
    void _runEvictionSlice() const;
@@ -468,7 +588,7 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
     * produce referneces to an already existing SharedObject are not masters -
     * they can be evicted and subsequently recreated.
     * 
-    * On entry, gCacheMutex must be held.
+    * On entry, the mutex of the key's shard must be held.
     * On exit, items in use count incremented, entry is marked as a master
     * entry, and value registered with cache so that subsequent calls to
     * addRef() and removeRef() on it correctly interact with the cache.
@@ -477,27 +597,29 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
         
    /**
     * Store a value and creation error status in given hash entry.
-    * On entry, gCacheMutex must be held. Hash entry element must be in progress.
-    * value must be non NULL.
+    * On entry, the mutex of the element's shard must be held.
+    * Hash entry element must be in progress. value must be non NULL.
     * On Exit, soft reference added to value. value and status stored in hash
     * entry. Soft reference removed from previous stored value. Waiting
-    * threads notified.
+    * threads of the shard notified.
     */
    void _put(
+           int32_t shard,
            const UHashElement *element,
            const SharedObject *value,
            const UErrorCode status) const;
     /**
      * Remove a soft reference, and delete the SharedObject if no references remain.
      * To be used from within the UnifiedCache implementation only.
-     * gCacheMutex must be held by caller.
+     * The mutex of a shard holding value must be held by caller,
+     * and the mutexes of all shards if this may remove the last soft reference.
      * @param value the SharedObject to be acted on.
      */
    void removeSoftRef(const SharedObject *value) const;
    
    /**
     * Increment the hard reference count of the given SharedObject.
-    * gCacheMutex must be held by the caller.
+    * The mutex of a shard holding value must be held by the caller.
     * Update numValuesEvictable on transitions between zero and one reference.
     * 
     * @param value The SharedObject to be referenced.
@@ -507,7 +629,7 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
    
   /**
     * Decrement the hard reference count of the given SharedObject.
-    * gCacheMutex must be held by the caller.
+    * The mutex of a shard holding value must be held by the caller.
     * Update numValuesEvictable on transitions between one and zero reference.
     * 
     * @param value The SharedObject to be referenced.
@@ -522,7 +644,8 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
    
    /**
     *  Fetch value and error code from a particular hash entry.
-    *  On entry, gCacheMutex must be held. value must be either NULL or must be
+    *  On entry, the mutex of the element's shard must be held.
+    *  value must be either NULL or must be
     *  included in the ref count of the object to which it points.
     *  On exit, value and status set to what is in the hash entry. Caller must
     *  eventually call removeRef on value.
@@ -534,21 +657,34 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
                        
     /**
      * Determine if given hash entry is in progress.
-     * On entry, gCacheMutex must be held.
+     * On entry, the mutex of the element's shard must be held.
      */
    UBool _inProgress(const UHashElement *element) const;
    
    /**
     * Determine if given hash entry is in progress.
-    * On entry, gCacheMutex must be held.
+    * On entry, the mutex of the element's shard must be held.
     */
    UBool _inProgress(const SharedObject *theValue, UErrorCode creationStatus) const;
    
    /**
     * Determine if given hash entry is eligible for eviction.
-    * On entry, gCacheMutex must be held.
+    * On entry, the mutexes of all shards must be held.
     */
    UBool _isEvictable(const UHashElement *element) const;
+
+   /**
+    * Counts the auto eviction of an entry.
+    * On entry, the mutexes of all shards must be held.
+    */
+   void _countEviction(const UHashElement *element) const;
+
+   /**
+    * Returns the statistics for the type name, adding it to stats.types if necessary.
+    * Returns NULL if stats.types cannot grow.
+    */
+   static UnifiedCacheTypeStatistics *_getTypeStatistics(
+           UnifiedCacheStatistics &stats, const char *typeName);
 };
 
 U_NAMESPACE_END
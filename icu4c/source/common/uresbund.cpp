@@ -41,18 +41,202 @@
 #include "uassert.h"
 #include "uresdata.h"
 
+#include <atomic>
+
 using namespace icu;
 
 /*
 Static cache for already opened resource bundles - mostly for keeping fallback info
 TODO: This cache should probably be removed when the deprecated code is
       completely removed.
+
+The hash table and the fallback chains (fParent) are modified only with resbMutex locked.
+Opening a bundle first loads the data of its fallback chain with preloadEntries(),
+which releases the mutex while loading, so that different bundles can be loaded
+in parallel. Those entries go into the cache without their fallback chains.
+The chain is then linked without releasing the mutex in between,
+so that no other thread sees a partially linked chain.
+Once an entry is handed out, its fallback chain does not change any more, and
+the reference counts are atomic, so that adding and removing references
+to open bundles does not need the mutex.
 */
 static UHashtable *cache = NULL;
 static icu::UInitOnce gCacheInitOnce = U_INITONCE_INITIALIZER;
 
 static UMutex resbMutex;
 
+/*
+ * UResourceDataEntry is also visible to C code, so fCountExisting is declared
+ * as a plain int32_t. Its memory is always accessed as an atomic integer.
+ */
+static_assert(sizeof(u_atomic_int32_t) == sizeof(int32_t),
+              "Atomic integer size on this platform differs from UResourceDataEntry.fCountExisting");
+
+static inline u_atomic_int32_t *countExisting(UResourceDataEntry *entry) {
+    return reinterpret_cast<u_atomic_int32_t *>(&entry->fCountExisting);
+}
+
+/*
+Fallback index:
+ures_getByKeyWithFallback() walks up the fallback chain and looks up
+each segment of the resource path in each parent bundle.
+The result of that walk depends only on the bundle where it starts
+and on the full resource path, so each entry lazily remembers it in
+its fFallbackIndex, keyed by the full path: the parent entry which has
+the resource, and the Resource item.
+A repeated lookup of the same path, for example "NumberElements/latn/patterns",
+is then a single hash table probe.
+Paths that are not found are not remembered, so that a missing resource
+is looked up again in the whole chain each time.
+
+Walks that go through an alias into another bundle are not indexed,
+so that an index only points to entries in its own fallback chain
+which live at least as long as the entry itself.
+
+An index is a fixed-size open-addressing hash table of immutable items.
+Items are only ever added, with one of a few mutexes held, and published
+with release stores, so that lookups do not lock anything.
+Once an index is three quarters full, no more items are added to it.
+*/
+static UBool gFallbackIndexEnabled = TRUE;
+
+static UMutex gFallbackIndexMutexes[8];
+
+namespace {
+
+const int32_t FALLBACK_INDEX_CAPACITY = 256;
+const int32_t FALLBACK_INDEX_MAX_COUNT = FALLBACK_INDEX_CAPACITY * 3 / 4;
+
+struct FallbackIndexItem {
+    int32_t hash;
+    UResourceDataEntry *dataEntry;
+    Resource res;
+    char path[1];  /* NUL-terminated full path, allocated with the item */
+};
+
+}  // namespace
+
+struct UResourceFallbackIndex : public UMemory {
+    UResourceFallbackIndex() : count(0) {
+        for(int32_t i = 0; i < FALLBACK_INDEX_CAPACITY; ++i) {
+            items[i].store(NULL, std::memory_order_relaxed);
+        }
+    }
+    ~UResourceFallbackIndex() {
+        for(int32_t i = 0; i < FALLBACK_INDEX_CAPACITY; ++i) {
+            uprv_free(const_cast<FallbackIndexItem *>(items[i].load(std::memory_order_relaxed)));
+        }
+    }
+
+    std::atomic<const FallbackIndexItem *> items[FALLBACK_INDEX_CAPACITY];
+    int32_t count;  /* modified only with the mutex held */
+};
+
+/* Like fCountExisting, fFallbackIndex is always accessed atomically. */
+static_assert(sizeof(std::atomic<UResourceFallbackIndex *>) == sizeof(UResourceFallbackIndex *),
+              "Atomic pointer size on this platform differs from UResourceDataEntry.fFallbackIndex");
+
+static inline std::atomic<UResourceFallbackIndex *> *fallbackIndex(UResourceDataEntry *entry) {
+    return reinterpret_cast<std::atomic<UResourceFallbackIndex *> *>(&entry->fFallbackIndex);
+}
+
+namespace {
+
+inline UMutex *fallbackIndexMutex(const UResourceDataEntry *entry) {
+    return &gFallbackIndexMutexes[
+        ((uintptr_t)entry / sizeof(UResourceDataEntry)) % UPRV_LENGTHOF(gFallbackIndexMutexes)];
+}
+
+/* Hashes the full path resPath[0..len[ + inKey without concatenating it. */
+int32_t hashFallbackIndexPath(const char *resPath, int32_t len, const char *inKey) {
+    uint32_t hash = 0;
+    for(int32_t i = 0; i < len; ++i) {
+        hash = 37u * hash + (uint8_t)resPath[i];
+    }
+    for(; *inKey != 0; ++inKey) {
+        hash = 37u * hash + (uint8_t)*inKey;
+    }
+    return (int32_t)hash;
+}
+
+inline int32_t fallbackIndexSlot(int32_t hash) {
+    return (int32_t)(((uint32_t)hash ^ ((uint32_t)hash >> 11)) % FALLBACK_INDEX_CAPACITY);
+}
+
+inline UBool matchesFallbackIndexItem(const FallbackIndexItem *item, int32_t hash,
+                                      const char *resPath, int32_t len, const char *inKey) {
+    return item->hash == hash &&
+        uprv_strncmp(item->path, resPath, len) == 0 &&
+        uprv_strcmp(item->path + len, inKey) == 0;
+}
+
+UBool findInFallbackIndex(UResourceDataEntry *entry, int32_t hash,
+                          const char *resPath, int32_t len, const char *inKey,
+                          UResourceDataEntry *&dataEntry, Resource &res) {
+    const UResourceFallbackIndex *index = fallbackIndex(entry)->load(std::memory_order_acquire);
+    if(index == NULL) {
+        return FALSE;
+    }
+    /* The index is never full, so an empty slot ends each probe sequence. */
+    for(int32_t i = fallbackIndexSlot(hash);; i = (i + 1) % FALLBACK_INDEX_CAPACITY) {
+        const FallbackIndexItem *item = index->items[i].load(std::memory_order_acquire);
+        if(item == NULL) {
+            return FALSE;
+        }
+        if(matchesFallbackIndexItem(item, hash, resPath, len, inKey)) {
+            dataEntry = item->dataEntry;
+            res = item->res;
+            return TRUE;
+        }
+    }
+}
+
+/* Out-of-memory is ignored: The index is only an optimization. */
+void addToFallbackIndex(UResourceDataEntry *entry, int32_t hash,
+                        const char *resPath, int32_t len, const char *inKey,
+                        UResourceDataEntry *dataEntry, Resource res) {
+    Mutex lock(fallbackIndexMutex(entry));
+    UResourceFallbackIndex *index = fallbackIndex(entry)->load(std::memory_order_relaxed);
+    if(index == NULL) {
+        index = new UResourceFallbackIndex();
+        if(index == NULL) {
+            return;
+        }
+        fallbackIndex(entry)->store(index, std::memory_order_release);
+    }
+    if(index->count >= FALLBACK_INDEX_MAX_COUNT) {
+        return;
+    }
+    int32_t i = fallbackIndexSlot(hash);
+    const FallbackIndexItem *item;
+    while((item = index->items[i].load(std::memory_order_relaxed)) != NULL) {
+        if(matchesFallbackIndexItem(item, hash, resPath, len, inKey)) {
+            return;  /* another thread added it */
+        }
+        i = (i + 1) % FALLBACK_INDEX_CAPACITY;
+    }
+    int32_t pathLength = len + (int32_t)uprv_strlen(inKey);
+    FallbackIndexItem *newItem =
+        (FallbackIndexItem *)uprv_malloc(sizeof(FallbackIndexItem) + pathLength);
+    if(newItem == NULL) {
+        return;
+    }
+    newItem->hash = hash;
+    newItem->dataEntry = dataEntry;
+    newItem->res = res;
+    uprv_memcpy(newItem->path, resPath, len);
+    uprv_strcpy(newItem->path + len, inKey);
+    index->items[i].store(newItem, std::memory_order_release);
+    ++index->count;
+}
+
+}  // namespace
+
+U_CAPI void U_EXPORT2
+ures_setFallbackIndexEnabled(UBool enabled) {
+    gFallbackIndexEnabled = enabled;
+}
+
 /* INTERNAL: hashes an entry  */
 static int32_t U_CALLCONV hashEntry(const UHashTok parm) {
     UResourceDataEntry *b = (UResourceDataEntry *)parm.pointer;
@@ -95,11 +279,10 @@ static UBool chopLocale(char *name) {
  *  Internal function
  */
 static void entryIncrease(UResourceDataEntry *entry) {
-    Mutex lock(&resbMutex);
-    entry->fCountExisting++;
+    umtx_atomic_inc(countExisting(entry));
     while(entry->fParent != NULL) {
       entry = entry->fParent;
-      entry->fCountExisting++;
+      umtx_atomic_inc(countExisting(entry));
     }
 }
 
@@ -151,6 +334,7 @@ static void
 free_entry(UResourceDataEntry *entry) {
     UResourceDataEntry *alias;
     res_unload(&(entry->fData));
+    delete fallbackIndex(entry)->load(std::memory_order_relaxed);
     if(entry->fName != NULL && entry->fName != entry->fNameBuffer) {
         uprv_free(entry->fName);
     }
@@ -158,14 +342,14 @@ free_entry(UResourceDataEntry *entry) {
         uprv_free(entry->fPath);
     }
     if(entry->fPool != NULL) {
-        --entry->fPool->fCountExisting;
+        umtx_atomic_dec(countExisting(entry->fPool));
     }
     alias = entry->fAlias;
     if(alias != NULL) {
         while(alias->fAlias != NULL) {
             alias = alias->fAlias;
         }
-        --alias->fCountExisting;
+        umtx_atomic_dec(countExisting(alias));
     }
     uprv_free(entry);
 }
@@ -203,7 +387,7 @@ static int32_t ures_flushCache()
             /* 04/05/2002 [weiv] fCountExisting should now be accurate. If it's not zero, that means that    */
             /* some resource bundles are still open somewhere. */
 
-            if (resB->fCountExisting == 0) {
+            if (umtx_loadAcquire(*countExisting(resB)) == 0) {
                 rbDeletedNum++;
                 deletedMore = TRUE;
                 uhash_removeElement(cache, e);
@@ -239,7 +423,7 @@ U_CAPI UBool U_EXPORT2 ures_dumpCacheContents(void) {
       resB = (UResourceDataEntry *) e->value.pointer;
       fprintf(stderr,"%s:%d: RB Cache: Entry @0x%p, refcount %d, name %s:%s.  Pool 0x%p, alias 0x%p, parent 0x%p\n",
               __FILE__, __LINE__,
-              (void*)resB, resB->fCountExisting,
+              (void*)resB, (int)umtx_loadAcquire(*countExisting(resB)),
               resB->fName?resB->fName:"NULL",
               resB->fPath?resB->fPath:"NULL",
               (void*)resB->fPool,
@@ -296,13 +480,17 @@ static void setEntryName(UResourceDataEntry *res, const char *name, UErrorCode *
 }
 
 static UResourceDataEntry *
-getPoolEntry(const char *path, UErrorCode *status);
+getPoolEntry(const char *path, UBool unlockToLoad, UErrorCode *status);
 
 /**
  *  INTERNAL: Inits and opens an entry from a data DLL.
  *    CAUTION:  resbMutex must be locked when calling this function.
+ *    If unlockToLoad is TRUE, then it is unlocked temporarily while loading
+ *    the data of a new entry. Only preloadEntries() does that:
+ *    Other threads may link fallback chains while the mutex is unlocked.
  */
-static UResourceDataEntry *init_entry(const char *localeID, const char *path, UErrorCode *status) {
+static UResourceDataEntry *init_entry(const char *localeID, const char *path, UBool unlockToLoad,
+                                      UErrorCode *status) {
     UResourceDataEntry *r = NULL;
     UResourceDataEntry find;
     /*int32_t hashValue;*/
@@ -361,7 +549,14 @@ static UResourceDataEntry *init_entry(const char *localeID, const char *path, UE
         }
 
         /* this is the actual loading */
+        /* The new entry is private to this thread until it is put into the cache. */
+        if (unlockToLoad) {
+            umtx_unlock(&resbMutex);
+        }
         res_load(&(r->fData), r->fPath, r->fName, status);
+        if (unlockToLoad) {
+            umtx_lock(&resbMutex);
+        }
 
         if (U_FAILURE(*status)) {
             /* if we failed to load due to an out-of-memory error, exit early. */
@@ -375,7 +570,7 @@ static UResourceDataEntry *init_entry(const char *localeID, const char *path, UE
         } else { /* if we have a regular entry */
             Resource aliasres;
             if (r->fData.usesPoolBundle) {
-                r->fPool = getPoolEntry(r->fPath, status);
+                r->fPool = getPoolEntry(r->fPath, unlockToLoad, status);
                 if (U_SUCCESS(*status)) {
                     const int32_t *poolIndexes = r->fPool->fData.pRoot + 1;
                     if(r->fData.pRoot[1 + URES_INDEX_POOL_CHECKSUM] == poolIndexes[URES_INDEX_POOL_CHECKSUM]) {
@@ -397,7 +592,7 @@ static UResourceDataEntry *init_entry(const char *localeID, const char *path, UE
                     const UChar *alias = res_getStringNoTrace(&(r->fData), aliasres, &aliasLen);
                     if(alias != NULL && aliasLen > 0) { /* if there is actual alias - unload and load new data */
                         u_UCharsToChars(alias, aliasName, aliasLen+1);
-                        r->fAlias = init_entry(aliasName, path, status);
+                        r->fAlias = init_entry(aliasName, path, unlockToLoad, status);
                     }
                 }
             }
@@ -428,7 +623,7 @@ static UResourceDataEntry *init_entry(const char *localeID, const char *path, UE
         while(r->fAlias != NULL) {
             r = r->fAlias;
         }
-        r->fCountExisting++; /* we increase its reference count */
+        umtx_atomic_inc(countExisting(r)); /* we increase its reference count */
         /* if the resource has a warning */
         /* we don't want to overwrite a status with no error */
         if(r->fBogus != U_ZERO_ERROR && U_SUCCESS(*status)) {
@@ -439,8 +634,8 @@ static UResourceDataEntry *init_entry(const char *localeID, const char *path, UE
 }
 
 static UResourceDataEntry *
-getPoolEntry(const char *path, UErrorCode *status) {
-    UResourceDataEntry *poolBundle = init_entry(kPoolBundleName, path, status);
+getPoolEntry(const char *path, UBool unlockToLoad, UErrorCode *status) {
+    UResourceDataEntry *poolBundle = init_entry(kPoolBundleName, path, unlockToLoad, status);
     if( U_SUCCESS(*status) &&
         (poolBundle == NULL || poolBundle->fBogus != U_ZERO_ERROR || !poolBundle->fData.isPoolBundle)
     ) {
@@ -449,6 +644,77 @@ getPoolEntry(const char *path, UErrorCode *status) {
     return poolBundle;
 }
 
+/**
+ * INTERNAL: Loads the data of the bundles in the fallback chain of localeID, and of root,
+ * that are not in the cache yet. The mutex is unlocked while loading,
+ * and the entries are put into the cache without linking their fallback chains.
+ * This follows the usual fallbacks but not the default locale;
+ * any entry that is needed later and not preloaded is loaded with the mutex locked.
+ *    CAUTION:  resbMutex must be locked when calling this function.
+ */
+static void
+preloadEntries(const char *path, const char *localeID, UBool usingUSRData, const char *usrDataPath) {
+    char name[ULOC_FULLNAME_CAPACITY];
+    if (uprv_strlen(localeID) >= sizeof(name)) {
+        return;
+    }
+    uprv_strcpy(name, localeID);
+    UBool hasParent = TRUE;
+    UBool needsRoot = TRUE;
+    while (hasParent) {
+        UErrorCode status = U_ZERO_ERROR;
+        UResourceDataEntry *r = init_entry(name, path, TRUE, &status);
+        if (U_FAILURE(status)) {
+            return;
+        }
+        UBool hasExplicitParent = FALSE;
+        if (r->fBogus == U_ZERO_ERROR) {
+            if (usingUSRData) {
+                UErrorCode usrStatus = U_ZERO_ERROR;
+                UResourceDataEntry *u = init_entry(name, usrDataPath, TRUE, &usrStatus);
+                if (U_SUCCESS(usrStatus)) {
+                    umtx_atomic_dec(countExisting(u));
+                }
+            }
+            if (r->fData.noFallback) {
+                hasParent = needsRoot = FALSE;
+            } else if (res_getResource(&r->fData, "%%ParentIsRoot") != RES_BOGUS) {
+                hasParent = FALSE;
+            } else {
+                Resource parentRes = res_getResource(&r->fData, "%%Parent");
+                int32_t parentLocaleLen = 0;
+                // No tracing: called during initial data loading
+                const UChar *parentLocaleName = parentRes == RES_BOGUS ? NULL :
+                    res_getStringNoTrace(&(r->fData), parentRes, &parentLocaleLen);
+                if (parentLocaleName != NULL && 0 < parentLocaleLen &&
+                        parentLocaleLen < UPRV_LENGTHOF(name)) {
+                    u_UCharsToChars(parentLocaleName, name, parentLocaleLen + 1);
+                    hasExplicitParent = TRUE;
+                } else if (uprv_strlen(r->fName) < sizeof(name)) {
+                    uprv_strcpy(name, r->fName);  /* the entry may be an alias */
+                }
+            }
+        }
+        umtx_atomic_dec(countExisting(r));
+        if (hasParent && !hasExplicitParent) {
+            hasParent = chopLocale(name);
+            if (hasParent && *name == '\0') {
+                uprv_strcpy(name, "und");
+            }
+        }
+        if (uprv_strcmp(name, kRootLocaleName) == 0) {
+            break;
+        }
+    }
+    if (needsRoot) {
+        UErrorCode status = U_ZERO_ERROR;
+        UResourceDataEntry *root = init_entry(kRootLocaleName, path, TRUE, &status);
+        if (U_SUCCESS(status)) {
+            umtx_atomic_dec(countExisting(root));
+        }
+    }
+}
+
 /* INTERNAL: */
 /*   CAUTION:  resbMutex must be locked when calling this function! */
 static UResourceDataEntry *
@@ -460,7 +726,7 @@ findFirstExisting(const char* path, char* name,
     *hasChopped = TRUE; /* we're starting with a fresh name */
 
     while(*hasChopped && !hasRealData) {
-        r = init_entry(name, path, status);
+        r = init_entry(name, path, FALSE, status);
         /* Null pointer test */
         if (U_FAILURE(*status)) {
             return NULL;
@@ -473,8 +739,8 @@ findFirstExisting(const char* path, char* name,
             /* not to be used - as there might be parent   */
             /* lines in cache from previous openings that  */
             /* are not updated yet. */
-            r->fCountExisting--;
-            /*entryCloseInt(r);*/
+            umtx_atomic_dec(countExisting(r));
+            /*entryClose(r);*/
             r = NULL;
             *status = U_USING_FALLBACK_WARNING;
         } else {
@@ -546,7 +812,7 @@ loadParentsExceptRoot(UResourceDataEntry *&t1,
         }
         // Insert regular parents.
         UErrorCode parentStatus = U_ZERO_ERROR;
-        UResourceDataEntry *t2 = init_entry(name, t1->fPath, &parentStatus);
+        UResourceDataEntry *t2 = init_entry(name, t1->fPath, FALSE, &parentStatus);
         if (U_FAILURE(parentStatus)) {
             *status = parentStatus;
             return FALSE;
@@ -554,7 +820,7 @@ loadParentsExceptRoot(UResourceDataEntry *&t1,
         UResourceDataEntry *u2 = NULL;
         UErrorCode usrStatus = U_ZERO_ERROR;
         if (usingUSRData) {  // This code inserts user override data into the inheritance chain.
-            u2 = init_entry(name, usrDataPath, &usrStatus);
+            u2 = init_entry(name, usrDataPath, FALSE, &usrStatus);
             // If we failed due to out-of-memory, report that to the caller and exit early.
             if (usrStatus == U_MEMORY_ALLOCATION_ERROR) {
                 *status = usrStatus;
@@ -569,7 +835,7 @@ loadParentsExceptRoot(UResourceDataEntry *&t1,
             t1->fParent = t2;
             if (usingUSRData) {
                 // The USR override data wasn't found, set it to be deleted.
-                u2->fCountExisting = 0;
+                umtx_storeRelease(*countExisting(u2), 0);
             }
         }
         t1 = t2;
@@ -582,7 +848,7 @@ static UBool  // returns U_SUCCESS(*status)
 insertRootBundle(UResourceDataEntry *&t1, UErrorCode *status) {
     if (U_FAILURE(*status)) { return FALSE; }
     UErrorCode parentStatus = U_ZERO_ERROR;
-    UResourceDataEntry *t2 = init_entry(kRootLocaleName, t1->fPath, &parentStatus);
+    UResourceDataEntry *t2 = init_entry(kRootLocaleName, t1->fPath, FALSE, &parentStatus);
     if (U_FAILURE(parentStatus)) {
         *status = parentStatus;
         return FALSE;
@@ -662,6 +928,8 @@ static UResourceDataEntry *entryOpen(const char* path, const char* localeID,
  
     Mutex lock(&resbMutex);    // Lock resbMutex until the end of this function.
 
+    preloadEntries(path, name, usingUSRData, usrDataPath);
+
     /* We're going to skip all the locales that do not have any data */
     r = findFirstExisting(path, name, &isRoot, &hasChopped, &isDefault, &intStatus);
 
@@ -676,7 +944,7 @@ static UResourceDataEntry *entryOpen(const char* path, const char* localeID,
         hasRealData = TRUE;
         if ( usingUSRData ) {  /* This code inserts user override data into the inheritance chain */
             UErrorCode usrStatus = U_ZERO_ERROR;
-            UResourceDataEntry *u1 = init_entry(t1->fName, usrDataPath, &usrStatus);
+            UResourceDataEntry *u1 = init_entry(t1->fName, usrDataPath, FALSE, &usrStatus);
             // If we failed due to out-of-memory, report the failure and exit early.
             if (intStatus == U_MEMORY_ALLOCATION_ERROR) {
                 *status = intStatus;
@@ -688,7 +956,7 @@ static UResourceDataEntry *entryOpen(const char* path, const char* localeID,
                     r = u1;
                 } else {
                     /* the USR override data wasn't found, set it to be deleted */
-                    u1->fCountExisting = 0;
+                    umtx_storeRelease(*countExisting(u1), 0);
                 }
             }
         }
@@ -754,7 +1022,7 @@ static UResourceDataEntry *entryOpen(const char* path, const char* localeID,
 
     // TODO: Does this ever loop?
     while(r != NULL && !isRoot && t1->fParent != NULL) {
-        t1->fParent->fCountExisting++;
+        umtx_atomic_inc(countExisting(t1->fParent));
         t1 = t1->fParent;
     }
 
@@ -783,11 +1051,12 @@ entryOpenDirect(const char* path, const char* localeID, UErrorCode* status) {
     }
 
     Mutex lock(&resbMutex);
+    preloadEntries(path, localeID, FALSE, NULL);
     // findFirstExisting() without fallbacks.
-    UResourceDataEntry *r = init_entry(localeID, path, status);
+    UResourceDataEntry *r = init_entry(localeID, path, FALSE, status);
     if(U_SUCCESS(*status)) {
         if(r->fBogus != U_ZERO_ERROR) {
-            r->fCountExisting--;
+            umtx_atomic_dec(countExisting(r));
             r = NULL;
         }
     } else {
@@ -816,7 +1085,7 @@ entryOpenDirect(const char* path, const char* localeID, UErrorCode* status) {
     if(r != NULL) {
         // TODO: Does this ever loop?
         while(t1->fParent != NULL) {
-            t1->fParent->fCountExisting++;
+            umtx_atomic_inc(countExisting(t1->fParent));
             t1 = t1->fParent;
         }
     }
@@ -825,15 +1094,16 @@ entryOpenDirect(const char* path, const char* localeID, UErrorCode* status) {
 
 /**
  * Functions to create and destroy resource bundles.
- *     CAUTION:  resbMutex must be locked when calling this function.
+ * The reference counts are atomic and the fallback chain of an open
+ * entry does not change, so this does not lock resbMutex.
  */
 /* INTERNAL: */
-static void entryCloseInt(UResourceDataEntry *resB) {
+static void entryClose(UResourceDataEntry *resB) {
     UResourceDataEntry *p = resB;
 
     while(resB != NULL) {
         p = resB->fParent;
-        resB->fCountExisting--;
+        umtx_atomic_dec(countExisting(resB));
 
         /* Entries are left in the cache. TODO: add ures_flushCache() to force a flush
          of the cache. */
@@ -857,14 +1127,6 @@ static void entryCloseInt(UResourceDataEntry *resB) {
     }
 }
 
-/** 
- *  API: closes a resource bundle and cleans up.
- */
-
-static void entryClose(UResourceDataEntry *resB) {
-  Mutex lock(&resbMutex);
-  entryCloseInt(resB);
-}
 
 /*
 U_CFUNC void ures_setResPath(UResourceBundle *resB, const char* toAdd) {
@@ -1877,7 +2139,14 @@ ures_getByKeyWithFallback(const UResourceBundle *resB,
             char *myPath = NULL;
             const char* resPath = resB->fResPath;
             int32_t len = resB->fResPathLen;
-            while(res == RES_BOGUS && dataEntry->fParent != NULL) { /* Otherwise, we'll look in parents */
+            UBool useIndex = gFallbackIndexEnabled;
+            UBool isIndexed = FALSE;
+            int32_t indexHash = 0;
+            if(useIndex) {
+                indexHash = hashFallbackIndexPath(resPath, len, inKey);
+                isIndexed = findInFallbackIndex(resB->fData, indexHash, resPath, len, inKey, dataEntry, res);
+            }
+            while(!isIndexed && res == RES_BOGUS && dataEntry->fParent != NULL) { /* Otherwise, we'll look in parents */
                 dataEntry = dataEntry->fParent;
                 rootRes = dataEntry->fData.rootRes;
 
@@ -1899,6 +2168,7 @@ ures_getByKeyWithFallback(const UResourceBundle *resB,
                             /* We hit an alias, but we didn't finish following the path. */
                             helper = init_resb_result(&(dataEntry->fData), res, NULL, -1, dataEntry, resB, 0, helper, status); 
                             /*helper = init_resb_result(&(dataEntry->fData), res, inKey, -1, dataEntry, resB, 0, helper, status);*/
+                            useIndex = FALSE;
                             if(helper) {
                               dataEntry = helper->fData;
                               rootRes = helper->fRes;
@@ -1912,6 +2182,10 @@ ures_getByKeyWithFallback(const UResourceBundle *resB,
                     } while(*myPath); /* Continue until the whole path is consumed */
                 }
             }
+            if(useIndex && !isIndexed && res != RES_BOGUS) {
+                addToFallbackIndex(resB->fData, indexHash, resB->fResPath, resB->fResPathLen, inKey,
+                                   dataEntry, res);
+            }
             /*const ResourceData *rd = getFallbackData(resB, &key, &realData, &res, status);*/
             if(res != RES_BOGUS) {
               /* check if resB->fResPath gives the right name here */
@@ -38,6 +38,8 @@
 struct UResourceDataEntry;
 typedef struct UResourceDataEntry UResourceDataEntry;
 
+struct UResourceFallbackIndex;
+
 /*
  * Note: If we wanted to make this structure smaller, then we could try
  * to use one UResourceDataEntry pointer for fAlias and fPool, with a separate
@@ -52,8 +54,11 @@ struct UResourceDataEntry {
     UResourceDataEntry *fPool;
     ResourceData fData; /* data for low level access */
     char fNameBuffer[3]; /* A small buffer of free space for fName. The free space is due to struct padding. */
-    uint32_t fCountExisting; /* how much is this resource used */
+    /* how much is this resource used; always accessed as an atomic integer, see uresbund.cpp */
+    int32_t fCountExisting;
     UErrorCode fBogus;
+    /* fallback-resolved lookups below this bundle, built lazily, see uresbund.cpp */
+    struct UResourceFallbackIndex *fFallbackIndex;
     /* int32_t fHashKey;*/ /* for faster access in the hashtable */
 };
 
@@ -165,6 +170,16 @@ U_CAPI UBool U_EXPORT2 ures_dumpCacheContents(void);
 /*U_CFUNC void ures_setResPath(UResourceBundle *resB, const char* toAdd);*/
 /*U_CFUNC void ures_freeResPath(UResourceBundle *resB);*/
 
+/**
+ * Enables or disables the per-bundle index of fallback-resolved lookups
+ * which ures_getByKeyWithFallback() builds lazily. The index is enabled by default.
+ * Turning it off is only useful for testing and for performance comparisons,
+ * and must not be done while other threads are using resource bundles.
+ * Indexes that were already built are kept but not used while disabled.
+ * @internal
+ */
+U_CAPI void U_EXPORT2 ures_setFallbackIndexEnabled(UBool enabled);
+
 /* Candidates for export */
 U_CFUNC UResourceBundle *ures_copyResb(UResourceBundle *r, const UResourceBundle *original, UErrorCode *status);
 
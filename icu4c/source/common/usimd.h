@@ -0,0 +1,457 @@
+// © 2019 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+
+// usimd.h
+
+/*
+ * Internal block-scanning helpers for the hot loops of the string conversion,
+ * set span, normalization and regular expression search code.
+ *
+ * Each function handles the leading part of its input that is "trivial"
+ * for the caller (for example, a run of ASCII characters) in blocks of
+ * 16 bytes or 8/16 UChars, and returns the number of units it handled.
+ * The caller continues with its regular per-character code at that index,
+ * so the result is always identical to that of the scalar loop alone.
+ *
+ * The vector implementation is selected at compile time:
+ * SSE2 on x86-64 (part of the baseline instruction set),
+ * NEON (Advanced SIMD) on AArch64, and a portable 64-bit word-at-a-time
+ * fallback everywhere else.  Functions documented to return 0 without
+ * vector support have no fallback.
+ * Define U_SIMD_DISABLE=1 to force the portable fallback.
+ */
+
+#ifndef __USIMD_H__
+#define __USIMD_H__
+
+#include "unicode/utypes.h"
+#include "cmemory.h"
+
+#if !defined(U_SIMD_DISABLE) || !U_SIMD_DISABLE
+#   if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#       define USIMD_SSE2 1
+#       include <emmintrin.h>
+#   elif (defined(__aarch64__) && defined(__ARM_NEON)) || defined(_M_ARM64)
+#       define USIMD_NEON 1
+#       include <arm_neon.h>
+#   endif
+#endif
+
+/**
+ * Marks a function that wraps a block kernel for a hot per-character loop,
+ * so that the compiler does not inline the kernel into that loop
+ * where its setup and register use can slow down the common case.
+ * @internal
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#   define USIMD_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#   define USIMD_NOINLINE __declspec(noinline)
+#else
+#   define USIMD_NOINLINE
+#endif
+
+/**
+ * Returns the length of the initial run of ASCII bytes (<=0x7f) in s[0..length[.
+ * @internal
+ */
+static inline int32_t
+usimd_asciiPrefixUTF8(const uint8_t *s, int32_t length) {
+    int32_t i = 0;
+#if USIMD_SSE2
+    while ((length - i) >= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(s + i));
+        if (_mm_movemask_epi8(v) != 0) { break; }
+        i += 16;
+    }
+#elif USIMD_NEON
+    while ((length - i) >= 16) {
+        if (vmaxvq_u8(vld1q_u8(s + i)) > 0x7f) { break; }
+        i += 16;
+    }
+#else
+    while ((length - i) >= 8) {
+        uint64_t w;
+        uprv_memcpy(&w, s + i, 8);
+        if ((w & 0x8080808080808080ULL) != 0) { break; }
+        i += 8;
+    }
+#endif
+    while (i < length && s[i] <= 0x7f) { ++i; }
+    return i;
+}
+
+/**
+ * Returns the length of the initial run of UChars below limit in s[0..length[.
+ * limit must be greater than 0.
+ * @internal
+ */
+static inline int32_t
+usimd_spanBelowUTF16(const UChar *s, int32_t length, UChar limit) {
+    int32_t i = 0;
+#if USIMD_SSE2
+    // Unsigned 16-bit comparison: c<limit <=> saturating c-(limit-1)==0.
+    __m128i max = _mm_set1_epi16((short)(limit - 1));
+    __m128i zero = _mm_setzero_si128();
+    while ((length - i) >= 8) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(s + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_subs_epu16(v, max), zero)) != 0xffff) { break; }
+        i += 8;
+    }
+#elif USIMD_NEON
+    uint16x8_t lim = vdupq_n_u16(limit);
+    while ((length - i) >= 8) {
+        if (vminvq_u16(vcltq_u16(vld1q_u16((const uint16_t *)(s + i)), lim)) == 0) { break; }
+        i += 8;
+    }
+#else
+    // Four 16-bit lanes per word.  Adding add to the low 15 bits of a lane
+    // carries into its high bit iff those bits are at least limit's low 15 bits.
+    // A lane with its high bit set is at least limit<=0x8000,
+    // and it must also carry for a higher limit.
+    const uint64_t highs = 0x8000800080008000ULL;
+    UBool limitHigh = limit > 0x8000;
+    uint64_t add = (uint64_t)(limitHigh ? 0x10000 - limit : 0x8000 - limit) * 0x0001000100010001ULL;
+    while ((length - i) >= 4) {
+        uint64_t w;
+        uprv_memcpy(&w, s + i, 8);
+        uint64_t t = (w & ~highs) + add;
+        t = limitHigh ? (t & w) : (t | w);
+        if ((t & highs) != 0) { break; }
+        i += 4;
+    }
+#endif
+    while (i < length && s[i] < limit) { ++i; }
+    return i;
+}
+
+/**
+ * Returns the length of the initial run of bytes below limit in s[0..length[.
+ * limit must be greater than 0.
+ * @internal
+ */
+static inline int32_t
+usimd_spanBelowUTF8(const uint8_t *s, int32_t length, uint8_t limit) {
+    int32_t i = 0;
+#if USIMD_SSE2
+    // Unsigned 8-bit comparison: b<limit <=> saturating b-(limit-1)==0.
+    __m128i max = _mm_set1_epi8((char)(limit - 1));
+    __m128i zero = _mm_setzero_si128();
+    while ((length - i) >= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(s + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_subs_epu8(v, max), zero)) != 0xffff) { break; }
+        i += 16;
+    }
+#elif USIMD_NEON
+    uint8x16_t lim = vdupq_n_u8(limit);
+    while ((length - i) >= 16) {
+        if (vminvq_u8(vcltq_u8(vld1q_u8(s + i), lim)) == 0) { break; }
+        i += 16;
+    }
+#else
+    // Eight byte lanes per word; see usimd_spanBelowUTF16().
+    const uint64_t highs = 0x8080808080808080ULL;
+    UBool limitHigh = limit > 0x80;
+    uint64_t add = (uint64_t)(limitHigh ? 0x100 - limit : 0x80 - limit) * 0x0101010101010101ULL;
+    while ((length - i) >= 8) {
+        uint64_t w;
+        uprv_memcpy(&w, s + i, 8);
+        uint64_t t = (w & ~highs) + add;
+        t = limitHigh ? (t & w) : (t | w);
+        if ((t & highs) != 0) { break; }
+        i += 8;
+    }
+#endif
+    while (i < length && s[i] < limit) { ++i; }
+    return i;
+}
+
+/**
+ * Copies the initial run of ASCII bytes of src[0..length[ into dest as UChars.
+ * dest must have room for length UChars.
+ * @return the number of bytes/UChars copied
+ * @internal
+ */
+static inline int32_t
+usimd_asciiFromUTF8(UChar *dest, const uint8_t *src, int32_t length) {
+    int32_t i = 0;
+#if USIMD_SSE2
+    __m128i zero = _mm_setzero_si128();
+    while ((length - i) >= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+        if (_mm_movemask_epi8(v) != 0) { break; }
+        _mm_storeu_si128((__m128i *)(dest + i), _mm_unpacklo_epi8(v, zero));
+        _mm_storeu_si128((__m128i *)(dest + i + 8), _mm_unpackhi_epi8(v, zero));
+        i += 16;
+    }
+#elif USIMD_NEON
+    while ((length - i) >= 16) {
+        uint8x16_t v = vld1q_u8(src + i);
+        if (vmaxvq_u8(v) > 0x7f) { break; }
+        vst1q_u16((uint16_t *)(dest + i), vmovl_u8(vget_low_u8(v)));
+        vst1q_u16((uint16_t *)(dest + i + 8), vmovl_u8(vget_high_u8(v)));
+        i += 16;
+    }
+#else
+    while ((length - i) >= 8) {
+        uint64_t w;
+        uprv_memcpy(&w, src + i, 8);
+        if ((w & 0x8080808080808080ULL) != 0) { break; }
+        for (int32_t j = 0; j < 8; ++j) {
+            dest[i + j] = src[i + j];
+        }
+        i += 8;
+    }
+#endif
+    uint8_t b;
+    while (i < length && (b = src[i]) <= 0x7f) {
+        dest[i++] = b;
+    }
+    return i;
+}
+
+/**
+ * Copies the initial run of ASCII UChars (<=0x7f) of src[0..length[ into dest as bytes.
+ * dest must have room for length bytes.
+ * @return the number of UChars/bytes copied
+ * @internal
+ */
+static inline int32_t
+usimd_asciiToUTF8(uint8_t *dest, const UChar *src, int32_t length) {
+    int32_t i = 0;
+#if USIMD_SSE2
+    __m128i nonASCII = _mm_set1_epi16((short)0xff80);
+    __m128i zero = _mm_setzero_si128();
+    while ((length - i) >= 16) {
+        __m128i a = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i b = _mm_loadu_si128((const __m128i *)(src + i + 8));
+        __m128i high = _mm_and_si128(_mm_or_si128(a, b), nonASCII);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, zero)) != 0xffff) { break; }
+        _mm_storeu_si128((__m128i *)(dest + i), _mm_packus_epi16(a, b));
+        i += 16;
+    }
+#elif USIMD_NEON
+    while ((length - i) >= 16) {
+        uint16x8_t a = vld1q_u16((const uint16_t *)(src + i));
+        uint16x8_t b = vld1q_u16((const uint16_t *)(src + i + 8));
+        if (vmaxvq_u16(vorrq_u16(a, b)) > 0x7f) { break; }
+        vst1q_u8(dest + i, vcombine_u8(vmovn_u16(a), vmovn_u16(b)));
+        i += 16;
+    }
+#else
+    while ((length - i) >= 4) {
+        uint64_t w;
+        uprv_memcpy(&w, src + i, 8);
+        if ((w & 0xff80ff80ff80ff80ULL) != 0) { break; }
+        for (int32_t j = 0; j < 4; ++j) {
+            dest[i + j] = (uint8_t)src[i + j];
+        }
+        i += 4;
+    }
+#endif
+    UChar c;
+    while (i < length && (c = src[i]) <= 0x7f) {
+        dest[i++] = (uint8_t)c;
+    }
+    return i;
+}
+
+/**
+ * Returns the length of an initial part of s[0..length[ in which
+ * each UChar c<=0x7f and (c is in one of the ranges)==contained.
+ * The ranges are given as rangesLength/2 pairs of inclusive start/end values <=0x7f.
+ * The result is a multiple of the block size and may be shorter than
+ * the actual span; the caller continues with its regular code.
+ * Without vector support this returns 0.
+ * @internal
+ */
+static inline int32_t
+usimd_spanASCIIRangesUTF16(const UChar *s, int32_t length,
+                           const uint8_t *ranges, int32_t rangesLength, UBool contained) {
+    int32_t i = 0;
+#if USIMD_SSE2
+    // Signed 16-bit comparisons are fine: code units >=0x8000 compare as negative
+    // and are therefore in none of the ranges.
+    __m128i zero = _mm_setzero_si128();
+    __m128i nonASCII = _mm_set1_epi16((short)0xff80);
+    while ((length - i) >= 8) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(s + i));
+        __m128i in = zero;
+        for (int32_t r = 0; r < rangesLength; r += 2) {
+            in = _mm_or_si128(in, _mm_andnot_si128(
+                _mm_cmpgt_epi16(v, _mm_set1_epi16(ranges[r + 1])),
+                _mm_cmpgt_epi16(v, _mm_set1_epi16((short)(ranges[r] - 1)))));
+        }
+        if (contained) {
+            if (_mm_movemask_epi8(in) != 0xffff) { break; }
+        } else {
+            __m128i ascii = _mm_cmpeq_epi16(_mm_and_si128(v, nonASCII), zero);
+            if (_mm_movemask_epi8(_mm_andnot_si128(in, ascii)) != 0xffff) { break; }
+        }
+        i += 8;
+    }
+#elif USIMD_NEON
+    while ((length - i) >= 8) {
+        uint16x8_t v = vld1q_u16((const uint16_t *)(s + i));
+        uint16x8_t in = vdupq_n_u16(0);
+        for (int32_t r = 0; r < rangesLength; r += 2) {
+            in = vorrq_u16(in, vandq_u16(vcgeq_u16(v, vdupq_n_u16(ranges[r])),
+                                         vcleq_u16(v, vdupq_n_u16(ranges[r + 1]))));
+        }
+        if (contained) {
+            if (vminvq_u16(in) == 0) { break; }
+        } else {
+            if (vmaxvq_u16(in) != 0 || vmaxvq_u16(v) > 0x7f) { break; }
+        }
+        i += 8;
+    }
+#else
+    (void)s;
+    (void)length;
+    (void)ranges;
+    (void)rangesLength;
+    (void)contained;
+#endif
+    return i;
+}
+
+/**
+ * Returns the length of an initial part of s[0..length[ in which
+ * each byte b<=0x7f and (b is in one of the ranges)==contained.
+ * The ranges are given as rangesLength/2 pairs of inclusive start/end values <=0x7f.
+ * The result is a multiple of the block size and may be shorter than
+ * the actual span; the caller continues with its regular code.
+ * Without vector support this returns 0.
+ * @internal
+ */
+static inline int32_t
+usimd_spanASCIIRangesUTF8(const uint8_t *s, int32_t length,
+                          const uint8_t *ranges, int32_t rangesLength, UBool contained) {
+    int32_t i = 0;
+#if USIMD_SSE2
+    // Signed 8-bit comparisons are fine: bytes >=0x80 compare as negative
+    // and are therefore in none of the ranges.
+    __m128i zero = _mm_setzero_si128();
+    while ((length - i) >= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(s + i));
+        __m128i in = zero;
+        for (int32_t r = 0; r < rangesLength; r += 2) {
+            in = _mm_or_si128(in, _mm_andnot_si128(
+                _mm_cmpgt_epi8(v, _mm_set1_epi8((char)ranges[r + 1])),
+                _mm_cmpgt_epi8(v, _mm_set1_epi8((char)(ranges[r] - 1)))));
+        }
+        if (contained) {
+            if (_mm_movemask_epi8(in) != 0xffff) { break; }
+        } else {
+            if ((_mm_movemask_epi8(in) | _mm_movemask_epi8(v)) != 0) { break; }
+        }
+        i += 16;
+    }
+#elif USIMD_NEON
+    while ((length - i) >= 16) {
+        uint8x16_t v = vld1q_u8(s + i);
+        uint8x16_t in = vdupq_n_u8(0);
+        for (int32_t r = 0; r < rangesLength; r += 2) {
+            in = vorrq_u8(in, vandq_u8(vcgeq_u8(v, vdupq_n_u8(ranges[r])),
+                                       vcleq_u8(v, vdupq_n_u8(ranges[r + 1]))));
+        }
+        if (contained) {
+            if (vminvq_u8(in) == 0) { break; }
+        } else {
+            if (vmaxvq_u8(in) != 0 || vmaxvq_u8(v) > 0x7f) { break; }
+        }
+        i += 16;
+    }
+#else
+    (void)s;
+    (void)length;
+    (void)ranges;
+    (void)rangesLength;
+    (void)contained;
+#endif
+    return i;
+}
+
+/**
+ * Returns the length of an initial part of s[0..length[ in which there is no index i
+ * (with i+lastOffset<length) where s[i]==first and s[i+lastOffset]==last.
+ * Used to skip over text that cannot contain a literal string
+ * whose first UChar is first and whose UChar at lastOffset is last.
+ * The result is a multiple of the block size and may be shorter than
+ * the actual part; the caller continues with its regular code.
+ * Without vector support this returns 0.
+ * @internal
+ */
+static inline int32_t
+usimd_skipNoPairUTF16(const UChar *s, int32_t length, UChar first, UChar last, int32_t lastOffset) {
+    int32_t i = 0;
+#if USIMD_SSE2
+    __m128i f = _mm_set1_epi16((short)first);
+    __m128i l = _mm_set1_epi16((short)last);
+    while ((length - i - lastOffset) >= 8) {
+        __m128i a = _mm_loadu_si128((const __m128i *)(s + i));
+        __m128i b = _mm_loadu_si128((const __m128i *)(s + i + lastOffset));
+        if (_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi16(a, f), _mm_cmpeq_epi16(b, l))) != 0) { break; }
+        i += 8;
+    }
+#elif USIMD_NEON
+    uint16x8_t f = vdupq_n_u16(first);
+    uint16x8_t l = vdupq_n_u16(last);
+    while ((length - i - lastOffset) >= 8) {
+        uint16x8_t a = vld1q_u16((const uint16_t *)(s + i));
+        uint16x8_t b = vld1q_u16((const uint16_t *)(s + i + lastOffset));
+        if (vmaxvq_u16(vandq_u16(vceqq_u16(a, f), vceqq_u16(b, l))) != 0) { break; }
+        i += 8;
+    }
+#else
+    (void)s;
+    (void)length;
+    (void)first;
+    (void)last;
+    (void)lastOffset;
+#endif
+    return i;
+}
+
+/**
+ * Returns the length of an initial part of s[0..length[ in which there is no index i
+ * (with i+lastOffset<length) where s[i]==first and s[i+lastOffset]==last.
+ * Used to skip over text that cannot contain a literal string
+ * whose first byte is first and whose byte at lastOffset is last.
+ * The result is a multiple of the block size and may be shorter than
+ * the actual part; the caller continues with its regular code.
+ * Without vector support this returns 0.
+ * @internal
+ */
+static inline int32_t
+usimd_skipNoPairUTF8(const uint8_t *s, int32_t length, uint8_t first, uint8_t last, int32_t lastOffset) {
+    int32_t i = 0;
+#if USIMD_SSE2
+    __m128i f = _mm_set1_epi8((char)first);
+    __m128i l = _mm_set1_epi8((char)last);
+    while ((length - i - lastOffset) >= 16) {
+        __m128i a = _mm_loadu_si128((const __m128i *)(s + i));
+        __m128i b = _mm_loadu_si128((const __m128i *)(s + i + lastOffset));
+        if (_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, f), _mm_cmpeq_epi8(b, l))) != 0) { break; }
+        i += 16;
+    }
+#elif USIMD_NEON
+    uint8x16_t f = vdupq_n_u8(first);
+    uint8x16_t l = vdupq_n_u8(last);
+    while ((length - i - lastOffset) >= 16) {
+        uint8x16_t a = vld1q_u8(s + i);
+        uint8x16_t b = vld1q_u8(s + i + lastOffset);
+        if (vmaxvq_u8(vandq_u8(vceqq_u8(a, f), vceqq_u8(b, l))) != 0) { break; }
+        i += 16;
+    }
+#else
+    (void)s;
+    (void)length;
+    (void)first;
+    (void)last;
+    (void)lastOffset;
+#endif
+    return i;
+}
+
+#endif
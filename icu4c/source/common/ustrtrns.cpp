@@ -34,6 +34,7 @@
 #include "cstring.h"
 #include "cmemory.h"
 #include "ustr_imp.h"
+#include "usimd.h"
 #include "uassert.h"
 
 U_CAPI UChar* U_EXPORT2 
@@ -403,6 +404,15 @@ u_strFromUTF8WithSub(UChar *dest,
                 c = (uint8_t)src[i++];
                 if(U8_IS_SINGLE(c)) {
                     *pDest++=(UChar)c;
+                    if(count > 1 && U8_IS_SINGLE(src[i])) {
+                        // Copy the rest of an ASCII run in blocks.
+                        // Each ASCII character uses one byte and one UChar,
+                        // so count is reduced accordingly.
+                        int32_t n = usimd_asciiFromUTF8(pDest, (const uint8_t *)src + i, count - 1);
+                        pDest += n;
+                        i += n;
+                        count -= n;
+                    }
                 } else {
                     uint8_t __t1, __t2;
                     if( /* handle U+0800..U+FFFF inline */
@@ -491,7 +501,10 @@ u_strFromUTF8WithSub(UChar *dest,
             // modified copy of U8_NEXT()
             c = (uint8_t)src[i++];
             if(U8_IS_SINGLE(c)) {
-                ++reqLength;
+                // Count the rest of an ASCII run in blocks.
+                int32_t n = 1 + usimd_asciiPrefixUTF8((const uint8_t *)src + i, srcLength - i);
+                reqLength += n;
+                i += n - 1;
             } else {
                 uint8_t __t1, __t2;
                 if( /* handle U+0800..U+FFFF inline */
@@ -690,6 +703,12 @@ u_strFromUTF8Lenient(UChar *dest,
                      * resynchronization after illegal sequences.
                      */
                     *pDest++=(UChar)ch;
+                    if(ch <= 0x7f) {
+                        /* copy the rest of an ASCII run in blocks */
+                        int32_t n = usimd_asciiFromUTF8(pDest, pSrc, (int32_t)(pSrcLimit - pSrc));
+                        pDest += n;
+                        pSrc += n;
+                    }
                 } else if(ch < 0xe0) { /* U+0080..U+07FF */
                     /* 0x3080 = (0xc0 << 6) + 0x80 */
                     *pDest++ = (UChar)((ch << 6) + *pSrc++ - 0x3080);
@@ -921,6 +940,17 @@ u_strToUTF8WithSub(char *dest,
                 ch=*pSrc++;
                 if(ch <= 0x7f) {
                     *pDest++ = (uint8_t)ch;
+                    if(count > 1 && *pSrc <= 0x7f) {
+                        /*
+                         * Copy the rest of an ASCII run in blocks.
+                         * Each ASCII character uses one UChar and one byte,
+                         * so count is reduced accordingly.
+                         */
+                        int32_t n = usimd_asciiToUTF8(pDest, pSrc, count - 1);
+                        pDest += n;
+                        pSrc += n;
+                        count -= n;
+                    }
                 } else if(ch <= 0x7ff) {
                     *pDest++=(uint8_t)((ch>>6)|0xc0);
                     *pDest++=(uint8_t)((ch&0x3f)|0x80);
@@ -1019,7 +1049,10 @@ u_strToUTF8WithSub(char *dest,
         while(pSrc<pSrcLimit) {
             ch=*pSrc++;
             if(ch<=0x7f) {
-                ++reqLength;
+                /* count the rest of an ASCII run in blocks */
+                int32_t n = usimd_spanBelowUTF16(pSrc, (int32_t)(pSrcLimit - pSrc), 0x80);
+                reqLength += 1 + n;
+                pSrc += n;
             } else if(ch<=0x7ff) {
                 reqLength+=2;
             } else if(!U16_IS_SURROGATE(ch)) {
@@ -1658,6 +1658,16 @@ utext_openUTF8(UText *ut, const char *s, int64_t length, UErrorCode *status) {
 
 }
 
+U_CAPI const char * U_EXPORT2
+utext_getUTF8(UText *ut, int32_t *pLength) {
+    if (ut == NULL || ut->pFuncs != &utf8Funcs) {
+        return NULL;
+    }
+    // utf8TextLength() finds the length of a zero terminated string.
+    *pLength = (int32_t)utext_nativeLength(ut);
+    return (const char *)ut->context;
+}
+
 
 
 
@@ -207,6 +207,11 @@ SharedCalendar::~SharedCalendar() {
     delete ptr;
 }
 
+template<> U_I18N_API
+const char *CacheKey<SharedCalendar>::getValueTypeName() const {
+    return "SharedCalendar";
+}
+
 template<> U_I18N_API
 const SharedCalendar *LocaleCacheKey<SharedCalendar>::createObject(
         const void * /*unusedCreationContext*/, UErrorCode &status) const {
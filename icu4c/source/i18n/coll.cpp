@@ -54,6 +54,7 @@
 #include "ucol_imp.h"
 #include "cstring.h"
 #include "cmemory.h"
+#include "uarrsort.h"
 #include "umutex.h"
 #include "servloc.h"
 #include "uassert.h"
@@ -535,6 +536,164 @@ UCollationResult Collator::compareUTF8(const StringPiece &source,
     return compare(sIter, tIter, status);
 }
 
+void Collator::compareBatch(const char16_t *const sources[], const int32_t sourceLengths[],
+                            const char16_t *const targets[], const int32_t targetLengths[],
+                            int32_t count, UCollationResult results[],
+                            UErrorCode &status) const {
+    if(U_FAILURE(status)) { return; }
+    if(count < 0 || (count > 0 && (sources == NULL || targets == NULL || results == NULL))) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    for(int32_t i = 0; i < count && U_SUCCESS(status); ++i) {
+        results[i] = compare(sources[i], sourceLengths != NULL ? sourceLengths[i] : -1,
+                             targets[i], targetLengths != NULL ? targetLengths[i] : -1,
+                             status);
+    }
+}
+
+void Collator::compareBatchUTF8(const char *const sources[], const int32_t sourceLengths[],
+                                const char *const targets[], const int32_t targetLengths[],
+                                int32_t count, UCollationResult results[],
+                                UErrorCode &status) const {
+    if(U_FAILURE(status)) { return; }
+    if(count < 0 || (count > 0 && (sources == NULL || targets == NULL || results == NULL))) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    for(int32_t i = 0; i < count && U_SUCCESS(status); ++i) {
+        results[i] = internalCompareUTF8(sources[i], sourceLengths != NULL ? sourceLengths[i] : -1,
+                                         targets[i], targetLengths != NULL ? targetLengths[i] : -1,
+                                         status);
+    }
+}
+
+namespace {
+
+inline int32_t stringLength(const char16_t *s) { return u_strlen(s); }
+inline int32_t stringLength(const char *s) { return static_cast<int32_t>(uprv_strlen(s)); }
+
+inline UCollationResult compareStrings(const Collator &coll,
+                                       const char16_t *left, int32_t leftLength,
+                                       const char16_t *right, int32_t rightLength,
+                                       UErrorCode &errorCode) {
+    return coll.compare(left, leftLength, right, rightLength, errorCode);
+}
+
+inline UCollationResult compareStrings(const Collator &coll,
+                                       const char *left, int32_t leftLength,
+                                       const char *right, int32_t rightLength,
+                                       UErrorCode &errorCode) {
+    return coll.internalCompareUTF8(left, leftLength, right, rightLength, errorCode);
+}
+
+template<typename CharType>
+struct SortIndexesContext {
+    const Collator &coll;
+    const CharType *const *strings;
+    const int32_t *lengths;
+    UErrorCode &errorCode;
+};
+
+template<typename CharType>
+int32_t U_CALLCONV
+compareIndexes(const void *context, const void *left, const void *right) {
+    const SortIndexesContext<CharType> &c =
+        *static_cast<const SortIndexesContext<CharType> *>(context);
+    int32_t leftIndex = *static_cast<const int32_t *>(left);
+    int32_t rightIndex = *static_cast<const int32_t *>(right);
+    int32_t result = compareStrings(c.coll,
+                                    c.strings[leftIndex], c.lengths[leftIndex],
+                                    c.strings[rightIndex], c.lengths[rightIndex],
+                                    c.errorCode);
+    // Strings that compare equal stay in input order.
+    return result != UCOL_EQUAL ? result : leftIndex - rightIndex;
+}
+
+/**
+ * Sorts the indexes with the collator.
+ * NUL-terminated strings are measured once up front rather than in every comparison.
+ */
+template<typename CharType>
+void sortIndexesImpl(const Collator &coll,
+                     const CharType *const strings[], const int32_t lengths[],
+                     int32_t count, int32_t indexes[], UErrorCode &errorCode) {
+    if(U_FAILURE(errorCode)) { return; }
+    if(count < 0 || (count > 0 && (strings == NULL || indexes == NULL))) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    if(count == 0) { return; }
+    LocalMemory<int32_t> knownLengths;
+    if(knownLengths.allocateInsteadAndReset(count) == NULL) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    for(int32_t i = 0; i < count; ++i) {
+        int32_t length = lengths != NULL ? lengths[i] : -1;
+        if(strings[i] == NULL) {
+            if(length != 0) {
+                errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+                return;
+            }
+        } else if(length < 0) {
+            length = stringLength(strings[i]);
+        }
+        knownLengths[i] = length;
+        indexes[i] = i;
+    }
+    SortIndexesContext<CharType> context = { coll, strings, knownLengths.getAlias(), errorCode };
+    uprv_sortArray(indexes, count, (int32_t)sizeof(int32_t),
+                   compareIndexes<CharType>, &context, FALSE, &errorCode);
+}
+
+}  // namespace
+
+void Collator::sortIndexes(const char16_t *const strings[], const int32_t lengths[],
+                           int32_t count, int32_t indexes[], UErrorCode &status) const {
+    sortIndexesImpl(*this, strings, lengths, count, indexes, status);
+}
+
+void Collator::sortIndexesUTF8(const char *const strings[], const int32_t lengths[],
+                               int32_t count, int32_t indexes[], UErrorCode &status) const {
+    sortIndexesImpl(*this, strings, lengths, count, indexes, status);
+}
+
+int32_t Collator::getSortKeys(const char16_t *const strings[], const int32_t lengths[],
+                             int32_t count, uint8_t *dest, int32_t destCapacity,
+                             int32_t offsets[], UErrorCode &status) const {
+    if(U_FAILURE(status)) { return 0; }
+    if(count < 0 || (count > 0 && strings == NULL) || offsets == NULL ||
+            destCapacity < 0 || (dest == NULL && destCapacity > 0)) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    int32_t totalLength = 0;
+    offsets[0] = 0;
+    for(int32_t i = 0; i < count; ++i) {
+        int32_t length = lengths != NULL ? lengths[i] : -1;
+        if(strings[i] == NULL && length != 0) {
+            status = U_ILLEGAL_ARGUMENT_ERROR;
+            return 0;
+        }
+        int32_t remaining = destCapacity - totalLength;
+        int32_t keyLength = remaining > 0 ?
+            getSortKey(strings[i], length, dest + totalLength, remaining) :
+            getSortKey(strings[i], length, NULL, 0);
+        if(keyLength == 0) {
+            // getSortKey() only returns 0 for an internal error.
+            status = U_MEMORY_ALLOCATION_ERROR;
+            return 0;
+        }
+        totalLength += keyLength;
+        offsets[i + 1] = totalLength;
+    }
+    if(totalLength > destCapacity) {
+        status = U_BUFFER_OVERFLOW_ERROR;
+    }
+    return totalLength;
+}
+
 UBool Collator::equals(const UnicodeString& source, 
                        const UnicodeString& target) const
 {
@@ -37,6 +37,7 @@
 #include "collationdata.h"
 #include "collationdatabuilder.h"
 #include "collationfastlatin.h"
+#include "collationfastscript.h"
 #include "collationroot.h"
 #include "collationrootelements.h"
 #include "collationruleparser.h"
@@ -284,6 +285,9 @@ CollationBuilder::parseAndBuild(const UnicodeString &ruleString,
     ownedSettings.fastLatinOptions = CollationFastLatin::getOptions(
         tailoring->data, ownedSettings,
         ownedSettings.fastLatinPrimaries, UPRV_LENGTHOF(ownedSettings.fastLatinPrimaries));
+    CollationFastScript::getOptions(
+        tailoring->data, ownedSettings,
+        ownedSettings.fastScriptOptions, UPRV_LENGTHOF(ownedSettings.fastScriptOptions));
     tailoring->rules = ruleString;
     tailoring->rules.getTerminatedBuffer();  // ensure NUL-termination
     tailoring->setVersion(base->version, rulesVersion);
@@ -23,6 +23,7 @@
 #include "collationdata.h"
 #include "collationdatareader.h"
 #include "collationfastlatin.h"
+#include "collationfastscript.h"
 #include "collationkeys.h"
 #include "collationrootelements.h"
 #include "collationsettings.h"
@@ -417,6 +418,9 @@ CollationDataReader::read(const CollationTailoring *base, const uint8_t *inBytes
     uint16_t fastLatinPrimaries[CollationFastLatin::LATIN_LIMIT];
     int32_t fastLatinOptions = CollationFastLatin::getOptions(
             tailoring.data, ts, fastLatinPrimaries, UPRV_LENGTHOF(fastLatinPrimaries));
+    int32_t fastScriptOptions[CollationFastScript::NUM_SCRIPTS];
+    CollationFastScript::getOptions(
+            tailoring.data, ts, fastScriptOptions, UPRV_LENGTHOF(fastScriptOptions));
     if(options == ts.options && ts.variableTop != 0 &&
             reorderCodesLength == ts.reorderCodesLength &&
             (reorderCodesLength == 0 ||
@@ -424,7 +428,8 @@ CollationDataReader::read(const CollationTailoring *base, const uint8_t *inBytes
             fastLatinOptions == ts.fastLatinOptions &&
             (fastLatinOptions < 0 ||
                 uprv_memcmp(fastLatinPrimaries, ts.fastLatinPrimaries,
-                            sizeof(fastLatinPrimaries)) == 0)) {
+                            sizeof(fastLatinPrimaries)) == 0) &&
+            uprv_memcmp(fastScriptOptions, ts.fastScriptOptions, sizeof(fastScriptOptions)) == 0) {
         return;
     }
 
@@ -451,6 +456,9 @@ CollationDataReader::read(const CollationTailoring *base, const uint8_t *inBytes
     settings->fastLatinOptions = CollationFastLatin::getOptions(
         tailoring.data, *settings,
         settings->fastLatinPrimaries, UPRV_LENGTHOF(settings->fastLatinPrimaries));
+    CollationFastScript::getOptions(
+        tailoring.data, *settings,
+        settings->fastScriptOptions, UPRV_LENGTHOF(settings->fastScriptOptions));
 }
 
 UBool U_CALLCONV
@@ -219,6 +219,8 @@ class U_I18N_API CollationFastLatin /* all static */ {
                                const uint8_t *right, int32_t rightLength);
 
 private:
+    friend class CollationFastScript;
+
     static uint32_t lookup(const uint16_t *table, UChar32 c);
     static uint32_t lookupUTF8(const uint16_t *table, UChar32 c,
                                const uint8_t *s8, int32_t &sIndex, int32_t sLength);
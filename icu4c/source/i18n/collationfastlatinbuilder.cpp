@@ -31,6 +31,7 @@
 #include "collationdata.h"
 #include "collationfastlatin.h"
 #include "collationfastlatinbuilder.h"
+#include "collationfastscript.h"
 #include "uassert.h"
 #include "uvectr64.h"
 
@@ -88,9 +89,11 @@ binarySearch(const int64_t list[], int32_t limit, int64_t ce) {
 
 CollationFastLatinBuilder::CollationFastLatinBuilder(UErrorCode &errorCode)
         : ce0(0), ce1(0),
+          fastScript(-1), numChars(CollationFastLatin::NUM_FAST_CHARS),
           contractionCEs(errorCode), uniqueCEs(errorCode),
           miniCEs(NULL),
-          firstDigitPrimary(0), firstLatinPrimary(0), lastLatinPrimary(0),
+          firstDigitPrimary(0), firstLatinPrimary(0),
+          firstScriptPrimary(0), lastScriptPrimary(0),
           firstShortPrimary(0), shortPrimaryOverflow(FALSE),
           headerLength(0) {
 }
@@ -101,6 +104,24 @@ CollationFastLatinBuilder::~CollationFastLatinBuilder() {
 
 UBool
 CollationFastLatinBuilder::forData(const CollationData &data, UErrorCode &errorCode) {
+    return build(data, errorCode);
+}
+
+UBool
+CollationFastLatinBuilder::forScript(const CollationData &data, int32_t script,
+                                     UErrorCode &errorCode) {
+    if(U_FAILURE(errorCode)) { return FALSE; }
+    if(script < 0 || CollationFastScript::NUM_SCRIPTS <= script) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return FALSE;
+    }
+    fastScript = script;
+    numChars = CollationFastScript::getNumChars(script);
+    return build(data, errorCode);
+}
+
+UBool
+CollationFastLatinBuilder::build(const CollationData &data, UErrorCode &errorCode) {
     if(U_FAILURE(errorCode)) { return FALSE; }
     if(!result.isEmpty()) {  // This builder is not reusable.
         errorCode = U_INVALID_STATE_ERROR;
@@ -115,7 +136,7 @@ CollationFastLatinBuilder::forData(const CollationData &data, UErrorCode &errorC
     if(shortPrimaryOverflow) {
         // Give digits long mini primaries,
         // so that there are more short primaries for letters.
-        firstShortPrimary = firstLatinPrimary;
+        firstShortPrimary = firstScriptPrimary;
         resetCEs();
         getCEs(data, errorCode);
         if(!encodeUniqueCEs(errorCode)) { return FALSE; }
@@ -154,14 +175,41 @@ CollationFastLatinBuilder::loadGroups(const CollationData &data, UErrorCode &err
 
     firstDigitPrimary = data.getFirstPrimaryForGroup(UCOL_REORDER_CODE_DIGIT);
     firstLatinPrimary = data.getFirstPrimaryForGroup(USCRIPT_LATIN);
-    lastLatinPrimary = data.getLastPrimaryForGroup(USCRIPT_LATIN);
-    if(firstDigitPrimary == 0 || firstLatinPrimary == 0) {
+    int32_t script = fastScript < 0 ? USCRIPT_LATIN : CollationFastScript::getScriptCode(fastScript);
+    firstScriptPrimary = data.getFirstPrimaryForGroup(script);
+    lastScriptPrimary = data.getLastPrimaryForGroup(script);
+    if(firstDigitPrimary == 0 || firstLatinPrimary == 0 || firstScriptPrimary == 0) {
         // missing data
         return FALSE;
     }
     return TRUE;
 }
 
+UChar32
+CollationFastLatinBuilder::getCharFromIndex(int32_t i) const {
+    if(fastScript < 0) {
+        if(i < CollationFastLatin::LATIN_LIMIT) {
+            return i;
+        }
+        return CollationFastLatin::PUNCT_START + (i - CollationFastLatin::LATIN_LIMIT);
+    }
+    if(i < CollationFastScript::PUNCT_INDEX) {
+        return i;
+    } else if(i < CollationFastScript::BLOCK_INDEX) {
+        return CollationFastLatin::PUNCT_START + (i - CollationFastScript::PUNCT_INDEX);
+    } else {
+        return CollationFastScript::getBlockStart(fastScript) + (i - CollationFastScript::BLOCK_INDEX);
+    }
+}
+
+int32_t
+CollationFastLatinBuilder::getCharIndex(UChar32 c) const {
+    if(fastScript < 0) {
+        return CollationFastLatin::getCharIndex((UChar)c);
+    }
+    return CollationFastScript::getCharIndex(fastScript, c);
+}
+
 UBool
 CollationFastLatinBuilder::inSameGroup(uint32_t p, uint32_t q) const {
     // Both or neither need to be encoded as short primaries,
@@ -204,13 +252,8 @@ CollationFastLatinBuilder::resetCEs() {
 void
 CollationFastLatinBuilder::getCEs(const CollationData &data, UErrorCode &errorCode) {
     if(U_FAILURE(errorCode)) { return; }
-    int32_t i = 0;
-    for(UChar c = 0;; ++i, ++c) {
-        if(c == CollationFastLatin::LATIN_LIMIT) {
-            c = CollationFastLatin::PUNCT_START;
-        } else if(c == CollationFastLatin::PUNCT_LIMIT) {
-            break;
-        }
+    for(int32_t i = 0; i < numChars; ++i) {
+        UChar32 c = getCharFromIndex(i);
         const CollationData *d;
         uint32_t ce32 = data.getCE32(c);
         if(ce32 == Collation::FALLBACK_CE32) {
@@ -303,8 +346,7 @@ CollationFastLatinBuilder::getCEsFromCE32(const CollationData &data, UChar32 c,
     // We do not support an ignorable ce0 unless it is completely ignorable.
     uint32_t p0 = (uint32_t)(ce0 >> 32);
     if(p0 == 0) { return FALSE; }
-    // We only support primaries up to the Latin script.
-    if(p0 > lastLatinPrimary) { return FALSE; }
+    if(!isSupportedPrimary(p0)) { return FALSE; }
     // We support non-common secondary and case weights only together with short primaries.
     uint32_t lower32_0 = (uint32_t)ce0;
     if(p0 < firstShortPrimary) {
@@ -321,6 +363,7 @@ CollationFastLatinBuilder::getCEsFromCE32(const CollationData &data, UChar32 c,
         // and determine for both whether they are variable.
         uint32_t p1 = (uint32_t)(ce1 >> 32);
         if(p1 == 0 ? p0 < firstShortPrimary : !inSameGroup(p0, p1)) { return FALSE; }
+        if(p1 != 0 && !isSupportedPrimary(p1)) { return FALSE; }
         uint32_t lower32_1 = (uint32_t)ce1;
         // No tertiary CEs.
         if((lower32_1 >> 16) == 0) { return FALSE; }
@@ -361,8 +404,8 @@ CollationFastLatinBuilder::getCEsFromContractionCE32(const CollationData &data,
     UCharsTrie::Iterator suffixes(p + 2, 0, errorCode);
     while(suffixes.next(errorCode)) {
         const UnicodeString &suffix = suffixes.getString();
-        int32_t x = CollationFastLatin::getCharIndex(suffix.charAt(0));
-        if(x < 0) { continue; }  // ignore anything but fast Latin text
+        int32_t x = getCharIndex(suffix.charAt(0));
+        if(x < 0) { continue; }  // ignore anything but characters in the table
         if(x == prevX) {
             if(addContraction) {
                 // Bail out for all contractions starting with this character.
@@ -565,11 +608,11 @@ UBool
 CollationFastLatinBuilder::encodeCharCEs(UErrorCode &errorCode) {
     if(U_FAILURE(errorCode)) { return FALSE; }
     int32_t miniCEsStart = result.length();
-    for(int32_t i = 0; i < CollationFastLatin::NUM_FAST_CHARS; ++i) {
+    for(int32_t i = 0; i < numChars; ++i) {
         result.append((UChar)0);  // initialize to completely ignorable
     }
     int32_t indexBase = result.length();
-    for(int32_t i = 0; i < CollationFastLatin::NUM_FAST_CHARS; ++i) {
+    for(int32_t i = 0; i < numChars; ++i) {
         int64_t ce = charCEs[i][0];
         if(isContractionCharCE(ce)) { continue; }  // defer contraction
         uint32_t miniCE = encodeTwoCEs(ce, charCEs[i][1]);
@@ -595,9 +638,9 @@ CollationFastLatinBuilder::encodeContractions(UErrorCode &errorCode) {
     // We encode all contraction lists so that the first word of a list
     // terminates the previous list, and we only need one additional terminator at the end.
     if(U_FAILURE(errorCode)) { return FALSE; }
-    int32_t indexBase = headerLength + CollationFastLatin::NUM_FAST_CHARS;
+    int32_t indexBase = headerLength + numChars;
     int32_t firstContractionIndex = result.length();
-    for(int32_t i = 0; i < CollationFastLatin::NUM_FAST_CHARS; ++i) {
+    for(int32_t i = 0; i < numChars; ++i) {
         int64_t ce = charCEs[i][0];
         if(!isContractionCharCE(ce)) { continue; }
         int32_t contractionIndex = result.length() - indexBase;
@@ -645,12 +688,9 @@ CollationFastLatinBuilder::encodeContractions(UErrorCode &errorCode) {
         printf(" %04x", result[i]);
     }
     printf("\n   char mini CEs");
-    U_ASSERT(CollationFastLatin::NUM_FAST_CHARS % 16 == 0);
+    U_ASSERT(numChars % 16 == 0);
     for(; i < indexBase; i += 16) {
-        UChar32 c = i - headerLength;
-        if(c >= CollationFastLatin::LATIN_LIMIT) {
-            c = CollationFastLatin::PUNCT_START + c - CollationFastLatin::LATIN_LIMIT;
-        }
+        UChar32 c = getCharFromIndex(i - headerLength);
         printf("\n %04x:", c);
         for(int32_t j = 0; j < 16; ++j) {
             printf(" %04x", result[i + j]);
@@ -36,6 +36,13 @@ class U_I18N_API CollationFastLatinBuilder : public UObject {
 
     UBool forData(const CollationData &data, UErrorCode &errorCode);
 
+    /**
+     * Builds a table for CollationFastScript:
+     * Only the special groups, digits and the given fast script
+     * get mini weights, for the characters of that fast-script table.
+     */
+    UBool forScript(const CollationData &data, int32_t fastScript, UErrorCode &errorCode);
+
     const uint16_t *getTable() const {
         return reinterpret_cast<const uint16_t *>(result.getBuffer());
     }
@@ -45,8 +52,21 @@ class U_I18N_API CollationFastLatinBuilder : public UObject {
     // space, punct, symbol, currency (not digit)
     enum { NUM_SPECIAL_GROUPS = UCOL_REORDER_CODE_CURRENCY - UCOL_REORDER_CODE_FIRST + 1 };
 
+    UBool build(const CollationData &data, UErrorCode &errorCode);
     UBool loadGroups(const CollationData &data, UErrorCode &errorCode);
     UBool inSameGroup(uint32_t p, uint32_t q) const;
+    /**
+     * We only support primaries before the Latin script (special groups & digits)
+     * and those of the table's script (Latin for the fast Latin table).
+     */
+    UBool isSupportedPrimary(uint32_t p) const {
+        return p < firstLatinPrimary || (firstScriptPrimary <= p && p <= lastScriptPrimary);
+    }
+
+    /** @return the character for a char index 0..numChars-1 */
+    UChar32 getCharFromIndex(int32_t i) const;
+    /** @return the char index for c, or -1 if c is not in the table */
+    int32_t getCharIndex(UChar32 c) const;
 
     void resetCEs();
     void getCEs(const CollationData &data, UErrorCode &errorCode);
@@ -71,6 +91,11 @@ class U_I18N_API CollationFastLatinBuilder : public UObject {
     // temporary "buffer"
     int64_t ce0, ce1;
 
+    // The script for which the table is built: -1 for fast Latin,
+    // otherwise a CollationFastScript script constant.
+    int32_t fastScript;
+    int32_t numChars;
+
     int64_t charCEs[CollationFastLatin::NUM_FAST_CHARS][2];
 
     UVector64 contractionCEs;
@@ -83,7 +108,9 @@ class U_I18N_API CollationFastLatinBuilder : public UObject {
     uint32_t lastSpecialPrimaries[NUM_SPECIAL_GROUPS];
     uint32_t firstDigitPrimary;
     uint32_t firstLatinPrimary;
-    uint32_t lastLatinPrimary;
+    // Latin for the fast Latin table.
+    uint32_t firstScriptPrimary;
+    uint32_t lastScriptPrimary;
     // This determines the first normal primary weight which is mapped to
     // a short mini primary. It must be >=firstDigitPrimary.
     uint32_t firstShortPrimary;
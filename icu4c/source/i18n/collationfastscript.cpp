@@ -0,0 +1,490 @@
+// © 2019 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+/*
+*******************************************************************************
+* collationfastscript.cpp
+*
+* created on: 2019dec02
+*/
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_COLLATION
+
+#include "unicode/ucol.h"
+#include "unicode/uscript.h"
+#include "collationdata.h"
+#include "collationfastlatin.h"
+#include "collationfastlatinbuilder.h"
+#include "collationfastscript.h"
+#include "collationsettings.h"
+#include "uassert.h"
+
+U_NAMESPACE_BEGIN
+
+namespace {
+
+// Special return values of nextCharIndex() for characters that are not in the table.
+const int32_t UNSUPPORTED_INDEX = -1;
+const int32_t U_FFFE_INDEX = -2;
+const int32_t U_FFFF_INDEX = -3;
+
+inline int32_t
+nextCharIndex(int32_t script, const UChar *s, int32_t &sIndex, int32_t /*sLength*/) {
+    UChar32 c = s[sIndex++];
+    int32_t x = CollationFastScript::getCharIndex(script, c);
+    if(x < 0) {
+        if(c == 0xfffe) {
+            x = U_FFFE_INDEX;
+        } else if(c == 0xffff) {
+            x = U_FFFF_INDEX;
+        }
+    }
+    return x;
+}
+
+inline int32_t
+nextCharIndex(int32_t script, const uint8_t *s, int32_t &sIndex, int32_t sLength) {
+    UChar32 c = s[sIndex++];
+    if(c <= 0x7f) {
+        return c;
+    }
+    uint8_t t;
+    if(c <= 0xdf && 0xc2 <= c && sIndex != sLength &&
+            0x80 <= (t = s[sIndex]) && t <= 0xbf) {
+        ++sIndex;
+        return CollationFastScript::getCharIndex(script, ((c & 0x1f) << 6) | (t & 0x3f));
+    }
+    int32_t i2 = sIndex + 1;
+    if(i2 < sLength || sLength < 0) {
+        // With NUL-termination, s[sIndex] is read before s[i2],
+        // so that we do not read past a NUL.
+        if(c == 0xe2 && s[sIndex] == 0x80 && 0x80 <= (t = s[i2]) && t <= 0xbf) {
+            sIndex += 2;
+            return CollationFastScript::PUNCT_INDEX + (t - 0x80);  // U+2000..U+203F
+        } else if(c == 0xef && s[sIndex] == 0xbf && ((t = s[i2]) == 0xbe || t == 0xbf)) {
+            sIndex += 2;
+            return t == 0xbe ? U_FFFE_INDEX : U_FFFF_INDEX;
+        }
+    }
+    return UNSUPPORTED_INDEX;
+}
+
+}  // namespace
+
+int32_t
+CollationFastScript::getScriptCode(int32_t script) {
+    return script == GREEK ? USCRIPT_GREEK : USCRIPT_CYRILLIC;
+}
+
+int32_t
+CollationFastScript::getScriptFromUTF8Lead(uint8_t lead) {
+    // U+0340..U+03FF and U+0400..U+047F.
+    // This only chooses a table; the compare functions check each character.
+    if(lead < 0xcd || 0xd1 < lead) {
+        return -1;
+    } else if(lead < 0xd0) {
+        return GREEK;
+    } else {
+        return CYRILLIC;
+    }
+}
+
+void
+CollationFastScript::getOptions(const CollationData *data, const CollationSettings &settings,
+                                int32_t *options, int32_t capacity) {
+    U_ASSERT(capacity == NUM_SCRIPTS);
+    for(int32_t script = 0; script < capacity; ++script) {
+        options[script] = -1;
+    }
+    if(capacity != NUM_SCRIPTS) { return; }
+    if((settings.options & CollationSettings::NUMERIC) != 0) {
+        // Numeric collation would need special handling of digits.
+        return;
+    }
+
+    // The mini primaries are in the order of the groups in a table:
+    // special groups, digits, then the table's script.
+    // Only a reordering which keeps that order is supported.
+    uint32_t prevStart = 0;
+    if(settings.hasReordering()) {
+        for(int32_t group = UCOL_REORDER_CODE_FIRST;
+                group < UCOL_REORDER_CODE_FIRST + CollationData::MAX_NUM_SPECIAL_REORDER_CODES;
+                ++group) {
+            uint32_t start = data->getFirstPrimaryForGroup(group);
+            start = settings.reorder(start);
+            if(start != 0) {
+                if(start < prevStart) { return; }
+                prevStart = start;
+            }
+        }
+    }
+    for(int32_t script = 0; script < NUM_SCRIPTS; ++script) {
+        uint32_t scriptStart = data->getFirstPrimaryForGroup(getScriptCode(script));
+        if(scriptStart == 0) { continue; }
+        if(settings.hasReordering()) {
+            scriptStart = settings.reorder(scriptStart);
+        }
+        if(scriptStart >= prevStart) {
+            options[script] = settings.options;
+        }
+    }
+}
+
+int32_t
+CollationFastScript::compareUTF16(const uint16_t *table, int32_t script, int32_t options,
+                                  const UChar *left, int32_t leftLength,
+                                  const UChar *right, int32_t rightLength) {
+    return compare(table, script, options, left, leftLength, right, rightLength);
+}
+
+int32_t
+CollationFastScript::compareUTF8(const uint16_t *table, int32_t script, int32_t options,
+                                 const uint8_t *left, int32_t leftLength,
+                                 const uint8_t *right, int32_t rightLength) {
+    return compare(table, script, options, left, leftLength, right, rightLength);
+}
+
+template<typename CharType>
+int32_t
+CollationFastScript::compare(const uint16_t *table, int32_t script, int32_t options,
+                             const CharType *left, int32_t leftLength,
+                             const CharType *right, int32_t rightLength) {
+    // This follows CollationFastLatin::compareUTF16() but without its
+    // per-character shortcuts, which depend on the fast Latin character ranges.
+    // Keep them in sync!
+    typedef CollationFastLatin FL;
+
+    U_ASSERT((table[0] >> 8) == FL::VERSION);
+    uint32_t variableTop;
+    if((options & CollationSettings::ALTERNATE_MASK) == 0) {
+        // No mini primaries are variable, set a variableTop just below the
+        // lowest long mini primary.
+        variableTop = FL::MIN_LONG - 1;
+    } else {
+        int32_t headerLength = table[0] & 0xff;
+        int32_t i = 1 + ((options & CollationSettings::MAX_VARIABLE_MASK) >>
+                         CollationSettings::MAX_VARIABLE_SHIFT);
+        if(i >= headerLength) {
+            return FL::BAIL_OUT_RESULT;  // variableTop >= digits, should not occur
+        }
+        variableTop = table[i];
+    }
+    table += (table[0] & 0xff);  // skip the header
+
+    // Check for supported characters, fetch mini CEs, and compare primaries.
+    int32_t leftIndex = 0, rightIndex = 0;
+    /**
+     * Single mini CE or a pair.
+     * The current mini CE is in the lower 16 bits, the next one is in the upper 16 bits.
+     * If there is only one, then it is in the lower bits, and the upper bits are 0.
+     */
+    uint32_t leftPair = 0, rightPair = 0;
+    for(;;) {
+        // We fetch CEs until we get a non-ignorable primary or reach the end.
+        while(leftPair == 0) {
+            if(leftIndex == leftLength) {
+                leftPair = FL::EOS;
+                break;
+            }
+            leftPair = nextPair(table, script, left, leftIndex, leftLength);
+            if(leftPair == FL::BAIL_OUT) { return FL::BAIL_OUT_RESULT; }
+            leftPair = FL::getPrimaries(variableTop, leftPair);
+        }
+
+        while(rightPair == 0) {
+            if(rightIndex == rightLength) {
+                rightPair = FL::EOS;
+                break;
+            }
+            rightPair = nextPair(table, script, right, rightIndex, rightLength);
+            if(rightPair == FL::BAIL_OUT) { return FL::BAIL_OUT_RESULT; }
+            rightPair = FL::getPrimaries(variableTop, rightPair);
+        }
+
+        if(leftPair == rightPair) {
+            if(leftPair == FL::EOS) { break; }
+            leftPair = rightPair = 0;
+            continue;
+        }
+        uint32_t leftPrimary = leftPair & 0xffff;
+        uint32_t rightPrimary = rightPair & 0xffff;
+        if(leftPrimary != rightPrimary) {
+            // Return the primary difference.
+            return (leftPrimary < rightPrimary) ? UCOL_LESS : UCOL_GREATER;
+        }
+        if(leftPair == FL::EOS) { break; }
+        leftPair >>= 16;
+        rightPair >>= 16;
+    }
+    // In the following, we need to re-fetch each character because we did not buffer the CEs,
+    // but we know that the string is well-formed and
+    // only contains supported characters and mappings.
+
+    // We might skip the secondary level but continue with the case level
+    // which is turned on separately.
+    if(CollationSettings::getStrength(options) >= UCOL_SECONDARY) {
+        leftIndex = rightIndex = 0;
+        leftPair = rightPair = 0;
+        for(;;) {
+            while(leftPair == 0) {
+                if(leftIndex == leftLength) {
+                    leftPair = FL::EOS;
+                    break;
+                }
+                leftPair = nextPair(table, script, left, leftIndex, leftLength);
+                leftPair = FL::getSecondaries(variableTop, leftPair);
+            }
+
+            while(rightPair == 0) {
+                if(rightIndex == rightLength) {
+                    rightPair = FL::EOS;
+                    break;
+                }
+                rightPair = nextPair(table, script, right, rightIndex, rightLength);
+                rightPair = FL::getSecondaries(variableTop, rightPair);
+            }
+
+            if(leftPair == rightPair) {
+                if(leftPair == FL::EOS) { break; }
+                leftPair = rightPair = 0;
+                continue;
+            }
+            uint32_t leftSecondary = leftPair & 0xffff;
+            uint32_t rightSecondary = rightPair & 0xffff;
+            if(leftSecondary != rightSecondary) {
+                if((options & CollationSettings::BACKWARD_SECONDARY) != 0) {
+                    // Full support for backwards secondary requires backwards contraction matching
+                    // and moving backwards between merge separators.
+                    return FL::BAIL_OUT_RESULT;
+                }
+                return (leftSecondary < rightSecondary) ? UCOL_LESS : UCOL_GREATER;
+            }
+            if(leftPair == FL::EOS) { break; }
+            leftPair >>= 16;
+            rightPair >>= 16;
+        }
+    }
+
+    if((options & CollationSettings::CASE_LEVEL) != 0) {
+        UBool strengthIsPrimary = CollationSettings::getStrength(options) == UCOL_PRIMARY;
+        leftIndex = rightIndex = 0;
+        leftPair = rightPair = 0;
+        for(;;) {
+            while(leftPair == 0) {
+                if(leftIndex == leftLength) {
+                    leftPair = FL::EOS;
+                    break;
+                }
+                leftPair = nextPair(table, script, left, leftIndex, leftLength);
+                leftPair = FL::getCases(variableTop, strengthIsPrimary, leftPair);
+            }
+
+            while(rightPair == 0) {
+                if(rightIndex == rightLength) {
+                    rightPair = FL::EOS;
+                    break;
+                }
+                rightPair = nextPair(table, script, right, rightIndex, rightLength);
+                rightPair = FL::getCases(variableTop, strengthIsPrimary, rightPair);
+            }
+
+            if(leftPair == rightPair) {
+                if(leftPair == FL::EOS) { break; }
+                leftPair = rightPair = 0;
+                continue;
+            }
+            uint32_t leftCase = leftPair & 0xffff;
+            uint32_t rightCase = rightPair & 0xffff;
+            if(leftCase != rightCase) {
+                if((options & CollationSettings::UPPER_FIRST) == 0) {
+                    return (leftCase < rightCase) ? UCOL_LESS : UCOL_GREATER;
+                } else {
+                    return (leftCase < rightCase) ? UCOL_GREATER : UCOL_LESS;
+                }
+            }
+            if(leftPair == FL::EOS) { break; }
+            leftPair >>= 16;
+            rightPair >>= 16;
+        }
+    }
+    if(CollationSettings::getStrength(options) <= UCOL_SECONDARY) { return UCOL_EQUAL; }
+
+    // Remove the case bits from the tertiary weight when caseLevel is on or caseFirst is off.
+    UBool withCaseBits = CollationSettings::isTertiaryWithCaseBits(options);
+
+    leftIndex = rightIndex = 0;
+    leftPair = rightPair = 0;
+    for(;;) {
+        while(leftPair == 0) {
+            if(leftIndex == leftLength) {
+                leftPair = FL::EOS;
+                break;
+            }
+            leftPair = nextPair(table, script, left, leftIndex, leftLength);
+            leftPair = FL::getTertiaries(variableTop, withCaseBits, leftPair);
+        }
+
+        while(rightPair == 0) {
+            if(rightIndex == rightLength) {
+                rightPair = FL::EOS;
+                break;
+            }
+            rightPair = nextPair(table, script, right, rightIndex, rightLength);
+            rightPair = FL::getTertiaries(variableTop, withCaseBits, rightPair);
+        }
+
+        if(leftPair == rightPair) {
+            if(leftPair == FL::EOS) { break; }
+            leftPair = rightPair = 0;
+            continue;
+        }
+        uint32_t leftTertiary = leftPair & 0xffff;
+        uint32_t rightTertiary = rightPair & 0xffff;
+        if(leftTertiary != rightTertiary) {
+            if(CollationSettings::sortsTertiaryUpperCaseFirst(options)) {
+                // Pass through EOS and MERGE_WEIGHT
+                // and keep real tertiary weights larger than the MERGE_WEIGHT.
+                // Tertiary CEs (secondary ignorables) are not supported in fast tables.
+                if(leftTertiary > FL::MERGE_WEIGHT) {
+                    leftTertiary ^= FL::CASE_MASK;
+                }
+                if(rightTertiary > FL::MERGE_WEIGHT) {
+                    rightTertiary ^= FL::CASE_MASK;
+                }
+            }
+            return (leftTertiary < rightTertiary) ? UCOL_LESS : UCOL_GREATER;
+        }
+        if(leftPair == FL::EOS) { break; }
+        leftPair >>= 16;
+        rightPair >>= 16;
+    }
+    if(CollationSettings::getStrength(options) <= UCOL_TERTIARY) { return UCOL_EQUAL; }
+
+    leftIndex = rightIndex = 0;
+    leftPair = rightPair = 0;
+    for(;;) {
+        while(leftPair == 0) {
+            if(leftIndex == leftLength) {
+                leftPair = FL::EOS;
+                break;
+            }
+            leftPair = nextPair(table, script, left, leftIndex, leftLength);
+            leftPair = FL::getQuaternaries(variableTop, leftPair);
+        }
+
+        while(rightPair == 0) {
+            if(rightIndex == rightLength) {
+                rightPair = FL::EOS;
+                break;
+            }
+            rightPair = nextPair(table, script, right, rightIndex, rightLength);
+            rightPair = FL::getQuaternaries(variableTop, rightPair);
+        }
+
+        if(leftPair == rightPair) {
+            if(leftPair == FL::EOS) { break; }
+            leftPair = rightPair = 0;
+            continue;
+        }
+        uint32_t leftQuaternary = leftPair & 0xffff;
+        uint32_t rightQuaternary = rightPair & 0xffff;
+        if(leftQuaternary != rightQuaternary) {
+            return (leftQuaternary < rightQuaternary) ? UCOL_LESS : UCOL_GREATER;
+        }
+        if(leftPair == FL::EOS) { break; }
+        leftPair >>= 16;
+        rightPair >>= 16;
+    }
+    return UCOL_EQUAL;
+}
+
+template<typename CharType>
+uint32_t
+CollationFastScript::nextPair(const uint16_t *table, int32_t script,
+                              const CharType *s, int32_t &sIndex, int32_t &sLength) {
+    typedef CollationFastLatin FL;
+
+    int32_t x = nextCharIndex(script, s, sIndex, sLength);
+    uint32_t ce;
+    if(x >= 0) {
+        ce = table[x];
+    } else if(x == UNSUPPORTED_INDEX) {
+        return FL::BAIL_OUT;
+    } else if(x == U_FFFE_INDEX) {
+        return FL::MERGE_WEIGHT;
+    } else {
+        return FL::MAX_SHORT | FL::COMMON_SEC | FL::LOWER_CASE | FL::COMMON_TER;  // U+FFFF
+    }
+    if(ce >= FL::MIN_LONG || ce < FL::CONTRACTION) {
+        return ce;  // simple or special mini CE
+    } else if(ce >= FL::EXPANSION) {
+        int32_t index = getNumChars(script) + (ce & FL::INDEX_MASK);
+        return ((uint32_t)table[index + 1] << 16) | table[index];
+    } else /* ce >= CONTRACTION */ {
+        if(x == 0 && sLength < 0) {
+            // U+0000 is always one code unit.
+            sLength = sIndex - 1;
+            return FL::EOS;
+        }
+        // Contraction list: Default mapping followed by
+        // 0 or more single-character contraction suffix mappings.
+        int32_t index = getNumChars(script) + (ce & FL::INDEX_MASK);
+        if(sIndex != sLength) {
+            // Read the next character.
+            int32_t nextIndex = sIndex;
+            int32_t x2 = nextCharIndex(script, s, nextIndex, sLength);
+            if(x2 == UNSUPPORTED_INDEX) {
+                return FL::BAIL_OUT;
+            } else if(x2 < 0) {
+                x2 = -1;  // U+FFFE & U+FFFF cannot occur in contractions.
+            } else if(x2 == 0 && sLength < 0) {
+                sLength = sIndex;
+                x2 = -1;
+            }
+            // Look for the next character in the contraction suffix list,
+            // which is in ascending order of single suffix characters.
+            int32_t i = index;
+            int32_t head = table[i];  // first skip the default mapping
+            int32_t contrX;
+            do {
+                i += head >> FL::CONTR_LENGTH_SHIFT;
+                head = table[i];
+                contrX = head & FL::CONTR_CHAR_MASK;
+            } while(contrX < x2);
+            if(contrX == x2) {
+                index = i;
+                sIndex = nextIndex;
+            }
+        }
+        // Return the CE or CEs for the default or contraction mapping.
+        int32_t length = table[index] >> FL::CONTR_LENGTH_SHIFT;
+        if(length == 1) {
+            return FL::BAIL_OUT;
+        }
+        ce = table[index + 1];
+        if(length == 2) {
+            return ce;
+        } else {
+            return ((uint32_t)table[index + 2] << 16) | ce;
+        }
+    }
+}
+
+CollationFastScriptTables::CollationFastScriptTables(const CollationData &data,
+                                                     UErrorCode &errorCode) {
+    for(int32_t script = 0; script < CollationFastScript::NUM_SCRIPTS; ++script) {
+        CollationFastLatinBuilder builder(errorCode);
+        if(builder.forScript(data, script, errorCode)) {
+            tables[script].setTo(reinterpret_cast<const UChar *>(builder.getTable()),
+                                 builder.lengthOfTable());
+        }
+        if(U_FAILURE(errorCode)) { return; }
+    }
+}
+
+CollationFastScriptTables::~CollationFastScriptTables() {}
+
+U_NAMESPACE_END
+
+#endif  // !UCONFIG_NO_COLLATION
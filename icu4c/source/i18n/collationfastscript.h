@@ -0,0 +1,179 @@
+// © 2019 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+/*
+*******************************************************************************
+* collationfastscript.h
+*
+* created on: 2019dec02
+*/
+
+#ifndef __COLLATIONFASTSCRIPT_H__
+#define __COLLATIONFASTSCRIPT_H__
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_COLLATION
+
+#include "unicode/uobject.h"
+#include "unicode/unistr.h"
+#include "collationfastlatin.h"
+
+U_NAMESPACE_BEGIN
+
+struct CollationData;
+struct CollationSettings;
+
+/**
+ * Collation fastpath for text in one of a few small non-Latin scripts.
+ *
+ * This uses tables in the CollationFastLatin format, with the same mini CEs and
+ * the same two-pass primary/secondary/tertiary scheme,
+ * but for a different set of characters:
+ * ASCII, U+2000..U+203F, and one script block (see getCharIndex()).
+ * A table has its own mini weights, so that the letters of its script get
+ * short mini primaries. Characters with weights outside the special groups,
+ * digits and the table's script (for example, ASCII letters) bail out.
+ *
+ * The tables are not stored in the collation data but
+ * built at runtime from it, on first use; see CollationFastScriptTables.
+ */
+class U_I18N_API CollationFastScript /* all static */ {
+public:
+    /** Greek and Coptic block U+0370..U+03FF. */
+    static const int32_t GREEK = 0;
+    /** Cyrillic letters U+0400..U+045F. */
+    static const int32_t CYRILLIC = 1;
+    static const int32_t NUM_SCRIPTS = 2;
+
+    static const UChar32 GREEK_START = 0x370;
+    static const UChar32 GREEK_LIMIT = 0x400;
+    static const UChar32 CYRILLIC_START = 0x400;
+    static const UChar32 CYRILLIC_LIMIT = 0x460;
+
+    static const int32_t ASCII_LIMIT = 0x80;
+    /** Char index of U+2000. */
+    static const int32_t PUNCT_INDEX = ASCII_LIMIT;
+    /** Char index of the first character of the script block. */
+    static const int32_t BLOCK_INDEX =
+            PUNCT_INDEX + (CollationFastLatin::PUNCT_LIMIT - CollationFastLatin::PUNCT_START);
+    static const int32_t MAX_NUM_CHARS = BLOCK_INDEX + (GREEK_LIMIT - GREEK_START);
+
+    /**
+     * Returns the fast script whose block contains c, or -1 if none.
+     */
+    static inline int32_t getScript(UChar32 c) {
+        if(c < GREEK_START || CYRILLIC_LIMIT <= c) {
+            return -1;
+        } else if(c < CYRILLIC_START) {
+            return GREEK;
+        } else {
+            return CYRILLIC;
+        }
+    }
+
+    static inline UChar32 getBlockStart(int32_t script) {
+        return script == GREEK ? GREEK_START : CYRILLIC_START;
+    }
+
+    static inline int32_t getBlockLength(int32_t script) {
+        return script == GREEK ? GREEK_LIMIT - GREEK_START : CYRILLIC_LIMIT - CYRILLIC_START;
+    }
+
+    /**
+     * Returns the fast script for a UTF-8 lead byte, or -1 if none.
+     * This only chooses the table to try for a string.
+     */
+    static int32_t getScriptFromUTF8Lead(uint8_t lead);
+
+    /** @return the USCRIPT_ code of the fast script */
+    static int32_t getScriptCode(int32_t script);
+
+    /** @return the number of characters in the table of the fast script */
+    static inline int32_t getNumChars(int32_t script) {
+        return BLOCK_INDEX + getBlockLength(script);
+    }
+
+    /**
+     * Returns the table index of c for the fast script, or -1 if c is not in the table.
+     * Note: U+FFFE & U+FFFF are forbidden in tailorings
+     * and thus do not occur in any contractions.
+     */
+    static inline int32_t getCharIndex(int32_t script, UChar32 c) {
+        if(c < ASCII_LIMIT) {
+            return c;
+        }
+        UChar32 blockStart = getBlockStart(script);
+        if((uint32_t)(c - blockStart) < (uint32_t)getBlockLength(script)) {
+            return BLOCK_INDEX + (c - blockStart);
+        } else if(CollationFastLatin::PUNCT_START <= c && c < CollationFastLatin::PUNCT_LIMIT) {
+            return PUNCT_INDEX + (c - CollationFastLatin::PUNCT_START);
+        } else {
+            return -1;
+        }
+    }
+
+    /**
+     * Computes the options values for the compare functions, one per fast script.
+     * A value is -1 if the fastpath is not supported for that script and the settings.
+     * The capacity must be NUM_SCRIPTS.
+     */
+    static void getOptions(const CollationData *data, const CollationSettings &settings,
+                           int32_t *options, int32_t capacity);
+
+    /**
+     * Compares two strings with the table for the fast script.
+     * The options value must be the script's CollationSettings::fastScriptOptions.
+     * Returns CollationFastLatin::BAIL_OUT_RESULT if the strings
+     * cannot be compared with the table.
+     */
+    static int32_t compareUTF16(const uint16_t *table, int32_t script, int32_t options,
+                                const UChar *left, int32_t leftLength,
+                                const UChar *right, int32_t rightLength);
+
+    static int32_t compareUTF8(const uint16_t *table, int32_t script, int32_t options,
+                               const uint8_t *left, int32_t leftLength,
+                               const uint8_t *right, int32_t rightLength);
+
+private:
+    template<typename CharType>
+    static int32_t compare(const uint16_t *table, int32_t script, int32_t options,
+                           const CharType *left, int32_t leftLength,
+                           const CharType *right, int32_t rightLength);
+
+    template<typename CharType>
+    static uint32_t nextPair(const uint16_t *table, int32_t script,
+                             const CharType *s, int32_t &sIndex, int32_t &sLength);
+
+    CollationFastScript();  // no constructor
+};
+
+/**
+ * The fast-script tables for one CollationData.
+ * Built once per CollationTailoring, on first use.
+ */
+class U_I18N_API CollationFastScriptTables : public UMemory {
+public:
+    /**
+     * Builds a table for each fast script.
+     * A script's table is empty if the data does not support the fastpath for it.
+     */
+    CollationFastScriptTables(const CollationData &data, UErrorCode &errorCode);
+    ~CollationFastScriptTables();
+
+    /** @return the table for the fast script, or NULL if there is none */
+    const uint16_t *getTable(int32_t script) const {
+        return tables[script].isEmpty() ? NULL :
+            reinterpret_cast<const uint16_t *>(tables[script].getBuffer());
+    }
+
+private:
+    CollationFastScriptTables(const CollationFastScriptTables &);  // not implemented
+    CollationFastScriptTables &operator=(const CollationFastScriptTables &);  // not implemented
+
+    UnicodeString tables[CollationFastScript::NUM_SCRIPTS];
+};
+
+U_NAMESPACE_END
+
+#endif  // !UCONFIG_NO_COLLATION
+#endif  // __COLLATIONFASTSCRIPT_H__
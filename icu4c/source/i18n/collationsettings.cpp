@@ -40,6 +40,7 @@ CollationSettings::CollationSettings(const CollationSettings &other)
     if(fastLatinOptions >= 0) {
         uprv_memcpy(fastLatinPrimaries, other.fastLatinPrimaries, sizeof(fastLatinPrimaries));
     }
+    uprv_memcpy(fastScriptOptions, other.fastScriptOptions, sizeof(fastScriptOptions));
 }
 
 CollationSettings::~CollationSettings() {
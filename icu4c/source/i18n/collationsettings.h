@@ -20,6 +20,7 @@
 
 #include "unicode/ucol.h"
 #include "collation.h"
+#include "collationfastscript.h"
 #include "sharedobject.h"
 #include "umutex.h"
 
@@ -110,7 +111,11 @@ struct U_I18N_API CollationSettings : public SharedObject {
               minHighNoReorder(0),
               reorderRanges(NULL), reorderRangesLength(0),
               reorderCodes(NULL), reorderCodesLength(0), reorderCodesCapacity(0),
-              fastLatinOptions(-1) {}
+              fastLatinOptions(-1) {
+        for(int32_t i = 0; i < CollationFastScript::NUM_SCRIPTS; ++i) {
+            fastScriptOptions[i] = -1;
+        }
+    }
 
     CollationSettings(const CollationSettings &other);
     virtual ~CollationSettings();
@@ -260,6 +265,8 @@ struct U_I18N_API CollationSettings : public SharedObject {
     /** Options for CollationFastLatin. Negative if disabled. */
     int32_t fastLatinOptions;
     uint16_t fastLatinPrimaries[0x180];
+    /** Options for CollationFastScript, per fast script. Negative if disabled. */
+    int32_t fastScriptOptions[CollationFastScript::NUM_SCRIPTS];
 
 private:
     void setReorderArrays(const int32_t *codes, int32_t codesLength,
@@ -22,6 +22,7 @@
 #include "unicode/uvernum.h"
 #include "cmemory.h"
 #include "collationdata.h"
+#include "collationfastscript.h"
 #include "collationsettings.h"
 #include "collationtailoring.h"
 #include "normalizer2impl.h"
@@ -38,7 +39,7 @@ CollationTailoring::CollationTailoring(const CollationSettings *baseSettings)
           ownedData(NULL),
           builder(NULL), memory(NULL), bundle(NULL),
           trie(NULL), unsafeBackwardSet(NULL),
-          maxExpansions(NULL) {
+          maxExpansions(NULL), fastScriptTables(NULL) {
     if(baseSettings != NULL) {
         U_ASSERT(baseSettings->reorderCodesLength == 0);
         U_ASSERT(baseSettings->reorderTable == NULL);
@@ -52,6 +53,7 @@ CollationTailoring::CollationTailoring(const CollationSettings *baseSettings)
     rules.getTerminatedBuffer();  // ensure NUL-termination
     version[0] = version[1] = version[2] = version[3] = 0;
     maxExpansionsInitOnce.reset();
+    fastScriptTablesInitOnce.reset();
 }
 
 CollationTailoring::~CollationTailoring() {
@@ -64,6 +66,8 @@ CollationTailoring::~CollationTailoring() {
     delete unsafeBackwardSet;
     uhash_close(maxExpansions);
     maxExpansionsInitOnce.reset();
+    delete fastScriptTables;
+    fastScriptTablesInitOnce.reset();
 }
 
 UBool
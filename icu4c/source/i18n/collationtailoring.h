@@ -32,6 +32,7 @@ struct UTrie2;
 U_NAMESPACE_BEGIN
 
 struct CollationData;
+class CollationFastScriptTables;
 
 class UnicodeSet;
 
@@ -83,6 +84,8 @@ struct U_I18N_API CollationTailoring : public SharedObject {
     UnicodeSet *unsafeBackwardSet;
     mutable UHashtable *maxExpansions;
     mutable UInitOnce maxExpansionsInitOnce;
+    mutable CollationFastScriptTables *fastScriptTables;
+    mutable UInitOnce fastScriptTablesInitOnce;
 
 private:
     /**
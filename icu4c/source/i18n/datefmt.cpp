@@ -58,6 +58,11 @@ class U_I18N_API DateFmtBestPattern : public SharedObject {
 DateFmtBestPattern::~DateFmtBestPattern() {
 }
 
+template<> U_I18N_API
+const char *CacheKey<DateFmtBestPattern>::getValueTypeName() const {
+    return "DateFmtBestPattern";
+}
+
 template<> U_I18N_API
 const DateFmtBestPattern *LocaleCacheKey<DateFmtBestPattern>::createObject(
         const void * /*creationContext*/, UErrorCode &status) const {
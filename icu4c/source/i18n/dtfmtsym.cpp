@@ -172,6 +172,11 @@ U_NAMESPACE_BEGIN
 SharedDateFormatSymbols::~SharedDateFormatSymbols() {
 }
 
+template<> U_I18N_API
+const char *CacheKey<SharedDateFormatSymbols>::getValueTypeName() const {
+    return "SharedDateFormatSymbols";
+}
+
 template<> U_I18N_API
 const SharedDateFormatSymbols *
         LocaleCacheKey<SharedDateFormatSymbols>::createObject(
@@ -236,6 +236,11 @@ static NumericDateFormatters *loadNumericDateFormatters(
     return result;
 }
 
+template<> U_I18N_API
+const char *CacheKey<MeasureFormatCacheData>::getValueTypeName() const {
+    return "MeasureFormatCacheData";
+}
+
 template<> U_I18N_API
 const MeasureFormatCacheData *LocaleCacheKey<MeasureFormatCacheData>::createObject(
         const void * /*unused*/, UErrorCode &status) const {
@@ -1254,6 +1254,11 @@ static void U_CALLCONV nscacheInit() {
     uhash_setValueDeleter(NumberingSystem_cache, deleteNumberingSystem);
 }
 
+template<> U_I18N_API
+const char *CacheKey<SharedNumberFormat>::getValueTypeName() const {
+    return "SharedNumberFormat";
+}
+
 template<> U_I18N_API
 const SharedNumberFormat *LocaleCacheKey<SharedNumberFormat>::createObject(
         const void * /*unused*/, UErrorCode &status) const {
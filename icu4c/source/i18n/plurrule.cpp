@@ -161,6 +161,11 @@ PluralRules::createDefaultRules(UErrorCode& status) {
 /******************************************************************************/
 /* Create PluralRules cache */
 
+template<> U_I18N_API
+const char *CacheKey<SharedPluralRules>::getValueTypeName() const {
+    return "SharedPluralRules";
+}
+
 template<> U_I18N_API
 const SharedPluralRules *LocaleCacheKey<SharedPluralRules>::createObject(
         const void * /*unused*/, UErrorCode &status) const {
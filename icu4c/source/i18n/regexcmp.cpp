@@ -319,6 +319,16 @@ void    RegexCompile::compile(
     //
     matchStartType();
 
+    //
+    // Optimization pass 3: a literal string that find() can search for
+    //
+    requiredString();
+
+    //
+    // Optimization pass 4: rows in the matcher's memo of explored backtracking states
+    //
+    assignMemoSlots();
+
     //
     // Set up fast latin-1 range sets
     //
@@ -3188,6 +3198,385 @@ void   RegexCompile::matchStartType() {
 
 
 
+//------------------------------------------------------------------------------
+//
+//   requiredString    Find a literal string that every match of the pattern
+//                     contains, with bounds on its offset from the start of the
+//                     match, so that find() can search for it instead of trying
+//                     a match at every position.
+//
+//                     An op is on every path through the pattern if no jump,
+//                     state save or loop passes over it or repeats it.  The
+//                     longest run of such literal ops, not counting capture
+//                     parentheses between them, is the required string.
+//
+//                     Look-around can examine text outside of the match; patterns
+//                     using it get no required string.
+//
+//------------------------------------------------------------------------------
+void   RegexCompile::requiredString() {
+    if (U_FAILURE(*fStatus)) {
+        return;
+    }
+
+    UVector64 *pat = fRXPat->fCompiledPat;
+    int32_t    end = pat->size();
+    int32_t    loc;
+    int32_t    op;
+
+    // crossings, after summing from the start, holds the number of branches that
+    //   can skip or repeat the op at each location.
+    UVector32  crossings(end+1, *fStatus);
+    crossings.setSize(end+1);
+    if (U_FAILURE(*fStatus)) {
+        return;
+    }
+    for (loc = 3; loc < end; loc++) {
+        op = (int32_t)pat->elementAti(loc);
+        int32_t from = loc;
+        int32_t to   = -1;
+        switch (URX_TYPE(op)) {
+        case URX_STATE_SAVE:
+        case URX_JMP:
+        case URX_JMP_SAV:
+        case URX_JMP_SAV_X:
+        case URX_CTR_LOOP:
+        case URX_CTR_LOOP_NG:
+            to = URX_VAL(op);
+            break;
+
+        case URX_JMPX:
+            to = URX_VAL(op);
+            loc++;
+            break;
+
+        case URX_CTR_INIT:
+        case URX_CTR_INIT_NG:
+            // A counted loop with a minimum of zero skips to its end.
+            to = URX_VAL(pat->elementAti(loc+1));
+            loc += 3;
+            break;
+
+        case URX_STRING:
+        case URX_STRING_I:
+            loc++;
+            break;
+
+        case URX_LA_START:
+        case URX_LB_START:
+            return;
+
+        default:
+            break;
+        }
+        if (to < 0) {
+            continue;
+        }
+        int32_t first = to > from ? from + 1 : to;      // The locations passed over or repeated.
+        int32_t last  = to > from ? to - 1   : from;
+        if (first <= last) {
+            crossings.setElementAt(crossings.elementAti(first) + 1, first);
+            crossings.setElementAt(crossings.elementAti(last + 1) - 1, last + 1);
+        }
+    }
+
+    UnicodeString run;
+    int32_t       runLoc   = -1;
+    UnicodeString required;
+    int32_t       requiredLoc = -1;
+    int32_t       crossed  = 0;
+    for (loc = 3; loc <= end; loc++) {
+        crossed += crossings.elementAti(loc);
+        op = loc < end ? (int32_t)pat->elementAti(loc) : 0;
+        int32_t opType = loc < end ? URX_TYPE(op) : (int32_t)URX_END;
+        if (crossed == 0 && opType == URX_ONECHAR) {
+            if (run.isEmpty()) {
+                runLoc = loc;
+            }
+            run.append((UChar32)URX_VAL(op));
+            continue;
+        }
+        if (crossed == 0 && opType == URX_STRING) {
+            if (run.isEmpty()) {
+                runLoc = loc;
+            }
+            loc++;
+            crossed += crossings.elementAti(loc);
+            run.append(fRXPat->fLiteralText, URX_VAL(op), URX_VAL(pat->elementAti(loc)));
+            continue;
+        }
+        if (crossed == 0 &&
+                (opType == URX_START_CAPTURE || opType == URX_END_CAPTURE || opType == URX_NOP)) {
+            continue;
+        }
+        if (run.length() > required.length()) {
+            required    = run;
+            requiredLoc = runLoc;
+        }
+        run.remove();
+        if (opType == URX_STRING || opType == URX_STRING_I || opType == URX_JMPX) {
+            loc++;
+            crossed += crossings.elementAti(loc);
+        } else if (opType == URX_CTR_INIT || opType == URX_CTR_INIT_NG) {
+            for (int32_t i = 0; i < 3; i++) {
+                loc++;
+                crossed += crossings.elementAti(loc);
+            }
+        }
+    }
+    if (required.isEmpty()) {
+        return;
+    }
+    // An unpaired surrogate in the pattern can match half of a surrogate pair in the
+    //   input; leave such strings to the matcher.
+    for (int32_t i = 0; i < required.length(); i = required.moveIndex32(i, 1)) {
+        if (U_IS_SURROGATE(required.char32At(i))) {
+            return;
+        }
+    }
+    // An end anchor ahead of the string can set requireEnd() in a match attempt that
+    //   fails before reaching the string, an attempt that find() would skip.  Leave
+    //   such patterns to the matcher, so that requireEnd() after a failed find() is
+    //   the same with or without the required string.
+    for (loc = 3; loc < requiredLoc; loc++) {
+        op = (int32_t)pat->elementAti(loc);
+        switch (URX_TYPE(op)) {
+        case URX_DOLLAR:
+        case URX_DOLLAR_D:
+        case URX_DOLLAR_M:
+        case URX_DOLLAR_MD:
+        case URX_BACKSLASH_Z:
+            return;
+
+        case URX_STRING:
+        case URX_STRING_I:
+        case URX_JMPX:
+            loc++;
+            break;
+
+        case URX_CTR_INIT:
+        case URX_CTR_INIT_NG:
+            loc += 3;
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    // Bounds on the length of the text matched ahead of the string.  maxMatchLength()
+    //   is given the string's first op too, so that it sees branches that end there,
+    //   and that op's length is taken off again.
+    op = (int32_t)pat->elementAti(requiredLoc);
+    int32_t firstOpLen = URX_TYPE(op) == URX_STRING ?
+        URX_VAL(pat->elementAti(requiredLoc+1)) : U16_LENGTH(URX_VAL(op));
+    int32_t maxOffset = maxMatchLength(3, requiredLoc);
+    fRXPat->fRequiredMinOffset = requiredLoc > 3 ? minMatchLength(3, requiredLoc-1) : 0;
+    fRXPat->fRequiredMaxOffset = maxOffset == INT32_MAX ? INT32_MAX : maxOffset - firstOpLen;
+
+    // The characters that the ops ahead of the string can match.  A match must start
+    //   after the last other character before the string, which bounds the offset
+    //   where maxMatchLength() can not, as in ^.*string or \w+\s+string.
+    //   Ops that can match almost anything give no bound.
+    LocalPointer<UnicodeSet> prefixChars(new UnicodeSet(), *fStatus);
+    if (U_FAILURE(*fStatus)) {
+        return;
+    }
+    UBool bounded = TRUE;
+    for (loc = 3; loc < requiredLoc && bounded; loc++) {
+        op = (int32_t)pat->elementAti(loc);
+        int32_t val = URX_VAL(op);
+        switch (URX_TYPE(op)) {
+        case URX_ONECHAR:
+            prefixChars->add(val);
+            break;
+
+        case URX_STRING:
+            loc++;
+            prefixChars->addAll(UnicodeString(fRXPat->fLiteralText, val, URX_VAL(pat->elementAti(loc))));
+            break;
+
+        case URX_SETREF:
+        case URX_LOOP_SR_I:
+            prefixChars->addAll(*(UnicodeSet *)fRXPat->fSets->elementAt(val));
+            break;
+
+        case URX_STATIC_SETREF:
+        case URX_STAT_SETREF_N:
+            {
+                UnicodeSet s(*fRXPat->fStaticSets[val & ~URX_NEG_SET]);
+                if ((val & URX_NEG_SET) != 0 || URX_TYPE(op) == URX_STAT_SETREF_N) {
+                    s.complement();
+                }
+                prefixChars->addAll(s);
+            }
+            break;
+
+        case URX_BACKSLASH_D:
+            if (val == 0) {
+                UnicodeSet s;
+                s.applyIntPropertyValue(UCHAR_GENERAL_CATEGORY_MASK, U_GC_ND_MASK, *fStatus);
+                prefixChars->addAll(s);
+            } else {
+                bounded = FALSE;
+            }
+            break;
+
+        case URX_BACKSLASH_H:
+            if (val == 0) {
+                UnicodeSet s;
+                s.applyIntPropertyValue(UCHAR_GENERAL_CATEGORY_MASK, U_GC_ZS_MASK, *fStatus);
+                prefixChars->addAll(s).add(9);
+            } else {
+                bounded = FALSE;
+            }
+            break;
+
+        case URX_DOTANY:            // Any but a line terminator.
+        case URX_LOOP_DOT_I:        //   .* loop; operand 1 for (?s), 2 for (?d).
+            if (URX_TYPE(op) == URX_DOTANY || val == 0) {
+                prefixChars->add(0, 0x9).add(0xe, 0x84).add(0x86, 0x2027).add(0x202a, 0x10ffff);
+            } else if (val == 2) {
+                prefixChars->add(0, 0x9).add(0xb, 0x10ffff);
+            } else {
+                bounded = FALSE;
+            }
+            break;
+
+        case URX_DOTANY_UNIX:       // Any but a line feed.
+            prefixChars->add(0, 0x9).add(0xb, 0x10ffff);
+            break;
+
+        case URX_JMPX:
+            loc++;
+            break;
+
+        case URX_CTR_INIT:
+        case URX_CTR_INIT_NG:
+            loc += 3;
+            break;
+
+        case URX_NOP:               // Ops that match nothing.
+        case URX_START_CAPTURE:
+        case URX_END_CAPTURE:
+        case URX_STATE_SAVE:
+        case URX_JMP:
+        case URX_JMP_SAV:
+        case URX_JMP_SAV_X:
+        case URX_CTR_LOOP:
+        case URX_CTR_LOOP_NG:
+        case URX_LOOP_C:
+        case URX_STO_SP:
+        case URX_LD_SP:
+        case URX_STO_INP_LOC:
+        case URX_BACKSLASH_B:
+        case URX_BACKSLASH_BU:
+        case URX_BACKSLASH_G:
+        case URX_CARET:
+        case URX_CARET_M:
+        case URX_CARET_M_UNIX:
+            break;
+
+        default:
+            bounded = FALSE;
+            break;
+        }
+    }
+    fRXPat->fRequiredPrefixSet = -1;
+    if (bounded && U_SUCCESS(*fStatus) && !prefixChars->contains(0, 0x10ffff)) {
+        fRXPat->fRequiredPrefixSet = fRXPat->fSets->size();
+        fRXPat->fSets->addElement(prefixChars.orphan(), *fStatus);
+    }
+
+    int32_t length = required.length();
+    if (length > REQUIRED_STRING_MAX_LENGTH) {
+        length = REQUIRED_STRING_MAX_LENGTH;
+        if (U16_IS_LEAD(required.charAt(length-1))) {
+            length--;
+        }
+    }
+    fRXPat->fRequiredStringIdx = fRXPat->fLiteralText.length();
+    fRXPat->fRequiredStringLen = length;
+    fRXPat->fLiteralText.append(required, 0, length);
+}
+
+
+
+//------------------------------------------------------------------------------
+//
+//   assignMemoSlots   Number the backtracking points of the compiled pattern, the
+//                     STATE_SAVE, JMP_SAV and LOOP_C ops, for use as rows of the
+//                     matcher's memo of explored states.
+//
+//                     When the result of matching onward from one of these points
+//                     depends only on the pattern position and the input position,
+//                     the matcher need never try the same pair twice, which bounds
+//                     the work of a match by (number of points) * (input length)
+//                     instead of growing exponentially.
+//
+//                     That does not hold for back references, look-around, atomic
+//                     groups and possessive quantifiers, counted loops or the
+//                     zero-length-loop checks, whose ops keep extra state in the
+//                     stack frame or restore an earlier stack.  Patterns using any
+//                     of them get no memo slots.
+//
+//                     The STATE_SAVE at the start of every pattern, which leaves
+//                     the frame that ends a failed match, is never memoized; a
+//                     find() may try the same start position more than once.
+//
+//------------------------------------------------------------------------------
+void   RegexCompile::assignMemoSlots() {
+    if (U_FAILURE(*fStatus)) {
+        return;
+    }
+
+    UVector32 *slots = fRXPat->fMemoSlots;
+    int32_t    end   = fRXPat->fCompiledPat->size();
+    int32_t    count = 0;
+    slots->setSize(end);
+    for (int32_t loc = 0; loc < end; loc++) {
+        int32_t slot = -1;
+        switch (URX_TYPE(fRXPat->fCompiledPat->elementAti(loc))) {
+        case URX_STATE_SAVE:
+        case URX_JMP_SAV:
+        case URX_LOOP_C:
+            if (loc > 0) {
+                slot = count++;
+            }
+            break;
+
+        case URX_BACKREF:
+        case URX_BACKREF_I:
+        case URX_LA_START:
+        case URX_LA_END:
+        case URX_LB_START:
+        case URX_LB_CONT:
+        case URX_LB_END:
+        case URX_LBN_CONT:
+        case URX_LBN_END:
+        case URX_STO_SP:
+        case URX_LD_SP:
+        case URX_CTR_INIT:
+        case URX_CTR_INIT_NG:
+        case URX_CTR_LOOP:
+        case URX_CTR_LOOP_NG:
+        case URX_STO_INP_LOC:
+        case URX_JMPX:
+        case URX_JMP_SAV_X:
+            slots->removeAllElements();
+            fRXPat->fMemoSlotCount = 0;
+            return;
+
+        default:
+            break;
+        }
+        slots->setElementAt(slot, loc);
+    }
+    fRXPat->fMemoSlotCount = count;
+}
+
+
+
 //------------------------------------------------------------------------------
 //
 //   minMatchLength    Calculate the length of the shortest string that could
@@ -3568,7 +3957,7 @@ int32_t   RegexCompile::maxMatchLength(int32_t start, int32_t end) {
             //       depending on whether the char is in the supplementary range.
         case URX_ONECHAR:
             currentLen = safeIncrement(currentLen, 1);
-            if (URX_VAL(op) > 0x10000) {
+            if (URX_VAL(op) >= 0x10000) {
                 currentLen = safeIncrement(currentLen, 1);
             }
             break;
@@ -119,6 +119,9 @@ class U_I18N_API RegexCompile : public UMemory {
     int32_t     maxMatchLength(int32_t start,
                                int32_t end);
     void        matchStartType();
+    void        requiredString();                    // Find a literal string that every match contains.
+    void        assignMemoSlots();                   // Number the backtracking points, for the
+                                                     //   matcher's memo of explored states.
     void        stripNOPs();
 
     void        setEval(int32_t op);
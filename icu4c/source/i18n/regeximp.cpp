@@ -15,6 +15,7 @@
 #if !UCONFIG_NO_REGULAR_EXPRESSIONS
 #include "regeximp.h"
 #include "unicode/utf16.h"
+#include "unicode/utf8.h"
 
 U_NAMESPACE_BEGIN
 
@@ -64,7 +65,11 @@ UBool CaseFoldingUTextIterator::inExpansion() {
 
 
 CaseFoldingUCharIterator::CaseFoldingUCharIterator(const UChar *chars, int64_t start, int64_t limit) :
-   fChars(chars), fIndex(start), fLimit(limit), fFoldChars(NULL), fFoldLength(0) {
+   fChars(chars), fChars8(NULL), fIndex(start), fLimit(limit), fFoldChars(NULL), fFoldLength(0) {
+}
+
+CaseFoldingUCharIterator::CaseFoldingUCharIterator(const uint8_t *chars, int64_t start, int64_t limit) :
+   fChars(NULL), fChars8(chars), fIndex(start), fLimit(limit), fFoldChars(NULL), fFoldLength(0) {
 }
 
 
@@ -80,7 +85,11 @@ UChar32 CaseFoldingUCharIterator::next() {
         if (fIndex >= fLimit) {
             return U_SENTINEL;
         }
-        U16_NEXT(fChars, fIndex, fLimit, originalC);
+        if (fChars8 != NULL) {
+            U8_NEXT_OR_FFFD(fChars8, fIndex, fLimit, originalC);
+        } else {
+            U16_NEXT(fChars, fIndex, fLimit, originalC);
+        }
 
         fFoldLength = ucase_toFullFolding(originalC, &fFoldChars, U_FOLD_CASE_DEFAULT);
         if (fFoldLength >= UCASE_MAX_STRING_LENGTH || fFoldLength < 0) {
@@ -18,6 +18,7 @@
 #include "unicode/uobject.h"
 #include "unicode/uniset.h"
 #include "unicode/utext.h"
+#include "unicode/regex.h"
 
 #include "cmemory.h"
 #include "ucase.h"
@@ -296,6 +297,12 @@ struct REStackFrame {
 // number of UVector elements in the header
 #define RESTACKFRAME_HDRCOUNT 2
 
+//
+//  The longest literal string that the compiler records as required in every match,
+//    for find() to search for.  Longer required strings are cut to this length.
+//
+#define REQUIRED_STRING_MAX_LENGTH 32
+
 //
 //  Start-Of-Match type.  Used by find() to quickly scan to positions where a
 //                        match might start before firing up the full match engine.
@@ -389,6 +396,7 @@ class CaseFoldingUTextIterator: public UMemory {
 class CaseFoldingUCharIterator: public UMemory {
       public:
         CaseFoldingUCharIterator(const UChar *chars, int64_t start, int64_t limit);
+        CaseFoldingUCharIterator(const uint8_t *chars, int64_t start, int64_t limit);   // UTF-8
         ~CaseFoldingUCharIterator();
 
         UChar32 next();           // Next case folded character
@@ -401,6 +409,7 @@ class CaseFoldingUCharIterator: public UMemory {
 
       private:
         const  UChar      *fChars;
+        const  uint8_t    *fChars8;     // UTF-8 input, if not NULL.
         int64_t            fIndex;
         int64_t            fLimit;
         const  UChar      *fFoldChars;
@@ -409,6 +418,28 @@ class CaseFoldingUCharIterator: public UMemory {
 
 };
 
+
+//  Skip ahead to the start positions from which a match can reach the pattern's
+//  required string.  Used by RegexMatcher::find() and by RegexSet.
+//  See rematch.cpp.
+
+inline UBool RegexMatcher::skipToRequiredString(int64_t &startIdx) {
+    if (startIdx > fRequiredLimit && !findRequiredString(startIdx)) {
+        return FALSE;
+    }
+    if (startIdx < fRequiredStart) {
+        startIdx = fRequiredStart;
+    }
+    return TRUE;
+}
+
+inline UBool RegexMatcher::skipToRequiredString(int32_t &startIdx) {
+    int64_t idx = startIdx;
+    UBool result = skipToRequiredString(idx);
+    startIdx = (int32_t)idx;
+    return result;
+}
+
 U_NAMESPACE_END
 #endif
 
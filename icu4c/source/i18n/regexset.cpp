@@ -0,0 +1,594 @@
+// © 2019 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+//
+//  file:  regexset.cpp
+//
+//  RegexSet, a set of regular expressions that are searched for together.
+//
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_REGULAR_EXPRESSIONS
+
+#include "unicode/regex.h"
+#include "unicode/uniset.h"
+#include "unicode/ustring.h"
+#include "charstr.h"
+#include "cmemory.h"
+#include "hash.h"
+#include "uassert.h"
+#include "uvector.h"
+#include "uvectr32.h"
+#include "regeximp.h"
+#include "regextxt.h"
+
+U_NAMESPACE_BEGIN
+
+//--------------------------------------------------------------------------------
+//
+//   RegexSetTables      The information shared by find() over all of the patterns
+//                       in a set, built from the patterns on first use.
+//
+//       Start groups    The patterns are grouped by where their matches can begin,
+//                       from RegexPattern::fStartType and fInitialChars.  A pattern
+//                       whose matches can begin with several characters is in the
+//                       group of each of them.  At each input position, find() tries
+//                       only the patterns of the groups that apply there.
+//
+//       Literals        The distinct required strings of the patterns (see
+//                       RegexCompile::requiredString()), in UTF-16 and in UTF-8,
+//                       bucketed by the low eight bits of their first code unit, so
+//                       that a single pass over the input finds all of them.
+//
+//--------------------------------------------------------------------------------
+namespace {
+
+enum {
+    kOtherChar   = 256,     // Groups 0..255 are by first character; this is for characters >= 256.
+    kAnyPosition = 257,     // Patterns that can match anywhere.
+    kLineStart   = 258,     // Patterns that match at the start of a line, (?m)^
+    kInputStart  = 259,     // Patterns that match at the start of the input, ^ or \A
+    kGroupCount  = 260
+};
+
+// Per-pattern state during a find().
+enum {
+    kUntried = 0,           // No match attempted yet.
+    kTrying,                // The pattern's matcher is set up with the input.
+    kMatched,               // The first match has been found.
+    kExcluded               // The pattern's required string is not in the rest of the input.
+};
+
+// Test for any of the Unicode line terminating characters.
+inline UBool isLineTerminator(UChar32 c) {
+    return (c<=0x0d && c>=0x0a) || c==0x85 || c==0x2028 || c==0x2029;
+}
+
+}  // namespace
+
+struct RegexSetTables : public UMemory {
+    RegexSetTables(UErrorCode &status);
+
+    UVector32       groupPatterns;                  // Pattern indexes, by start group.
+    int32_t         groupLimits[kGroupCount + 1];   // Group g is [groupLimits[g], groupLimits[g+1]).
+
+    UnicodeString   literals16;                     // The distinct required strings, concatenated.
+    UVector32       literalStarts16;                // Start of each string in literals16, plus the end.
+    UVector32       bucketLiterals16;               // Literal indexes, by the low bits of their first unit.
+    int32_t         bucketLimits16[257];
+    UVector32       patternLiterals16;              // For each pattern, its literal index, or -1.
+
+    CharString      literals8;                      // The same for UTF-8.  Strings containing U+FFFD
+    UVector32       literalStarts8;                 //   are left out, as ill-formed UTF-8 input
+    UVector32       bucketLiterals8;                //   reads as U+FFFD.
+    int32_t         bucketLimits8[257];
+    UVector32       patternLiterals8;
+
+    // Scratch space for find(), one entry per pattern or literal.
+    MaybeStackArray<uint8_t, 40>  states;
+    MaybeStackArray<int64_t, 40>  minStarts;       // No match can start before this.
+    MaybeStackArray<int64_t, 40>  matchStarts;
+    MaybeStackArray<int64_t, 40>  matchLimits;
+    MaybeStackArray<int64_t, 40>  literalFound;    // First occurrence of each literal, or -1.
+};
+
+RegexSetTables::RegexSetTables(UErrorCode &status) :
+        groupPatterns(status), literalStarts16(status), bucketLiterals16(status), patternLiterals16(status),
+        literalStarts8(status), bucketLiterals8(status), patternLiterals8(status) {
+    uprv_memset(groupLimits, 0, sizeof(groupLimits));
+    uprv_memset(bucketLimits16, 0, sizeof(bucketLimits16));
+    uprv_memset(bucketLimits8, 0, sizeof(bucketLimits8));
+}
+
+namespace {
+
+// Find the first occurrence of each of the literals that has not been found yet,
+//   setting found[literal] to its index in s.
+//   Return the number of literals found.
+template<typename T>
+int32_t findLiterals(const T *s, int32_t length,
+                     const T *lits, const int32_t *litStarts, int32_t litCount,
+                     const int32_t *bucketLimits, const int32_t *bucketLiterals,
+                     int64_t *found) {
+    int32_t numFound = 0;
+    for (int32_t i = 0; i < length; i++) {
+        uint8_t b = (uint8_t)s[i];
+        for (int32_t k = bucketLimits[b]; k < bucketLimits[b + 1]; k++) {
+            int32_t lit = bucketLiterals[k];
+            int32_t litLength = litStarts[lit + 1] - litStarts[lit];
+            if (found[lit] < 0 && litLength <= length - i &&
+                    uprv_memcmp(s + i, lits + litStarts[lit], litLength * sizeof(T)) == 0) {
+                found[lit] = i;
+                if (++numFound == litCount) {
+                    return numFound;
+                }
+            }
+        }
+    }
+    return numFound;
+}
+
+// Group the literals by the low eight bits of their first code unit.
+template<typename T>
+void bucketLiterals(const T *lits, const UVector32 &litStarts,
+                    UVector32 &bucketLiterals, int32_t *bucketLimits, UErrorCode &status) {
+    int32_t litCount = litStarts.size() - 1;
+    for (int32_t b = 0; b < 256; b++) {
+        bucketLimits[b] = bucketLiterals.size();
+        for (int32_t lit = 0; lit < litCount; lit++) {
+            if ((uint8_t)lits[litStarts.elementAti(lit)] == b) {
+                bucketLiterals.addElement(lit, status);
+            }
+        }
+    }
+    bucketLimits[256] = bucketLiterals.size();
+}
+
+UBool isInStartGroup(int32_t startType, const UnicodeSet *initialChars, int32_t group) {
+    switch (startType) {
+    case START_NO_INFO:
+        return group == kAnyPosition;
+    case START_START:
+        return group == kInputStart;
+    case START_LINE:
+        return group == kLineStart;
+    case START_CHAR:
+    case START_SET:
+    case START_STRING:
+        if (group < kOtherChar) {
+            return initialChars->contains(group);
+        }
+        return group == kOtherChar && initialChars->containsSome(0x100, 0x10ffff);
+    default:
+        UPRV_UNREACHABLE;
+    }
+}
+
+}  // namespace
+
+
+//--------------------------------------------------------------------------------
+//
+//   Constructor, destructor, add()
+//
+//--------------------------------------------------------------------------------
+RegexSet::RegexSet(UErrorCode &status) : fPatterns(NULL), fMatchers(NULL), fTables(NULL) {
+    if (U_FAILURE(status)) {
+        return;
+    }
+    fPatterns = new UVector(uprv_deleteUObject, NULL, status);
+    fMatchers = new UVector(uprv_deleteUObject, NULL, status);
+    if (U_SUCCESS(status) && (fPatterns == NULL || fMatchers == NULL)) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+    }
+}
+
+RegexSet::~RegexSet() {
+    delete fTables;
+    delete fMatchers;
+    delete fPatterns;
+}
+
+int32_t RegexSet::add(const UnicodeString &regex, uint32_t flags, UParseError &pe, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return -1;
+    }
+    return addPattern(RegexPattern::compile(regex, flags, pe, status), status);
+}
+
+int32_t RegexSet::add(const UnicodeString &regex, uint32_t flags, UErrorCode &status) {
+    UParseError pe;
+    return add(regex, flags, pe, status);
+}
+
+int32_t RegexSet::addPattern(RegexPattern *pat, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        delete pat;
+        return -1;
+    }
+    if (fPatterns == NULL || fMatchers == NULL) {
+        delete pat;
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return -1;
+    }
+    int32_t index = fPatterns->size();
+    fPatterns->addElement(pat, status);
+    if (U_FAILURE(status)) {
+        delete pat;
+        return -1;
+    }
+    // Matchers are created on a pattern's first match attempt.
+    fMatchers->addElement((void *)NULL, status);
+    if (U_FAILURE(status)) {
+        fPatterns->removeElementAt(index);
+        return -1;
+    }
+    delete fTables;
+    fTables = NULL;
+    return index;
+}
+
+int32_t RegexSet::size() const {
+    return fPatterns == NULL ? 0 : fPatterns->size();
+}
+
+const RegexPattern *RegexSet::getPattern(int32_t index) const {
+    if (index < 0 || index >= size()) {
+        return NULL;
+    }
+    return (const RegexPattern *)fPatterns->elementAt(index);
+}
+
+
+//--------------------------------------------------------------------------------
+//
+//   buildTables()
+//
+//--------------------------------------------------------------------------------
+void RegexSet::buildTables(UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return;
+    }
+    if (fPatterns == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    LocalPointer<RegexSetTables> tables(new RegexSetTables(status), status);
+    if (U_FAILURE(status)) {
+        return;
+    }
+    int32_t patternCount = fPatterns->size();
+
+    int32_t group;
+    int32_t i;
+    for (group = 0; group < kGroupCount; group++) {
+        tables->groupLimits[group] = tables->groupPatterns.size();
+        for (i = 0; i < patternCount; i++) {
+            const RegexPattern *pat = (const RegexPattern *)fPatterns->elementAt(i);
+            if (isInStartGroup(pat->fStartType, pat->fInitialChars, group)) {
+                tables->groupPatterns.addElement(i, status);
+            }
+        }
+    }
+    tables->groupLimits[kGroupCount] = tables->groupPatterns.size();
+
+    // Collect the distinct required strings.  literalMap maps each one to its
+    //   UTF-16 literal index plus one.
+    Hashtable  literalMap(status);
+    UVector32  literals16To8(status);
+    tables->literalStarts16.addElement(0, status);
+    tables->literalStarts8.addElement(0, status);
+    for (i = 0; i < patternCount && U_SUCCESS(status); i++) {
+        const RegexPattern *pat = (const RegexPattern *)fPatterns->elementAt(i);
+        if (pat->fRequiredStringLen == 0) {
+            tables->patternLiterals16.addElement(-1, status);
+            tables->patternLiterals8.addElement(-1, status);
+            continue;
+        }
+        UnicodeString lit(pat->fLiteralText, pat->fRequiredStringIdx, pat->fRequiredStringLen);
+        int32_t lit16 = literalMap.geti(lit) - 1;
+        if (lit16 < 0) {
+            lit16 = tables->literalStarts16.size() - 1;
+            literalMap.puti(lit, lit16 + 1, status);
+            tables->literals16.append(lit);
+            tables->literalStarts16.addElement(tables->literals16.length(), status);
+            int32_t lit8 = -1;
+            if (lit.indexOf((UChar)0xfffd) < 0) {
+                char    buf[REQUIRED_STRING_MAX_LENGTH * 3];
+                int32_t length8 = 0;
+                u_strToUTF8(buf, UPRV_LENGTHOF(buf), &length8, lit.getBuffer(), lit.length(), &status);
+                lit8 = tables->literalStarts8.size() - 1;
+                tables->literals8.append(buf, length8, status);
+                tables->literalStarts8.addElement(tables->literals8.length(), status);
+            }
+            literals16To8.addElement(lit8, status);
+        }
+        tables->patternLiterals16.addElement(lit16, status);
+        tables->patternLiterals8.addElement(literals16To8.elementAti(lit16), status);
+    }
+    bucketLiterals(tables->literals16.getBuffer(), tables->literalStarts16,
+                   tables->bucketLiterals16, tables->bucketLimits16, status);
+    bucketLiterals((const uint8_t *)tables->literals8.data(), tables->literalStarts8,
+                   tables->bucketLiterals8, tables->bucketLimits8, status);
+
+    int32_t literalCount = tables->literalStarts16.size() - 1;
+    if ((patternCount > tables->states.getCapacity() &&
+            (tables->states.resize(patternCount) == NULL ||
+             tables->minStarts.resize(patternCount) == NULL ||
+             tables->matchStarts.resize(patternCount) == NULL ||
+             tables->matchLimits.resize(patternCount) == NULL)) ||
+        (literalCount > tables->literalFound.getCapacity() &&
+            tables->literalFound.resize(literalCount) == NULL)) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+    }
+    if (U_SUCCESS(status)) {
+        fTables = tables.orphan();
+    }
+}
+
+
+//--------------------------------------------------------------------------------
+//
+//   findAll()     Find the first match of each pattern in the input,
+//                 leaving the results in fTables.
+//
+//       Pass 1    Find the first occurrence of each of the patterns' required
+//                 strings.  A pattern whose string does not occur can not match,
+//                 and no match of the others can start further before the
+//                 occurrence than the string's maximum offset in a match.
+//                 This is done for UTF-16 input that is all in one chunk, and
+//                 for UTF-8 input.
+//
+//       Pass 2    Step through the input, and at each position try the patterns
+//                 of the start groups that apply there, until each of them has
+//                 matched.  Matches of a pattern are tried at increasing positions,
+//                 so the first one is the one RegexMatcher::find() would find.
+//                 After a failed attempt, the matcher's own search for the
+//                 pattern's required string skips ahead to the next position
+//                 from which a match could reach it.
+//
+//--------------------------------------------------------------------------------
+void RegexSet::findAll(UText *input, UErrorCode &status) {
+    if (fTables == NULL) {
+        buildTables(status);
+    }
+    if (U_FAILURE(status)) {
+        return;
+    }
+    RegexSetTables *tables = fTables;
+    int32_t patternCount = fPatterns->size();
+    uint8_t *states      = tables->states.getAlias();
+    int64_t *minStarts   = tables->minStarts.getAlias();
+    int64_t *matchStarts = tables->matchStarts.getAlias();
+    int64_t *matchLimits = tables->matchLimits.getAlias();
+    int64_t *literalFound = tables->literalFound.getAlias();
+    int32_t i;
+    for (i = 0; i < patternCount; i++) {
+        states[i]      = kUntried;
+        minStarts[i]   = 0;
+        matchStarts[i] = -1;
+        matchLimits[i] = -1;
+    }
+
+    // Iterate over a shallow clone, leaving the caller's UText alone.
+    UText text = UTEXT_INITIALIZER;
+    utext_clone(&text, input, FALSE, TRUE, &status);
+    if (U_FAILURE(status)) {
+        return;
+    }
+    int64_t length  = utext_nativeLength(&text);
+    UBool   inChunk = UTEXT_FULL_TEXT_IN_CHUNK(&text, length);
+
+    // Pass 1
+    const int32_t *patternLiterals = NULL;
+    int32_t        unitsPerUChar   = 1;
+    int32_t        length8;
+    const char    *input8 = NULL;
+    if (inChunk) {
+        int32_t literalCount = tables->literalStarts16.size() - 1;
+        uprv_memset(literalFound, 0xff, literalCount * sizeof(int64_t));
+        findLiterals(text.chunkContents, (int32_t)length,
+                     tables->literals16.getBuffer(), tables->literalStarts16.getBuffer(), literalCount,
+                     tables->bucketLimits16, tables->bucketLiterals16.getBuffer(), literalFound);
+        patternLiterals = tables->patternLiterals16.getBuffer();
+    } else if ((input8 = utext_getUTF8(&text, &length8)) != NULL) {
+        int32_t literalCount = tables->literalStarts8.size() - 1;
+        uprv_memset(literalFound, 0xff, literalCount * sizeof(int64_t));
+        findLiterals((const uint8_t *)input8, length8,
+                     (const uint8_t *)tables->literals8.data(), tables->literalStarts8.getBuffer(), literalCount,
+                     tables->bucketLimits8, tables->bucketLiterals8.getBuffer(), literalFound);
+        patternLiterals = tables->patternLiterals8.getBuffer();
+        unitsPerUChar = 3;
+    }
+    int32_t remaining = patternCount;
+    if (patternLiterals != NULL) {
+        for (i = 0; i < patternCount; i++) {
+            int32_t lit = patternLiterals[i];
+            if (lit < 0) {
+                continue;
+            }
+            int64_t found = literalFound[lit];
+            if (found < 0) {
+                states[i] = kExcluded;
+                --remaining;
+                continue;
+            }
+            const RegexPattern *pat = (const RegexPattern *)fPatterns->elementAt(i);
+            if (pat->fRequiredMaxOffset != INT32_MAX) {
+                minStarts[i] = found - (int64_t)pat->fRequiredMaxOffset * unitsPerUChar;
+            }
+        }
+    }
+
+    // Pass 2
+    UTEXT_SETNATIVEINDEX(&text, 0);
+    int64_t pos  = 0;
+    UChar32 prev = U_SENTINEL;
+    const int32_t *groupPatterns = tables->groupPatterns.getBuffer();
+    while (remaining > 0) {
+        UChar32 c = UTEXT_NEXT32(&text);
+        int64_t next = UTEXT_GETNATIVEINDEX(&text);
+        int32_t groups[4];
+        int32_t groupCount = 0;
+        groups[groupCount++] = kAnyPosition;
+        if (c >= 0) {
+            groups[groupCount++] = c < kOtherChar ? c : kOtherChar;
+        }
+        if (pos == 0) {
+            groups[groupCount++] = kInputStart;
+        }
+        if (pos == 0 || (isLineTerminator(prev) && !(prev == 0x0d && c == 0x0a))) {
+            groups[groupCount++] = kLineStart;
+        }
+        for (int32_t g = 0; g < groupCount; g++) {
+            int32_t group = groups[g];
+            for (int32_t k = tables->groupLimits[group]; k < tables->groupLimits[group + 1]; k++) {
+                int32_t p = groupPatterns[k];
+                if (states[p] >= kMatched || pos < minStarts[p]) {
+                    continue;
+                }
+                const RegexPattern *pat = (const RegexPattern *)fPatterns->elementAt(p);
+                if (group == kOtherChar && !pat->fInitialChars->contains(c)) {
+                    continue;
+                }
+                // Beyond this, the shortest match would extend past the end of the input.
+                //   The minimum length is in UTF-16 units; treat it as one unit otherwise.
+                int64_t minLength = UTEXT_USES_U16(&text) ? pat->fMinMatchLen : (pat->fMinMatchLen > 0);
+                if (pos > length - minLength) {
+                    continue;
+                }
+                RegexMatcher *matcher = (RegexMatcher *)fMatchers->elementAt(p);
+                if (states[p] == kUntried) {
+                    if (matcher == NULL) {
+                        matcher = pat->matcher(status);
+                        if (U_FAILURE(status)) {
+                            delete matcher;
+                            utext_close(&text);
+                            return;
+                        }
+                        fMatchers->setElementAt(matcher, p);
+                    }
+                    matcher->reset(&text);
+                    if (U_FAILURE(matcher->fDeferredStatus)) {
+                        status = matcher->fDeferredStatus;
+                        utext_close(&text);
+                        return;
+                    }
+                    // The memo and the search for the required string are shared by
+                    //   the match attempts at all later positions.
+                    matcher->resetMemo(pos);
+                    matcher->resetRequiredString();
+                    states[p] = kTrying;
+                }
+                if (inChunk) {
+                    matcher->MatchChunkAt((int32_t)pos, FALSE, status);
+                } else {
+                    matcher->MatchAt(pos, FALSE, status);
+                }
+                if (U_FAILURE(status)) {
+                    utext_close(&text);
+                    return;
+                }
+                if (matcher->fMatch) {
+                    states[p]      = kMatched;
+                    matchStarts[p] = matcher->fMatchStart;
+                    matchLimits[p] = matcher->fMatchEnd;
+                    --remaining;
+                } else if (c >= 0) {
+                    // Skip the positions from which no match can reach the next
+                    //   occurrence of the required string, as find() does.
+                    int64_t nextStart = next;
+                    if (matcher->skipToRequiredString(nextStart)) {
+                        minStarts[p] = nextStart;
+                    } else {
+                        states[p] = kExcluded;
+                        --remaining;
+                    }
+                }
+            }
+        }
+        if (c < 0) {
+            break;
+        }
+        prev = c;
+        pos  = next;
+    }
+    utext_close(&text);
+}
+
+
+//--------------------------------------------------------------------------------
+//
+//   find()
+//
+//--------------------------------------------------------------------------------
+namespace {
+
+// Copy out the results of RegexSet::findAll().
+template<typename T>
+int32_t copyResults(const RegexSetTables &tables, int32_t patternCount,
+                    int32_t *indexes, T *starts, T *limits, int32_t capacity, UErrorCode &status) {
+    int32_t count = 0;
+    for (int32_t i = 0; i < patternCount; i++) {
+        if (tables.states[i] != kMatched) {
+            continue;
+        }
+        if (count < capacity) {
+            indexes[count] = i;
+            if (starts != NULL) {
+                starts[count] = (T)tables.matchStarts[i];
+            }
+            if (limits != NULL) {
+                limits[count] = (T)tables.matchLimits[i];
+            }
+        }
+        count++;
+    }
+    if (count > capacity) {
+        status = U_BUFFER_OVERFLOW_ERROR;
+    }
+    return count;
+}
+
+}  // namespace
+
+int32_t RegexSet::find(UText *input, int32_t *indexes, int64_t *starts, int64_t *limits,
+                       int32_t capacity, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (input == NULL || capacity < 0 || (indexes == NULL && capacity > 0)) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    findAll(input, status);
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    return copyResults(*fTables, fPatterns->size(), indexes, starts, limits, capacity, status);
+}
+
+int32_t RegexSet::find(const UnicodeString &input, int32_t *indexes, int32_t *starts, int32_t *limits,
+                       int32_t capacity, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (capacity < 0 || (indexes == NULL && capacity > 0)) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    UText text = UTEXT_INITIALIZER;
+    utext_openConstUnicodeString(&text, &input, &status);
+    findAll(&text, status);
+    utext_close(&text);
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    return copyResults(*fTables, fPatterns->size(), indexes, starts, limits, capacity, status);
+}
+
+UOBJECT_DEFINE_RTTI_IMPLEMENTATION(RegexSet)
+
+U_NAMESPACE_END
+
+#endif  // !UCONFIG_NO_REGULAR_EXPRESSIONS
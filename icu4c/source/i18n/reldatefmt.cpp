@@ -693,6 +693,11 @@ static UBool getDateTimePattern(
     return getStringByIndex(topLevel.getAlias(), 8, result, status);
 }
 
+template<> U_I18N_API
+const char *CacheKey<RelativeDateTimeCacheData>::getValueTypeName() const {
+    return "RelativeDateTimeCacheData";
+}
+
 template<> U_I18N_API
 const RelativeDateTimeCacheData *LocaleCacheKey<RelativeDateTimeCacheData>::createObject(const void * /*unused*/, UErrorCode &status) const {
     const char *localeId = fLoc.getName();
@@ -23,12 +23,14 @@
 #include "unicode/rbbi.h"
 #include "unicode/utf.h"
 #include "unicode/utf16.h"
+#include "unicode/utf8.h"
 #include "uassert.h"
 #include "cmemory.h"
 #include "cstr.h"
 #include "uvector.h"
 #include "uvectr32.h"
 #include "uvectr64.h"
+#include "usimd.h"
 #include "regeximp.h"
 #include "regexst.h"
 #include "regextxt.h"
@@ -53,6 +55,14 @@ static const int32_t DEFAULT_BACKTRACK_STACK_CAPACITY = 8000000;
 //   This constant determines that state saves per tick number.
 static const int32_t TIMER_INITIAL_VALUE = 10000;
 
+// Upper limit on the size of the memo of explored backtracking states, in bits.
+//   Input beyond what fits is matched without the memo.
+static const int64_t MEMO_MAX_BITS = 0x4000000;
+
+// Number of backtracking points a match operation passes before it starts using
+//   the memo, in addition to one per 32 bit word of memo that must be cleared.
+static const int32_t MEMO_INITIAL_COUNTDOWN = 32;
+
 
 // Test for any of the Unicode line terminating characters.
 static inline UBool isLineTerminator(UChar32 c) {
@@ -62,6 +72,166 @@ static inline UBool isLineTerminator(UChar32 c) {
     return (c<=0x0d && c>=0x0a) || c==0x85 || c==0x2028 || c==0x2029;
 }
 
+// Iteration over the input buffer of MatchBufferAt(), which holds either UTF-16
+//   code units or UTF-8 bytes.  Ill-formed UTF-8 reads as U+FFFD, as it does
+//   through the UTF-8 UText.
+template<typename Index>
+static inline void inputNext(const UChar *s, Index &i, int64_t length, UChar32 &c) {
+    U16_NEXT(s, i, length, c);
+}
+
+template<typename Index>
+static inline void inputNext(const uint8_t *s, Index &i, int64_t length, UChar32 &c) {
+    U8_NEXT_OR_FFFD(s, i, length, c);
+}
+
+template<typename Index>
+static inline void inputFwd1(const UChar *s, Index &i, int64_t length) {
+    U16_FWD_1(s, i, length);
+}
+
+template<typename Index>
+static inline void inputFwd1(const uint8_t *s, Index &i, int64_t length) {
+    U8_FWD_1(s, i, length);
+}
+
+template<typename Index>
+static inline void inputPrev(const UChar *s, int64_t start, Index &i, UChar32 &c) {
+    U16_PREV(s, start, i, c);
+}
+
+template<typename Index>
+static inline void inputPrev(const uint8_t *s, int64_t start, Index &i, UChar32 &c) {
+    int32_t i32 = (int32_t)i;
+    U8_PREV_OR_FFFD(s, (int32_t)start, i32, c);
+    i = i32;
+}
+
+static inline void inputGet(const UChar *s, int64_t start, int64_t i, int64_t length, UChar32 &c) {
+    U16_GET(s, start, i, length, c);
+}
+
+static inline void inputGet(const uint8_t *s, int64_t start, int64_t i, int64_t length, UChar32 &c) {
+    U8_GET_OR_FFFD(s, (int32_t)start, (int32_t)i, (int32_t)length, c);
+}
+
+template<typename Index>
+static inline void inputBack1(const UChar *s, int64_t start, Index &i) {
+    U16_BACK_1(s, start, i);
+}
+
+template<typename Index>
+static inline void inputBack1(const uint8_t *s, int64_t start, Index &i) {
+    int32_t i32 = (int32_t)i;
+    U8_BACK_1(s, (int32_t)start, i32);
+    i = i32;
+}
+
+template<typename Index>
+static inline void inputSetCpStart(const UChar *s, int64_t start, Index &i) {
+    U16_SET_CP_START(s, start, i);
+}
+
+template<typename Index>
+static inline void inputSetCpStart(const uint8_t *s, int64_t start, Index &i) {
+    int32_t i32 = (int32_t)i;
+    U8_SET_CP_START(s, (int32_t)start, i32);
+    i = i32;
+}
+
+// Match a literal string from the pattern at input index i, advancing i past it.
+//   Set hitEnd if the input ends before the match is complete.
+static UBool matchString(const UChar *s, int32_t &i, int32_t limit,
+                         const UChar *lit, int32_t litLength, UBool &hitEnd) {
+    const UChar *pInp = s + i;
+    const UChar *pInpLimit = s + limit;
+    const UChar *pEnd = pInp + litLength;
+    while (pInp < pEnd) {
+        if (pInp >= pInpLimit) {
+            hitEnd = TRUE;
+            return FALSE;
+        }
+        if (*pInp++ != *lit++) {
+            return FALSE;
+        }
+    }
+    i += litLength;
+    return TRUE;
+}
+
+static UBool matchString(const uint8_t *s, int32_t &i, int32_t limit,
+                         const UChar *lit, int32_t litLength, UBool &hitEnd) {
+    int32_t litIdx = 0;
+    int32_t ix = i;
+    while (litIdx < litLength) {
+        if (ix >= limit) {
+            hitEnd = TRUE;
+            return FALSE;
+        }
+        UChar32 c = s[ix];
+        if (c < 0x80 && c == lit[litIdx]) {
+            ++ix;
+            ++litIdx;
+            continue;
+        }
+        UChar32 litC;
+        U8_NEXT_OR_FFFD(s, ix, limit, c);
+        U16_NEXT(lit, litIdx, litLength, litC);
+        if (c != litC) {
+            return FALSE;
+        }
+    }
+    i = ix;
+    return TRUE;
+}
+
+// Match the text of a capture group, [groupStart, groupLimit), at input index i,
+//   advancing i past it.  Set hitEnd if the input ends before the match is complete.
+static UBool matchBackRef(const UChar *s, int32_t groupStart, int32_t groupLimit,
+                          int32_t &i, int32_t limit, UBool &hitEnd) {
+    int32_t ix = i;
+    for (int32_t groupIndex = groupStart; groupIndex < groupLimit; ++groupIndex, ++ix) {
+        if (ix >= limit) {
+            hitEnd = TRUE;
+            return FALSE;
+        }
+        if (s[groupIndex] != s[ix]) {
+            return FALSE;
+        }
+    }
+    if (groupStart < groupLimit && U16_IS_LEAD(s[groupLimit-1]) &&
+            ix < limit && U16_IS_TRAIL(s[ix])) {
+        // Capture group ended with an unpaired lead surrogate.
+        // Back reference is not permitted to match lead only of a surrogatge pair.
+        return FALSE;
+    }
+    i = ix;
+    return TRUE;
+}
+
+static UBool matchBackRef(const uint8_t *s, int32_t groupStart, int32_t groupLimit,
+                          int32_t &i, int32_t limit, UBool &hitEnd) {
+    // Compare characters rather than bytes: an ill-formed sequence at the end
+    //   of the group must not match the start of a longer one.
+    int32_t ix = i;
+    int32_t groupIndex = groupStart;
+    while (groupIndex < groupLimit) {
+        if (ix >= limit) {
+            hitEnd = TRUE;
+            return FALSE;
+        }
+        UChar32 groupC;
+        UChar32 c;
+        U8_NEXT_OR_FFFD(s, groupIndex, groupLimit, groupC);
+        U8_NEXT_OR_FFFD(s, ix, limit, c);
+        if (c != groupC) {
+            return FALSE;
+        }
+    }
+    i = ix;
+    return TRUE;
+}
+
 //-----------------------------------------------------------------------------
 //
 //   Constructor and Destructor
@@ -174,6 +344,7 @@ RegexMatcher::~RegexMatcher() {
     if (fAltInputText) {
         utext_close(fAltInputText);
     }
+    uprv_free(fMemo);
 
     #if UCONFIG_NO_BREAK_ITERATION==0
     delete fWordBreakItr;
@@ -214,6 +385,13 @@ void RegexMatcher::init(UErrorCode &status) {
     fTime              = 0;
     fTickCounter       = 0;
     fStackLimit        = DEFAULT_BACKTRACK_STACK_CAPACITY;
+    fMemo              = NULL;
+    fMemoCapacity      = 0;
+    fMemoStart         = 0;
+    fMemoWidth         = 0;
+    fMemoCountdown     = -1;
+    fRequiredStart     = 0;
+    fRequiredLimit     = U_INT64_MAX;
     fCallbackFn        = NULL;
     fCallbackContext   = NULL;
     fFindProgressCallbackFn      = NULL;
@@ -604,6 +782,174 @@ UBool RegexMatcher::findProgressInterrupt(int64_t pos, UErrorCode &status) {
     return FALSE;
 }
 
+//--------------------------------------------------------------------------------
+//
+//   Required string search for find().
+//
+//       RegexCompile::requiredString() may find a literal string that every match
+//       of the pattern contains, at an offset from the start of the match between
+//       fRequiredMinOffset and fRequiredMaxOffset, and the set of characters that
+//       can come ahead of it in a match.  Rather than trying a match at
+//       every candidate start position, find() searches ahead for the string and
+//       skips the positions from which no match could reach it.  Skipped match
+//       attempts could not have looked at the input beyond the string, so hitEnd()
+//       and requireEnd() are unaffected.
+//
+//       The search is done on UTF-16 input that is all in one chunk, and on UTF-8
+//       input, for which the offsets are scaled to bytes.  Other input is matched
+//       at every position as before.
+//
+//       resetRequiredString   At the start of a find(); decides whether the search
+//                             can be used with the current input.
+//
+//       findRequiredString    Find the next occurrence of the string that a match
+//                             starting at or after startIdx could contain, and set
+//                             fRequiredStart..fRequiredLimit to the range of start
+//                             positions from which a match could reach it.
+//                             Return FALSE if there is no such occurrence.
+//
+//       skipToRequiredString  Move startIdx forward past positions from which no
+//                             match can reach an occurrence of the string.
+//                             Return FALSE if no match is possible at or after startIdx.
+//                             In regeximp.h, for use by RegexSet as well.
+//
+//--------------------------------------------------------------------------------
+namespace {
+
+inline int32_t skipNoPair(const UChar *s, int32_t length, UChar first, UChar last, int32_t lastOffset) {
+    return usimd_skipNoPairUTF16(s, length, first, last, lastOffset);
+}
+
+inline int32_t skipNoPair(const uint8_t *s, int32_t length, uint8_t first, uint8_t last, int32_t lastOffset) {
+    return usimd_skipNoPairUTF8(s, length, first, last, lastOffset);
+}
+
+// Index of the first occurrence of lit in s[start..limit[, or -1 if there is none.
+// Blocks of text without a matching first and last unit are skipped with vector
+// compares; the candidates left over are checked one at a time.
+template<typename T>
+int32_t findLiteral(const T *s, int32_t start, int32_t limit, const T *lit, int32_t litLength) {
+    T first = lit[0];
+    int32_t lastOffset = litLength - 1;
+    T last = lit[lastOffset];
+    int32_t end = limit - lastOffset;           // An occurrence must begin before end.
+    int32_t i = start;
+    while (i < end) {
+        i += skipNoPair(s + i, limit - i, first, last, lastOffset);
+        int32_t blockEnd = end - i > 16 ? i + 16 : end;
+        for (; i < blockEnd; i++) {
+            if (s[i] == first && s[i + lastOffset] == last &&
+                    uprv_memcmp(s + i, lit, litLength * sizeof(T)) == 0) {
+                return i;
+            }
+        }
+    }
+    return -1;
+}
+
+}  // namespace
+
+void RegexMatcher::resetRequiredString() {
+    fRequiredStart = 0;
+    fRequiredLimit = U_INT64_MAX;
+    const RegexPattern *pat = fPattern;
+    if (pat->fRequiredStringLen == 0) {
+        return;
+    }
+    if (!UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength)) {
+        int32_t length8;
+        if (utext_getUTF8(fInputText, &length8) == NULL) {
+            return;
+        }
+        // Ill-formed UTF-8 reads as U+FFFD, which a byte search for U+FFFD would not find.
+        const UChar *lit = pat->fLiteralText.getBuffer() + pat->fRequiredStringIdx;
+        if (u_memchr(lit, 0xfffd, pat->fRequiredStringLen) != NULL) {
+            return;
+        }
+    }
+    fRequiredLimit = -1;        // Search before the first match attempt.
+}
+
+UBool RegexMatcher::findRequiredString(int64_t startIdx) {
+    const RegexPattern *pat = fPattern;
+    const UChar *lit       = pat->fLiteralText.getBuffer() + pat->fRequiredStringIdx;
+    int32_t      litLength = pat->fRequiredStringLen;
+    int64_t      minOffset = pat->fRequiredMinOffset;
+    int64_t      maxOffset = pat->fRequiredMaxOffset;
+    int64_t      found;
+    int64_t      start;
+    const UnicodeSet *prefix  = NULL;
+    Regex8BitSet     *prefix8 = NULL;
+    if (pat->fRequiredPrefixSet >= 0) {
+        prefix  = (const UnicodeSet *)pat->fSets->elementAt(pat->fRequiredPrefixSet);
+        prefix8 = &pat->fSets8[pat->fRequiredPrefixSet];
+    }
+    if (UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength)) {
+        const UChar *inputBuf = fInputText->chunkContents;
+        found = findLiteral(inputBuf, (int32_t)(startIdx + minOffset), (int32_t)fActiveLimit, lit, litLength);
+        if (found < 0) {
+            return FALSE;
+        }
+        start = startIdx;
+        if (maxOffset != INT32_MAX && found - maxOffset > startIdx) {
+            int32_t i = (int32_t)(found - maxOffset);
+            U16_SET_CP_START(inputBuf, (int32_t)startIdx, i);
+            start = i;
+        }
+        if (prefix != NULL) {
+            int32_t i = (int32_t)found;
+            while (i > start) {
+                int32_t limit = i;
+                UChar32 c;
+                U16_PREV(inputBuf, (int32_t)start, i, c);
+                if (c < 256 ? !prefix8->contains(c) : !prefix->contains(c)) {
+                    start = limit;
+                    break;
+                }
+            }
+        }
+    } else {
+        // UTF-8 input; see resetRequiredString().  A UTF-16 code unit takes
+        //   one to three bytes.
+        int32_t length8;
+        const uint8_t *inputBuf = (const uint8_t *)utext_getUTF8(fInputText, &length8);
+        uint8_t lit8[REQUIRED_STRING_MAX_LENGTH * 3];
+        int32_t lit8Length = 0;
+        UErrorCode status = U_ZERO_ERROR;
+        u_strToUTF8((char *)lit8, UPRV_LENGTHOF(lit8), &lit8Length, lit, litLength, &status);
+        U_ASSERT(U_SUCCESS(status));
+        found = findLiteral(inputBuf, (int32_t)(startIdx + minOffset), (int32_t)fActiveLimit, lit8, lit8Length);
+        if (found < 0) {
+            return FALSE;
+        }
+        start = startIdx;
+        if (maxOffset != INT32_MAX && found - maxOffset * 3 > startIdx) {
+            int32_t i = (int32_t)(found - maxOffset * 3);
+            U8_SET_CP_START(inputBuf, 0, i);    // As the UTF-8 UText does.
+            if (i > startIdx) {
+                start = i;
+            }
+        }
+        if (prefix != NULL) {
+            // Ill-formed sequences (c < 0) may read differently backwards than
+            //   forwards; only well-formed characters end the scan.
+            int32_t i = (int32_t)found;
+            while (i > start) {
+                int32_t limit = i;
+                UChar32 c;
+                U8_PREV(inputBuf, (int32_t)start, i, c);
+                if (c >= 0 && (c < 256 ? !prefix8->contains(c) : !prefix->contains(c))) {
+                    start = limit;
+                    break;
+                }
+            }
+        }
+    }
+    fRequiredStart = start;
+    fRequiredLimit = found - minOffset;
+    return TRUE;
+}
+
 //--------------------------------------------------------------------------------
 //
 //   find()
@@ -638,6 +984,11 @@ UBool RegexMatcher::find(UErrorCode &status) {
     if (UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength)) {
         return findUsingChunk(status);
     }
+    int32_t length8;
+    const uint8_t *input8 = (const uint8_t *)utext_getUTF8(fInputText, &length8);
+    if (input8 != NULL) {
+        return findInBuffer(input8, status);
+    }
 
     int64_t startPos = fMatchEnd;
     if (startPos==0) {
@@ -670,6 +1021,10 @@ UBool RegexMatcher::find(UErrorCode &status) {
         }
     }
 
+    // The memo is shared by the match attempts at all start positions.
+    resetMemo(startPos);
+    resetRequiredString();
+
 
     // Compute the position in the input string beyond which a match can not begin, because
     //   the minimum length match would extend past the end of the input.
@@ -697,6 +1052,11 @@ UBool RegexMatcher::find(UErrorCode &status) {
         // No optimization was found.
         //  Try a match at each input position.
         for (;;) {
+            if (!skipToRequiredString(startPos)) {
+                fMatch = FALSE;
+                fHitEnd = TRUE;
+                return FALSE;
+            }
             MatchAt(startPos, FALSE, status);
             if (U_FAILURE(status)) {
                 return FALSE;
@@ -740,6 +1100,14 @@ UBool RegexMatcher::find(UErrorCode &status) {
             UTEXT_SETNATIVEINDEX(fInputText, startPos);
             for (;;) {
                 int64_t pos = startPos;
+                if (!skipToRequiredString(pos)) {
+                    fMatch = FALSE;
+                    fHitEnd = TRUE;
+                    return FALSE;
+                }
+                if (pos != startPos) {
+                    UTEXT_SETNATIVEINDEX(fInputText, pos);
+                }
                 c = UTEXT_NEXT32(fInputText);
                 startPos = UTEXT_GETNATIVEINDEX(fInputText);
                 // c will be -1 (U_SENTINEL) at end of text, in which case we
@@ -754,7 +1122,7 @@ UBool RegexMatcher::find(UErrorCode &status) {
                     if (fMatch) {
                         return TRUE;
                     }
-                    UTEXT_SETNATIVEINDEX(fInputText, pos);
+                    UTEXT_SETNATIVEINDEX(fInputText, startPos);
                 }
                 if (startPos > testStartLimit) {
                     fMatch = FALSE;
@@ -776,6 +1144,14 @@ UBool RegexMatcher::find(UErrorCode &status) {
             UTEXT_SETNATIVEINDEX(fInputText, startPos);
             for (;;) {
                 int64_t pos = startPos;
+                if (!skipToRequiredString(pos)) {
+                    fMatch = FALSE;
+                    fHitEnd = TRUE;
+                    return FALSE;
+                }
+                if (pos != startPos) {
+                    UTEXT_SETNATIVEINDEX(fInputText, pos);
+                }
                 c = UTEXT_NEXT32(fInputText);
                 startPos = UTEXT_GETNATIVEINDEX(fInputText);
                 if (c == theChar) {
@@ -822,6 +1198,13 @@ UBool RegexMatcher::find(UErrorCode &status) {
             if (fPattern->fFlags & UREGEX_UNIX_LINES) {
                 for (;;) {
                     if (ch == 0x0a) {
+                        int64_t pos = startPos;
+                        if (!skipToRequiredString(pos)) {
+                            fMatch = FALSE;
+                            fHitEnd = TRUE;
+                            return FALSE;
+                        }
+                        if (pos == startPos) {
                             MatchAt(startPos, FALSE, status);
                             if (U_FAILURE(status)) {
                                 return FALSE;
@@ -830,6 +1213,14 @@ UBool RegexMatcher::find(UErrorCode &status) {
                                 return TRUE;
                             }
                             UTEXT_SETNATIVEINDEX(fInputText, startPos);
+                        } else {
+                            // Go on from the first position that could reach the string.
+                            startPos = pos;
+                            UTEXT_SETNATIVEINDEX(fInputText, startPos);
+                            ch = UTEXT_PREVIOUS32(fInputText);
+                            UTEXT_SETNATIVEINDEX(fInputText, startPos);
+                            continue;
+                        }
                     }
                     if (startPos >= testStartLimit) {
                         fMatch = FALSE;
@@ -851,14 +1242,29 @@ UBool RegexMatcher::find(UErrorCode &status) {
                             (void)UTEXT_NEXT32(fInputText);
                             startPos = UTEXT_GETNATIVEINDEX(fInputText);
                         }
-                        MatchAt(startPos, FALSE, status);
-                        if (U_FAILURE(status)) {
+                        int64_t pos = startPos;
+                        if (!skipToRequiredString(pos)) {
+                            fMatch = FALSE;
+                            fHitEnd = TRUE;
                             return FALSE;
                         }
-                        if (fMatch) {
-                            return TRUE;
+                        if (pos == startPos) {
+                            MatchAt(startPos, FALSE, status);
+                            if (U_FAILURE(status)) {
+                                return FALSE;
+                            }
+                            if (fMatch) {
+                                return TRUE;
+                            }
+                            UTEXT_SETNATIVEINDEX(fInputText, startPos);
+                        } else {
+                            // Go on from the first position that could reach the string.
+                            startPos = pos;
+                            UTEXT_SETNATIVEINDEX(fInputText, startPos);
+                            ch = UTEXT_PREVIOUS32(fInputText);
+                            UTEXT_SETNATIVEINDEX(fInputText, startPos);
+                            continue;
                         }
-                        UTEXT_SETNATIVEINDEX(fInputText, startPos);
                     }
                     if (startPos >= testStartLimit) {
                         fMatch = FALSE;
@@ -917,6 +1323,18 @@ UBool RegexMatcher::find(int64_t start, UErrorCode &status) {
 //
 //--------------------------------------------------------------------------------
 UBool RegexMatcher::findUsingChunk(UErrorCode &status) {
+    return findInBuffer(fInputText->chunkContents, status);
+}
+
+
+//--------------------------------------------------------------------------------
+//
+//   findInBuffer() -- like find(), but with the entire string available in a
+//                     buffer of UTF-16 or UTF-8 code units.  See MatchBufferAt().
+//
+//--------------------------------------------------------------------------------
+template<typename CharT>
+UBool RegexMatcher::findInBuffer(const CharT *inputBuf, UErrorCode &status) {
     // Start at the position of the last match end.  (Will be zero if the
     //   matcher has been reset.
     //
@@ -926,8 +1344,6 @@ UBool RegexMatcher::findUsingChunk(UErrorCode &status) {
         startPos = (int32_t)fActiveStart;
     }
 
-    const UChar *inputBuf = fInputText->chunkContents;
-
     if (fMatch) {
         // Save the position of any previous successful match.
         fLastMatchEnd = fMatchEnd;
@@ -940,7 +1356,7 @@ UBool RegexMatcher::findUsingChunk(UErrorCode &status) {
                 fHitEnd = TRUE;
                 return FALSE;
             }
-            U16_FWD_1(inputBuf, startPos, fInputLength);
+            inputFwd1(inputBuf, startPos, fInputLength);
         }
     } else {
         if (fLastMatchEnd >= 0) {
@@ -952,12 +1368,17 @@ UBool RegexMatcher::findUsingChunk(UErrorCode &status) {
         }
     }
 
+    resetMemo(startPos);
+    resetRequiredString();
+
 
     // Compute the position in the input string beyond which a match can not begin, because
     //   the minimum length match would extend past the end of the input.
     //   Note:  some patterns that cannot match anything will have fMinMatchLength==Max Int.
     //          Be aware of possible overflows if making changes here.
     //   Note:  a match can begin at inputBuf + testLen; it is an inclusive limit.
+    //   Note:  the minimum length is in UTF-16 code units.  UTF-8 input has at least
+    //          as many bytes.
     int32_t testLen  = (int32_t)(fActiveLimit - fPattern->fMinMatchLen);
     if (startPos > testLen) {
         fMatch = FALSE;
@@ -973,7 +1394,12 @@ UBool RegexMatcher::findUsingChunk(UErrorCode &status) {
         // No optimization was found.
         //  Try a match at each input position.
         for (;;) {
-            MatchChunkAt(startPos, FALSE, status);
+            if (!skipToRequiredString(startPos)) {
+                fMatch = FALSE;
+                fHitEnd = TRUE;
+                return FALSE;
+            }
+            MatchBufferAt(inputBuf, startPos, FALSE, status);
             if (U_FAILURE(status)) {
                 return FALSE;
             }
@@ -984,7 +1410,7 @@ UBool RegexMatcher::findUsingChunk(UErrorCode &status) {
                 fHitEnd = TRUE;
                 return FALSE;
             }
-            U16_FWD_1(inputBuf, startPos, fActiveLimit);
+            inputFwd1(inputBuf, startPos, fActiveLimit);
             // Note that it's perfectly OK for a pattern to have a zero-length
             //   match at the end of a string, so we must make sure that the loop
             //   runs with startPos == testLen the last time through.
@@ -1000,7 +1426,7 @@ UBool RegexMatcher::findUsingChunk(UErrorCode &status) {
             fMatch = FALSE;
             return FALSE;
         }
-        MatchChunkAt(startPos, FALSE, status);
+        MatchBufferAt(inputBuf, startPos, FALSE, status);
         if (U_FAILURE(status)) {
             return FALSE;
         }
@@ -1012,11 +1438,16 @@ UBool RegexMatcher::findUsingChunk(UErrorCode &status) {
         // Match may start on any char from a pre-computed set.
         U_ASSERT(fPattern->fMinMatchLen > 0);
         for (;;) {
+            if (!skipToRequiredString(startPos)) {
+                fMatch = FALSE;
+                fHitEnd = TRUE;
+                return FALSE;
+            }
             int32_t pos = startPos;
-            U16_NEXT(inputBuf, startPos, fActiveLimit, c);  // like c = inputBuf[startPos++];
+            inputNext(inputBuf, startPos, fActiveLimit, c);
             if ((c<256 && fPattern->fInitialChars8->contains(c)) ||
                 (c>=256 && fPattern->fInitialChars->contains(c))) {
-                MatchChunkAt(pos, FALSE, status);
+                MatchBufferAt(inputBuf, pos, FALSE, status);
                 if (U_FAILURE(status)) {
                     return FALSE;
                 }
@@ -1042,10 +1473,15 @@ UBool RegexMatcher::findUsingChunk(UErrorCode &status) {
         U_ASSERT(fPattern->fMinMatchLen > 0);
         UChar32 theChar = fPattern->fInitialChar;
         for (;;) {
+            if (!skipToRequiredString(startPos)) {
+                fMatch = FALSE;
+                fHitEnd = TRUE;
+                return FALSE;
+            }
             int32_t pos = startPos;
-            U16_NEXT(inputBuf, startPos, fActiveLimit, c);  // like c = inputBuf[startPos++];
+            inputNext(inputBuf, startPos, fActiveLimit, c);
             if (c == theChar) {
-                MatchChunkAt(pos, FALSE, status);
+                MatchBufferAt(inputBuf, pos, FALSE, status);
                 if (U_FAILURE(status)) {
                     return FALSE;
                 }
@@ -1068,26 +1504,38 @@ UBool RegexMatcher::findUsingChunk(UErrorCode &status) {
     {
         UChar32 ch;
         if (startPos == fAnchorStart) {
-            MatchChunkAt(startPos, FALSE, status);
+            MatchBufferAt(inputBuf, startPos, FALSE, status);
             if (U_FAILURE(status)) {
                 return FALSE;
             }
             if (fMatch) {
                 return TRUE;
             }
-            U16_FWD_1(inputBuf, startPos, fActiveLimit);
+            inputFwd1(inputBuf, startPos, fActiveLimit);
         }
 
         if (fPattern->fFlags & UREGEX_UNIX_LINES) {
             for (;;) {
                 ch = inputBuf[startPos-1];
                 if (ch == 0x0a) {
-                    MatchChunkAt(startPos, FALSE, status);
-                    if (U_FAILURE(status)) {
+                    int32_t pos = startPos;
+                    if (!skipToRequiredString(pos)) {
+                        fMatch = FALSE;
+                        fHitEnd = TRUE;
                         return FALSE;
                     }
-                    if (fMatch) {
-                        return TRUE;
+                    if (pos == startPos) {
+                        MatchBufferAt(inputBuf, startPos, FALSE, status);
+                        if (U_FAILURE(status)) {
+                            return FALSE;
+                        }
+                        if (fMatch) {
+                            return TRUE;
+                        }
+                    } else {
+                        // Go on from the first position that could reach the string.
+                        startPos = pos;
+                        continue;
                     }
                 }
                 if (startPos >= testLen) {
@@ -1095,7 +1543,7 @@ UBool RegexMatcher::findUsingChunk(UErrorCode &status) {
                     fHitEnd = TRUE;
                     return FALSE;
                 }
-                U16_FWD_1(inputBuf, startPos, fActiveLimit);
+                inputFwd1(inputBuf, startPos, fActiveLimit);
                 // Note that it's perfectly OK for a pattern to have a zero-length
                 //   match at the end of a string, so we must make sure that the loop
                 //   runs with startPos == testLen the last time through.
@@ -1104,17 +1552,30 @@ UBool RegexMatcher::findUsingChunk(UErrorCode &status) {
             }
         } else {
             for (;;) {
-                ch = inputBuf[startPos-1];
+                int32_t prevPos = startPos;
+                inputPrev(inputBuf, fAnchorStart, prevPos, ch);
                 if (isLineTerminator(ch)) {
                     if (ch == 0x0d && startPos < fActiveLimit && inputBuf[startPos] == 0x0a) {
                         startPos++;
                     }
-                    MatchChunkAt(startPos, FALSE, status);
-                    if (U_FAILURE(status)) {
+                    int32_t pos = startPos;
+                    if (!skipToRequiredString(pos)) {
+                        fMatch = FALSE;
+                        fHitEnd = TRUE;
                         return FALSE;
                     }
-                    if (fMatch) {
-                        return TRUE;
+                    if (pos == startPos) {
+                        MatchBufferAt(inputBuf, startPos, FALSE, status);
+                        if (U_FAILURE(status)) {
+                            return FALSE;
+                        }
+                        if (fMatch) {
+                            return TRUE;
+                        }
+                    } else {
+                        // Go on from the first position that could reach the string.
+                        startPos = pos;
+                        continue;
                     }
                 }
                 if (startPos >= testLen) {
@@ -1122,7 +1583,7 @@ UBool RegexMatcher::findUsingChunk(UErrorCode &status) {
                     fHitEnd = TRUE;
                     return FALSE;
                 }
-                U16_FWD_1(inputBuf, startPos, fActiveLimit);
+                inputFwd1(inputBuf, startPos, fActiveLimit);
                 // Note that it's perfectly OK for a pattern to have a zero-length
                 //   match at the end of a string, so we must make sure that the loop
                 //   runs with startPos == testLen the last time through.
@@ -1467,6 +1928,7 @@ UBool RegexMatcher::lookingAt(UErrorCode &status) {
     else {
         resetPreserveRegion();
     }
+    resetMemo(fActiveStart);
     if (UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength)) {
         MatchChunkAt((int32_t)fActiveStart, FALSE, status);
     } else {
@@ -1505,6 +1967,7 @@ UBool RegexMatcher::lookingAt(int64_t start, UErrorCode &status) {
         return FALSE;
     }
 
+    resetMemo(nativeStart);
     if (UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength)) {
         MatchChunkAt((int32_t)nativeStart, FALSE, status);
     } else {
@@ -1539,6 +2002,7 @@ UBool RegexMatcher::matches(UErrorCode &status) {
         resetPreserveRegion();
     }
 
+    resetMemo(fActiveStart);
     if (UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength)) {
         MatchChunkAt((int32_t)fActiveStart, TRUE, status);
     } else {
@@ -1577,6 +2041,7 @@ UBool RegexMatcher::matches(int64_t start, UErrorCode &status) {
         return FALSE;
     }
 
+    resetMemo(nativeStart);
     if (UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength)) {
         MatchChunkAt((int32_t)nativeStart, TRUE, status);
     } else {
@@ -2563,19 +3028,18 @@ UBool RegexMatcher::isWordBoundary(int64_t pos) {
     return isBoundary;
 }
 
-UBool RegexMatcher::isChunkWordBoundary(int32_t pos) {
+template<typename CharT>
+UBool RegexMatcher::isBufferWordBoundary(const CharT *inputBuf, int32_t pos) {
     UBool isBoundary = FALSE;
     UBool cIsWord    = FALSE;
 
-    const UChar *inputBuf = fInputText->chunkContents;
-
     if (pos >= fLookLimit) {
         fHitEnd = TRUE;
     } else {
         // Determine whether char c at current position is a member of the word set of chars.
         // If we're off the end of the string, behave as though we're not at a word char.
         UChar32 c;
-        U16_GET(inputBuf, fLookStart, pos, fLookLimit, c);
+        inputGet(inputBuf, fLookStart, pos, fLookLimit, c);
         if (u_hasBinaryProperty(c, UCHAR_GRAPHEME_EXTEND) || u_charType(c) == U_FORMAT_CHAR) {
             // Current char is a combining one.  Not a boundary.
             return FALSE;
@@ -2591,7 +3055,7 @@ UBool RegexMatcher::isChunkWordBoundary(int32_t pos) {
             break;
         }
         UChar32 prevChar;
-        U16_PREV(inputBuf, fLookStart, pos, prevChar);
+        inputPrev(inputBuf, fLookStart, pos, prevChar);
         if (!(u_hasBinaryProperty(prevChar, UCHAR_GRAPHEME_EXTEND)
               || u_charType(prevChar) == U_FORMAT_CHAR)) {
             prevCIsWord = fPattern->fStaticSets[URX_ISWORD_SET]->contains(prevChar);
@@ -2631,11 +3095,7 @@ UBool RegexMatcher::isUWordBoundary(int64_t pos) {
                             //    words are not boundaries.  All non-word chars stand by themselves,
                             //    with word boundaries on both sides.
     } else {
-        if (!UTEXT_USES_U16(fInputText)) {
-            // !!!: Would like a better way to do this!
-            UErrorCode status = U_ZERO_ERROR;
-            pos = utext_extract(fInputText, 0, pos, NULL, 0, &status);
-        }
+        // The break iterator works on the native indexes of the UText.
         returnVal = fWordBreakItr->isBoundary((int32_t)pos);
     }
 #endif
@@ -2725,6 +3185,106 @@ inline REStackFrame *RegexMatcher::StateSave(REStackFrame *fp, int64_t savePatId
     return (REStackFrame *)newFP;
 }
 
+//--------------------------------------------------------------------------------
+//
+//   Memo of explored backtracking states.
+//
+//       For patterns where RegexCompile::assignMemoSlots() found it safe, whether
+//       matching can succeed onward from a backtracking point (STATE_SAVE, JMP_SAV,
+//       or the try-the-rest-of-the-pattern step of a LOOP_C) depends only on the
+//       pattern position and the input position.  Once such a state has been tried
+//       and has failed, trying it again is pointless; skipping it bounds the work of
+//       a match operation by (backtracking points) * (input length), where plain
+//       backtracking can take exponential time.  Capture groups, hitEnd() and
+//       requireEnd() come out the same as without the memo.
+//
+//       Most matches finish after only a few backtracks, so the memo is switched on
+//       only after a match operation has passed a number of backtracking points
+//       proportional to the size of memo to be cleared.
+//
+//       resetMemo      At the start of a match operation (find(), matches() or
+//                      lookingAt()), which may try several start positions.
+//                      startIdx is the earliest position that will be tried.
+//
+//       startMemo      Allocate and clear the memo, at the end of the countdown.
+//                      Return FALSE if it can't be allocated; matching then carries
+//                      on without it.
+//
+//       memoTest       TRUE if the state has already been tried.
+//
+//       memoTestAndSet TRUE if the state has already been tried, otherwise
+//                      remembers that it is being tried now.
+//                      Also counts down to startMemo().
+//
+//--------------------------------------------------------------------------------
+void RegexMatcher::resetMemo(int64_t startIdx) {
+    int32_t slotCount = fPattern->fMemoSlotCount;
+    if (slotCount == 0) {
+        fMemoCountdown = -1;
+        return;
+    }
+    int64_t width    = fActiveLimit - startIdx + 1;
+    int64_t maxWidth = MEMO_MAX_BITS / slotCount;
+    fMemoStart     = startIdx;
+    fMemoWidth     = (int32_t)(width < maxWidth ? width : maxWidth);
+    fMemoCountdown = MEMO_INITIAL_COUNTDOWN + (int32_t)(((int64_t)slotCount * fMemoWidth) >> 5);
+}
+
+UBool RegexMatcher::startMemo() {
+    int32_t words = (int32_t)(((int64_t)fPattern->fMemoSlotCount * fMemoWidth + 31) >> 5);
+    if (words > fMemoCapacity) {
+        uprv_free(fMemo);
+        fMemo = (uint32_t *)uprv_malloc(words * sizeof(uint32_t));
+        if (fMemo == NULL) {
+            fMemoCapacity = 0;
+            fMemoCountdown = -1;
+            return FALSE;
+        }
+        fMemoCapacity = words;
+    }
+    uprv_memset(fMemo, 0, words * sizeof(uint32_t));
+    fMemoCountdown = 0;
+    return TRUE;
+}
+
+inline UBool RegexMatcher::memoTest(int32_t patIdx, int64_t inputIdx) const {
+    U_ASSERT(fMemoCountdown == 0);
+    int64_t column = inputIdx - fMemoStart;
+    if (column < 0 || column >= fMemoWidth) {
+        return FALSE;
+    }
+    int32_t slot = fPattern->fMemoSlots->elementAti(patIdx);
+    if (slot < 0) {
+        return FALSE;
+    }
+    int64_t bit = (int64_t)slot * fMemoWidth + column;
+    return (fMemo[bit >> 5] & ((uint32_t)1 << (bit & 31))) != 0;
+}
+
+inline UBool RegexMatcher::memoTestAndSet(int32_t patIdx, int64_t inputIdx) {
+    if (fMemoCountdown != 0) {
+        if (fMemoCountdown < 0 || --fMemoCountdown > 0 || !startMemo()) {
+            return FALSE;
+        }
+    }
+    int64_t column = inputIdx - fMemoStart;
+    if (column < 0 || column >= fMemoWidth) {
+        return FALSE;
+    }
+    int32_t slot = fPattern->fMemoSlots->elementAti(patIdx);
+    if (slot < 0) {
+        return FALSE;
+    }
+    int64_t bit = (int64_t)slot * fMemoWidth + column;
+    uint32_t &word = fMemo[bit >> 5];
+    uint32_t mask = (uint32_t)1 << (bit & 31);
+    if ((word & mask) != 0) {
+        return TRUE;
+    }
+    word |= mask;
+    return FALSE;
+}
+
 #if defined(REGEX_DEBUG)
 namespace {
 UnicodeString StringFromUText(UText *ut) {
@@ -2767,6 +3327,14 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
         return;
     }
 
+    // UTF-8 input in memory is matched directly on its bytes.
+    int32_t length8;
+    const uint8_t *input8 = (const uint8_t *)utext_getUTF8(fInputText, &length8);
+    if (input8 != NULL) {
+        MatchBufferAt(input8, (int32_t)startIdx, toEnd, status);
+        return;
+    }
+
     //  Cache frequently referenced items from the compiled pattern
     //
     int64_t             *pat           = fPattern->fCompiledPat->getBuffer();
@@ -2882,6 +3450,11 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
 
 
         case URX_STATE_SAVE:
+            if (memoTestAndSet((int32_t)fp->fPatIdx-1, fp->fInputIdx)) {
+                // Already tried, and failed, from this point.
+                fp = (REStackFrame *)fStack->popFrame(fFrameSize);
+                break;
+            }
             fp = StateSave(fp, opValue, status);
             break;
 
@@ -3484,6 +4057,10 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
 
         case URX_JMP_SAV:
             U_ASSERT(opValue < fPattern->fCompiledPat->size());
+            if (memoTestAndSet((int32_t)fp->fPatIdx-1, fp->fInputIdx)) {
+                fp = (REStackFrame *)fStack->popFrame(fFrameSize);
+                break;
+            }
             fp = StateSave(fp, fp->fPatIdx, status);       // State save to loc following current
             fp->fPatIdx = opValue;                         // Then JMP.
             break;
@@ -4131,11 +4708,28 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                 Regex8BitSet *s8 = &fPattern->fSets8[opValue];
                 UnicodeSet   *s  = (UnicodeSet *)fSets->elementAt(opValue);
 
+                // Peek ahead in the compiled pattern, to the URX_LOOP_C that
+                //   must follow.  It's operand is the stack location
+                //   that holds the starting input index for the match of this [set]*
+                int32_t loopcIdx = (int32_t)fp->fPatIdx;
+                int32_t loopcOp = (int32_t)pat[loopcIdx];
+                U_ASSERT(URX_TYPE(loopcOp) == URX_LOOP_C);
+                int32_t stackLoc = URX_VAL(loopcOp);
+                U_ASSERT(stackLoc >= 0 && stackLoc < fFrameSize);
+
                 // Loop through input, until either the input is exhausted or
                 //   we reach a character that is not a member of the set.
+                // With the memo in use, also stop at a position from which the rest of
+                //   the pattern has already been tried.  It then has been from all of the
+                //   following positions in this run of set members, too.
                 int64_t ix = fp->fInputIdx;
+                UBool   tried = FALSE;
                 UTEXT_SETNATIVEINDEX(fInputText, ix);
                 for (;;) {
+                    if (fMemoCountdown == 0 && memoTest(loopcIdx, ix)) {
+                        tried = TRUE;
+                        break;
+                    }
                     if (ix >= fActiveLimit) {
                         fHitEnd = TRUE;
                         break;
@@ -4153,6 +4747,18 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                     ix = UTEXT_GETNATIVEINDEX(fInputText);
                 }
 
+                if (tried) {
+                    if (ix == fp->fInputIdx) {
+                        fp = (REStackFrame *)fStack->popFrame(fFrameSize);
+                        break;
+                    }
+                    // Continue with the LOOP_C, which backs up from ix without trying it.
+                    fp->fExtra[stackLoc] = fp->fInputIdx;
+                    fp->fInputIdx = ix;
+                    break;
+                }
+                (void)memoTestAndSet(loopcIdx, ix);
+
                 // If there were no matching characters, skip over the loop altogether.
                 //   The loop doesn't run at all, a * op always succeeds.
                 if (ix == fp->fInputIdx) {
@@ -4160,13 +4766,6 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                     break;
                 }
 
-                // Peek ahead in the compiled pattern, to the URX_LOOP_C that
-                //   must follow.  It's operand is the stack location
-                //   that holds the starting input index for the match of this [set]*
-                int32_t loopcOp = (int32_t)pat[fp->fPatIdx];
-                U_ASSERT(URX_TYPE(loopcOp) == URX_LOOP_C);
-                int32_t stackLoc = URX_VAL(loopcOp);
-                U_ASSERT(stackLoc >= 0 && stackLoc < fFrameSize);
                 fp->fExtra[stackLoc] = fp->fInputIdx;
                 fp->fInputIdx = ix;
 
@@ -4184,25 +4783,42 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
             //   This op scans through all remaining input.
             //   The following LOOP_C op emulates stack unwinding if the following pattern fails.
             {
+                // Peek ahead in the compiled pattern, to the URX_LOOP_C that
+                //   must follow.  It's operand is the stack location
+                //   that holds the starting input index for the match of this .*
+                int32_t loopcIdx = (int32_t)fp->fPatIdx;
+                int32_t loopcOp = (int32_t)pat[loopcIdx];
+                U_ASSERT(URX_TYPE(loopcOp) == URX_LOOP_C);
+                int32_t stackLoc = URX_VAL(loopcOp);
+                U_ASSERT(stackLoc >= 0 && stackLoc < fFrameSize);
+
                 // Loop through input until the input is exhausted (we reach an end-of-line)
-                // In DOTALL mode, we can just go straight to the end of the input.
+                // In DOTALL mode, we can just go straight to the end of the input,
+                //   unless the memo is in use.  As for LOOP_SR_I, scanning then stops
+                //   at a position from which the rest of the pattern has been tried.
                 int64_t ix;
-                if ((opValue & 1) == 1) {
+                UBool   tried = FALSE;
+                if ((opValue & 1) == 1 && fMemoCountdown != 0) {
                     // Dot-matches-All mode.  Jump straight to the end of the string.
                     ix = fActiveLimit;
                     fHitEnd = TRUE;
                 } else {
-                    // NOT DOT ALL mode.  Line endings do not match '.'
-                    // Scan forward until a line ending or end of input.
+                    // Scan forward until a line ending (in NOT DOT ALL mode)
+                    //   or end of input.
                     ix = fp->fInputIdx;
                     UTEXT_SETNATIVEINDEX(fInputText, ix);
                     for (;;) {
+                        if (fMemoCountdown == 0 && memoTest(loopcIdx, ix)) {
+                            tried = TRUE;
+                            break;
+                        }
                         if (ix >= fActiveLimit) {
                             fHitEnd = TRUE;
                             break;
                         }
                         UChar32 c = UTEXT_NEXT32(fInputText);
-                        if ((c & 0x7f) <= 0x29) {          // Fast filter of non-new-line-s
+                        if ((c & 0x7f) <= 0x29 &&          // Fast filter of non-new-line-s
+                                (opValue & 1) == 0) {
                             if ((c == 0x0a) ||             //  0x0a is newline in both modes.
                                (((opValue & 2) == 0) &&    // IF not UNIX_LINES mode
                                     isLineTerminator(c))) {
@@ -4214,6 +4830,18 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                     }
                 }
 
+                if (tried) {
+                    if (ix == fp->fInputIdx) {
+                        fp = (REStackFrame *)fStack->popFrame(fFrameSize);
+                        break;
+                    }
+                    // Continue with the LOOP_C, which backs up from ix without trying it.
+                    fp->fExtra[stackLoc] = fp->fInputIdx;
+                    fp->fInputIdx = ix;
+                    break;
+                }
+                (void)memoTestAndSet(loopcIdx, ix);
+
                 // If there were no matching characters, skip over the loop altogether.
                 //   The loop doesn't run at all, a * op always succeeds.
                 if (ix == fp->fInputIdx) {
@@ -4221,13 +4849,6 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                     break;
                 }
 
-                // Peek ahead in the compiled pattern, to the URX_LOOP_C that
-                //   must follow.  It's operand is the stack location
-                //   that holds the starting input index for the match of this .*
-                int32_t loopcOp = (int32_t)pat[fp->fPatIdx];
-                U_ASSERT(URX_TYPE(loopcOp) == URX_LOOP_C);
-                int32_t stackLoc = URX_VAL(loopcOp);
-                U_ASSERT(stackLoc >= 0 && stackLoc < fFrameSize);
                 fp->fExtra[stackLoc] = fp->fInputIdx;
                 fp->fInputIdx = ix;
 
@@ -4249,6 +4870,9 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                     // We've backed up the input idx to the point that the loop started.
                     // The loop is done.  Leave here without saving state.
                     //  Subsequent failures won't come back here.
+                    if (memoTestAndSet((int32_t)fp->fPatIdx-1, fp->fInputIdx)) {
+                        fp = (REStackFrame *)fStack->popFrame(fFrameSize);
+                    }
                     break;
                 }
                 // Set up for the next iteration of the loop, with input index
@@ -4272,7 +4896,12 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
                     }
                 }
 
-
+                if (memoTestAndSet((int32_t)fp->fPatIdx-1, fp->fInputIdx)) {
+                    // The rest of the pattern has already been tried from here.
+                    //   Back up again, without saving state.
+                    fp->fPatIdx--;
+                    break;
+                }
                 fp = StateSave(fp, fp->fPatIdx-1, status);
             }
             break;
@@ -4318,17 +4947,31 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
 
 //--------------------------------------------------------------------------------
 //
-//   MatchChunkAt   This is the actual matching engine. Like MatchAt, but with the
-//                  assumption that the entire string is available in the UText's
-//                  chunk buffer. For now, that means we can use int32_t indexes,
+//   MatchChunkAt   Run the matching engine on the UText's chunk buffer, for
+//                  when the entire string is available there.
+//
+//--------------------------------------------------------------------------------
+void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &status) {
+    MatchBufferAt(fInputText->chunkContents, startIdx, toEnd, status);
+}
+
+
+//--------------------------------------------------------------------------------
+//
+//   MatchBufferAt  This is the actual matching engine. Like MatchAt, but with the
+//                  entire string available in a buffer of UTF-16 or UTF-8 code units:
+//                  the UText's chunk buffer, or the bytes of a UTF-8 UText.
+//                  For now, that means we can use int32_t indexes,
 //                  except for anything that needs to be saved (like group starts
-//                  and ends).
+//                  and ends).  Indexes are native indexes of the UText in both cases.
 //
+//                  inputBuf:    the input code units.
 //                  startIdx:    begin matching a this index.
 //                  toEnd:       if true, match must extend to end of the input region
 //
 //--------------------------------------------------------------------------------
-void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &status) {
+template<typename CharT>
+void RegexMatcher::MatchBufferAt(const CharT *inputBuf, int32_t startIdx, UBool toEnd, UErrorCode &status) {
     UBool       isMatch  = FALSE;      // True if the we have a match.
 
     int32_t     backSearchIndex = INT32_MAX; // used after greedy single-character matches for searching backwards
@@ -4356,8 +4999,6 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
     const UChar         *litText       = fPattern->fLiteralText.getBuffer();
     UVector             *fSets         = fPattern->fSets;
 
-    const UChar         *inputBuf      = fInputText->chunkContents;
-
     fFrameSize = fPattern->fFrameSize;
     REStackFrame        *fp            = resetStack();
     if (U_FAILURE(fDeferredStatus)) {
@@ -4410,7 +5051,7 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
         case URX_ONECHAR:
             if (fp->fInputIdx < fActiveLimit) {
                 UChar32 c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                inputNext(inputBuf, fp->fInputIdx, fActiveLimit, c);
                 if (c == opValue) {
                     break;
                 }
@@ -4436,25 +5077,10 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                 U_ASSERT(opType == URX_STRING_LEN);
                 U_ASSERT(stringLen >= 2);
 
-                const UChar * pInp = inputBuf + fp->fInputIdx;
-                const UChar * pInpLimit = inputBuf + fActiveLimit;
-                const UChar * pPat = litText+stringStartIdx;
-                const UChar * pEnd = pInp + stringLen;
-                UBool success = TRUE;
-                while (pInp < pEnd) {
-                    if (pInp >= pInpLimit) {
-                        fHitEnd = TRUE;
-                        success = FALSE;
-                        break;
-                    }
-                    if (*pInp++ != *pPat++) {
-                        success = FALSE;
-                        break;
-                    }
-                }
-
-                if (success) {
-                    fp->fInputIdx += stringLen;
+                int32_t inputIdx = (int32_t)fp->fInputIdx;
+                if (matchString(inputBuf, inputIdx, (int32_t)fActiveLimit,
+                                litText+stringStartIdx, stringLen, fHitEnd)) {
+                    fp->fInputIdx = inputIdx;
                 } else {
                     fp = (REStackFrame *)fStack->popFrame(fFrameSize);
                 }
@@ -4463,6 +5089,11 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
 
 
         case URX_STATE_SAVE:
+            if (memoTestAndSet((int32_t)fp->fPatIdx-1, fp->fInputIdx)) {
+                // Already tried, and failed, from this point.
+                fp = (REStackFrame *)fStack->popFrame(fFrameSize);
+                break;
+            }
             fp = StateSave(fp, opValue, status);
             break;
 
@@ -4500,7 +5131,8 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
 
         case URX_DOLLAR:                   //  $, test for End of line
             //     or for position before new line at end of input
-            if (fp->fInputIdx < fAnchorLimit-2) {
+            //   A line ending is at most two UTF-16 code units (CR/LF), or three UTF-8 bytes.
+            if (fp->fInputIdx < fAnchorLimit - (sizeof(CharT) == 1 ? 3 : 2)) {
                 // We are no where near the end of input.  Fail.
                 //   This is the common case.  Keep it first.
                 fp = (REStackFrame *)fStack->popFrame(fFrameSize);
@@ -4515,23 +5147,24 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
 
             // If we are positioned just before a new-line that is located at the
             //   end of input, succeed.
-            if (fp->fInputIdx == fAnchorLimit-1) {
+            {
+                int32_t ix = (int32_t)fp->fInputIdx;
                 UChar32 c;
-                U16_GET(inputBuf, fAnchorStart, fp->fInputIdx, fAnchorLimit, c);
-
-                if (isLineTerminator(c)) {
-                    if ( !(c==0x0a && fp->fInputIdx>fAnchorStart && inputBuf[fp->fInputIdx-1]==0x0d)) {
-                        // At new-line at end of input. Success
-                        fHitEnd = TRUE;
-                        fRequireEnd = TRUE;
-                        break;
+                inputNext(inputBuf, ix, fAnchorLimit, c);
+                if (ix == fAnchorLimit) {
+                    if (isLineTerminator(c)) {
+                        if ( !(c==0x0a && fp->fInputIdx>fAnchorStart && inputBuf[fp->fInputIdx-1]==0x0d)) {
+                            // At new-line at end of input. Success
+                            fHitEnd = TRUE;
+                            fRequireEnd = TRUE;
+                            break;
+                        }
                     }
-                }
-            } else if (fp->fInputIdx == fAnchorLimit-2 &&
-                inputBuf[fp->fInputIdx]==0x0d && inputBuf[fp->fInputIdx+1]==0x0a) {
+                } else if (ix == fAnchorLimit-1 && c==0x0d && inputBuf[ix]==0x0a) {
                     fHitEnd = TRUE;
                     fRequireEnd = TRUE;
                     break;                         // At CR/LF at end of input.  Success
+                }
             }
 
             fp = (REStackFrame *)fStack->popFrame(fFrameSize);
@@ -4572,7 +5205,8 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                 }
                 // If we are positioned just before a new-line, succeed.
                 // It makes no difference where the new-line is within the input.
-                UChar32 c = inputBuf[fp->fInputIdx];
+                UChar32 c;
+                inputGet(inputBuf, fAnchorStart, fp->fInputIdx, fAnchorLimit, c);
                 if (isLineTerminator(c)) {
                     // At a line end, except for the odd chance of  being in the middle of a CR/LF sequence
                     //  In multi-line mode, hitting a new-line just before the end of input does not
@@ -4619,7 +5253,9 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                 }
                 // Check whether character just before the current pos is a new-line
                 //   unless we are at the end of input
-                UChar  c = inputBuf[fp->fInputIdx - 1];
+                int32_t ix = (int32_t)fp->fInputIdx;
+                UChar32 c;
+                inputPrev(inputBuf, fAnchorStart, ix, c);
                 if ((fp->fInputIdx < fAnchorLimit) &&
                     isLineTerminator(c)) {
                     //  It's a new-line.  ^ is true.  Success.
@@ -4651,7 +5287,7 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
 
         case URX_BACKSLASH_B:          // Test for word boundaries
             {
-                UBool success = isChunkWordBoundary((int32_t)fp->fInputIdx);
+                UBool success = isBufferWordBoundary(inputBuf, (int32_t)fp->fInputIdx);
                 success ^= (UBool)(opValue != 0);     // flip sense for \B
                 if (!success) {
                     fp = (REStackFrame *)fStack->popFrame(fFrameSize);
@@ -4680,7 +5316,7 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                 }
 
                 UChar32 c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                inputNext(inputBuf, fp->fInputIdx, fActiveLimit, c);
                 int8_t ctype = u_charType(c);     // TODO:  make a unicode set for this.  Will be faster.
                 UBool success = (ctype == U_DECIMAL_DIGIT_NUMBER);
                 success ^= (UBool)(opValue != 0);        // flip sense for \D
@@ -4706,7 +5342,7 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                     break;
                 }
                 UChar32 c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                inputNext(inputBuf, fp->fInputIdx, fActiveLimit, c);
                 int8_t ctype = u_charType(c);
                 UBool success = (ctype == U_SPACE_SEPARATOR || c == 9);  // SPACE_SEPARATOR || TAB
                 success ^= (UBool)(opValue != 0);        // flip sense for \H
@@ -4725,14 +5361,12 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                     break;
                 }
                 UChar32 c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                inputNext(inputBuf, fp->fInputIdx, fActiveLimit, c);
                 if (isLineTerminator(c)) {
                     if (c == 0x0d && fp->fInputIdx < fActiveLimit) {
                         // Check for CR/LF sequence. Consume both together when found.
-                        UChar c2;
-                        U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c2);
-                        if (c2 != 0x0a) {
-                            U16_PREV(inputBuf, 0, fp->fInputIdx, c2);
+                        if (inputBuf[fp->fInputIdx] == 0x0a) {
+                            fp->fInputIdx++;
                         }
                     }
                 } else {
@@ -4750,7 +5384,7 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                     break;
                 }
                 UChar32 c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                inputNext(inputBuf, fp->fInputIdx, fActiveLimit, c);
                 UBool success = isLineTerminator(c);
                 success ^= (UBool)(opValue != 0);        // flip sense for \V
                 if (!success) {
@@ -4777,7 +5411,7 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
             // Examine (and consume) the current char.
             //   Dispatch into a little state machine, based on the char.
             UChar32  c;
-            U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+            inputNext(inputBuf, fp->fInputIdx, fActiveLimit, c);
             UnicodeSet **sets = fPattern->fStaticSets;
             if (sets[URX_GC_NORMAL]->contains(c))  goto GC_Extend;
             if (sets[URX_GC_CONTROL]->contains(c)) goto GC_Control;
@@ -4792,27 +5426,27 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
 
 GC_L:
             if (fp->fInputIdx >= fActiveLimit)         goto GC_Done;
-            U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+            inputNext(inputBuf, fp->fInputIdx, fActiveLimit, c);
             if (sets[URX_GC_L]->contains(c))       goto GC_L;
             if (sets[URX_GC_LV]->contains(c))      goto GC_V;
             if (sets[URX_GC_LVT]->contains(c))     goto GC_T;
             if (sets[URX_GC_V]->contains(c))       goto GC_V;
-            U16_PREV(inputBuf, 0, fp->fInputIdx, c);
+            inputPrev(inputBuf, 0, fp->fInputIdx, c);
             goto GC_Extend;
 
 GC_V:
             if (fp->fInputIdx >= fActiveLimit)         goto GC_Done;
-            U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+            inputNext(inputBuf, fp->fInputIdx, fActiveLimit, c);
             if (sets[URX_GC_V]->contains(c))       goto GC_V;
             if (sets[URX_GC_T]->contains(c))       goto GC_T;
-            U16_PREV(inputBuf, 0, fp->fInputIdx, c);
+            inputPrev(inputBuf, 0, fp->fInputIdx, c);
             goto GC_Extend;
 
 GC_T:
             if (fp->fInputIdx >= fActiveLimit)         goto GC_Done;
-            U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+            inputNext(inputBuf, fp->fInputIdx, fActiveLimit, c);
             if (sets[URX_GC_T]->contains(c))       goto GC_T;
-            U16_PREV(inputBuf, 0, fp->fInputIdx, c);
+            inputPrev(inputBuf, 0, fp->fInputIdx, c);
             goto GC_Extend;
 
 GC_Extend:
@@ -4821,9 +5455,9 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                 if (fp->fInputIdx >= fActiveLimit) {
                     break;
                 }
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                inputNext(inputBuf, fp->fInputIdx, fActiveLimit, c);
                 if (sets[URX_GC_EXTEND]->contains(c) == FALSE) {
-                    U16_BACK_1(inputBuf, 0, fp->fInputIdx);
+                    inputBack1(inputBuf, 0, fp->fInputIdx);
                     break;
                 }
             }
@@ -4875,7 +5509,7 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                 U_ASSERT(opValue > 0 && opValue < URX_LAST_SET);
 
                 UChar32 c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                inputNext(inputBuf, fp->fInputIdx, fActiveLimit, c);
                 if (c < 256) {
                     Regex8BitSet *s8 = &fPattern->fStaticSets8[opValue];
                     if (s8->contains(c)) {
@@ -4907,7 +5541,7 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                 U_ASSERT(opValue > 0 && opValue < URX_LAST_SET);
 
                 UChar32  c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                inputNext(inputBuf, fp->fInputIdx, fActiveLimit, c);
                 if (c < 256) {
                     Regex8BitSet *s8 = &fPattern->fStaticSets8[opValue];
                     if (s8->contains(c) == FALSE) {
@@ -4936,7 +5570,7 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
 
                 // There is input left.  Pick up one char and test it for set membership.
                 UChar32  c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                inputNext(inputBuf, fp->fInputIdx, fActiveLimit, c);
                 if (c<256) {
                     Regex8BitSet *s8 = &fPattern->fSets8[opValue];
                     if (s8->contains(c)) {
@@ -4969,7 +5603,7 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
 
                 // There is input left.  Advance over one char, unless we've hit end-of-line
                 UChar32  c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                inputNext(inputBuf, fp->fInputIdx, fActiveLimit, c);
                 if (isLineTerminator(c)) {
                     // End of line in normal mode.   . does not match.
                     fp = (REStackFrame *)fStack->popFrame(fFrameSize);
@@ -4992,11 +5626,11 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                 // There is input left.  Advance over one char, except if we are
                 //   at a cr/lf, advance over both of them.
                 UChar32 c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                inputNext(inputBuf, fp->fInputIdx, fActiveLimit, c);
                 if (c==0x0d && fp->fInputIdx < fActiveLimit) {
                     // In the case of a CR/LF, we need to advance over both.
                     if (inputBuf[fp->fInputIdx] == 0x0a) {
-                        U16_FWD_1(inputBuf, fp->fInputIdx, fActiveLimit);
+                        fp->fInputIdx++;
                     }
                 }
             }
@@ -5016,7 +5650,7 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
 
                 // There is input left.  Advance over one char, unless we've hit end-of-line
                 UChar32 c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                inputNext(inputBuf, fp->fInputIdx, fActiveLimit, c);
                 if (c == 0x0a) {
                     // End of line in normal mode.   '.' does not match the \n
                     fp = (REStackFrame *)fStack->popFrame(fFrameSize);
@@ -5035,6 +5669,10 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
 
         case URX_JMP_SAV:
             U_ASSERT(opValue < fPattern->fCompiledPat->size());
+            if (memoTestAndSet((int32_t)fp->fPatIdx-1, fp->fInputIdx)) {
+                fp = (REStackFrame *)fStack->popFrame(fFrameSize);
+                break;
+            }
             fp = StateSave(fp, fp->fPatIdx, status);       // State save to loc following current
             fp->fPatIdx = opValue;                         // Then JMP.
             break;
@@ -5233,30 +5871,14 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                 int64_t groupStartIdx = fp->fExtra[opValue];
                 int64_t groupEndIdx   = fp->fExtra[opValue+1];
                 U_ASSERT(groupStartIdx <= groupEndIdx);
-                int64_t inputIndex = fp->fInputIdx;
+                int32_t inputIndex = (int32_t)fp->fInputIdx;
                 if (groupStartIdx < 0) {
                     // This capture group has not participated in the match thus far,
                     fp = (REStackFrame *)fStack->popFrame(fFrameSize);   // FAIL, no match.
                     break;
                 }
-                UBool success = TRUE;
-                for (int64_t groupIndex = groupStartIdx; groupIndex < groupEndIdx; ++groupIndex,++inputIndex) {
-                    if (inputIndex >= fActiveLimit) {
-                        success = FALSE;
-                        fHitEnd = TRUE;
-                        break;
-                    }
-                    if (inputBuf[groupIndex] != inputBuf[inputIndex]) {
-                        success = FALSE;
-                        break;
-                    }
-                }
-                if (success && groupStartIdx < groupEndIdx && U16_IS_LEAD(inputBuf[groupEndIdx-1]) &&
-                        inputIndex < fActiveLimit && U16_IS_TRAIL(inputBuf[inputIndex])) {
-                    // Capture group ended with an unpaired lead surrogate.
-                    // Back reference is not permitted to match lead only of a surrogatge pair.
-                    success = FALSE;
-                }
+                UBool success = matchBackRef(inputBuf, (int32_t)groupStartIdx, (int32_t)groupEndIdx,
+                                             inputIndex, (int32_t)fActiveLimit, fHitEnd);
                 if (success) {
                     fp->fInputIdx = inputIndex;
                 } else {
@@ -5388,7 +6010,7 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
         case URX_ONECHAR_I:
             if (fp->fInputIdx < fActiveLimit) {
                 UChar32 c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                inputNext(inputBuf, fp->fInputIdx, fActiveLimit, c);
                 if (u_foldCase(c, U_FOLD_CASE_DEFAULT) == opValue) {
                     break;
                 }
@@ -5470,6 +6092,11 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                 //   of this op in the pattern.
                 int32_t minML = (int32_t)pat[fp->fPatIdx++];
                 int32_t maxML = (int32_t)pat[fp->fPatIdx++];
+                if (sizeof(CharT) == 1) {
+                    // utf-8 fix to maximum match length. The pattern compiler assumes utf-16.
+                    // The max length need not be exact; it just needs to be >= actual maximum.
+                    maxML *= 3;
+                }
                 U_ASSERT(minML <= maxML);
                 U_ASSERT(minML >= 0);
 
@@ -5480,7 +6107,7 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                     // First time through loop.
                     lbStartIdx = fp->fInputIdx - minML;
                     if (lbStartIdx > 0 && lbStartIdx < fInputLength) {
-                        U16_SET_CP_START(inputBuf, 0, lbStartIdx);
+                        inputSetCpStart(inputBuf, 0, lbStartIdx);
                     }
                 } else {
                     // 2nd through nth time through the loop.
@@ -5488,7 +6115,7 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                     if (lbStartIdx == 0) {
                         lbStartIdx--;
                     } else {
-                        U16_BACK_1(inputBuf, 0, lbStartIdx);
+                        inputBack1(inputBuf, 0, lbStartIdx);
                     }
                 }
 
@@ -5546,6 +6173,10 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                 int32_t maxML       = (int32_t)pat[fp->fPatIdx++];
                 int32_t continueLoc = (int32_t)pat[fp->fPatIdx++];
                 continueLoc = URX_VAL(continueLoc);
+                if (sizeof(CharT) == 1) {
+                    // utf-8 fix to maximum match length. The pattern compiler assumes utf-16.
+                    maxML *= 3;
+                }
                 U_ASSERT(minML <= maxML);
                 U_ASSERT(minML >= 0);
                 U_ASSERT(continueLoc > fp->fPatIdx);
@@ -5557,15 +6188,15 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                     // First time through loop.
                     lbStartIdx = fp->fInputIdx - minML;
                     if (lbStartIdx > 0 && lbStartIdx < fInputLength) {
-                        U16_SET_CP_START(inputBuf, 0, lbStartIdx);
+                        inputSetCpStart(inputBuf, 0, lbStartIdx);
                     }
                 } else {
                     // 2nd through nth time through the loop.
                     // Back up start position for match by one.
                     if (lbStartIdx == 0) {
-                        lbStartIdx--;   // Because U16_BACK is unsafe starting at 0.
+                        lbStartIdx--;   // Because inputBack1 is unsafe starting at 0.
                     } else {
-                        U16_BACK_1(inputBuf, 0, lbStartIdx);
+                        inputBack1(inputBuf, 0, lbStartIdx);
                     }
                 }
 
@@ -5637,29 +6268,58 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                 Regex8BitSet *s8 = &fPattern->fSets8[opValue];
                 UnicodeSet   *s  = (UnicodeSet *)fSets->elementAt(opValue);
 
+                // Peek ahead in the compiled pattern, to the URX_LOOP_C that
+                //   must follow.  It's operand is the stack location
+                //   that holds the starting input index for the match of this [set]*
+                int32_t loopcIdx = (int32_t)fp->fPatIdx;
+                int32_t loopcOp = (int32_t)pat[loopcIdx];
+                U_ASSERT(URX_TYPE(loopcOp) == URX_LOOP_C);
+                int32_t stackLoc = URX_VAL(loopcOp);
+                U_ASSERT(stackLoc >= 0 && stackLoc < fFrameSize);
+
                 // Loop through input, until either the input is exhausted or
                 //   we reach a character that is not a member of the set.
+                // With the memo in use, also stop at a position from which the rest of
+                //   the pattern has already been tried.  It then has been from all of the
+                //   following positions in this run of set members, too.
                 int32_t ix = (int32_t)fp->fInputIdx;
+                UBool   tried = FALSE;
                 for (;;) {
+                    if (fMemoCountdown == 0 && memoTest(loopcIdx, ix)) {
+                        tried = TRUE;
+                        break;
+                    }
                     if (ix >= fActiveLimit) {
                         fHitEnd = TRUE;
                         break;
                     }
                     UChar32   c;
-                    U16_NEXT(inputBuf, ix, fActiveLimit, c);
+                    inputNext(inputBuf, ix, fActiveLimit, c);
                     if (c<256) {
                         if (s8->contains(c) == FALSE) {
-                            U16_BACK_1(inputBuf, 0, ix);
+                            inputBack1(inputBuf, 0, ix);
                             break;
                         }
                     } else {
                         if (s->contains(c) == FALSE) {
-                            U16_BACK_1(inputBuf, 0, ix);
+                            inputBack1(inputBuf, 0, ix);
                             break;
                         }
                     }
                 }
 
+                if (tried) {
+                    if (ix == fp->fInputIdx) {
+                        fp = (REStackFrame *)fStack->popFrame(fFrameSize);
+                        break;
+                    }
+                    // Continue with the LOOP_C, which backs up from ix without trying it.
+                    fp->fExtra[stackLoc] = fp->fInputIdx;
+                    fp->fInputIdx = ix;
+                    break;
+                }
+                (void)memoTestAndSet(loopcIdx, ix);
+
                 // If there were no matching characters, skip over the loop altogether.
                 //   The loop doesn't run at all, a * op always succeeds.
                 if (ix == fp->fInputIdx) {
@@ -5667,13 +6327,6 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                     break;
                 }
 
-                // Peek ahead in the compiled pattern, to the URX_LOOP_C that
-                //   must follow.  It's operand is the stack location
-                //   that holds the starting input index for the match of this [set]*
-                int32_t loopcOp = (int32_t)pat[fp->fPatIdx];
-                U_ASSERT(URX_TYPE(loopcOp) == URX_LOOP_C);
-                int32_t stackLoc = URX_VAL(loopcOp);
-                U_ASSERT(stackLoc >= 0 && stackLoc < fFrameSize);
                 fp->fExtra[stackLoc] = fp->fInputIdx;
                 fp->fInputIdx = ix;
 
@@ -5691,37 +6344,66 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
             //   This op scans through all remaining input.
             //   The following LOOP_C op emulates stack unwinding if the following pattern fails.
             {
+                // Peek ahead in the compiled pattern, to the URX_LOOP_C that
+                //   must follow.  It's operand is the stack location
+                //   that holds the starting input index for the match of this .*
+                int32_t loopcIdx = (int32_t)fp->fPatIdx;
+                int32_t loopcOp = (int32_t)pat[loopcIdx];
+                U_ASSERT(URX_TYPE(loopcOp) == URX_LOOP_C);
+                int32_t stackLoc = URX_VAL(loopcOp);
+                U_ASSERT(stackLoc >= 0 && stackLoc < fFrameSize);
+
                 // Loop through input until the input is exhausted (we reach an end-of-line)
-                // In DOTALL mode, we can just go straight to the end of the input.
+                // In DOTALL mode, we can just go straight to the end of the input,
+                //   unless the memo is in use.  As for LOOP_SR_I, scanning then stops
+                //   at a position from which the rest of the pattern has been tried.
                 int32_t ix;
-                if ((opValue & 1) == 1) {
+                UBool   tried = FALSE;
+                if ((opValue & 1) == 1 && fMemoCountdown != 0) {
                     // Dot-matches-All mode.  Jump straight to the end of the string.
                     ix = (int32_t)fActiveLimit;
                     fHitEnd = TRUE;
                 } else {
-                    // NOT DOT ALL mode.  Line endings do not match '.'
-                    // Scan forward until a line ending or end of input.
+                    // Scan forward until a line ending (in NOT DOT ALL mode)
+                    //   or end of input.
                     ix = (int32_t)fp->fInputIdx;
                     for (;;) {
+                        if (fMemoCountdown == 0 && memoTest(loopcIdx, ix)) {
+                            tried = TRUE;
+                            break;
+                        }
                         if (ix >= fActiveLimit) {
                             fHitEnd = TRUE;
                             break;
                         }
                         UChar32   c;
-                        U16_NEXT(inputBuf, ix, fActiveLimit, c);   // c = inputBuf[ix++]
-                        if ((c & 0x7f) <= 0x29) {          // Fast filter of non-new-line-s
+                        inputNext(inputBuf, ix, fActiveLimit, c);
+                        if ((c & 0x7f) <= 0x29 &&          // Fast filter of non-new-line-s
+                                (opValue & 1) == 0) {
                             if ((c == 0x0a) ||             //  0x0a is newline in both modes.
                                 (((opValue & 2) == 0) &&    // IF not UNIX_LINES mode
                                    isLineTerminator(c))) {
                                 //  char is a line ending.  Put the input pos back to the
                                 //    line ending char, and exit the scanning loop.
-                                U16_BACK_1(inputBuf, 0, ix);
+                                inputBack1(inputBuf, 0, ix);
                                 break;
                             }
                         }
                     }
                 }
 
+                if (tried) {
+                    if (ix == fp->fInputIdx) {
+                        fp = (REStackFrame *)fStack->popFrame(fFrameSize);
+                        break;
+                    }
+                    // Continue with the LOOP_C, which backs up from ix without trying it.
+                    fp->fExtra[stackLoc] = fp->fInputIdx;
+                    fp->fInputIdx = ix;
+                    break;
+                }
+                (void)memoTestAndSet(loopcIdx, ix);
+
                 // If there were no matching characters, skip over the loop altogether.
                 //   The loop doesn't run at all, a * op always succeeds.
                 if (ix == fp->fInputIdx) {
@@ -5729,13 +6411,6 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                     break;
                 }
 
-                // Peek ahead in the compiled pattern, to the URX_LOOP_C that
-                //   must follow.  It's operand is the stack location
-                //   that holds the starting input index for the match of this .*
-                int32_t loopcOp = (int32_t)pat[fp->fPatIdx];
-                U_ASSERT(URX_TYPE(loopcOp) == URX_LOOP_C);
-                int32_t stackLoc = URX_VAL(loopcOp);
-                U_ASSERT(stackLoc >= 0 && stackLoc < fFrameSize);
                 fp->fExtra[stackLoc] = fp->fInputIdx;
                 fp->fInputIdx = ix;
 
@@ -5757,6 +6432,9 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                     // We've backed up the input idx to the point that the loop started.
                     // The loop is done.  Leave here without saving state.
                     //  Subsequent failures won't come back here.
+                    if (memoTestAndSet((int32_t)fp->fPatIdx-1, fp->fInputIdx)) {
+                        fp = (REStackFrame *)fStack->popFrame(fFrameSize);
+                    }
                     break;
                 }
                 // Set up for the next iteration of the loop, with input index
@@ -5766,7 +6444,7 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                 //    the initial scan forward.)
                 U_ASSERT(fp->fInputIdx > 0);
                 UChar32 prevC;
-                U16_PREV(inputBuf, 0, fp->fInputIdx, prevC); // !!!: should this 0 be one of f*Limit?
+                inputPrev(inputBuf, 0, fp->fInputIdx, prevC); // !!!: should this 0 be one of f*Limit?
 
                 if (prevC == 0x0a &&
                     fp->fInputIdx > backSearchIndex &&
@@ -5774,11 +6452,16 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                     int32_t prevOp = (int32_t)pat[fp->fPatIdx-2];
                     if (URX_TYPE(prevOp) == URX_LOOP_DOT_I) {
                         // .*, stepping back over CRLF pair.
-                        U16_BACK_1(inputBuf, 0, fp->fInputIdx);
+                        inputBack1(inputBuf, 0, fp->fInputIdx);
                     }
                 }
 
-
+                if (memoTestAndSet((int32_t)fp->fPatIdx-1, fp->fInputIdx)) {
+                    // The rest of the pattern has already been tried from here.
+                    //   Back up again, without saving state.
+                    fp->fPatIdx--;
+                    break;
+                }
                 fp = StateSave(fp, fp->fPatIdx-1, status);
             }
             break;
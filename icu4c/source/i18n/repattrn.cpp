@@ -15,10 +15,13 @@
 #if !UCONFIG_NO_REGULAR_EXPRESSIONS
 
 #include "unicode/regex.h"
+#include "unicode/uchar.h"
 #include "unicode/uclean.h"
+#include "unicode/udata.h"
 #include "cmemory.h"
 #include "cstr.h"
 #include "uassert.h"
+#include "ucmndata.h"
 #include "uhash.h"
 #include "uvector.h"
 #include "uvectr32.h"
@@ -107,10 +110,17 @@ RegexPattern &RegexPattern::operator = (const RegexPattern &other) {
     fInitialChar      = other.fInitialChar;
     *fInitialChars8   = *other.fInitialChars8;
     fNeedsAltInput    = other.fNeedsAltInput;
+    fRequiredStringIdx = other.fRequiredStringIdx;
+    fRequiredStringLen = other.fRequiredStringLen;
+    fRequiredMinOffset = other.fRequiredMinOffset;
+    fRequiredMaxOffset = other.fRequiredMaxOffset;
+    fRequiredPrefixSet = other.fRequiredPrefixSet;
+    fMemoSlotCount    = other.fMemoSlotCount;
 
     //  Copy the pattern.  It's just values, nothing deep to copy.
     fCompiledPat->assign(*other.fCompiledPat, fDeferredStatus);
     fGroupMap->assign(*other.fGroupMap, fDeferredStatus);
+    fMemoSlots->assign(*other.fMemoSlots, fDeferredStatus);
 
     //  Copy the Unicode Sets.
     //    Could be made more efficient if the sets were reference counted and shared,
@@ -184,19 +194,27 @@ void RegexPattern::init() {
     fInitialChar      = 0;
     fInitialChars8    = NULL;
     fNeedsAltInput    = FALSE;
+    fRequiredStringIdx = 0;
+    fRequiredStringLen = 0;
+    fRequiredMinOffset = 0;
+    fRequiredMaxOffset = 0;
+    fRequiredPrefixSet = -1;
+    fMemoSlots        = NULL;
+    fMemoSlotCount    = 0;
     fNamedCaptureMap  = NULL;
 
     fPattern          = NULL; // will be set later
     fPatternString    = NULL; // may be set later
     fCompiledPat      = new UVector64(fDeferredStatus);
     fGroupMap         = new UVector32(fDeferredStatus);
+    fMemoSlots        = new UVector32(fDeferredStatus);
     fSets             = new UVector(fDeferredStatus);
     fInitialChars     = new UnicodeSet;
     fInitialChars8    = new Regex8BitSet;
     if (U_FAILURE(fDeferredStatus)) {
         return;
     }
-    if (fCompiledPat == NULL  || fGroupMap == NULL || fSets == NULL ||
+    if (fCompiledPat == NULL  || fGroupMap == NULL || fMemoSlots == NULL || fSets == NULL ||
             fInitialChars == NULL || fInitialChars8 == NULL) {
         fDeferredStatus = U_MEMORY_ALLOCATION_ERROR;
         return;
@@ -247,6 +265,8 @@ void RegexPattern::zap() {
     fSets8 = NULL;
     delete fGroupMap;
     fGroupMap = NULL;
+    delete fMemoSlots;
+    fMemoSlots = NULL;
     delete fInitialChars;
     fInitialChars = NULL;
     delete fInitialChars8;
@@ -465,6 +485,770 @@ RegexPattern::compile(UText                *regex,
 }
 
 
+//---------------------------------------------------------------------
+//
+//   Serialized form
+//
+//     A data header, with the Unicode version as the data version,
+//     followed by the indexes and then by the arrays that they locate.
+//     The ICU version that wrote the data is one of the indexes; data from
+//     another version is compiled again from its regular expression.
+//
+//---------------------------------------------------------------------
+namespace {
+
+static const UDataInfo serializedDataInfo = {
+    sizeof(UDataInfo),
+    0,
+
+    U_IS_BIG_ENDIAN,
+    U_CHARSET_FAMILY,
+    U_SIZEOF_UCHAR,
+    0,
+
+    { 0x52, 0x65, 0x67, 0x78 },         // dataFormat="Regx"
+    { 1, 0, 0, 0 },                     // formatVersion; change with the compiled pattern ops
+    { 0, 0, 0, 0 }                      // dataVersion, set to the Unicode version
+};
+
+enum {
+    // Values of RegexPattern fields.
+    IX_INDEXES_LENGTH,      // Number of indexes.
+    IX_ICU_VERSION,         // U_ICU_VERSION of the writer, as a UVersionInfo.
+    IX_FLAGS,
+    IX_MIN_MATCH_LEN,
+    IX_FRAME_SIZE,
+    IX_DATA_SIZE,
+    IX_START_TYPE,
+    IX_INITIAL_STRING_IDX,
+    IX_INITIAL_STRING_LEN,
+    IX_INITIAL_CHAR,
+    IX_NEEDS_ALT_INPUT,
+    IX_REQUIRED_STRING_IDX,
+    IX_REQUIRED_STRING_LEN,
+    IX_REQUIRED_MIN_OFFSET,
+    IX_REQUIRED_MAX_OFFSET,
+    IX_REQUIRED_PREFIX_SET,
+    IX_MEMO_SLOT_COUNT,
+
+    // Byte offsets of the arrays from the start of the indexes, in this order.
+    //   Each array ends where the next one begins.
+    IX_COMPILED_PAT_OFFSET,     // int32_t compiled pattern ops.
+    IX_GROUP_MAP_OFFSET,        // int32_t group map.
+    IX_MEMO_SLOTS_OFFSET,       // int32_t memo slots.
+    IX_NAMED_CAPTURES_OFFSET,   // int32_t pairs of group number and name length.
+    IX_SET_LENGTHS_OFFSET,      // int32_t length of each serialized set, in uint16_t units.
+                                //   The initial chars set first, then fSets from index 1.
+    IX_SETS8_OFFSET,            // Regex8BitSet for each of the sets, in the same order.
+    IX_PATTERN_OFFSET,          // UChar regular expression.
+    IX_LITERAL_TEXT_OFFSET,     // UChar literal text.
+    IX_NAMES_OFFSET,            // UChar capture group names.
+    IX_SETS_OFFSET,             // uint16_t serialized UnicodeSets.
+    IX_TOTAL_SIZE,              // End of the data, a multiple of 4.
+
+    IX_COUNT
+};
+
+// Appends serialized data to a destination buffer of limited capacity,
+//   counting the length of whatever does not fit.
+class SerializedPatternWriter : public UMemory {
+public:
+    SerializedPatternWriter(uint8_t *dest, int32_t capacity) :
+        fDest(dest), fCapacity(capacity), fLength(0) {}
+
+    void append(const void *p, int32_t length) {
+        uint8_t *q = reserve(length);
+        if (q != NULL) {
+            uprv_memcpy(q, p, length);
+        }
+    }
+
+    // Returns where to write the next length bytes, or NULL if they do not fit.
+    uint8_t *reserve(int32_t length) {
+        uint8_t *q = fLength + length <= fCapacity ? fDest + fLength : NULL;
+        fLength += length;
+        return q;
+    }
+
+    int32_t length() const { return fLength; }
+
+private:
+    uint8_t *fDest;
+    int32_t  fCapacity;
+    int32_t  fLength;
+};
+
+UBool isSerializedPatternAcceptable(const UDataInfo *pInfo) {
+    return
+        pInfo->size >= 20 &&
+        pInfo->isBigEndian == U_IS_BIG_ENDIAN &&
+        pInfo->charsetFamily == U_CHARSET_FAMILY &&
+        pInfo->sizeofUChar == U_SIZEOF_UCHAR &&
+        pInfo->dataFormat[0] == 0x52 &&     // dataFormat="Regx"
+        pInfo->dataFormat[1] == 0x65 &&
+        pInfo->dataFormat[2] == 0x67 &&
+        pInfo->dataFormat[3] == 0x78 &&
+        pInfo->formatVersion[0] == 1;
+}
+
+// Checks a set serialized by UnicodeSet::serialize(), which the deserializing
+//   UnicodeSet constructor trusts: the header must give the data's length, and the
+//   boundaries must be ascending and not above 0x110000.
+UBool isValidSerializedSet(const uint16_t *data, int32_t length) {
+    int32_t headerSize = (data[0] & 0x8000) != 0 ? 2 : 1;
+    if (length < headerSize || headerSize + (data[0] & 0x7fff) != length) {
+        return FALSE;
+    }
+    int32_t bmpLength = headerSize == 1 ? data[0] : data[1];
+    int32_t listLength = length - headerSize;
+    if (bmpLength > listLength || (listLength - bmpLength) % 2 != 0) {
+        return FALSE;
+    }
+    const uint16_t *list = data + headerSize;
+    UChar32 prev = -1;
+    for (int32_t i = 0; i < listLength; i += i < bmpLength ? 1 : 2) {
+        UChar32 c = i < bmpLength ? list[i] : ((UChar32)list[i] << 16) | list[i + 1];
+        if (c <= prev || c > 0x110000) {
+            return FALSE;
+        }
+        prev = c;
+    }
+    return TRUE;
+}
+
+}  // namespace
+
+
+//---------------------------------------------------------------------
+//
+//   serialize
+//
+//---------------------------------------------------------------------
+int32_t RegexPattern::serialize(uint8_t *dest, int32_t destCapacity, UErrorCode &status) const {
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (U_FAILURE(fDeferredStatus)) {
+        status = fDeferredStatus;
+        return 0;
+    }
+    if (destCapacity < 0 || (destCapacity > 0 && (dest == NULL || ((uintptr_t)dest & 3) != 0))) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+
+    DataHeader header;
+    uprv_memset(&header, 0, sizeof(header));
+    header.dataHeader.headerSize = (uint16_t)sizeof(header);
+    header.dataHeader.magic1 = 0xda;
+    header.dataHeader.magic2 = 0x27;
+    uprv_memcpy(&header.info, &serializedDataInfo, sizeof(UDataInfo));
+    u_getUnicodeVersion(header.info.dataVersion);
+    U_ASSERT((sizeof(header) & 3) == 0);
+
+    int32_t indexes[IX_COUNT];
+    indexes[IX_INDEXES_LENGTH]      = IX_COUNT;
+    UVersionInfo icuVersion;
+    u_getVersion(icuVersion);
+    uprv_memcpy(&indexes[IX_ICU_VERSION], icuVersion, sizeof(UVersionInfo));
+    indexes[IX_FLAGS]               = (int32_t)fFlags;
+    indexes[IX_MIN_MATCH_LEN]       = fMinMatchLen;
+    indexes[IX_FRAME_SIZE]          = fFrameSize;
+    indexes[IX_DATA_SIZE]           = fDataSize;
+    indexes[IX_START_TYPE]          = fStartType;
+    indexes[IX_INITIAL_STRING_IDX]  = fInitialStringIdx;
+    indexes[IX_INITIAL_STRING_LEN]  = fInitialStringLen;
+    indexes[IX_INITIAL_CHAR]        = fInitialChar;
+    indexes[IX_NEEDS_ALT_INPUT]     = fNeedsAltInput;
+    indexes[IX_REQUIRED_STRING_IDX] = fRequiredStringIdx;
+    indexes[IX_REQUIRED_STRING_LEN] = fRequiredStringLen;
+    indexes[IX_REQUIRED_MIN_OFFSET] = fRequiredMinOffset;
+    indexes[IX_REQUIRED_MAX_OFFSET] = fRequiredMaxOffset;
+    indexes[IX_REQUIRED_PREFIX_SET] = fRequiredPrefixSet;
+    indexes[IX_MEMO_SLOT_COUNT]     = fMemoSlotCount;
+
+    SerializedPatternWriter writer(dest, destCapacity);
+    writer.append(&header, (int32_t)sizeof(header));
+    int32_t indexesStart = writer.length();
+    writer.reserve((int32_t)sizeof(indexes));       // Written last, with the offsets filled in.
+
+    // The compiled pattern ops all fit into 32 bits.
+    indexes[IX_COMPILED_PAT_OFFSET] = writer.length() - indexesStart;
+    for (int32_t i = 0; i < fCompiledPat->size(); i++) {
+        int64_t op = fCompiledPat->elementAti(i);
+        if (op != (int32_t)op) {
+            status = U_UNSUPPORTED_ERROR;
+            return 0;
+        }
+        int32_t op32 = (int32_t)op;
+        writer.append(&op32, 4);
+    }
+    indexes[IX_GROUP_MAP_OFFSET] = writer.length() - indexesStart;
+    writer.append(fGroupMap->getBuffer(), fGroupMap->size() * 4);
+    indexes[IX_MEMO_SLOTS_OFFSET] = writer.length() - indexesStart;
+    writer.append(fMemoSlots->getBuffer(), fMemoSlots->size() * 4);
+
+    indexes[IX_NAMED_CAPTURES_OFFSET] = writer.length() - indexesStart;
+    UnicodeString names;
+    if (fNamedCaptureMap != NULL) {
+        int32_t hashPos = UHASH_FIRST;
+        while (const UHashElement *hashEl = uhash_nextElement(fNamedCaptureMap, &hashPos)) {
+            const UnicodeString *name = (const UnicodeString *)hashEl->key.pointer;
+            int32_t pair[2] = { hashEl->value.integer, name->length() };
+            writer.append(pair, (int32_t)sizeof(pair));
+            names.append(*name);
+        }
+    }
+
+    // The sets: the initial chars set, and the sets referenced from the compiled pattern.
+    //   Set zero of fSets is reserved, and NULL.
+    int32_t numSets = fSets->size();
+    indexes[IX_SET_LENGTHS_OFFSET] = writer.length() - indexesStart;
+    for (int32_t i = 0; i < numSets; i++) {
+        const UnicodeSet *set = i == 0 ? fInitialChars : (const UnicodeSet *)fSets->elementAt(i);
+        UErrorCode preflightStatus = U_ZERO_ERROR;
+        int32_t setLength = set->serialize(NULL, 0, preflightStatus);
+        writer.append(&setLength, 4);
+    }
+    indexes[IX_SETS8_OFFSET] = writer.length() - indexesStart;
+    for (int32_t i = 0; i < numSets; i++) {
+        const Regex8BitSet *set8 = i == 0 ? fInitialChars8 : &fSets8[i];
+        writer.append(set8->d, (int32_t)sizeof(set8->d));
+    }
+
+    UnicodeString source = pattern();
+    indexes[IX_PATTERN_OFFSET] = writer.length() - indexesStart;
+    writer.append(source.getBuffer(), source.length() * U_SIZEOF_UCHAR);
+    indexes[IX_LITERAL_TEXT_OFFSET] = writer.length() - indexesStart;
+    writer.append(fLiteralText.getBuffer(), fLiteralText.length() * U_SIZEOF_UCHAR);
+    indexes[IX_NAMES_OFFSET] = writer.length() - indexesStart;
+    writer.append(names.getBuffer(), names.length() * U_SIZEOF_UCHAR);
+
+    indexes[IX_SETS_OFFSET] = writer.length() - indexesStart;
+    for (int32_t i = 0; i < numSets; i++) {
+        const UnicodeSet *set = i == 0 ? fInitialChars : (const UnicodeSet *)fSets->elementAt(i);
+        UErrorCode preflightStatus = U_ZERO_ERROR;
+        int32_t setLength = set->serialize(NULL, 0, preflightStatus);
+        uint16_t *p = (uint16_t *)writer.reserve(setLength * 2);
+        if (p != NULL) {
+            set->serialize(p, setLength, status);
+        }
+    }
+    int32_t padding = (4 - writer.length()) & 3;
+    static const uint8_t zeros[4] = {0, 0, 0, 0};
+    writer.append(zeros, padding);
+    indexes[IX_TOTAL_SIZE] = writer.length() - indexesStart;
+
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (writer.length() > destCapacity) {
+        status = U_BUFFER_OVERFLOW_ERROR;
+    } else {
+        uprv_memcpy(dest + indexesStart, indexes, sizeof(indexes));
+    }
+    return writer.length();
+}
+
+
+//---------------------------------------------------------------------
+//
+//   createFromSerialized
+//
+//---------------------------------------------------------------------
+RegexPattern * U_EXPORT2
+RegexPattern::createFromSerialized(const uint8_t  *data,
+                                   int32_t        length,
+                                   UErrorCode     &status)
+{
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    if (data == NULL || length < (int32_t)sizeof(DataHeader) || ((uintptr_t)data & 3) != 0) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return NULL;
+    }
+    const DataHeader *header = reinterpret_cast<const DataHeader *>(data);
+    int32_t headerLength = header->dataHeader.headerSize;
+    if (!(header->dataHeader.magic1 == 0xda && header->dataHeader.magic2 == 0x27 &&
+            (headerLength & 3) == 0 && headerLength <= length - IX_COUNT * 4 &&
+            isSerializedPatternAcceptable(&header->info))) {
+        status = U_INVALID_FORMAT_ERROR;
+        return NULL;
+    }
+
+    // Check that the arrays are in order, within the data, and whole numbers of their units.
+    const uint8_t *inBytes = data + headerLength;
+    const int32_t *indexes = reinterpret_cast<const int32_t *>(inBytes);
+    int32_t inLength = length - headerLength;
+    if (indexes[IX_INDEXES_LENGTH] < IX_COUNT || indexes[IX_INDEXES_LENGTH] > inLength / 4 ||
+            indexes[IX_COMPILED_PAT_OFFSET] < indexes[IX_INDEXES_LENGTH] * 4 ||
+            indexes[IX_TOTAL_SIZE] > inLength) {
+        status = U_INVALID_FORMAT_ERROR;
+        return NULL;
+    }
+    for (int32_t i = IX_COMPILED_PAT_OFFSET; i < IX_TOTAL_SIZE; i++) {
+        int32_t unitSize = i < IX_SETS8_OFFSET ? 4 : i == IX_SETS8_OFFSET ? 32 : 2;
+        if (indexes[i + 1] < indexes[i] || (indexes[i + 1] - indexes[i]) % unitSize != 0) {
+            status = U_INVALID_FORMAT_ERROR;
+            return NULL;
+        }
+    }
+    const int32_t *namedCaptures = reinterpret_cast<const int32_t *>(inBytes + indexes[IX_NAMED_CAPTURES_OFFSET]);
+    const int32_t *setLengths = reinterpret_cast<const int32_t *>(inBytes + indexes[IX_SET_LENGTHS_OFFSET]);
+    const UChar   *names = reinterpret_cast<const UChar *>(inBytes + indexes[IX_NAMES_OFFSET]);
+    const uint16_t *sets = reinterpret_cast<const uint16_t *>(inBytes + indexes[IX_SETS_OFFSET]);
+    int32_t namedCapturesLength = (indexes[IX_SET_LENGTHS_OFFSET] - indexes[IX_NAMED_CAPTURES_OFFSET]) / 8;
+    int32_t numSets = (indexes[IX_SETS8_OFFSET] - indexes[IX_SET_LENGTHS_OFFSET]) / 4;
+    int32_t namesLength = (indexes[IX_SETS_OFFSET] - indexes[IX_NAMES_OFFSET]) / 2;
+    int32_t setsLength = (indexes[IX_TOTAL_SIZE] - indexes[IX_SETS_OFFSET]) / 2;
+    if (numSets < 1 || numSets != (indexes[IX_PATTERN_OFFSET] - indexes[IX_SETS8_OFFSET]) / 32) {
+        status = U_INVALID_FORMAT_ERROR;
+        return NULL;
+    }
+    for (int32_t i = 0; i < namedCapturesLength; i++) {
+        int32_t nameLength = namedCaptures[i * 2 + 1];
+        if (nameLength < 0 || nameLength > namesLength) {
+            status = U_INVALID_FORMAT_ERROR;
+            return NULL;
+        }
+        namesLength -= nameLength;
+    }
+    for (int32_t i = 0, setsOffset = 0; i < numSets; i++) {
+        if (setLengths[i] < 1 || setLengths[i] > setsLength ||
+                !isValidSerializedSet(sets + setsOffset, setLengths[i])) {
+            status = U_INVALID_FORMAT_ERROR;
+            return NULL;
+        }
+        setsLength -= setLengths[i];
+        setsOffset += setLengths[i];
+    }
+
+    UnicodeString source(FALSE, reinterpret_cast<const UChar *>(inBytes + indexes[IX_PATTERN_OFFSET]),
+                         (indexes[IX_LITERAL_TEXT_OFFSET] - indexes[IX_PATTERN_OFFSET]) / 2);
+    UVersionInfo icuVersion, unicodeVersion;
+    u_getVersion(icuVersion);
+    u_getUnicodeVersion(unicodeVersion);
+    if (uprv_memcmp(&indexes[IX_ICU_VERSION], icuVersion, sizeof(UVersionInfo)) != 0 ||
+            uprv_memcmp(header->info.dataVersion, unicodeVersion, sizeof(UVersionInfo)) != 0) {
+        // Written by another version of ICU, whose compiled pattern ops may differ,
+        //   or with other Unicode data. Compile the regular expression again.
+        return compile(source, (uint32_t)indexes[IX_FLAGS], status);
+    }
+
+    RegexStaticSets::initGlobals(&status);
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    LocalPointer<RegexPattern> This(new RegexPattern, status);
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    if (U_FAILURE(This->fDeferredStatus)) {
+        status = This->fDeferredStatus;
+        return NULL;
+    }
+
+    This->fFlags             = (uint32_t)indexes[IX_FLAGS];
+    This->fMinMatchLen       = indexes[IX_MIN_MATCH_LEN];
+    This->fFrameSize         = indexes[IX_FRAME_SIZE];
+    This->fDataSize          = indexes[IX_DATA_SIZE];
+    This->fStartType         = indexes[IX_START_TYPE];
+    This->fInitialStringIdx  = indexes[IX_INITIAL_STRING_IDX];
+    This->fInitialStringLen  = indexes[IX_INITIAL_STRING_LEN];
+    This->fInitialChar       = indexes[IX_INITIAL_CHAR];
+    This->fNeedsAltInput     = (UBool)indexes[IX_NEEDS_ALT_INPUT];
+    This->fRequiredStringIdx = indexes[IX_REQUIRED_STRING_IDX];
+    This->fRequiredStringLen = indexes[IX_REQUIRED_STRING_LEN];
+    This->fRequiredMinOffset = indexes[IX_REQUIRED_MIN_OFFSET];
+    This->fRequiredMaxOffset = indexes[IX_REQUIRED_MAX_OFFSET];
+    This->fRequiredPrefixSet = indexes[IX_REQUIRED_PREFIX_SET];
+    This->fMemoSlotCount     = indexes[IX_MEMO_SLOT_COUNT];
+    This->fStaticSets        = RegexStaticSets::gStaticSets->fPropSets;
+    This->fStaticSets8       = RegexStaticSets::gStaticSets->fPropSets8;
+
+    This->fPatternString = new UnicodeString(source);
+    if (This->fPatternString == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    This->fPattern = utext_openConstUnicodeString(NULL, This->fPatternString, &status);
+    This->fLiteralText.setTo(reinterpret_cast<const UChar *>(inBytes + indexes[IX_LITERAL_TEXT_OFFSET]),
+                             (indexes[IX_NAMES_OFFSET] - indexes[IX_LITERAL_TEXT_OFFSET]) / 2);
+
+    const int32_t *compiledPat = reinterpret_cast<const int32_t *>(inBytes + indexes[IX_COMPILED_PAT_OFFSET]);
+    int32_t compiledPatLength = (indexes[IX_GROUP_MAP_OFFSET] - indexes[IX_COMPILED_PAT_OFFSET]) / 4;
+    int64_t *pat = This->fCompiledPat->reserveBlock(compiledPatLength, status);
+    int32_t groupMapLength = (indexes[IX_MEMO_SLOTS_OFFSET] - indexes[IX_GROUP_MAP_OFFSET]) / 4;
+    int32_t *groupMap = This->fGroupMap->reserveBlock(groupMapLength, status);
+    int32_t memoSlotsLength = (indexes[IX_NAMED_CAPTURES_OFFSET] - indexes[IX_MEMO_SLOTS_OFFSET]) / 4;
+    int32_t *memoSlots = This->fMemoSlots->reserveBlock(memoSlotsLength, status);
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    for (int32_t i = 0; i < compiledPatLength; i++) {
+        pat[i] = compiledPat[i];
+    }
+    uprv_memcpy(groupMap, inBytes + indexes[IX_GROUP_MAP_OFFSET], groupMapLength * 4);
+    uprv_memcpy(memoSlots, inBytes + indexes[IX_MEMO_SLOTS_OFFSET], memoSlotsLength * 4);
+
+    for (int32_t i = 0; i < namedCapturesLength && U_SUCCESS(status); i++) {
+        int32_t nameLength = namedCaptures[i * 2 + 1];
+        if (!This->initNamedCaptureMap()) {
+            status = This->fDeferredStatus;
+            return NULL;
+        }
+        UnicodeString *name = new UnicodeString(names, nameLength);
+        if (name == NULL) {
+            status = U_MEMORY_ALLOCATION_ERROR;
+            return NULL;
+        }
+        uhash_puti(This->fNamedCaptureMap, name, namedCaptures[i * 2], &status);
+        names += nameLength;
+    }
+
+    // Note:  init() already added the reserved, empty element zero to fSets.
+    const Regex8BitSet *sets8 = reinterpret_cast<const Regex8BitSet *>(inBytes + indexes[IX_SETS8_OFFSET]);
+    This->fSets8 = new Regex8BitSet[numSets];
+    if (This->fSets8 == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    for (int32_t i = 0; i < numSets && U_SUCCESS(status); i++) {
+        if (i == 0) {
+            *This->fInitialChars = UnicodeSet(sets, setLengths[i], UnicodeSet::kSerialized, status);
+            *This->fInitialChars8 = sets8[i];
+        } else {
+            UnicodeSet *set = new UnicodeSet(sets, setLengths[i], UnicodeSet::kSerialized, status);
+            if (set == NULL) {
+                status = U_MEMORY_ALLOCATION_ERROR;
+                break;
+            }
+            This->fSets->addElement(set, status);
+            This->fSets8[i] = sets8[i];
+        }
+        sets += setLengths[i];
+    }
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    if (!This->isValidLoadedPattern()) {
+        status = U_INVALID_FORMAT_ERROR;
+        return NULL;
+    }
+    return This.orphan();
+}
+
+
+//---------------------------------------------------------------------
+//
+//   isValidLoadedPattern    Checks the fields and the compiled pattern ops
+//                           of a pattern made by createFromSerialized().
+//
+//                           The matcher trusts the compiler's output. Data that
+//                           did not come from serialize() must not make it read
+//                           or write outside of the pattern's arrays, or outside
+//                           of the matcher's stack frames and static data.
+//                           So every index, offset, slot and jump target is
+//                           checked against what it refers to, and the ops
+//                           that work together must appear together, the way
+//                           the compiler emits them.
+//
+//---------------------------------------------------------------------
+UBool RegexPattern::isValidLoadedPattern() const {
+    const int64_t *pat     = fCompiledPat->getBuffer();
+    int32_t patLength      = fCompiledPat->size();
+    int32_t literalLength  = fLiteralText.length();
+    int32_t numSets        = fSets->size();
+    int32_t extraSize      = fFrameSize - RESTACKFRAME_HDRCOUNT;    // Size of REStackFrame::fExtra.
+    if (patLength < 1 || fMinMatchLen < 0 ||
+            extraSize < 0 || extraSize >= 0x00fffff0 || fDataSize < 0 || fDataSize >= 0x00fffff0) {
+        return FALSE;
+    }
+
+    // How a match starts, and what find() searches for.
+    if (fInitialStringIdx < 0 || fInitialStringLen < 0 ||
+            fInitialStringLen > literalLength - fInitialStringIdx) {
+        return FALSE;
+    }
+    switch (fStartType) {
+    case START_NO_INFO:
+    case START_SET:
+    case START_START:
+    case START_LINE:
+        break;
+    case START_STRING:
+        if (fInitialStringLen == 0) {
+            return FALSE;
+        }
+        U_FALLTHROUGH;
+    case START_CHAR:
+        if (fInitialChar < 0 || fInitialChar > 0x10ffff) {
+            return FALSE;
+        }
+        break;
+    default:
+        return FALSE;
+    }
+    if (fRequiredStringLen != 0 &&
+            (fRequiredStringIdx < 0 || fRequiredStringLen < 0 ||
+             fRequiredStringLen > literalLength - fRequiredStringIdx ||
+             fRequiredMinOffset < 0 || fRequiredMaxOffset < 0)) {
+        return FALSE;
+    }
+    if (fRequiredPrefixSet != -1 && (fRequiredPrefixSet < 1 || fRequiredPrefixSet >= numSets)) {
+        return FALSE;
+    }
+
+    // Capture groups: each has three stack frame slots; see URX_START_CAPTURE.
+    int32_t numGroups = fGroupMap->size();
+    for (int32_t i = 0; i < numGroups; i++) {
+        int32_t frameLoc = fGroupMap->elementAti(i);
+        if (frameLoc < 0 || frameLoc + 2 >= extraSize) {
+            return FALSE;
+        }
+    }
+    if (fNamedCaptureMap != NULL) {
+        int32_t hashPos = UHASH_FIRST;
+        while (const UHashElement *hashEl = uhash_nextElement(fNamedCaptureMap, &hashPos)) {
+            if (hashEl->value.integer < 1 || hashEl->value.integer > numGroups) {
+                return FALSE;
+            }
+        }
+    }
+
+    // Memo slots: none, or one per op.
+    int32_t memoSlotsLength = fMemoSlots->size();
+    if (fMemoSlotCount < 0 || fMemoSlotCount > patLength ||
+            (memoSlotsLength == 0 ? fMemoSlotCount != 0 : memoSlotsLength != patLength)) {
+        return FALSE;
+    }
+    for (int32_t loc = 0; loc < memoSlotsLength; loc++) {
+        int32_t slot = fMemoSlots->elementAti(loc);
+        if (slot < -1 || slot >= fMemoSlotCount) {
+            return FALSE;
+        }
+    }
+
+    // The compiled pattern ops, in two passes.
+    //   The first one finds where each op starts, and checks the operands that
+    //   refer to sets, strings, frame slots and data slots.
+    //   An op that restores the stack or the input region from data slots
+    //   must come after an op that saves them there.
+    //   The second one checks the operands that refer to other ops.
+    MaybeStackArray<UBool, 256> isOpStart;
+    MaybeStackArray<UBool, 64> isSaved;
+    if (isOpStart.resize(patLength) == NULL || (fDataSize > 0 && isSaved.resize(fDataSize) == NULL)) {
+        return FALSE;
+    }
+    uprv_memset(isOpStart.getAlias(), 0, patLength * sizeof(UBool));
+    uprv_memset(isSaved.getAlias(), 0, fDataSize * sizeof(UBool));
+    int32_t loc = 0;
+    while (loc < patLength) {
+        isOpStart[loc] = TRUE;
+        int32_t op    = (int32_t)pat[loc];
+        int32_t value = URX_VAL(op);
+        int32_t opLength = 1;
+        UBool isValid;
+        switch (URX_TYPE(op)) {
+        case URX_BACKTRACK:
+        case URX_END:
+        case URX_NOP:
+        case URX_DOTANY:
+        case URX_FAIL:
+        case URX_BACKSLASH_B:
+        case URX_BACKSLASH_G:
+        case URX_BACKSLASH_X:
+        case URX_BACKSLASH_Z:
+        case URX_DOTANY_ALL:
+        case URX_BACKSLASH_D:
+        case URX_CARET:
+        case URX_DOLLAR:
+        case URX_DOTANY_UNIX:
+        case URX_CARET_M_UNIX:
+        case URX_DOLLAR_M:
+        case URX_CARET_M:
+        case URX_BACKSLASH_BU:
+        case URX_DOLLAR_D:
+        case URX_DOLLAR_MD:
+        case URX_BACKSLASH_H:
+        case URX_BACKSLASH_R:
+        case URX_BACKSLASH_V:
+        case URX_STATE_SAVE:
+        case URX_JMP:
+        case URX_JMP_SAV:
+        case URX_JMP_SAV_X:
+        case URX_CTR_LOOP:
+        case URX_CTR_LOOP_NG:
+        case URX_LOOP_DOT_I:
+            isValid = TRUE;
+            break;
+        case URX_ONECHAR:
+        case URX_ONECHAR_I:
+            isValid = value <= 0x10ffff;
+            break;
+        case URX_STRING:
+        case URX_STRING_I:
+            // Start index of the string in fLiteralText, followed by its length.
+            opLength = 2;
+            isValid = loc + 1 < patLength && URX_TYPE(pat[loc + 1]) == URX_STRING_LEN &&
+                      URX_VAL(pat[loc + 1]) <= literalLength - value;
+            break;
+        case URX_START_CAPTURE:
+        case URX_END_CAPTURE:
+            isValid = value + 2 < extraSize;
+            break;
+        case URX_STATIC_SETREF:
+            value &= ~URX_NEG_SET;
+            U_FALLTHROUGH;
+        case URX_STAT_SETREF_N:
+            isValid = value > 0 && value < URX_LAST_SET;
+            break;
+        case URX_SETREF:
+            isValid = value > 0 && value < numSets;
+            break;
+        case URX_LOOP_SR_I:
+            // Followed by the URX_LOOP_C, which is checked on its own.
+            isValid = value > 0 && value < numSets;
+            break;
+        case URX_LOOP_C:
+            isValid = value < extraSize;
+            break;
+        case URX_CTR_INIT:
+        case URX_CTR_INIT_NG:
+            // The counter, and if the loop is unbounded the input position at the last
+            //   iteration, followed by the location of the CTR_LOOP, and by the min and max counts.
+            opLength = 4;
+            isValid = loc + 3 < patLength && value + (pat[loc + 3] == -1 ? 1 : 0) < extraSize &&
+                      URX_TYPE(pat[loc + 1]) == URX_RELOC_OPRND &&
+                      pat[loc + 2] >= 0 &&
+                      (pat[loc + 3] >= pat[loc + 2] || pat[loc + 3] == -1);
+            break;
+        case URX_STO_SP:
+            isValid = value < fDataSize;
+            if (isValid) {
+                isSaved[value] = TRUE;
+            }
+            break;
+        case URX_LD_SP:
+            isValid = value < fDataSize && isSaved[value];
+            break;
+        case URX_BACKREF:
+        case URX_BACKREF_I:
+            // The matcher has a second input text only for patterns with back references.
+            isValid = value + 1 < extraSize && fNeedsAltInput;
+            break;
+        case URX_STO_INP_LOC:
+            isValid = value < extraSize;
+            break;
+        case URX_JMPX:
+            // Followed by the frame slot with the input position at the loop start.
+            opLength = 2;
+            isValid = loc + 1 < patLength && URX_VAL(pat[loc + 1]) < extraSize;
+            break;
+        case URX_LA_START:
+            isValid = value + 3 < fDataSize;
+            if (isValid) {
+                isSaved[value] = TRUE;
+            }
+            break;
+        case URX_LA_END:
+            isValid = value + 3 < fDataSize && isSaved[value];
+            break;
+        case URX_LB_START:
+            isValid = value + 4 < fDataSize;
+            if (isValid) {
+                isSaved[value] = TRUE;
+            }
+            break;
+        case URX_LB_END:
+        case URX_LBN_END:
+            isValid = value + 4 < fDataSize && isSaved[value];
+            break;
+        case URX_LB_CONT:
+        case URX_LBN_CONT:
+            // Followed by the min and max match lengths,
+            //   and for URX_LBN_CONT by the location after the look-behind block.
+            opLength = URX_TYPE(op) == URX_LB_CONT ? 3 : 4;
+            isValid = value + 4 < fDataSize && isSaved[value] && loc + opLength <= patLength &&
+                      pat[loc + 1] >= 0 && pat[loc + 2] >= pat[loc + 1] &&
+                      pat[loc + 2] <= INT32_MAX / 3;
+            break;
+        default:
+            isValid = FALSE;
+            break;
+        }
+        if (!isValid) {
+            return FALSE;
+        }
+        loc += opLength;
+    }
+    if (loc != patLength || URX_TYPE(pat[patLength - 1]) != URX_END) {
+        // The last op must be the URX_END, and not an operand of another op.
+        return FALSE;
+    }
+
+    for (loc = 0; loc < patLength; loc++) {
+        if (!isOpStart[loc]) {
+            continue;
+        }
+        int32_t op     = (int32_t)pat[loc];
+        int32_t target = URX_VAL(op);
+        UBool isValid;
+        switch (URX_TYPE(op)) {
+        case URX_STATE_SAVE:
+        case URX_JMP:
+        case URX_JMP_SAV:
+        case URX_JMPX:
+            isValid = target < patLength && isOpStart[target];
+            break;
+        case URX_JMP_SAV_X:
+            // Jumps to the op after the URX_STO_INP_LOC that saved the input position.
+            isValid = target > 0 && target < patLength && isOpStart[target] &&
+                      isOpStart[target - 1] && URX_TYPE(pat[target - 1]) == URX_STO_INP_LOC;
+            break;
+        case URX_CTR_INIT:
+        case URX_CTR_INIT_NG:
+            {
+                // The loop op refers back to this one, and the match can continue after it.
+                int32_t loopLoc  = URX_VAL(pat[loc + 1]);
+                uint32_t loopType = URX_TYPE(op) == URX_CTR_INIT ? URX_CTR_LOOP : URX_CTR_LOOP_NG;
+                isValid = loopLoc > loc && loopLoc + 1 < patLength && isOpStart[loopLoc] &&
+                          URX_TYPE(pat[loopLoc]) == loopType && URX_VAL(pat[loopLoc]) == loc;
+            }
+            break;
+        case URX_CTR_LOOP:
+        case URX_CTR_LOOP_NG:
+            {
+                uint32_t initType = URX_TYPE(op) == URX_CTR_LOOP ? URX_CTR_INIT : URX_CTR_INIT_NG;
+                isValid = target < loc && isOpStart[target] && URX_TYPE(pat[target]) == initType;
+            }
+            break;
+        case URX_LOOP_SR_I:
+        case URX_LOOP_DOT_I:
+            isValid = loc + 1 < patLength && URX_TYPE(pat[loc + 1]) == URX_LOOP_C;
+            break;
+        case URX_LOOP_C:
+            isValid = loc > 0 && isOpStart[loc - 1] &&
+                      (URX_TYPE(pat[loc - 1]) == URX_LOOP_SR_I ||
+                       URX_TYPE(pat[loc - 1]) == URX_LOOP_DOT_I);
+            break;
+        case URX_LBN_CONT:
+            target = URX_VAL(pat[loc + 3]);
+            isValid = target > loc && target < patLength && isOpStart[target];
+            break;
+        default:
+            isValid = TRUE;
+            break;
+        }
+        if (!isValid) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+
 //---------------------------------------------------------------------
 //
 //   flags
@@ -848,6 +1632,11 @@ void RegexPattern::dumpPattern() const {
                 printf("%#x\n", fInitialChar);
             }
     }
+    if (fRequiredStringLen > 0) {
+        UnicodeString requiredString(fLiteralText, fRequiredStringIdx, fRequiredStringLen);
+        printf("   Required string: \"%s\" at offset %d..%d, prefix set %d\n", CStr(requiredString)(),
+               fRequiredMinOffset, fRequiredMaxOffset, fRequiredPrefixSet);
+    }
 
     printf("Named Capture Groups:\n");
     if (!fNamedCaptureMap || uhash_count(fNamedCaptureMap) == 0) {
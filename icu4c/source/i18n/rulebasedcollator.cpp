@@ -39,6 +39,7 @@
 #include "collationdata.h"
 #include "collationdatareader.h"
 #include "collationfastlatin.h"
+#include "collationfastscript.h"
 #include "collationiterator.h"
 #include "collationkeys.h"
 #include "collationroot.h"
@@ -694,6 +695,9 @@ RuleBasedCollator::setFastLatinOptions(CollationSettings &ownedSettings) const {
     ownedSettings.fastLatinOptions = CollationFastLatin::getOptions(
             data, ownedSettings,
             ownedSettings.fastLatinPrimaries, UPRV_LENGTHOF(ownedSettings.fastLatinPrimaries));
+    CollationFastScript::getOptions(
+            data, ownedSettings,
+            ownedSettings.fastScriptOptions, UPRV_LENGTHOF(ownedSettings.fastScriptOptions));
 }
 
 UCollationResult
@@ -701,7 +705,7 @@ RuleBasedCollator::compare(const UnicodeString &left, const UnicodeString &right
                            UErrorCode &errorCode) const {
     if(U_FAILURE(errorCode)) { return UCOL_EQUAL; }
     return doCompare(left.getBuffer(), left.length(),
-                     right.getBuffer(), right.length(), errorCode);
+                     right.getBuffer(), right.length(), NULL, NULL, errorCode);
 }
 
 UCollationResult
@@ -717,7 +721,7 @@ RuleBasedCollator::compare(const UnicodeString &left, const UnicodeString &right
     if(leftLength > length) { leftLength = length; }
     if(rightLength > length) { rightLength = length; }
     return doCompare(left.getBuffer(), leftLength,
-                     right.getBuffer(), rightLength, errorCode);
+                     right.getBuffer(), rightLength, NULL, NULL, errorCode);
 }
 
 UCollationResult
@@ -736,7 +740,7 @@ RuleBasedCollator::compare(const UChar *left, int32_t leftLength,
     } else {
         if(rightLength >= 0) { leftLength = u_strlen(left); }
     }
-    return doCompare(left, leftLength, right, rightLength, errorCode);
+    return doCompare(left, leftLength, right, rightLength, NULL, NULL, errorCode);
 }
 
 UCollationResult
@@ -749,7 +753,8 @@ RuleBasedCollator::compareUTF8(const StringPiece &left, const StringPiece &right
         errorCode = U_ILLEGAL_ARGUMENT_ERROR;
         return UCOL_EQUAL;
     }
-    return doCompare(leftBytes, left.length(), rightBytes, right.length(), errorCode);
+    return doCompare(leftBytes, left.length(), rightBytes, right.length(),
+                     NULL, NULL, errorCode);
 }
 
 UCollationResult
@@ -769,7 +774,99 @@ RuleBasedCollator::internalCompareUTF8(const char *left, int32_t leftLength,
         if(rightLength >= 0) { leftLength = static_cast<int32_t>(uprv_strlen(left)); }
     }
     return doCompare(reinterpret_cast<const uint8_t *>(left), leftLength,
-                     reinterpret_cast<const uint8_t *>(right), rightLength, errorCode);
+                     reinterpret_cast<const uint8_t *>(right), rightLength,
+                     NULL, NULL, errorCode);
+}
+
+void
+RuleBasedCollator::compareBatch(const UChar *const sources[], const int32_t sourceLengths[],
+                                const UChar *const targets[], const int32_t targetLengths[],
+                                int32_t count, UCollationResult results[],
+                                UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) { return; }
+    if(count < 0 || (count > 0 && (sources == NULL || targets == NULL || results == NULL))) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    // One pair of collation iterators for the whole batch:
+    // Each comparison that gets past the fast paths resets them to its strings
+    // rather than constructing new ones, and their CE and normalization buffers
+    // keep the capacity that earlier pairs needed.
+    UBool numeric = settings->isNumeric();
+    UTF16CollationIterator leftIter(data, numeric, NULL, NULL, NULL);
+    UTF16CollationIterator rightIter(data, numeric, NULL, NULL, NULL);
+    FCDUTF16CollationIterator leftFCDIter(data, numeric, NULL, NULL, NULL);
+    FCDUTF16CollationIterator rightFCDIter(data, numeric, NULL, NULL, NULL);
+    CollationIterator *left, *right;
+    if(settings->dontCheckFCD()) {
+        left = &leftIter;
+        right = &rightIter;
+    } else {
+        left = &leftFCDIter;
+        right = &rightFCDIter;
+    }
+    for(int32_t i = 0; i < count && U_SUCCESS(errorCode); ++i) {
+        const UChar *source = sources[i];
+        const UChar *target = targets[i];
+        int32_t sourceLength = sourceLengths != NULL ? sourceLengths[i] : -1;
+        int32_t targetLength = targetLengths != NULL ? targetLengths[i] : -1;
+        if((source == NULL && sourceLength != 0) || (target == NULL && targetLength != 0)) {
+            errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+            break;
+        }
+        // Same as in compare(): Both or neither strings have a known length.
+        if(sourceLength >= 0) {
+            if(targetLength < 0) { targetLength = u_strlen(target); }
+        } else {
+            if(targetLength >= 0) { sourceLength = u_strlen(source); }
+        }
+        results[i] = doCompare(source, sourceLength, target, targetLength,
+                               left, right, errorCode);
+    }
+}
+
+void
+RuleBasedCollator::compareBatchUTF8(const char *const sources[], const int32_t sourceLengths[],
+                                    const char *const targets[], const int32_t targetLengths[],
+                                    int32_t count, UCollationResult results[],
+                                    UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) { return; }
+    if(count < 0 || (count > 0 && (sources == NULL || targets == NULL || results == NULL))) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    // See compareBatch().
+    UBool numeric = settings->isNumeric();
+    UTF8CollationIterator leftIter(data, numeric, NULL, 0, 0);
+    UTF8CollationIterator rightIter(data, numeric, NULL, 0, 0);
+    FCDUTF8CollationIterator leftFCDIter(data, numeric, NULL, 0, 0);
+    FCDUTF8CollationIterator rightFCDIter(data, numeric, NULL, 0, 0);
+    CollationIterator *left, *right;
+    if(settings->dontCheckFCD()) {
+        left = &leftIter;
+        right = &rightIter;
+    } else {
+        left = &leftFCDIter;
+        right = &rightFCDIter;
+    }
+    for(int32_t i = 0; i < count && U_SUCCESS(errorCode); ++i) {
+        const char *source = sources[i];
+        const char *target = targets[i];
+        int32_t sourceLength = sourceLengths != NULL ? sourceLengths[i] : -1;
+        int32_t targetLength = targetLengths != NULL ? targetLengths[i] : -1;
+        if((source == NULL && sourceLength != 0) || (target == NULL && targetLength != 0)) {
+            errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+            break;
+        }
+        if(sourceLength >= 0) {
+            if(targetLength < 0) { targetLength = static_cast<int32_t>(uprv_strlen(target)); }
+        } else {
+            if(targetLength >= 0) { sourceLength = static_cast<int32_t>(uprv_strlen(source)); }
+        }
+        results[i] = doCompare(reinterpret_cast<const uint8_t *>(source), sourceLength,
+                               reinterpret_cast<const uint8_t *>(target), targetLength,
+                               left, right, errorCode);
+    }
 }
 
 namespace {
@@ -967,6 +1064,7 @@ UCollationResult compareNFDIter(const Normalizer2Impl &nfcImpl,
 UCollationResult
 RuleBasedCollator::doCompare(const UChar *left, int32_t leftLength,
                              const UChar *right, int32_t rightLength,
+                             CollationIterator *leftIter, CollationIterator *rightIter,
                              UErrorCode &errorCode) const {
     // U_FAILURE(errorCode) checked by caller.
     if(left == right && leftLength == rightLength) {
@@ -1046,6 +1144,41 @@ RuleBasedCollator::doCompare(const UChar *left, int32_t leftLength,
     }
 
     if(result == CollationFastLatin::BAIL_OUT_RESULT) {
+        // Try the fastpath for the script of the first difference.
+        int32_t fastScript = -1;
+        if(equalPrefixLength != leftLength) {
+            fastScript = CollationFastScript::getScript(left[equalPrefixLength]);
+        }
+        if(fastScript < 0 && equalPrefixLength != rightLength) {
+            fastScript = CollationFastScript::getScript(right[equalPrefixLength]);
+        }
+        int32_t fastScriptOptions;
+        const uint16_t *table;
+        if(fastScript >= 0 &&
+                (table = getFastScriptTable(fastScript, fastScriptOptions, errorCode)) != NULL) {
+            result = CollationFastScript::compareUTF16(
+                    table, fastScript, fastScriptOptions,
+                    left + equalPrefixLength,
+                    leftLength >= 0 ? leftLength - equalPrefixLength : -1,
+                    right + equalPrefixLength,
+                    rightLength >= 0 ? rightLength - equalPrefixLength : -1);
+        }
+    }
+
+    if(result == CollationFastLatin::BAIL_OUT_RESULT && leftIter != NULL) {
+        if(settings->dontCheckFCD()) {
+            static_cast<UTF16CollationIterator *>(leftIter)->setText(
+                    left, left + equalPrefixLength, leftLimit);
+            static_cast<UTF16CollationIterator *>(rightIter)->setText(
+                    right, right + equalPrefixLength, rightLimit);
+        } else {
+            static_cast<FCDUTF16CollationIterator *>(leftIter)->setText(
+                    left, left + equalPrefixLength, leftLimit);
+            static_cast<FCDUTF16CollationIterator *>(rightIter)->setText(
+                    right, right + equalPrefixLength, rightLimit);
+        }
+        result = CollationCompare::compareUpToQuaternary(*leftIter, *rightIter, *settings, errorCode);
+    } else if(result == CollationFastLatin::BAIL_OUT_RESULT) {
         if(settings->dontCheckFCD()) {
             UTF16CollationIterator leftIter(data, numeric,
                                             left, left + equalPrefixLength, leftLimit);
@@ -1086,6 +1219,7 @@ RuleBasedCollator::doCompare(const UChar *left, int32_t leftLength,
 UCollationResult
 RuleBasedCollator::doCompare(const uint8_t *left, int32_t leftLength,
                              const uint8_t *right, int32_t rightLength,
+                             CollationIterator *leftIter, CollationIterator *rightIter,
                              UErrorCode &errorCode) const {
     // U_FAILURE(errorCode) checked by caller.
     if(left == right && leftLength == rightLength) {
@@ -1175,6 +1309,41 @@ RuleBasedCollator::doCompare(const uint8_t *left, int32_t leftLength,
     }
 
     if(result == CollationFastLatin::BAIL_OUT_RESULT) {
+        // Try the fastpath for the script of the first difference.
+        int32_t fastScript = -1;
+        if(equalPrefixLength != leftLength) {
+            fastScript = CollationFastScript::getScriptFromUTF8Lead(left[equalPrefixLength]);
+        }
+        if(fastScript < 0 && equalPrefixLength != rightLength) {
+            fastScript = CollationFastScript::getScriptFromUTF8Lead(right[equalPrefixLength]);
+        }
+        int32_t fastScriptOptions;
+        const uint16_t *table;
+        if(fastScript >= 0 &&
+                (table = getFastScriptTable(fastScript, fastScriptOptions, errorCode)) != NULL) {
+            result = CollationFastScript::compareUTF8(
+                    table, fastScript, fastScriptOptions,
+                    left + equalPrefixLength,
+                    leftLength >= 0 ? leftLength - equalPrefixLength : -1,
+                    right + equalPrefixLength,
+                    rightLength >= 0 ? rightLength - equalPrefixLength : -1);
+        }
+    }
+
+    if(result == CollationFastLatin::BAIL_OUT_RESULT && leftIter != NULL) {
+        if(settings->dontCheckFCD()) {
+            static_cast<UTF8CollationIterator *>(leftIter)->setText(
+                    left, equalPrefixLength, leftLength);
+            static_cast<UTF8CollationIterator *>(rightIter)->setText(
+                    right, equalPrefixLength, rightLength);
+        } else {
+            static_cast<FCDUTF8CollationIterator *>(leftIter)->setText(
+                    left, equalPrefixLength, leftLength);
+            static_cast<FCDUTF8CollationIterator *>(rightIter)->setText(
+                    right, equalPrefixLength, rightLength);
+        }
+        result = CollationCompare::compareUpToQuaternary(*leftIter, *rightIter, *settings, errorCode);
+    } else if(result == CollationFastLatin::BAIL_OUT_RESULT) {
         if(settings->dontCheckFCD()) {
             UTF8CollationIterator leftIter(data, numeric, left, equalPrefixLength, leftLength);
             UTF8CollationIterator rightIter(data, numeric, right, equalPrefixLength, rightLength);
@@ -1328,6 +1497,46 @@ RuleBasedCollator::getSortKey(const UChar *s, int32_t length,
     return U_SUCCESS(errorCode) ? sink.NumberOfBytesAppended() : 0;
 }
 
+int32_t
+RuleBasedCollator::getSortKeys(const UChar *const strings[], const int32_t lengths[],
+                               int32_t count, uint8_t *dest, int32_t destCapacity,
+                               int32_t offsets[], UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) { return 0; }
+    if(count < 0 || (count > 0 && strings == NULL) || offsets == NULL ||
+            destCapacity < 0 || (dest == NULL && destCapacity > 0)) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    uint8_t noDest[1] = { 0 };
+    if(dest == NULL) {
+        dest = noDest;
+        destCapacity = 0;
+    }
+    // Append all of the keys to one sink. Each key ends with a terminator byte,
+    // and the sink keeps counting bytes beyond its capacity for preflighting.
+    FixedSortKeyByteSink sink(reinterpret_cast<char *>(dest), destCapacity);
+    offsets[0] = 0;
+    for(int32_t i = 0; i < count; ++i) {
+        const UChar *s = strings[i];
+        int32_t length = lengths != NULL ? lengths[i] : -1;
+        if(s == NULL) {
+            if(length != 0) {
+                errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+                return 0;
+            }
+            s = u"";  // writeSortKey() needs a non-NULL empty string
+        }
+        writeSortKey(s, length, sink, errorCode);
+        if(U_FAILURE(errorCode)) { return 0; }
+        offsets[i + 1] = sink.NumberOfBytesAppended();
+    }
+    int32_t totalLength = sink.NumberOfBytesAppended();
+    if(totalLength > destCapacity) {
+        errorCode = U_BUFFER_OVERFLOW_ERROR;
+    }
+    return totalLength;
+}
+
 void
 RuleBasedCollator::writeSortKey(const UChar *s, int32_t length,
                                 SortKeyByteSink &sink, UErrorCode &errorCode) const {
@@ -1622,6 +1831,24 @@ RuleBasedCollator::initMaxExpansions(UErrorCode &errorCode) const {
     return U_SUCCESS(errorCode);
 }
 
+void U_CALLCONV
+RuleBasedCollator::computeFastScriptTables(const CollationTailoring *t, UErrorCode &errorCode) {
+    t->fastScriptTables = new CollationFastScriptTables(*t->data, errorCode);
+    if(t->fastScriptTables == NULL) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+    }
+}
+
+const uint16_t *
+RuleBasedCollator::getFastScriptTable(int32_t script, int32_t &options,
+                                      UErrorCode &errorCode) const {
+    options = settings->fastScriptOptions[script];
+    if(options < 0) { return NULL; }
+    umtx_initOnce(tailoring->fastScriptTablesInitOnce, computeFastScriptTables, tailoring, errorCode);
+    if(U_FAILURE(errorCode)) { return NULL; }
+    return tailoring->fastScriptTables->getTable(script);
+}
+
 CollationElementIterator *
 RuleBasedCollator::createCollationElementIterator(const UnicodeString& source) const {
     UErrorCode errorCode = U_ZERO_ERROR;
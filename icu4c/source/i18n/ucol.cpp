@@ -209,6 +209,23 @@ ucol_getSortKey(const    UCollator    *coll,
     return keySize;
 }
 
+U_CAPI int32_t U_EXPORT2
+ucol_getSortKeys(const UCollator *coll,
+                 const UChar *const *strings,
+                 const int32_t *lengths,
+                 int32_t count,
+                 uint8_t *dest,
+                 int32_t destCapacity,
+                 int32_t *offsets,
+                 UErrorCode *status)
+{
+    if(status==NULL || U_FAILURE(*status)) {
+        return 0;
+    }
+    return Collator::fromUCollator(coll)->
+            getSortKeys(strings, lengths, count, dest, destCapacity, offsets, *status);
+}
+
 U_CAPI int32_t U_EXPORT2
 ucol_nextSortKeyPart(const UCollator *coll,
                      UCharIterator *iter,
@@ -486,6 +503,54 @@ ucol_strcollUTF8(
     return returnVal;
 }
 
+U_CAPI void U_EXPORT2
+ucol_strcollBatch(const UCollator *coll,
+                  const UChar *const *sources, const int32_t *sourceLengths,
+                  const UChar *const *targets, const int32_t *targetLengths,
+                  int32_t count, UCollationResult *results, UErrorCode *status)
+{
+    if (U_FAILURE(*status)) {
+        return;
+    }
+    Collator::fromUCollator(coll)->compareBatch(
+            sources, sourceLengths, targets, targetLengths, count, results, *status);
+}
+
+U_CAPI void U_EXPORT2
+ucol_strcollBatchUTF8(const UCollator *coll,
+                      const char *const *sources, const int32_t *sourceLengths,
+                      const char *const *targets, const int32_t *targetLengths,
+                      int32_t count, UCollationResult *results, UErrorCode *status)
+{
+    if (U_FAILURE(*status)) {
+        return;
+    }
+    Collator::fromUCollator(coll)->compareBatchUTF8(
+            sources, sourceLengths, targets, targetLengths, count, results, *status);
+}
+
+U_CAPI void U_EXPORT2
+ucol_sortIndexes(const UCollator *coll,
+                 const UChar *const *strings, const int32_t *lengths,
+                 int32_t count, int32_t *indexes, UErrorCode *status)
+{
+    if (U_FAILURE(*status)) {
+        return;
+    }
+    Collator::fromUCollator(coll)->sortIndexes(strings, lengths, count, indexes, *status);
+}
+
+U_CAPI void U_EXPORT2
+ucol_sortIndexesUTF8(const UCollator *coll,
+                     const char *const *strings, const int32_t *lengths,
+                     int32_t count, int32_t *indexes, UErrorCode *status)
+{
+    if (U_FAILURE(*status)) {
+        return;
+    }
+    Collator::fromUCollator(coll)->sortIndexesUTF8(strings, lengths, count, indexes, *status);
+}
+
 
 /* convenience function for comparing strings */
 U_CAPI UBool U_EXPORT2
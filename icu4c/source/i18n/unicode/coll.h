@@ -486,6 +486,81 @@ class U_I18N_API Collator : public UObject {
                                          const StringPiece &target,
                                          UErrorCode &status) const;
 
+    // Do not enclose the batch functions with #ifndef U_HIDE_DRAFT_API because they are virtual.
+
+    /**
+     * Compares pairs of strings using the Collator:
+     * results[i] is the result of comparing sources[i] with targets[i].
+     * This is equivalent to count calls to
+     * compare(const char16_t*, int32_t, const char16_t*, int32_t, UErrorCode&)
+     * but avoids the per-call overhead when there are many pairs of short strings.
+     * @param sources array of count source strings
+     * @param sourceLengths array of count source string lengths, each -1 if that string
+     *        is NUL-terminated; or nullptr if all source strings are NUL-terminated
+     * @param targets array of count target strings
+     * @param targetLengths array of count target string lengths, each -1 if that string
+     *        is NUL-terminated; or nullptr if all target strings are NUL-terminated
+     * @param count the number of string pairs
+     * @param results array of count UCollationResult values to be filled in
+     * @param status ICU status
+     * @draft ICU 67
+     */
+    virtual void compareBatch(const char16_t *const sources[], const int32_t sourceLengths[],
+                              const char16_t *const targets[], const int32_t targetLengths[],
+                              int32_t count, UCollationResult results[],
+                              UErrorCode &status) const;
+
+    /**
+     * Compares pairs of UTF-8 strings using the Collator:
+     * results[i] is the result of comparing sources[i] with targets[i].
+     * Same as compareBatch() but for UTF-8 input.
+     * Malformed UTF-8 byte sequences are treated as U+FFFD, as in compareUTF8().
+     * @param sources array of count source strings
+     * @param sourceLengths array of count source string lengths, each -1 if that string
+     *        is NUL-terminated; or nullptr if all source strings are NUL-terminated
+     * @param targets array of count target strings
+     * @param targetLengths array of count target string lengths, each -1 if that string
+     *        is NUL-terminated; or nullptr if all target strings are NUL-terminated
+     * @param count the number of string pairs
+     * @param results array of count UCollationResult values to be filled in
+     * @param status ICU status
+     * @draft ICU 67
+     */
+    virtual void compareBatchUTF8(const char *const sources[], const int32_t sourceLengths[],
+                                  const char *const targets[], const int32_t targetLengths[],
+                                  int32_t count, UCollationResult results[],
+                                  UErrorCode &status) const;
+
+    /**
+     * Sorts an array of strings using the Collator, without moving the strings.
+     * Sets indexes[] to the permutation of 0..count-1 which lists the strings
+     * in ascending order: strings[indexes[0]] is the smallest.
+     * Strings that compare equal stay in their input order.
+     * @param strings array of count strings
+     * @param lengths array of count string lengths, each -1 if that string
+     *        is NUL-terminated; or nullptr if all strings are NUL-terminated
+     * @param count the number of strings
+     * @param indexes array of count indexes to be filled in
+     * @param status ICU status
+     * @draft ICU 67
+     */
+    virtual void sortIndexes(const char16_t *const strings[], const int32_t lengths[],
+                             int32_t count, int32_t indexes[], UErrorCode &status) const;
+
+    /**
+     * Sorts an array of UTF-8 strings using the Collator, without moving the strings.
+     * Same as sortIndexes() but for UTF-8 input.
+     * @param strings array of count strings
+     * @param lengths array of count string lengths, each -1 if that string
+     *        is NUL-terminated; or nullptr if all strings are NUL-terminated
+     * @param count the number of strings
+     * @param indexes array of count indexes to be filled in
+     * @param status ICU status
+     * @draft ICU 67
+     */
+    virtual void sortIndexesUTF8(const char *const strings[], const int32_t lengths[],
+                                 int32_t count, int32_t indexes[], UErrorCode &status) const;
+
     /**
      * Transforms the string into a series of characters that can be compared
      * with CollationKey::compareTo. It is not possible to restore the original
@@ -1041,6 +1116,41 @@ class U_I18N_API Collator : public UObject {
     virtual int32_t getSortKey(const char16_t*source, int32_t sourceLength,
                                uint8_t*result, int32_t resultLength) const = 0;
 
+    // Do not enclose getSortKeys() with #ifndef U_HIDE_DRAFT_API because it is virtual.
+
+    /**
+     * Writes the sort keys for an array of strings into one contiguous buffer.
+     * The key for strings[i] is at dest+offsets[i] and is offsets[i+1]-offsets[i] bytes long,
+     * including its terminating zero byte, so each key can be compared using strcmp().
+     * The keys are the same as those returned by getSortKey().
+     *
+     * This avoids a separate allocation and function call for each key
+     * when building many keys, for example for an index.
+     * It may be called concurrently on the same Collator from multiple threads:
+     * To build keys in parallel, give each thread a range of the strings
+     * and its own segment of the output buffer (sized via preflighting),
+     * and add the segment start to that thread's offsets.
+     *
+     * If the total length of the keys exceeds destCapacity, then the buffer contents
+     * are undefined, status is set to U_BUFFER_OVERFLOW_ERROR, and
+     * the offsets are still set as if the buffer had been large enough.
+     *
+     * @param strings array of count strings
+     * @param lengths array of count string lengths, each -1 if that string
+     *        is NUL-terminated; or nullptr if all strings are NUL-terminated
+     * @param count the number of strings
+     * @param dest output buffer for the concatenated sort keys; can be nullptr if destCapacity==0
+     * @param destCapacity capacity of dest
+     * @param offsets array of count+1 offsets to be filled in; offsets[0]=0 and
+     *        offsets[count] is the total length
+     * @param status ICU status
+     * @return the total length of all of the sort keys
+     * @draft ICU 67
+     */
+    virtual int32_t getSortKeys(const char16_t *const strings[], const int32_t lengths[],
+                                int32_t count, uint8_t *dest, int32_t destCapacity,
+                                int32_t offsets[], UErrorCode &status) const;
+
     /**
      * Produce a bound for a given sortkey and a number of levels.
      * Return value is always the number of bytes needed, regardless of
@@ -40,6 +40,9 @@
  * expression pattern strings application code can be simplified and the explicit
  * need for `RegexPattern` objects can usually be eliminated.
  *
+ * Class `RegexSet` holds a number of patterns and finds which of them match
+ *  an input text, sharing the work of searching the text among them.
+ *
  */
 
 #include "unicode/utypes.h"
@@ -62,6 +65,7 @@ struct UHashtable;
 U_NAMESPACE_BEGIN
 
 struct Regex8BitSet;
+struct RegexSetTables;
 class  RegexCImpl;
 class  RegexMatcher;
 class  RegexPattern;
@@ -320,6 +324,58 @@ class U_I18N_API RegexPattern U_FINAL : public UObject {
         uint32_t             flags,
         UErrorCode           &status);
 
+#ifndef U_HIDE_DRAFT_API
+   /**
+    * Writes the compiled form of this pattern, so that createFromSerialized()
+    * can recreate it without compiling the regular expression again.
+    * For example, patterns can be compiled and serialized at build time,
+    * and the data mapped into memory and loaded at run time.
+    *
+    * The serialized form is specific to the byte order and the version of ICU
+    * that wrote it, and it records the version of the Unicode data that the
+    * pattern was compiled with. It includes the regular expression and
+    * its flags. Its length is a multiple of 4, so that several serialized
+    * patterns can be written one after another.
+    *
+    * @param dest     Destination buffer, aligned on a 4-byte boundary.
+    *                 Can be NULL if destCapacity==0 for pure preflighting.
+    * @param destCapacity The capacity of dest, in bytes.
+    * @param status   A reference to a UErrorCode to receive any errors.
+    *                 U_BUFFER_OVERFLOW_ERROR if destCapacity is too small.
+    * @return the length of the serialized pattern, in bytes
+    * @see createFromSerialized
+    * @draft ICU 67
+    */
+    int32_t serialize(uint8_t *dest, int32_t destCapacity, UErrorCode &status) const;
+
+   /**
+    * Creates a RegexPattern from the form written by serialize(), without
+    * compiling the regular expression. The data is copied; it need not remain
+    * valid after this function returns.
+    *
+    * If the data was written by another version of ICU, or with other Unicode
+    * data than ICU uses now, then the compiled form or the character properties
+    * and case foldings in the pattern may have changed, and the regular expression
+    * stored with it is compiled again instead.
+    *
+    * The compiled form is checked before it is used: indexes, lengths and
+    * references between its parts must be consistent, as written by serialize().
+    *
+    * @param data     The serialized pattern, aligned on a 4-byte boundary.
+    * @param length   The length of the data, in bytes.
+    * @param status   A reference to a UErrorCode to receive any errors.
+    *                 U_INVALID_FORMAT_ERROR if the data is not a serialized pattern
+    *                 that this version of ICU can read, or if it is inconsistent.
+    * @return A new RegexPattern object, to be deleted by the caller,
+    *         or NULL if an error occurred.
+    * @see serialize
+    * @draft ICU 67
+    */
+    static RegexPattern * U_EXPORT2 createFromSerialized(const uint8_t *data,
+        int32_t              length,
+        UErrorCode           &status);
+#endif  /* U_HIDE_DRAFT_API */
+
    /**
     * Get the #URegexpFlag match mode flags that were used when compiling this pattern.
     * @return  the #URegexpFlag match mode flags
@@ -626,11 +682,27 @@ class U_I18N_API RegexPattern U_FINAL : public UObject {
     Regex8BitSet   *fInitialChars8;
     UBool           fNeedsAltInput;
 
+    int32_t         fRequiredStringIdx;  // A literal string that every match contains, as an
+    int32_t         fRequiredStringLen;  //   index and length in fLiteralText.  Length 0 if none.
+    int32_t         fRequiredMinOffset;  // Bounds on the offset of the required string from the
+    int32_t         fRequiredMaxOffset;  //   start of a match, in UTF-16 code units.
+                                         //   Max is INT32_MAX if unbounded.
+    int32_t         fRequiredPrefixSet;  // Index in fSets of the characters that a match can
+                                         //   contain ahead of the required string, or -1 if
+                                         //   there is no useful bound.
+
+    UVector32       *fMemoSlots;   // Map from compiled pattern position to the row used for
+                                   //   that backtracking point in a matcher's memo of
+                                   //   explored states, or -1.  See RegexMatcher::MatchAt().
+    int32_t         fMemoSlotCount; // Number of rows in the memo.  Zero if the pattern can
+                                   //   not be memoized (back references, look-around, etc.)
+
     UHashtable     *fNamedCaptureMap;  // Map from capture group names to numbers.
 
     friend class RegexCompile;
     friend class RegexMatcher;
     friend class RegexCImpl;
+    friend class RegexSet;
 
     //
     //  Implementation Methods
@@ -641,6 +713,8 @@ class U_I18N_API RegexPattern U_FINAL : public UObject {
 
     void        dumpOp(int32_t index) const;
 
+    UBool       isValidLoadedPattern() const;   // Range checks for createFromSerialized().
+
   public:
 #ifndef U_HIDE_INTERNAL_API
     /**
@@ -1766,6 +1840,7 @@ class U_I18N_API RegexMatcher U_FINAL : public UObject {
 
     friend class RegexPattern;
     friend class RegexCImpl;
+    friend class RegexSet;
 public:
 #ifndef U_HIDE_INTERNAL_API
     /** @internal  */
@@ -1785,14 +1860,29 @@ class U_I18N_API RegexMatcher U_FINAL : public UObject {
     inline REStackFrame *StateSave(REStackFrame *fp, int64_t savePatIdx, UErrorCode &status);
     void                 IncrementTime(UErrorCode &status);
 
+    void                 resetMemo(int64_t startIdx);   // Prepare the memo for a new match operation.
+    UBool                startMemo();
+    inline UBool         memoTest(int32_t patIdx, int64_t inputIdx) const;
+    inline UBool         memoTestAndSet(int32_t patIdx, int64_t inputIdx);
+
+    void                 resetRequiredString();         // Prepare find() to search for the required string.
+    UBool                findRequiredString(int64_t startIdx);
+    inline UBool         skipToRequiredString(int64_t &startIdx);
+    inline UBool         skipToRequiredString(int32_t &startIdx);
+
     // Call user find callback function, if set. Return TRUE if operation should be interrupted.
     inline UBool         findProgressInterrupt(int64_t matchIndex, UErrorCode &status);
     
     int64_t              appendGroup(int32_t groupNum, UText *dest, UErrorCode &status) const;
     
     UBool                findUsingChunk(UErrorCode &status);
+    template<typename CharT>
+    UBool                findInBuffer(const CharT *inputBuf, UErrorCode &status);
     void                 MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &status);
-    UBool                isChunkWordBoundary(int32_t pos);
+    template<typename CharT>
+    void                 MatchBufferAt(const CharT *inputBuf, int32_t startIdx, UBool toEnd, UErrorCode &status);
+    template<typename CharT>
+    UBool                isBufferWordBoundary(const CharT *inputBuf, int32_t pos);
 
     const RegexPattern  *fPattern;
     RegexPattern        *fPatternOwned;    // Non-NULL if this matcher owns the pattern, and
@@ -1858,6 +1948,21 @@ class U_I18N_API RegexMatcher U_FINAL : public UObject {
     int32_t             fStackLimit;       // Maximum memory size to use for the backtrack
                                            //   stack, in bytes.  Zero for unlimited.
 
+    uint32_t           *fMemo;             // One bit per (backtracking point, input position),
+                                           //   set once matching from that state has been tried.
+                                           //   NULL until first needed.
+    int32_t             fMemoCapacity;     // Size of fMemo, in 32 bit words.
+    int64_t             fMemoStart;        // Input position of the first column of fMemo.
+    int32_t             fMemoWidth;        // Number of input positions covered by fMemo.
+    int32_t             fMemoCountdown;    // Backtracking points to pass before fMemo is used.
+                                           //   Zero while in use, negative if not usable.
+
+    int64_t             fRequiredStart;    // During find(), the range of start positions from
+    int64_t             fRequiredLimit;    //   which a match could reach the next occurrence of
+                                           //   the pattern's required string.  Limit is -1 before
+                                           //   the first search, and U_INT64_MAX if find() does
+                                           //   not search for the string.
+
     URegexMatchCallback *fCallbackFn;       // Pointer to match progress callback funct.
                                            //   NULL if there is no callback.
     const void         *fCallbackContext;  // User Context ptr for callback function.
@@ -1877,6 +1982,166 @@ class U_I18N_API RegexMatcher U_FINAL : public UObject {
     RuleBasedBreakIterator  *fWordBreakItr;
 };
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * A set of regular expressions that are searched for together, for example the
+ * rules of a filter that are all applied to each line of input.
+ *
+ * RegexSet::find() reports which of the patterns match the input text, and
+ * where each of them first matches, with two passes over the text that are
+ * shared by all of the patterns, rather than one find() per pattern.
+ * The first pass searches for the literal strings that the patterns require
+ * (see RegexMatcher::find()); patterns whose string does not occur are not
+ * tried at all.  The second pass tries the remaining patterns only at positions
+ * where their matches can begin, as determined by the first character, the
+ * start of a line, or the start of the input.
+ *
+ * The results are the same as from a RegexMatcher::find() with each pattern on
+ * the whole of the input text.
+ *
+ * A RegexSet is not thread safe; like a RegexMatcher, each thread needs its own.
+ *
+ * @draft ICU 67
+ */
+class U_I18N_API RegexSet U_FINAL : public UObject {
+public:
+    /**
+     * Construct an empty set of patterns.
+     *
+     * @param status  A reference to a UErrorCode to receive any errors.
+     * @draft ICU 67
+     */
+    RegexSet(UErrorCode &status);
+
+    /**
+     * Destructor.
+     *
+     * @draft ICU 67
+     */
+    virtual ~RegexSet();
+
+    /**
+     * Compile a regular expression and add it to the set.
+     * The arguments are as for RegexPattern::compile().
+     *
+     * @param regex   The regular expression to be compiled.
+     * @param flags   The UREGEX_* flags to control the regular expression matching.
+     * @param pe      Receives the position (line and column numbers) of any syntax
+     *                error within the regular expression.
+     * @param status  A reference to a UErrorCode to receive any errors.
+     * @return        The index of the pattern in the set, or -1 if there was an error,
+     *                in which case the set is not changed.
+     * @draft ICU 67
+     */
+    int32_t add(const UnicodeString &regex, uint32_t flags, UParseError &pe, UErrorCode &status);
+
+    /**
+     * Compile a regular expression and add it to the set.
+     *
+     * @param regex   The regular expression to be compiled.
+     * @param flags   The UREGEX_* flags to control the regular expression matching.
+     * @param status  A reference to a UErrorCode to receive any errors.
+     * @return        The index of the pattern in the set, or -1 if there was an error,
+     *                in which case the set is not changed.
+     * @draft ICU 67
+     */
+    int32_t add(const UnicodeString &regex, uint32_t flags, UErrorCode &status);
+
+    /**
+     * Get the number of patterns in the set.
+     *
+     * @return  The number of patterns.
+     * @draft ICU 67
+     */
+    int32_t size() const;
+
+    /**
+     * Get one of the patterns in the set.
+     *
+     * @param index  The index of the pattern, as returned by add().
+     * @return       The pattern, which remains owned by the set, or NULL if the
+     *               index is out of range.
+     * @draft ICU 67
+     */
+    const RegexPattern *getPattern(int32_t index) const;
+
+    /**
+     * Find the patterns that match somewhere in the input text.
+     *
+     * For each matching pattern, in order of their indexes, its index is
+     * stored in indexes, and the start and limit of its first match in
+     * starts and limits, unless they are NULL.  The first match is the one that
+     * RegexMatcher::find() would find.
+     *
+     * If more patterns match than fit in capacity, nothing more is stored,
+     * status is set to U_BUFFER_OVERFLOW_ERROR and the number of matching
+     * patterns is returned.
+     *
+     * @param input     The input text.  It must not be changed or deleted during the call.
+     * @param indexes   Receives the indexes of the matching patterns.  May be NULL
+     *                  if capacity is zero.
+     * @param starts    Receives the start index of the first match of each pattern
+     *                  in indexes, or NULL.
+     * @param limits    Receives the end index of the first match of each pattern
+     *                  in indexes, or NULL.
+     * @param capacity  The size of the indexes, starts and limits arrays.
+     * @param status    A reference to a UErrorCode to receive any errors.
+     * @return          The number of matching patterns.
+     * @draft ICU 67
+     */
+    int32_t find(const UnicodeString &input, int32_t *indexes, int32_t *starts, int32_t *limits,
+                 int32_t capacity, UErrorCode &status);
+
+    /**
+     * Find the patterns that match somewhere in the input text.
+     * As find(const UnicodeString &, ...), with the positions of the matches
+     * being native indexes in the input text.
+     *
+     * @param input     The input text.  It must not be changed or deleted during the call.
+     * @param indexes   Receives the indexes of the matching patterns.  May be NULL
+     *                  if capacity is zero.
+     * @param starts    Receives the native start index of the first match of each pattern
+     *                  in indexes, or NULL.
+     * @param limits    Receives the native end index of the first match of each pattern
+     *                  in indexes, or NULL.
+     * @param capacity  The size of the indexes, starts and limits arrays.
+     * @param status    A reference to a UErrorCode to receive any errors.
+     * @return          The number of matching patterns.
+     * @draft ICU 67
+     */
+    int32_t find(UText *input, int32_t *indexes, int64_t *starts, int64_t *limits,
+                 int32_t capacity, UErrorCode &status);
+
+    /**
+     * ICU "poor man's RTTI", returns a UClassID for this class.
+     *
+     * @draft ICU 67
+     */
+    static UClassID U_EXPORT2 getStaticClassID();
+
+    /**
+     * ICU "poor man's RTTI", returns a UClassID for the actual class.
+     *
+     * @draft ICU 67
+     */
+    virtual UClassID getDynamicClassID() const;
+
+private:
+    RegexSet(const RegexSet &other);            // Copying is not implemented.
+    RegexSet &operator =(const RegexSet &rhs);
+
+    int32_t addPattern(RegexPattern *pat, UErrorCode &status);
+    void    buildTables(UErrorCode &status);
+    void    findAll(UText *input, UErrorCode &status);
+
+    UVector          *fPatterns;       // The compiled patterns, owned.
+    UVector          *fMatchers;       // A RegexMatcher for each pattern, owned.
+    RegexSetTables   *fTables;         // Start positions and required strings of the patterns,
+                                       //   built by the first find(). NULL until then, and
+                                       //   after a pattern is added.
+};
+#endif  /* U_HIDE_DRAFT_API */
+
 U_NAMESPACE_END
 #endif  // UCONFIG_NO_REGULAR_EXPRESSIONS
 
@@ -77,6 +77,7 @@ U_NAMESPACE_BEGIN
 
 struct CollationCacheEntry;
 struct CollationData;
+class CollationIterator;
 struct CollationSettings;
 struct CollationTailoring;
 /**
@@ -346,6 +347,26 @@ class U_I18N_API RuleBasedCollator : public Collator {
                                          const StringPiece &target,
                                          UErrorCode &status) const;
 
+    /**
+     * Compares pairs of strings using this collator.
+     * @see Collator::compareBatch
+     * @draft ICU 67
+     */
+    virtual void compareBatch(const char16_t *const sources[], const int32_t sourceLengths[],
+                              const char16_t *const targets[], const int32_t targetLengths[],
+                              int32_t count, UCollationResult results[],
+                              UErrorCode &status) const;
+
+    /**
+     * Compares pairs of UTF-8 strings using this collator.
+     * @see Collator::compareBatchUTF8
+     * @draft ICU 67
+     */
+    virtual void compareBatchUTF8(const char *const sources[], const int32_t sourceLengths[],
+                                  const char *const targets[], const int32_t targetLengths[],
+                                  int32_t count, UCollationResult results[],
+                                  UErrorCode &status) const;
+
     /**
      * Transforms the string into a series of characters
      * that can be compared with CollationKey.compare().
@@ -655,6 +676,15 @@ class U_I18N_API RuleBasedCollator : public Collator {
     virtual int32_t getSortKey(const char16_t *source, int32_t sourceLength,
                                uint8_t *result, int32_t resultLength) const;
 
+    /**
+     * Writes the sort keys for an array of strings into one contiguous buffer.
+     * @see Collator::getSortKeys
+     * @draft ICU 67
+     */
+    virtual int32_t getSortKeys(const char16_t *const strings[], const int32_t lengths[],
+                                int32_t count, uint8_t *dest, int32_t destCapacity,
+                                int32_t offsets[], UErrorCode &status) const;
+
     /**
      * Retrieves the reordering codes for this collator.
      * @param dest The array to fill with the script ordering.
@@ -827,11 +857,17 @@ class U_I18N_API RuleBasedCollator : public Collator {
     void adoptTailoring(CollationTailoring *t, UErrorCode &errorCode);
 
     // Both lengths must be <0 or else both must be >=0.
+    // If leftIter and rightIter are not NULL, then they are used instead of
+    // newly constructed iterators; they must be UTF16CollationIterator
+    // (UTF8CollationIterator for UTF-8) if settings->dontCheckFCD(),
+    // otherwise the FCD subclass, and are reset to the text.
     UCollationResult doCompare(const char16_t *left, int32_t leftLength,
                                const char16_t *right, int32_t rightLength,
+                               CollationIterator *leftIter, CollationIterator *rightIter,
                                UErrorCode &errorCode) const;
     UCollationResult doCompare(const uint8_t *left, int32_t leftLength,
                                const uint8_t *right, int32_t rightLength,
+                               CollationIterator *leftIter, CollationIterator *rightIter,
                                UErrorCode &errorCode) const;
 
     void writeSortKey(const char16_t *s, int32_t length,
@@ -867,6 +903,14 @@ class U_I18N_API RuleBasedCollator : public Collator {
 
     void setFastLatinOptions(CollationSettings &ownedSettings) const;
 
+    static void U_CALLCONV computeFastScriptTables(const CollationTailoring *t, UErrorCode &errorCode);
+    /**
+     * Returns the CollationFastScript table for the fast script
+     * and sets its options, or returns NULL if that fastpath is not supported.
+     */
+    const uint16_t *getFastScriptTable(int32_t script, int32_t &options,
+                                       UErrorCode &errorCode) const;
+
     const CollationData *data;
     const CollationSettings *settings;  // reference-counted
     const CollationTailoring *tailoring;  // alias of cacheEntry->tailoring
@@ -592,6 +592,109 @@ ucol_strcollUTF8(
         int32_t         targetLength,
         UErrorCode      *status);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Compare pairs of strings: results[i] is the result of comparing
+ * sources[i] with targets[i], as with ucol_strcoll().
+ * This avoids the per-call overhead of ucol_strcoll()
+ * when there are many pairs of short strings.
+ * @param coll The UCollator containing the comparison rules.
+ * @param sources Array of count source strings.
+ * @param sourceLengths Array of count source string lengths, each -1 if that string
+ *        is null-terminated; or NULL if all source strings are null-terminated.
+ * @param targets Array of count target strings.
+ * @param targetLengths Array of count target string lengths, each -1 if that string
+ *        is null-terminated; or NULL if all target strings are null-terminated.
+ * @param count The number of string pairs.
+ * @param results Array of count UCollationResult values to be filled in.
+ * @param status A pointer to a UErrorCode to receive any errors
+ * @see ucol_strcoll
+ * @draft ICU 67
+ */
+U_DRAFT void U_EXPORT2
+ucol_strcollBatch(
+        const UCollator     *coll,
+        const UChar *const  *sources,
+        const int32_t       *sourceLengths,
+        const UChar *const  *targets,
+        const int32_t       *targetLengths,
+        int32_t             count,
+        UCollationResult    *results,
+        UErrorCode          *status);
+
+/**
+ * Compare pairs of UTF-8 strings: results[i] is the result of comparing
+ * sources[i] with targets[i], as with ucol_strcollUTF8().
+ * @param coll The UCollator containing the comparison rules.
+ * @param sources Array of count source UTF-8 strings.
+ * @param sourceLengths Array of count source string lengths, each -1 if that string
+ *        is null-terminated; or NULL if all source strings are null-terminated.
+ * @param targets Array of count target UTF-8 strings.
+ * @param targetLengths Array of count target string lengths, each -1 if that string
+ *        is null-terminated; or NULL if all target strings are null-terminated.
+ * @param count The number of string pairs.
+ * @param results Array of count UCollationResult values to be filled in.
+ * @param status A pointer to a UErrorCode to receive any errors
+ * @see ucol_strcollUTF8
+ * @draft ICU 67
+ */
+U_DRAFT void U_EXPORT2
+ucol_strcollBatchUTF8(
+        const UCollator     *coll,
+        const char *const   *sources,
+        const int32_t       *sourceLengths,
+        const char *const   *targets,
+        const int32_t       *targetLengths,
+        int32_t             count,
+        UCollationResult    *results,
+        UErrorCode          *status);
+
+/**
+ * Sort an array of strings without moving them.
+ * Sets indexes to the permutation of 0..count-1 which lists the strings
+ * in ascending order: strings[indexes[0]] is the smallest.
+ * Strings that compare equal stay in their input order.
+ * This is faster than sorting with ucol_strcoll() as the comparison function.
+ * @param coll The UCollator containing the comparison rules.
+ * @param strings Array of count strings.
+ * @param lengths Array of count string lengths, each -1 if that string
+ *        is null-terminated; or NULL if all strings are null-terminated.
+ * @param count The number of strings.
+ * @param indexes Array of count indexes to be filled in.
+ * @param status A pointer to a UErrorCode to receive any errors
+ * @draft ICU 67
+ */
+U_DRAFT void U_EXPORT2
+ucol_sortIndexes(
+        const UCollator     *coll,
+        const UChar *const  *strings,
+        const int32_t       *lengths,
+        int32_t             count,
+        int32_t             *indexes,
+        UErrorCode          *status);
+
+/**
+ * Sort an array of UTF-8 strings without moving them.
+ * Same as ucol_sortIndexes() but for UTF-8 input.
+ * @param coll The UCollator containing the comparison rules.
+ * @param strings Array of count UTF-8 strings.
+ * @param lengths Array of count string lengths, each -1 if that string
+ *        is null-terminated; or NULL if all strings are null-terminated.
+ * @param count The number of strings.
+ * @param indexes Array of count indexes to be filled in.
+ * @param status A pointer to a UErrorCode to receive any errors
+ * @draft ICU 67
+ */
+U_DRAFT void U_EXPORT2
+ucol_sortIndexesUTF8(
+        const UCollator     *coll,
+        const char *const   *strings,
+        const int32_t       *lengths,
+        int32_t             count,
+        int32_t             *indexes,
+        UErrorCode          *status);
+#endif  /* U_HIDE_DRAFT_API */
+
 /**
  * Determine if one string is greater than another.
  * This function is equivalent to {@link #ucol_strcoll } == UCOL_GREATER
@@ -1021,6 +1124,47 @@ ucol_getSortKey(const    UCollator    *coll,
         uint8_t        *result,
         int32_t        resultLength);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Get the sort keys for an array of strings, written into one contiguous buffer.
+ * The key for strings[i] starts at dest+offsets[i] and is offsets[i+1]-offsets[i] bytes long,
+ * including its terminating zero byte.
+ * The keys are the same as those returned by ucol_getSortKey().
+ *
+ * This is faster than calling ucol_getSortKey() for each string and
+ * avoids one allocation per key.
+ * Like other functions that take a const UCollator, it may be called concurrently
+ * from multiple threads; for parallel key generation, give each thread
+ * a range of the strings and its own segment of the buffer.
+ *
+ * If the total length exceeds destCapacity, then *status is set to
+ * U_BUFFER_OVERFLOW_ERROR, the buffer contents are undefined,
+ * and the offsets are still set for the full length (preflighting).
+ * @param coll The UCollator containing the collation rules.
+ * @param strings Array of count strings.
+ * @param lengths Array of count string lengths, each -1 if that string
+ *        is null-terminated; or NULL if all strings are null-terminated.
+ * @param count The number of strings.
+ * @param dest A pointer to a buffer to receive the sort keys.
+ *        Can be NULL if destCapacity==0.
+ * @param destCapacity The size of dest.
+ * @param offsets Array of count+1 offsets to be filled in.
+ *        offsets[0]=0 and offsets[count] is the total length.
+ * @param status A pointer to a UErrorCode to receive any errors
+ * @return The total length of all of the sort keys.
+ * @draft ICU 67
+ */
+U_DRAFT int32_t U_EXPORT2
+ucol_getSortKeys(const UCollator    *coll,
+                 const UChar *const *strings,
+                 const int32_t      *lengths,
+                 int32_t            count,
+                 uint8_t            *dest,
+                 int32_t            destCapacity,
+                 int32_t            *offsets,
+                 UErrorCode         *status);
+#endif  /* U_HIDE_DRAFT_API */
+
 
 /** Gets the next count bytes of a sort key. Caller needs
  *  to preserve state array between calls and to provide
@@ -54,6 +54,17 @@ class U_I18N_API UTF16CollationIterator : public CollationIterator {
         limit = lim;
     }
 
+    /**
+     * Resets the iterator to the state of a newly constructed one
+     * on the new text, keeping its buffers.
+     */
+    void setText(const UChar *s, const UChar *p, const UChar *lim) {
+        reset();
+        start = s;
+        pos = p;
+        limit = lim;
+    }
+
     virtual UChar32 nextCodePoint(UErrorCode &errorCode);
 
     virtual UChar32 previousCodePoint(UErrorCode &errorCode);
@@ -95,6 +106,19 @@ class U_I18N_API FCDUTF16CollationIterator : public UTF16CollationIterator {
 
     virtual ~FCDUTF16CollationIterator();
 
+    /**
+     * Resets the iterator to the state of a newly constructed one
+     * on the new text, keeping its buffers.
+     */
+    void setText(const UChar *s, const UChar *p, const UChar *lim) {
+        UTF16CollationIterator::setText(s, p, lim);
+        rawStart = s;
+        segmentStart = p;
+        segmentLimit = NULL;
+        rawLimit = lim;
+        checkDir = 1;
+    }
+
     virtual UBool operator==(const CollationIterator &other) const;
 
     virtual void resetToOffset(int32_t newOffset);
@@ -40,6 +40,17 @@ class U_I18N_API UTF8CollationIterator : public CollationIterator {
 
     virtual ~UTF8CollationIterator();
 
+    /**
+     * Resets the iterator to the state of a newly constructed one
+     * on the new text, keeping its buffers.
+     */
+    void setText(const uint8_t *s, int32_t p, int32_t len) {
+        reset();
+        u8 = s;
+        pos = p;
+        length = len;
+    }
+
     virtual void resetToOffset(int32_t newOffset);
 
     virtual int32_t getOffset() const;
@@ -87,6 +98,16 @@ class U_I18N_API FCDUTF8CollationIterator : public UTF8CollationIterator {
 
     virtual ~FCDUTF8CollationIterator();
 
+    /**
+     * Resets the iterator to the state of a newly constructed one
+     * on the new text, keeping its buffers.
+     */
+    void setText(const uint8_t *s, int32_t p, int32_t len) {
+        UTF8CollationIterator::setText(s, p, len);
+        state = CHECK_FWD;
+        start = p;
+    }
+
     virtual void resetToOffset(int32_t newOffset);
 
     virtual int32_t getOffset() const;
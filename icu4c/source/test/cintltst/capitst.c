@@ -90,6 +90,7 @@ void addCollAPITest(TestNode** root)
     addTest(root, &TestBengaliSortKey, "tscoll/capitst/TestBengaliSortKey");
     addTest(root, &TestGetKeywordValuesForLocale, "tscoll/capitst/TestGetKeywordValuesForLocale");
     addTest(root, &TestStrcollNull, "tscoll/capitst/TestStrcollNull");
+    addTest(root, &TestStrcollBatch, "tscoll/capitst/TestStrcollBatch");
 }
 
 void TestGetSetAttr(void) {
@@ -2565,4 +2566,64 @@ static void TestStrcollNull(void) {
     ucol_close(coll);
 }
 
+static void TestStrcollBatch(void) {
+    UErrorCode status = U_ZERO_ERROR;
+    UCollator *coll;
+
+    /* "b", "A", "a", "\u5c71", "", "b" */
+    static const UChar s0[] = {0x62, 0}, s1[] = {0x41, 0}, s2[] = {0x61, 0};
+    static const UChar s3[] = {0x5c71, 0}, s4[] = {0}, s5[] = {0x62, 0};
+    const UChar *strings[] = { s0, s1, s2, s3, s4, s5 };
+    const int32_t lengths[] = { 1, -1, 1, -1, 0, -1 };
+    const char *strings8[] = { "b", "A", "a", "\xE5\xB1\xB1", "", "b" };
+    /* expected sort order, with equal strings in input order */
+    static const int32_t expectedIndexes[] = { 4, 2, 1, 0, 5, 3 };
+    int32_t indexes[6];
+    UCollationResult results[6], results8[6];
+    int32_t i;
+
+    coll = ucol_open("en", &status);
+    if (U_FAILURE(status)) {
+        log_err_status(status, "English Collator creation failed.: %s\n", myErrorName(status));
+        return;
+    }
+
+    /* compare each string with the following one */
+    ucol_strcollBatch(coll, strings, lengths, strings + 1, lengths + 1, 5, results, &status);
+    ucol_strcollBatchUTF8(coll, strings8, NULL, strings8 + 1, NULL, 5, results8, &status);
+    if (U_FAILURE(status)) {
+        log_err("ucol_strcollBatch() or ucol_strcollBatchUTF8() failed: %s\n", myErrorName(status));
+    } else {
+        for (i = 0; i < 5; ++i) {
+            UCollationResult expected = ucol_strcoll(coll, strings[i], lengths[i], strings[i + 1], lengths[i + 1]);
+            if (results[i] != expected || results8[i] != expected) {
+                log_err("ucol_strcollBatch()/UTF8 [%d] = %d/%d != ucol_strcoll() = %d\n",
+                        (int)i, (int)results[i], (int)results8[i], (int)expected);
+            }
+        }
+    }
+
+    ucol_sortIndexes(coll, strings, lengths, 6, indexes, &status);
+    if (U_FAILURE(status)) {
+        log_err("ucol_sortIndexes() failed: %s\n", myErrorName(status));
+    } else if (uprv_memcmp(indexes, expectedIndexes, sizeof(indexes)) != 0) {
+        log_err("ucol_sortIndexes() returned the wrong order\n");
+    }
+    uprv_memset(indexes, 0, sizeof(indexes));
+    ucol_sortIndexesUTF8(coll, strings8, NULL, 6, indexes, &status);
+    if (U_FAILURE(status)) {
+        log_err("ucol_sortIndexesUTF8() failed: %s\n", myErrorName(status));
+    } else if (uprv_memcmp(indexes, expectedIndexes, sizeof(indexes)) != 0) {
+        log_err("ucol_sortIndexesUTF8() returned the wrong order\n");
+    }
+
+    status = U_ZERO_ERROR;
+    ucol_sortIndexes(coll, NULL, NULL, 1, indexes, &status);
+    if (status != U_ILLEGAL_ARGUMENT_ERROR) {
+        log_err("ERROR: ucol_sortIndexes(strings=NULL) should return U_ILLEGAL_ARGUMENT_ERROR\n");
+    }
+
+    ucol_close(coll);
+}
+
 #endif /* #if !UCONFIG_NO_COLLATION */
@@ -137,6 +137,11 @@
      */
     static void TestStrcollNull(void);
 
+    /**
+     * test the batch comparison and sorting functions
+     */
+    static void TestStrcollBatch(void);
+
 #endif /* #if !UCONFIG_NO_COLLATION */
 
 #endif
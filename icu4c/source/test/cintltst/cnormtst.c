@@ -65,6 +65,7 @@ TestGetRawDecomposition(void);
 
 static void TestAppendRestoreMiddle(void);
 static void TestGetEasyToUseInstance(void);
+static void TestIsNormalizedBatch(void);
 
 static const char* const canonTests[][3] = {
     /* Input*/                    /*Decomposed*/                /*Composed*/
@@ -156,6 +157,7 @@ void addNormTest(TestNode** root)
     addTest(root, &TestGetRawDecomposition, "tsnorm/cnormtst/TestGetRawDecomposition");
     addTest(root, &TestAppendRestoreMiddle, "tsnorm/cnormtst/TestAppendRestoreMiddle");
     addTest(root, &TestGetEasyToUseInstance, "tsnorm/cnormtst/TestGetEasyToUseInstance");
+    addTest(root, &TestIsNormalizedBatch, "tsnorm/cnormtst/TestIsNormalizedBatch");
 }
 
 static const char* const modeStrings[]={
@@ -1698,4 +1700,78 @@ TestGetEasyToUseInstance() {
     }
 }
 
+static void
+TestIsNormalizedBatch() {
+    /* Strings back to back: NFC/NFD yes/no/maybe cases, empty strings, Hangul. */
+    static const UChar text[]={
+        0x61, 0x62, 0x63,           /* abc */
+        0xe0,                       /* a-grave */
+        0x61, 0x300,                /* a + grave: NFC maybe -> no */
+        0x71, 0x300,                /* q + grave: NFC maybe -> yes */
+        0x41, 0x323, 0x308,         /* canonical order */
+        0x41, 0x308, 0x323,         /* not canonical order */
+        0x1100, 0x1161,             /* Jamo L+V: NFC no */
+        0xac00, 0x11a8,             /* LV+T: NFC no */
+        0xac01,                     /* LVT */
+        0x2126                      /* Ohm sign: singleton */
+    };
+    static const int32_t offsets[]={ 0, 3, 4, 6, 8, 8, 11, 14, 16, 18, 19, 19, 20 };
+    static const char *const names[]={ "nfc", "nfc", "nfkc", "nfc" };
+    static const UNormalization2Mode modes[]={
+        UNORM2_COMPOSE, UNORM2_DECOMPOSE, UNORM2_COMPOSE, UNORM2_FCD
+    };
+    int32_t count=UPRV_LENGTHOF(offsets)-1;
+    int32_t m, i;
+    for(m=0; m<UPRV_LENGTHOF(modes); ++m) {
+        uint8_t results[2]={ 0xff, 0xff };
+        int32_t numNormalized, expectedNumNormalized=0;
+        UErrorCode errorCode=U_ZERO_ERROR;
+        const UNormalizer2 *n2=unorm2_getInstance(NULL, names[m], modes[m], &errorCode);
+        if(U_FAILURE(errorCode)) {
+            log_err_status(errorCode, "unorm2_getInstance(%s, %d) failed: %s\n",
+                           names[m], (int)modes[m], u_errorName(errorCode));
+            continue;
+        }
+        numNormalized=unorm2_isNormalizedBatch(n2, text, offsets, count, results, &errorCode);
+        if(U_FAILURE(errorCode)) {
+            log_err("unorm2_isNormalizedBatch(%s, %d) failed: %s\n",
+                    names[m], (int)modes[m], u_errorName(errorCode));
+            continue;
+        }
+        for(i=0; i<count; ++i) {
+            UBool expected=unorm2_isNormalized(n2, text+offsets[i], offsets[i+1]-offsets[i], &errorCode);
+            UBool actual=(UBool)((results[i>>3]>>(i&7))&1);
+            if(actual!=expected) {
+                log_err("unorm2_isNormalizedBatch(%s, %d) string %d: %d != isNormalized() %d\n",
+                        names[m], (int)modes[m], (int)i, actual, expected);
+            }
+            expectedNumNormalized+=expected;
+        }
+        if(numNormalized!=expectedNumNormalized || (results[1]>>(count-8))!=0) {
+            log_err("unorm2_isNormalizedBatch(%s, %d) returned %d normalized strings, expected %d\n",
+                    names[m], (int)modes[m], (int)numNormalized, (int)expectedNumNormalized);
+        }
+    }
+
+    {
+        static const int32_t badOffsets[]={ 0, 3, 1 };
+        uint8_t results[1];
+        UErrorCode errorCode=U_ZERO_ERROR;
+        const UNormalizer2 *n2=unorm2_getNFCInstance(&errorCode);
+        if(U_FAILURE(errorCode)) {
+            log_err_status(errorCode, "unorm2_getNFCInstance() failed: %s\n", u_errorName(errorCode));
+            return;
+        }
+        unorm2_isNormalizedBatch(n2, text, badOffsets, 2, results, &errorCode);
+        if(errorCode!=U_ILLEGAL_ARGUMENT_ERROR) {
+            log_err("unorm2_isNormalizedBatch(decreasing offsets) failed to set U_ILLEGAL_ARGUMENT_ERROR\n");
+        }
+        errorCode=U_ZERO_ERROR;
+        unorm2_isNormalizedBatch(n2, text, NULL, 2, results, &errorCode);
+        if(errorCode!=U_ILLEGAL_ARGUMENT_ERROR) {
+            log_err("unorm2_isNormalizedBatch(offsets=NULL) failed to set U_ILLEGAL_ARGUMENT_ERROR\n");
+        }
+    }
+}
+
 #endif /* #if !UCONFIG_NO_NORMALIZATION */
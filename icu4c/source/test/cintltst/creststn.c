@@ -215,6 +215,7 @@ static void TestCLDRStyleAliases(void);
 static void TestFallbackCodes(void);
 static void TestGetUTF8String(void);
 static void TestCLDRVersion(void);
+static void TestFallbackIndex(void);
 
 /***************************************************************************************/
 
@@ -251,6 +252,7 @@ void addNEWResourceBundleTest(TestNode** root)
     addTest(root, &TestGetFunctionalEquivalent,"tsutil/creststn/TestGetFunctionalEquivalent");
     addTest(root, &TestJB3763,                "tsutil/creststn/TestJB3763");
     addTest(root, &TestStackReuse,            "tsutil/creststn/TestStackReuse");
+    addTest(root, &TestFallbackIndex,         "tsutil/creststn/TestFallbackIndex");
 }
 
 
@@ -2897,6 +2899,77 @@ static void TestStackReuse(void) {
     ures_close(&table);
 }
 
+/*
+ * Looks up a path with ures_getByKeyWithFallback(), below the sub-table at
+ * tablePath if that is not NULL, and returns the value's type,
+ * and its string contents (or size) in value/length.
+ */
+static UResType getWithFallback(const char *locale, const char *tablePath, const char *path,
+                                const UChar **value, int32_t *length, UErrorCode *status) {
+    UResourceBundle *rb = ures_open(NULL, locale, status);
+    UResourceBundle *table = NULL;
+    UResourceBundle *item;
+    UResType type = URES_NONE;
+    *value = NULL;
+    *length = 0;
+    if(tablePath != NULL) {
+        table = ures_getByKeyWithFallback(rb, tablePath, NULL, status);
+    }
+    item = ures_getByKeyWithFallback(table != NULL ? table : rb, path, NULL, status);
+    if(U_SUCCESS(*status)) {
+        type = ures_getType(item);
+        if(type == URES_STRING) {
+            *value = ures_getString(item, length, status);
+        } else {
+            *length = ures_getSize(item);
+        }
+    }
+    ures_close(item);
+    ures_close(table);
+    ures_close(rb);
+    return type;
+}
+
+static void TestFallbackIndex(void) {
+    static const char *const locales[] = { "de_CH", "de_AT", "fr_CA", "sr_Latn_BA", "zh_Hant_HK", "en_GB", "xx_YY" };
+    static const char *const paths[][2] = {
+        { NULL, "NumberElements/latn/patterns/decimalFormat" },
+        { NULL, "NumberElements/latn/symbols/decimal" },
+        { NULL, "calendar/gregorian/DateTimePatterns" },
+        { NULL, "calendar/gregorian/noSuchKey" },
+        { "NumberElements", "latn/symbols/group" },
+        { "calendar", "gregorian/dayNames/format/wide" }
+    };
+    int32_t i, j, round;
+    for(i = 0; i < UPRV_LENGTHOF(locales); ++i) {
+        for(j = 0; j < UPRV_LENGTHOF(paths); ++j) {
+            UErrorCode expectedStatus = U_ZERO_ERROR;
+            const UChar *expectedValue;
+            int32_t expectedLength;
+            UResType expectedType;
+            ures_setFallbackIndexEnabled(FALSE);
+            expectedType = getWithFallback(locales[i], paths[j][0], paths[j][1],
+                                           &expectedValue, &expectedLength, &expectedStatus);
+            ures_setFallbackIndexEnabled(TRUE);
+            /* The first round may build the index, the second one uses it. */
+            for(round = 0; round < 2; ++round) {
+                UErrorCode status = U_ZERO_ERROR;
+                const UChar *value;
+                int32_t length;
+                UResType type = getWithFallback(locales[i], paths[j][0], paths[j][1],
+                                                &value, &length, &status);
+                if(status != expectedStatus || type != expectedType || length != expectedLength ||
+                        (value != NULL && u_strcmp(value, expectedValue) != 0)) {
+                    log_err("%s %s/%s round %d: got type %d length %d %s, expected type %d length %d %s\n",
+                            locales[i], paths[j][0] != NULL ? paths[j][0] : "", paths[j][1], (int)round,
+                            (int)type, (int)length, u_errorName(status),
+                            (int)expectedType, (int)expectedLength, u_errorName(expectedStatus));
+                }
+            }
+        }
+    }
+}
+
 /* Test ures_getUTF8StringXYZ() --------------------------------------------- */
 
 /*
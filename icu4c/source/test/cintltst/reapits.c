@@ -2287,7 +2287,8 @@ static void TestBug10815() {
     re = uregex_openC(".z", 0, 0, &status);
     TEST_ASSERT_SUCCESS(status);
 
-    u_uastrncpy(text, "Hello, World.",  UPRV_LENGTHOF(text));
+    // The text ends with the z that every match needs, so that find() does look for a match.
+    u_uastrncpy(text, "Hello, World.z",  UPRV_LENGTHOF(text));
     uregex_setText(re, text, -1, &status);
     TEST_ASSERT_SUCCESS(status);
 
@@ -2307,7 +2308,9 @@ static void TestBug10815() {
 
     // Pattern + this text gives an exponential time match. Without the callback to stop the match,
     // it will appear to be stuck in a (near) infinite loop.
-    u_uastrncpy(text, "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx",  UPRV_LENGTHOF(text));
+    // The text ends with the y that every match needs, after a number of x's that is not a
+    // multiple of three, so that find() does try to match from the start.
+    u_uastrncpy(text, "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxy",  UPRV_LENGTHOF(text));
     uregex_setText(re, text, -1, &status);
     TEST_ASSERT_SUCCESS(status);
 
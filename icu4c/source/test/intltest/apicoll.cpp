@@ -48,6 +48,7 @@
 #include "sfwdchit.h"
 #include "cmemory.h"
 #include <stdlib.h>
+#include <string>
 
 void
 CollationAPITest::doAssert(UBool condition, const char *message)
@@ -2517,6 +2518,161 @@ void CollationAPITest::TestGapTooSmall() {
     }
 }
 
+void CollationAPITest::TestCompareBatch() {
+    IcuTestErrorCode errorCode(*this, "TestCompareBatch");
+    LocalPointer<Collator> coll(Collator::createInstance(Locale::getEnglish(), errorCode));
+    if(errorCode.errDataIfFailureAndReset("Collator::createInstance(English)")) {
+        return;
+    }
+    // Fast-Latin pairs, pairs that need the full collation code,
+    // mixed known/unknown lengths and an empty string.
+    // The full-code pairs alternate with fast-Latin ones, so that the iterators
+    // which compareBatch() keeps for the batch get reset between different texts.
+    const char16_t *sources[] = {
+        u"abc", u"ABC", u"c\u00F4te", u"ab", u"\u4E00", u"a\u0308", u"x", u"",
+        u"\u1E0B\u0323", u"same", u"\u0E01\u0E32", u"\uAC00\u0301x"
+    };
+    const char16_t *targets[] = {
+        u"abd", u"abc", u"cot\u00E9", u"abc", u"\u4E01", u"\u00E4", u"xyz", u"a",
+        u"\u1E0D\u0307", u"same", u"\u0E01\u0E33", u"\uAC00\u0301"
+    };
+    int32_t sourceLengths[] = { -1, 3, -1, 2, -1, 2, -1, 0, -1, 4, -1, 3 };
+    int32_t targetLengths[] = { 3, -1, -1, 2, -1, -1, 1, -1, -1, -1, 2, -1 };
+    const int32_t count = UPRV_LENGTHOF(sources);
+    const char *sources8[count];
+    const char *targets8[count];
+    std::string sourceStrings8[count], targetStrings8[count];
+    for(int32_t i = 0; i < count; ++i) {
+        int32_t sourceLength = sourceLengths[i] >= 0 ? sourceLengths[i] : u_strlen(sources[i]);
+        int32_t targetLength = targetLengths[i] >= 0 ? targetLengths[i] : u_strlen(targets[i]);
+        UnicodeString(FALSE, sources[i], sourceLength).toUTF8String(sourceStrings8[i]);
+        UnicodeString(FALSE, targets[i], targetLength).toUTF8String(targetStrings8[i]);
+        sources8[i] = sourceStrings8[i].c_str();
+        targets8[i] = targetStrings8[i].c_str();
+    }
+
+    // Without and with normalization, which use different iterator types.
+    static const UColAttributeValue normalization[] = { UCOL_OFF, UCOL_ON };
+    for(int32_t n = 0; n < UPRV_LENGTHOF(normalization); ++n) {
+        coll->setAttribute(UCOL_NORMALIZATION_MODE, normalization[n], errorCode);
+        UCollationResult results[count];
+        coll->compareBatch(sources, sourceLengths, targets, targetLengths, count, results, errorCode);
+        if(errorCode.errIfFailureAndReset("compareBatch()")) { return; }
+        for(int32_t i = 0; i < count; ++i) {
+            int32_t sourceLength = sourceLengths[i] >= 0 ? sourceLengths[i] : u_strlen(sources[i]);
+            int32_t targetLength = targetLengths[i] >= 0 ? targetLengths[i] : u_strlen(targets[i]);
+            UnicodeString source(FALSE, sources[i], sourceLength);
+            UnicodeString target(FALSE, targets[i], targetLength);
+            assertEquals(UnicodeString("compareBatch(") + source + ", " + target + ") norm=" + n,
+                         (int32_t)coll->compare(source, target, errorCode), (int32_t)results[i]);
+        }
+
+        UCollationResult results8[count];
+        coll->compareBatchUTF8(sources8, NULL, targets8, NULL, count, results8, errorCode);
+        if(errorCode.errIfFailureAndReset("compareBatchUTF8()")) { return; }
+        for(int32_t i = 0; i < count; ++i) {
+            assertEquals(UnicodeString("compareBatchUTF8(") + sources8[i] + ", " + targets8[i] +
+                         ") norm=" + n,
+                         (int32_t)results[i], (int32_t)results8[i]);
+        }
+    }
+
+    UCollationResult results[1];
+    coll->compareBatch(sources, NULL, targets, NULL, -1, results, errorCode);
+    assertEquals("compareBatch(count<0)", U_ILLEGAL_ARGUMENT_ERROR, errorCode.reset());
+    coll->compareBatch(NULL, NULL, targets, NULL, 1, results, errorCode);
+    assertEquals("compareBatch(sources=NULL)", U_ILLEGAL_ARGUMENT_ERROR, errorCode.reset());
+    coll->compareBatch(NULL, NULL, NULL, NULL, 0, NULL, errorCode);
+    assertSuccess("compareBatch(count=0)", errorCode);
+}
+
+void CollationAPITest::TestSortIndexes() {
+    IcuTestErrorCode errorCode(*this, "TestSortIndexes");
+    LocalPointer<Collator> coll(Collator::createInstance(Locale::getEnglish(), errorCode));
+    if(errorCode.errDataIfFailureAndReset("Collator::createInstance(English)")) {
+        return;
+    }
+    const char16_t *strings[] = {
+        u"pear", u"Apple", u"一", u"apple", u"peach", u"b", u"", u"pear", u"äpple"
+    };
+    const int32_t count = UPRV_LENGTHOF(strings);
+    // Expected order; equal strings ("pear") in input order.
+    const int32_t expected[count] = { 6, 3, 1, 8, 5, 4, 0, 7, 2 };
+    int32_t indexes[count];
+    coll->sortIndexes(strings, NULL, count, indexes, errorCode);
+    if(errorCode.errIfFailureAndReset("sortIndexes()")) { return; }
+    for(int32_t i = 0; i < count; ++i) {
+        assertEquals(UnicodeString("sortIndexes()[") + i + "]", expected[i], indexes[i]);
+    }
+
+    const char *strings8[count];
+    int32_t lengths8[count];
+    std::string strings8Storage[count];
+    for(int32_t i = 0; i < count; ++i) {
+        UnicodeString(strings[i]).toUTF8String(strings8Storage[i]);
+        strings8[i] = strings8Storage[i].data();
+        lengths8[i] = (i & 1) ? -1 : (int32_t)strings8Storage[i].length();
+    }
+    coll->sortIndexesUTF8(strings8, lengths8, count, indexes, errorCode);
+    if(errorCode.errIfFailureAndReset("sortIndexesUTF8()")) { return; }
+    for(int32_t i = 0; i < count; ++i) {
+        assertEquals(UnicodeString("sortIndexesUTF8()[") + i + "]", expected[i], indexes[i]);
+    }
+
+    const char16_t *withNull[] = { u"a", NULL };
+    int32_t withNullLengths[] = { 1, -1 };
+    coll->sortIndexes(withNull, withNullLengths, 2, indexes, errorCode);
+    assertEquals("sortIndexes(NULL string)", U_ILLEGAL_ARGUMENT_ERROR, errorCode.reset());
+}
+
+void CollationAPITest::TestGetSortKeys() {
+    IcuTestErrorCode errorCode(*this, "TestGetSortKeys");
+    LocalPointer<Collator> coll(Collator::createInstance(Locale::getEnglish(), errorCode));
+    if(errorCode.errDataIfFailureAndReset("Collator::createInstance(English)")) {
+        return;
+    }
+    const char16_t *strings[] = {
+        u"pear", u"Apple", u"一", NULL, u"äpple", u"", u"ab\u0301c\u0327"
+    };
+    const int32_t count = UPRV_LENGTHOF(strings);
+    const int32_t lengths[count] = { -1, 5, -1, 0, 5, -1, -1 };
+    int32_t offsets[count + 1];
+
+    // Preflight.
+    int32_t totalLength = coll->getSortKeys(strings, lengths, count, NULL, 0, offsets, errorCode);
+    assertEquals("getSortKeys(preflight)", U_BUFFER_OVERFLOW_ERROR, errorCode.reset());
+    assertEquals("getSortKeys(preflight) offsets[count]", totalLength, offsets[count]);
+
+    uint8_t keys[200];
+    if(!assertTrue("total sort keys length fits", totalLength <= UPRV_LENGTHOF(keys))) { return; }
+    int32_t length = coll->getSortKeys(strings, lengths, count, keys, UPRV_LENGTHOF(keys),
+                                       offsets, errorCode);
+    if(errorCode.errIfFailureAndReset("getSortKeys()")) { return; }
+    assertEquals("getSortKeys() length", totalLength, length);
+    assertEquals("getSortKeys() offsets[0]", 0, offsets[0]);
+    for(int32_t i = 0; i < count; ++i) {
+        uint8_t key[100];
+        int32_t keyLength = strings[i] != NULL ?
+            coll->getSortKey(strings[i], lengths[i], key, UPRV_LENGTHOF(key)) :
+            coll->getSortKey(u"", 0, key, UPRV_LENGTHOF(key));
+        UnicodeString name = UnicodeString("getSortKeys() key ") + i;
+        if(assertEquals(name + " length", keyLength, offsets[i + 1] - offsets[i])) {
+            assertTrue(name + " bytes", uprv_memcmp(key, keys + offsets[i], keyLength) == 0);
+        }
+    }
+
+    // Too small for the last key: The offsets are still set.
+    length = coll->getSortKeys(strings, lengths, count, keys, totalLength - 1, offsets, errorCode);
+    assertEquals("getSortKeys(too small)", U_BUFFER_OVERFLOW_ERROR, errorCode.reset());
+    assertEquals("getSortKeys(too small) length", totalLength, length);
+
+    const int32_t badLengths[] = { -1, -1, -1, 1, -1, -1, -1 };
+    coll->getSortKeys(strings, badLengths, count, keys, UPRV_LENGTHOF(keys), offsets, errorCode);
+    assertEquals("getSortKeys(NULL string)", U_ILLEGAL_ARGUMENT_ERROR, errorCode.reset());
+    coll->getSortKeys(strings, lengths, count, keys, UPRV_LENGTHOF(keys), NULL, errorCode);
+    assertEquals("getSortKeys(NULL offsets)", U_ILLEGAL_ARGUMENT_ERROR, errorCode.reset());
+}
+
  void CollationAPITest::dump(UnicodeString msg, RuleBasedCollator* c, UErrorCode& status) {
     const char* bigone = "One";
     const char* littleone = "one";
@@ -2560,6 +2716,9 @@ void CollationAPITest::runIndexedTest( int32_t index, UBool exec, const char* &n
     TESTCASE_AUTO(TestIterNumeric);
     TESTCASE_AUTO(TestBadKeywords);
     TESTCASE_AUTO(TestGapTooSmall);
+    TESTCASE_AUTO(TestCompareBatch);
+    TESTCASE_AUTO(TestSortIndexes);
+    TESTCASE_AUTO(TestGetSortKeys);
     TESTCASE_AUTO_END;
 }
 
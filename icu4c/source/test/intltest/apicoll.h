@@ -174,6 +174,9 @@ class CollationAPITest: public IntlTestCollator {
     void TestIterNumeric();
     void TestBadKeywords();
     void TestGapTooSmall();
+    void TestCompareBatch();
+    void TestSortIndexes();
+    void TestGetSortKeys();
 
 private:
     // If this is too small for the test data, just increase it.
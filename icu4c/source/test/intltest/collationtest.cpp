@@ -71,6 +71,7 @@ class CollationTest : public IntlTest {
     void TestImplicits();
     void TestNulTerminated();
     void TestIllegalUTF8();
+    void TestFastScript();
     void TestShortFCDData();
     void TestFCD();
     void TestCollationWeights();
@@ -141,6 +142,7 @@ void CollationTest::runIndexedTest(int32_t index, UBool exec, const char *&name,
     TESTCASE_AUTO(TestImplicits);
     TESTCASE_AUTO(TestNulTerminated);
     TESTCASE_AUTO(TestIllegalUTF8);
+    TESTCASE_AUTO(TestFastScript);
     TESTCASE_AUTO(TestShortFCDData);
     TESTCASE_AUTO(TestFCD);
     TESTCASE_AUTO(TestCollationWeights);
@@ -315,6 +317,100 @@ void CollationTest::TestIllegalUTF8() {
     }
 }
 
+void CollationTest::TestFastScript() {
+    IcuTestErrorCode errorCode(*this, "TestFastScript");
+
+    // Greek & Cyrillic text with ASCII & general punctuation,
+    // compared with the CollationFastScript fastpath where possible.
+    // Latin letters, combining marks and other characters make it bail out.
+    static const char16_t *strings[] = {
+        u"\u0430", u"\u0410", u"\u0430\u0431", u"\u0431\u0430", u"\u0435", u"\u0451", u"\u0401",
+        u"\u0435\u0308", u"\u0438", u"\u0439", u"\u0419", u"\u0456", u"\u0457", u"\u0491",
+        u"\u0454", u"\u0430-\u0431", u"\u0430\u2010\u0431", u"\u0430 \u0431", u"\u0430\u00A0\u0431",
+        u"\u0430.\u0431", u"\u0430\u2014\u0431", u"\u0430\u0431 12", u"\u0430\u0431 9",
+        u"\u0430\uFFFE\u0431", u"\u0430\uFFFF", u"\u0430b", u"\u0430\u0432", u"\u044F", u"\u042F",
+        u"\u0436\u0435\u043B\u0435\u0437\u043D\u0430\u044F",
+        u"\u0416\u0435\u043B\u0435\u0437\u043D\u0430\u044F",
+        u"\u03B1", u"\u0391", u"\u03AC", u"\u0386", u"\u03B1\u0301", u"\u03C3", u"\u03C2", u"\u03A3",
+        u"\u03B9", u"\u03CA", u"\u0390", u"\u03B1\u03B2\u03B3", u"\u03B1\u03B2 \u03B3",
+        u"\u03B1-\u03B2", u"\u03B1\u2019\u03B2", u"\u03B1\u03B2\u03B3\u03B4\u03AD\u03C2",
+        u"\u0391\u0392\u0393\u0394\u0388\u03A3", u"\u03C9", u"\u03CE", u"\u037E", u";",
+        u"\u03B1\u0430", u"\u0430\u03B1", u"a", u"-", u"\u2030", u"1\u0430", u"1\u03B1"
+    };
+    static const char *const locales[] = { "", "ru", "uk", "bg", "sr", "el" };
+
+    for(int32_t l = 0; l < UPRV_LENGTHOF(locales); ++l) {
+        LocalPointer<Collator> base(Collator::createInstance(Locale(locales[l]), errorCode));
+        if(errorCode.errDataIfFailureAndReset("Collator::createInstance(%s)", locales[l])) {
+            continue;
+        }
+        for(int32_t variant = 0; variant < 7; ++variant) {
+            LocalPointer<Collator> coll(base->clone());
+            if(coll.isNull()) {
+                errln("Collator::clone() failed");
+                return;
+            }
+            switch(variant) {
+            case 1:
+                coll->setAttribute(UCOL_ALTERNATE_HANDLING, UCOL_SHIFTED, errorCode);
+                coll->setAttribute(UCOL_STRENGTH, UCOL_QUATERNARY, errorCode);
+                break;
+            case 2:
+                coll->setAttribute(UCOL_CASE_FIRST, UCOL_UPPER_FIRST, errorCode);
+                break;
+            case 3:
+                coll->setAttribute(UCOL_CASE_LEVEL, UCOL_ON, errorCode);
+                coll->setAttribute(UCOL_STRENGTH, UCOL_PRIMARY, errorCode);
+                break;
+            case 4:
+                coll->setAttribute(UCOL_FRENCH_COLLATION, UCOL_ON, errorCode);
+                break;
+            case 5: {
+                static const int32_t codes[] = { USCRIPT_CYRILLIC, USCRIPT_GREEK, USCRIPT_LATIN };
+                coll->setReorderCodes(codes, UPRV_LENGTHOF(codes), errorCode);
+                break;
+            }
+            case 6: {
+                static const int32_t codes[] = { UCOL_REORDER_CODE_DIGIT, USCRIPT_GREEK };
+                coll->setReorderCodes(codes, UPRV_LENGTHOF(codes), errorCode);
+                break;
+            }
+            default:
+                break;
+            }
+            if(errorCode.errIfFailureAndReset("setting attributes for variant %d", (int)variant)) {
+                continue;
+            }
+            for(int32_t i = 0; i < UPRV_LENGTHOF(strings); ++i) {
+                UnicodeString left(strings[i]);
+                std::string left8;
+                left.toUTF8String(left8);
+                CollationKey leftKey;
+                coll->getCollationKey(left, leftKey, errorCode);
+                for(int32_t j = 0; j < UPRV_LENGTHOF(strings); ++j) {
+                    UnicodeString right(strings[j]);
+                    std::string right8;
+                    right.toUTF8String(right8);
+                    CollationKey rightKey;
+                    coll->getCollationKey(right, rightKey, errorCode);
+                    UCollationResult expected = leftKey.compareTo(rightKey, errorCode);
+                    UCollationResult order = coll->compare(left, right, errorCode);
+                    UCollationResult orderNUL = coll->compare(
+                        left.getTerminatedBuffer(), -1, right.getTerminatedBuffer(), -1, errorCode);
+                    UCollationResult order8 = coll->compareUTF8(left8, right8, errorCode);
+                    if(errorCode.errIfFailureAndReset("compare()")) { return; }
+                    if(order != expected || orderNUL != expected || order8 != expected) {
+                        errln("locale \"%s\" variant %d: compare(%d, %d)=%d NUL-terminated=%d "
+                              "UTF-8=%d != sort key comparison %d",
+                              locales[l], (int)variant, (int)i, (int)j,
+                              order, orderNUL, order8, expected);
+                    }
+                }
+            }
+        }
+    }
+}
+
 namespace {
 
 void addLeadSurrogatesForSupplementary(const UnicodeSet &src, UnicodeSet &dest) {
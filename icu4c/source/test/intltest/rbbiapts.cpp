@@ -1117,6 +1117,208 @@ void RBBIAPITest::TestGetBinaryRules() {
 }
 
 
+// Creates the English character, word, line and sentence break iterators,
+// for TestGetBoundaries() and TestUpdateBoundaries().
+static void createEnglishBreakIterators(LocalPointer<BreakIterator> (&iters)[4], UErrorCode &status) {
+    const Locale &en = Locale::getEnglish();
+    iters[0].adoptInsteadAndCheckErrorCode(BreakIterator::createCharacterInstance(en, status), status);
+    iters[1].adoptInsteadAndCheckErrorCode(BreakIterator::createWordInstance(en, status), status);
+    iters[2].adoptInsteadAndCheckErrorCode(BreakIterator::createLineInstance(en, status), status);
+    iters[3].adoptInsteadAndCheckErrorCode(BreakIterator::createSentenceInstance(en, status), status);
+}
+
+//
+//  TestGetBoundaries
+//     Boundaries from getBoundaries() over adjacent ranges, as when segmenting in parallel,
+//     must match forward iteration over the whole text, including the rule status values.
+//
+void RBBIAPITest::TestGetBoundaries() {
+    UErrorCode status = U_ZERO_ERROR;
+    // Latin, numbers and punctuation, CJK and Thai (dictionary), and a supplementary character.
+    UnicodeString text(u"The quick (\"brown\") fox can't jump 32.3 feet, right?\r\n"
+                       u"\u4E00\u4E8C\u4E09\u56DB\u4E94 \u0E01\u0E32\u0E23\u0E17\u0E14\u0E2A\u0E2D\u0E1A"
+                       u"\u0E20\u0E32\u0E29\u0E32\u0E44\u0E17\u0E22 \U0001F600 Hello   world.  Next sentence!");
+    LocalPointer<BreakIterator> iters[4];
+    createEnglishBreakIterators(iters, status);
+    if (U_FAILURE(status)) {
+        dataerrln("%s:%d Failed to create break iterators: %s", __FILE__, __LINE__, u_errorName(status));
+        return;
+    }
+    for (int32_t k = 0; k < UPRV_LENGTHOF(iters); ++k) {
+        RuleBasedBreakIterator *bi = dynamic_cast<RuleBasedBreakIterator *>(iters[k].getAlias());
+        bi->setText(text);
+        int32_t expected[200], expectedStatuses[200];
+        int32_t expectedLength = 0;
+        for (int32_t b = bi->first(); b != BreakIterator::DONE; b = bi->next()) {
+            expectedStatuses[expectedLength] = bi->getRuleStatus();
+            expected[expectedLength++] = b;
+        }
+
+        // Whole text, and preflighting.
+        int32_t boundaries[200], statuses[200];
+        int32_t length = bi->getBoundaries(0, text.length(), nullptr, nullptr, 0, status);
+        assertEquals("preflighting", U_BUFFER_OVERFLOW_ERROR, status);
+        assertEquals("preflighting length", expectedLength, length);
+        status = U_ZERO_ERROR;
+        length = bi->getBoundaries(0, text.length(), boundaries, statuses, UPRV_LENGTHOF(boundaries), status);
+        if (!assertSuccess(WHERE, status) || !assertEquals(WHERE, expectedLength, length)) {
+            return;
+        }
+        // Normal iteration continues from a boundary after the range.
+        assertEquals("current() after getBoundaries()", text.length(), bi->current());
+        assertEquals("previous() after getBoundaries()", expected[expectedLength - 2], bi->previous());
+        assertEquals("getRuleStatus() after previous()", expectedStatuses[expectedLength - 2], bi->getRuleStatus());
+
+        // Split into n ranges for every range count, and concatenate the results.
+        for (int32_t n = 1; n <= 25; ++n) {
+            length = 0;
+            for (int32_t i = 0; i < n && U_SUCCESS(status); ++i) {
+                int32_t start = (text.length() * i) / n;
+                int32_t limit = (text.length() * (i + 1)) / n;
+                length += bi->getBoundaries(start, limit, boundaries + length, statuses + length,
+                                            UPRV_LENGTHOF(boundaries) - length, status);
+            }
+            if (!assertSuccess(WHERE, status)) {
+                return;
+            }
+            char name[80];
+            sprintf(name, "iterator %d, %d ranges", (int)k, (int)n);
+            if (!assertEquals(name, expectedLength, length)) {
+                continue;
+            }
+            for (int32_t i = 0; i < length; ++i) {
+                if (boundaries[i] != expected[i] || statuses[i] != expectedStatuses[i]) {
+                    errln("%s: boundary %d is %d status %d, expected %d status %d", name, (int)i,
+                          (int)boundaries[i], (int)statuses[i], (int)expected[i], (int)expectedStatuses[i]);
+                    break;
+                }
+            }
+        }
+    }
+
+    // Argument errors.
+    RuleBasedBreakIterator *bi = dynamic_cast<RuleBasedBreakIterator *>(iters[1].getAlias());
+    int32_t boundaries[4];
+    bi->getBoundaries(5, 4, boundaries, nullptr, UPRV_LENGTHOF(boundaries), status);
+    assertEquals("limit<start", U_ILLEGAL_ARGUMENT_ERROR, status);
+    status = U_ZERO_ERROR;
+    bi->getBoundaries(0, 4, nullptr, nullptr, 4, status);
+    assertEquals("boundaries=nullptr", U_ILLEGAL_ARGUMENT_ERROR, status);
+}
+
+//
+//  TestUpdateBoundaries
+//      Random edits of a text, each checked against segmenting the whole edited text.
+//
+void RBBIAPITest::TestUpdateBoundaries() {
+    UErrorCode status = U_ZERO_ERROR;
+    UnicodeString text(u"The quick (\"brown\") fox can't jump 32.3 feet, right?\r\n"
+                       u"\u4E00\u4E8C\u4E09\u56DB\u4E94 \u0E01\u0E32\u0E23\u0E17\u0E14\u0E2A\u0E2D\u0E1A"
+                       u"\u0E20\u0E32\u0E29\u0E32\u0E44\u0E17\u0E22 \U0001F600 Hello   world.  Next sentence! "
+                       u"\u041F\u0440\u0438\u0432\u0435\u0442, \u043C\u0438\u0440. e\u0301 \U0001F1E9\U0001F1EA "
+                       u"\u0E2A\u0E27\u0E31\u0E2A\u0E14\u0E35\u0E04\u0E23\u0E31\u0E1A\u0E27\u0E31\u0E19\u0E19\u0E35\u0E49"
+                       u"\u0E2D\u0E32\u0E01\u0E32\u0E28\u0E14\u0E35\u0E21\u0E32\u0E01");
+    static const char16_t *insertions[] = {
+        u"", u"x", u" ", u"ab cd", u". ", u"? Yes", u"\r\n", u"'", u"3.5",
+        u"\u0E01\u0E32\u0E23", u"\u0E19", u"\u0E14\u0E35", u"\u65E5\u672C", u"\U0001F600", u"\u0301", u"\U0001F1E9"
+    };
+    LocalPointer<BreakIterator> iters[4];
+    createEnglishBreakIterators(iters, status);
+    if (U_FAILURE(status)) {
+        dataerrln("%s:%d Failed to create break iterators: %s", __FILE__, __LINE__, u_errorName(status));
+        return;
+    }
+    uint32_t seed = 12345;
+    for (int32_t trial = 0; trial < 1000; ++trial) {
+        // Up to three replacements, in text order, recorded in an Edits object.
+        UnicodeString newText;
+        Edits edits;
+        int32_t numEdits = 1 + (int32_t)((seed = seed * 1103515245 + 12345) >> 16) % 3;
+        int32_t srcIndex = 0;
+        for (int32_t e = 0; e < numEdits; ++e) {
+            int32_t remaining = text.length() - srcIndex;
+            int32_t start = srcIndex + (int32_t)((seed = seed * 1103515245 + 12345) >> 16) % (remaining / 2 + 1);
+            int32_t oldLength = (int32_t)((seed = seed * 1103515245 + 12345) >> 16) % 6;
+            if (start + oldLength > text.length()) {
+                oldLength = text.length() - start;
+            }
+            const char16_t *insertion = insertions[((seed = seed * 1103515245 + 12345) >> 16) % UPRV_LENGTHOF(insertions)];
+            int32_t newLength = u_strlen(insertion);
+            if (oldLength == 0 && newLength == 0) {
+                continue;
+            }
+            newText.append(text, srcIndex, start - srcIndex);
+            edits.addUnchanged(start - srcIndex);
+            newText.append(insertion, newLength);
+            edits.addReplace(oldLength, newLength);
+            srcIndex = start + oldLength;
+        }
+        newText.append(text, srcIndex, text.length() - srcIndex);
+        edits.addUnchanged(text.length() - srcIndex);
+
+        for (int32_t k = 0; k < UPRV_LENGTHOF(iters); ++k) {
+            RuleBasedBreakIterator *bi = dynamic_cast<RuleBasedBreakIterator *>(iters[k].getAlias());
+            int32_t oldBoundaries[300];
+            bi->setText(text);
+            int32_t oldLength = bi->getBoundaries(0, text.length(), oldBoundaries, nullptr,
+                                                  UPRV_LENGTHOF(oldBoundaries), status);
+            int32_t expected[300];
+            bi->setText(newText);
+            int32_t expectedLength = bi->getBoundaries(0, newText.length(), expected, nullptr,
+                                                       UPRV_LENGTHOF(expected), status);
+            // A fresh iterator, so that nothing is cached from segmenting the whole new text.
+            LocalPointer<RuleBasedBreakIterator> bi2(bi->clone());
+            bi2->setText(newText);
+            int32_t boundaries[300];
+            int32_t length = bi2->updateBoundaries(oldBoundaries, oldLength, edits,
+                                                   boundaries, UPRV_LENGTHOF(boundaries), status);
+            if (!assertSuccess(WHERE, status)) {
+                return;
+            }
+            char name[80];
+            sprintf(name, "trial %d, iterator %d", (int)trial, (int)k);
+            if (!assertEquals(name, expectedLength, length)) {
+                continue;
+            }
+            for (int32_t i = 0; i < length; ++i) {
+                if (boundaries[i] != expected[i]) {
+                    errln("%s: boundary %d is %d, expected %d", name, (int)i, (int)boundaries[i], (int)expected[i]);
+                    break;
+                }
+            }
+        }
+        text = newText;
+        if (text.length() > 250) {
+            text.truncate(200);
+        }
+    }
+
+    // Preflighting, no changes, and argument errors.
+    RuleBasedBreakIterator *bi = dynamic_cast<RuleBasedBreakIterator *>(iters[1].getAlias());
+    bi->setText(text);
+    int32_t oldBoundaries[300], boundaries[300];
+    int32_t oldLength = bi->getBoundaries(0, text.length(), oldBoundaries, nullptr,
+                                          UPRV_LENGTHOF(oldBoundaries), status);
+    Edits edits;
+    edits.addUnchanged(text.length());
+    int32_t length = bi->updateBoundaries(oldBoundaries, oldLength, edits, nullptr, 0, status);
+    assertEquals("preflighting", U_BUFFER_OVERFLOW_ERROR, status);
+    assertEquals("preflighting length", oldLength, length);
+    status = U_ZERO_ERROR;
+    length = bi->updateBoundaries(oldBoundaries, oldLength, edits, boundaries, UPRV_LENGTHOF(boundaries), status);
+    assertSuccess("no changes", status);
+    assertTrue("no changes", length == oldLength && uprv_memcmp(boundaries, oldBoundaries, length * 4) == 0);
+    edits.addReplace(0, 1);
+    bi->updateBoundaries(oldBoundaries, oldLength, edits, boundaries, UPRV_LENGTHOF(boundaries), status);
+    assertEquals("edits for a different length", U_ILLEGAL_ARGUMENT_ERROR, status);
+    status = U_ZERO_ERROR;
+    edits.reset();
+    edits.addUnchanged(text.length());
+    bi->updateBoundaries(oldBoundaries, oldLength, edits, oldBoundaries + 1, 10, status);
+    assertEquals("overlapping arrays", U_ILLEGAL_ARGUMENT_ERROR, status);
+}
+
+
 void RBBIAPITest::TestRefreshInputText() {
     /*
      *  RefreshInput changes out the input of a Break Iterator without
@@ -1435,6 +1637,10 @@ void RBBIAPITest::runIndexedTest( int32_t index, UBool exec, const char* &name,
     TESTCASE_AUTO(TestGetBinaryRules);
 #endif
     TESTCASE_AUTO(TestRefreshInputText);
+#if !UCONFIG_NO_FILE_IO
+    TESTCASE_AUTO(TestGetBoundaries);
+    TESTCASE_AUTO(TestUpdateBoundaries);
+#endif
 #if !UCONFIG_NO_BREAK_ITERATION
     TESTCASE_AUTO(TestFilteredBreakIteratorBuilder);
 #endif
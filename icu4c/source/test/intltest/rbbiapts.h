@@ -90,6 +90,9 @@ class RBBIAPITest: public IntlTest {
 
     void TestRefreshInputText();
 
+    void TestGetBoundaries();
+    void TestUpdateBoundaries();
+
     /**
      *Internal subroutines
      **/
@@ -14,6 +14,7 @@
 #include "unicode/utypes.h"
 #if !UCONFIG_NO_BREAK_ITERATION
 
+#include <algorithm>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -30,6 +31,7 @@
 #include "unicode/schriter.h"
 #include "unicode/uchar.h"
 #include "unicode/utf16.h"
+#include "unicode/utf8.h"
 #include "unicode/ucnv.h"
 #include "unicode/uniset.h"
 #include "unicode/uscript.h"
@@ -126,6 +128,10 @@ void RBBITest::runIndexedTest( int32_t index, UBool exec, const char* &name, cha
     TESTCASE_AUTO(TestReverse);
     TESTCASE_AUTO(TestBug13692);
     TESTCASE_AUTO(TestDebugRules);
+    TESTCASE_AUTO(TestTable_8_16_Bits);
+    TESTCASE_AUTO(TestDictionaryCache);
+    TESTCASE_AUTO(TestUTF8Text);
+    TESTCASE_AUTO(TestPreloadDictionaries);
     TESTCASE_AUTO_END;
 }
 
@@ -4611,6 +4617,7 @@ void RBBITest::TestTableRedundancies() {
     const RBBIStateTable *fwtbl = dw->fForwardTable;
     int32_t numCharClasses = dw->fHeader->fCatCount;
     // printf("Char Classes: %d     states: %d\n", numCharClasses, fwtbl->fNumStates);
+    bool in8Bits = fwtbl->fFlags & RBBI_8BITS_ROWS;
 
     // Check for duplicate columns (character categories)
 
@@ -4619,7 +4626,11 @@ void RBBITest::TestTableRedundancies() {
         UnicodeString s;
         for (int32_t r = 1; r < (int32_t)fwtbl->fNumStates; r++) {
             RBBIStateTableRow  *row = (RBBIStateTableRow *) (fwtbl->fTableData + (fwtbl->fRowLen * r));
-            s.append(row->fNextState[column]);
+            if (in8Bits) {
+                s.append(row->r8.fNextState[column]);
+            } else {
+                s.append(row->r16.fNextState[column]);
+            }
         }
         columns.push_back(s);
     }
@@ -4639,12 +4650,20 @@ void RBBITest::TestTableRedundancies() {
     for (int32_t r=0; r < (int32_t)fwtbl->fNumStates; r++) {
         UnicodeString s;
         RBBIStateTableRow  *row = (RBBIStateTableRow *) (fwtbl->fTableData + (fwtbl->fRowLen * r));
-        assertTrue(WHERE, row->fAccepting >= -1);
-        s.append(row->fAccepting + 1);   // values of -1 are expected.
-        s.append(row->fLookAhead);
-        s.append(row->fTagIdx);
-        for (int32_t column = 0; column < numCharClasses; column++) {
-            s.append(row->fNextState[column]);
+        if (in8Bits) {
+            s.append(row->r8.fAccepting);
+            s.append(row->r8.fLookAhead);
+            s.append(row->r8.fTagIdx);
+            for (int32_t column = 0; column < numCharClasses; column++) {
+                s.append(row->r8.fNextState[column]);
+            }
+        } else {
+            s.append(row->r16.fAccepting);
+            s.append(row->r16.fLookAhead);
+            s.append(row->r16.fTagIdx);
+            for (int32_t column = 0; column < numCharClasses; column++) {
+                s.append(row->r16.fNextState[column]);
+            }
         }
         rows.push_back(s);
     }
@@ -4860,6 +4879,235 @@ void RBBITest::TestDebugRules() {
 #endif
 }
 
+// State tables with up to 256 states are stored with 8-bit rows, larger ones with 16-bit rows.
+// Check that both kinds are chosen when they should be, and give the same boundaries.
+// Each 'a' of the rule adds a state to the forward table.
+void RBBITest::TestTable_8_16_Bits() {
+    static const int32_t lengths[] = {100, 400};
+    for (int32_t i = 0; i < UPRV_LENGTHOF(lengths); ++i) {
+        int32_t n = lengths[i];
+        UErrorCode status = U_ZERO_ERROR;
+        UParseError pe;
+        UnicodeString rules(u"!!forward; ");
+        rules.append(UnicodeString(n, u'a', n)).append(u" {200};");
+        RuleBasedBreakIterator bi(rules, pe, status);
+        if (!assertSuccess(WHERE, status)) {
+            return;
+        }
+        const RBBIStateTable *fwtbl = bi.fData->fForwardTable;
+        assertEquals(WHERE, n <= 200, (fwtbl->fFlags & RBBI_8BITS_ROWS) != 0);
+
+        UnicodeString text(n + 1, u'a', n + 1);
+        text.append(u'b');
+        bi.setText(text);
+        assertEquals(WHERE, 0, bi.first());
+        assertEquals(WHERE, n, bi.next());
+        assertEquals(WHERE, 200, bi.getRuleStatus());
+        assertEquals(WHERE, n + 1, bi.next());
+        assertEquals(WHERE, 0, bi.getRuleStatus());
+        assertEquals(WHERE, n + 2, bi.next());
+        assertEquals(WHERE, UBRK_DONE, bi.next());
+        // Random access goes through the safe reverse table.
+        assertEquals(WHERE, n, bi.preceding(n + 1));
+        assertEquals(WHERE, n + 1, bi.following(n));
+    }
+
+    // The standard rules all fit into 8-bit rows.
+    UErrorCode status = U_ZERO_ERROR;
+    LocalPointer<RuleBasedBreakIterator> bi(
+        (RuleBasedBreakIterator *)BreakIterator::createLineInstance(Locale::getEnglish(), status));
+    if (!assertSuccess(WHERE, status, true)) {
+        return;
+    }
+    assertTrue(WHERE, (bi->fData->fForwardTable->fFlags & RBBI_8BITS_ROWS) != 0);
+    assertTrue(WHERE, (bi->fData->fReverseTable->fFlags & RBBI_8BITS_ROWS) != 0);
+}
+
+// With the dictionary cache on, the boundaries must be the same as without it,
+// and a run segmented by one break iterator must be found by another one.
+void RBBITest::TestDictionaryCache() {
+    UErrorCode status = U_ZERO_ERROR;
+    // Three Thai runs and a Japanese one.
+    UnicodeString text(u"\u0E20\u0E32\u0E29\u0E32\u0E44\u0E17\u0E22\u0E07\u0E48\u0E32\u0E22 abc "
+                       u"\u0E2A\u0E27\u0E31\u0E2A\u0E14\u0E35\u0E04\u0E23\u0E31\u0E1A, "
+                       u"\u65E5\u672C\u8A9E\u306E\u30C6\u30AD\u30B9\u30C8\u3067\u3059\u3002 "
+                       u"\u0E02\u0E2D\u0E1A\u0E04\u0E38\u0E13\u0E21\u0E32\u0E01");
+    LocalPointer<BreakIterator> bi(BreakIterator::createWordInstance(Locale::getEnglish(), status));
+    if (!assertSuccess(WHERE, status, true)) {
+        return;
+    }
+    std::vector<int32_t> expected;
+    bi->setText(text);
+    for (int32_t b = bi->first(); b != UBRK_DONE; b = bi->next()) {
+        expected.push_back(b);
+    }
+
+    int64_t hits0, misses0, hits, misses;
+    RuleBasedBreakIterator::getDictionaryCacheStatistics(hits0, misses0);
+    RuleBasedBreakIterator::setDictionaryCacheCapacity(10, status);
+    assertSuccess(WHERE, status);
+    for (int32_t pass = 0; pass < 2; ++pass) {
+        // A new iterator each time, so that the per-iterator caches are empty.
+        LocalPointer<BreakIterator> bi2(BreakIterator::createWordInstance(Locale::getEnglish(), status));
+        if (!assertSuccess(WHERE, status)) {
+            break;
+        }
+        bi2->setText(text);
+        std::vector<int32_t> actual;
+        for (int32_t b = bi2->first(); b != UBRK_DONE; b = bi2->next()) {
+            actual.push_back(b);
+        }
+        assertTrue(WHERE, expected == actual);
+        RuleBasedBreakIterator::getDictionaryCacheStatistics(hits, misses);
+        if (pass == 0) {
+            assertEquals(WHERE, (int64_t)0, hits - hits0);
+            assertEquals(WHERE, (int64_t)4, misses - misses0);
+        } else {
+            assertEquals(WHERE, (int64_t)4, hits - hits0);
+            assertEquals(WHERE, (int64_t)4, misses - misses0);
+        }
+    }
+
+    // With room for only one run, cycling through four runs always misses.
+    RuleBasedBreakIterator::setDictionaryCacheCapacity(1, status);
+    RuleBasedBreakIterator::getDictionaryCacheStatistics(hits0, misses0);
+    LocalPointer<BreakIterator> bi3(BreakIterator::createWordInstance(Locale::getEnglish(), status));
+    if (assertSuccess(WHERE, status)) {
+        bi3->setText(text);
+        std::vector<int32_t> actual;
+        for (int32_t b = bi3->first(); b != UBRK_DONE; b = bi3->next()) {
+            actual.push_back(b);
+        }
+        assertTrue(WHERE, expected == actual);
+        RuleBasedBreakIterator::getDictionaryCacheStatistics(hits, misses);
+        assertEquals(WHERE, (int64_t)0, hits - hits0);
+        assertEquals(WHERE, (int64_t)4, misses - misses0);
+    }
+
+    RuleBasedBreakIterator::setDictionaryCacheCapacity(-1, status);
+    assertEquals(WHERE, U_ILLEGAL_ARGUMENT_ERROR, status);
+    status = U_ZERO_ERROR;
+    RuleBasedBreakIterator::setDictionaryCacheCapacity(0, status);
+    assertSuccess(WHERE, status);
+}
+
+// UTF-8 text is iterated without going through the UText for each character.
+// Check that the boundaries, as byte offsets, match those of the same text in UTF-16,
+// including around ill-formed sequences, which read as U+FFFD.
+void RBBITest::TestUTF8Text() {
+    static const char utf8[] =
+        "The quick (\"brown\") fox can't jump 32.3 feet, right? "
+        "\xD0\x9F\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82 \xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E\xE3\x81\xA7\xE3\x81\x99\xE3\x80\x82 "
+        "\xE0\xB8\xA0\xE0\xB8\xB2\xE0\xB8\xA9\xE0\xB8\xB2\xE0\xB9\x84\xE0\xB8\x97\xE0\xB8\xA2 "
+        "e\xCC\x81 \xF0\x9F\x91\xA8\xE2\x80\x8D\xF0\x9F\x91\xA9\xE2\x80\x8D\xF0\x9F\x91\xA7 \xF0\x9F\x87\xA9\xF0\x9F\x87\xAA. "
+        "Bad: \xC0\x80 a\x80" "b \xE0\x80 \xED\xA0\x80 \xF0\x9F\x98 x\xF4\x90\x80\x80y \xFF\xFE. End";
+    int32_t utf8Length = (int32_t)strlen(utf8);
+
+    // The UTF-16 text, and the UTF-8 offset of each UTF-16 code point boundary.
+    UnicodeString utf16;
+    std::vector<int32_t> utf8Offsets;
+    for (int32_t i = 0; i < utf8Length;) {
+        utf8Offsets.resize(utf16.length() + 1, -1);
+        utf8Offsets[utf16.length()] = i;
+        UChar32 c;
+        U8_NEXT_OR_FFFD((const uint8_t *)utf8, i, utf8Length, c);
+        utf16.append(c);
+    }
+    utf8Offsets.resize(utf16.length() + 1, -1);
+    utf8Offsets[utf16.length()] = utf8Length;
+
+    for (int32_t type = UBRK_CHARACTER; type <= UBRK_SENTENCE; ++type) {
+        UErrorCode status = U_ZERO_ERROR;
+        LocalPointer<BreakIterator> bi16;
+        switch (type) {
+            case UBRK_CHARACTER: bi16.adoptInstead(BreakIterator::createCharacterInstance("en", status)); break;
+            case UBRK_WORD:      bi16.adoptInstead(BreakIterator::createWordInstance("en", status)); break;
+            case UBRK_LINE:      bi16.adoptInstead(BreakIterator::createLineInstance("en", status)); break;
+            default:             bi16.adoptInstead(BreakIterator::createSentenceInstance("en", status)); break;
+        }
+        if (!assertSuccess(WHERE, status, true)) {
+            return;
+        }
+        LocalPointer<BreakIterator> bi8(bi16->clone());
+        bi16->setText(utf16);
+        std::vector<int32_t> expected;
+        for (int32_t b = bi16->first(); b != UBRK_DONE; b = bi16->next()) {
+            assertTrue(WHERE, utf8Offsets[b] >= 0);
+            expected.push_back(utf8Offsets[b]);
+        }
+
+        for (int32_t nulTerminated = 0; nulTerminated <= 1; ++nulTerminated) {
+            LocalUTextPointer ut(utext_openUTF8(nullptr, utf8, nulTerminated ? -1 : utf8Length, &status));
+            bi8->setText(ut.getAlias(), status);
+            if (!assertSuccess(WHERE, status)) {
+                return;
+            }
+            std::vector<int32_t> forward;
+            for (int32_t b = bi8->first(); b != UBRK_DONE; b = bi8->next()) {
+                forward.push_back(b);
+            }
+            assertTrue(WHERE, expected == forward);
+
+            std::vector<int32_t> backward;
+            for (int32_t b = bi8->last(); b != UBRK_DONE; b = bi8->previous()) {
+                backward.insert(backward.begin(), b);
+            }
+            assertTrue(WHERE, expected == backward);
+
+            // Random access, from every code point boundary, on a fresh iterator
+            // each time so that the results come from the rules and not the cache.
+            for (int32_t i16 = 0; i16 < (int32_t)utf8Offsets.size(); ++i16) {
+                int32_t i8 = utf8Offsets[i16];
+                if (i8 < 0) {
+                    continue;
+                }
+                LocalPointer<BreakIterator> bi(bi8->clone());
+                bi->setText(ut.getAlias(), status);
+                std::vector<int32_t>::iterator it = std::upper_bound(expected.begin(), expected.end(), i8);
+                int32_t following = it == expected.end() ? UBRK_DONE : *it;
+                if (!assertEquals(WHERE, following, bi->following(i8))) {
+                    errln("type %d, following(%d)", type, i8);
+                }
+                bi->setText(ut.getAlias(), status);
+                it = std::lower_bound(expected.begin(), expected.end(), i8);
+                int32_t preceding = it == expected.begin() ? UBRK_DONE : *(it - 1);
+                if (!assertEquals(WHERE, preceding, bi->preceding(i8))) {
+                    errln("type %d, preceding(%d)", type, i8);
+                }
+                bi->setText(ut.getAlias(), status);
+                assertTrue(WHERE, std::binary_search(expected.begin(), expected.end(), i8) ==
+                                  (bool)bi->isBoundary(i8));
+            }
+        }
+    }
+}
+
+void RBBITest::TestPreloadDictionaries() {
+    UErrorCode status = U_ZERO_ERROR;
+    RuleBasedBreakIterator::preloadDictionaries(status);
+    if (!assertSuccess(WHERE, status, true)) {
+        return;
+    }
+    // A second call finds everything loaded already.
+    RuleBasedBreakIterator::preloadDictionaries(status);
+    assertSuccess(WHERE, status);
+
+    // Segmentation with the preloaded engines is unchanged.
+    UnicodeString text(u"\u0E20\u0E32\u0E29\u0E32\u0E44\u0E17\u0E22\u0E07\u0E48\u0E32\u0E22 "
+                       u"\u65E5\u672C\u8A9E\u306E\u30C6\u30AD\u30B9\u30C8 "
+                       u"\u1797\u17B6\u179F\u17B6\u1781\u17D2\u1798\u17C2\u179A");
+    static const int32_t expected[] = { 0, 4, 7, 11, 12, 15, 16, 20, 21, 30 };
+    LocalPointer<BreakIterator> bi(BreakIterator::createWordInstance(Locale::getEnglish(), status));
+    if (!assertSuccess(WHERE, status, true)) {
+        return;
+    }
+    bi->setText(text);
+    std::vector<int32_t> actual;
+    for (int32_t b = bi->first(); b != UBRK_DONE; b = bi->next()) {
+        actual.push_back(b);
+    }
+    assertTrue(WHERE, actual == std::vector<int32_t>(expected, expected + UPRV_LENGTHOF(expected)));
+}
 
 
 #endif // #if !UCONFIG_NO_BREAK_ITERATION
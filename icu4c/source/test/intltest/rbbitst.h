@@ -83,6 +83,10 @@ class RBBITest: public IntlTest {
     void TestReverse(std::unique_ptr<RuleBasedBreakIterator>bi);
     void TestBug13692();
     void TestDebugRules();
+    void TestTable_8_16_Bits();
+    void TestDictionaryCache();
+    void TestUTF8Text();
+    void TestPreloadDictionaries();
 
     void TestDebug();
     void TestProperties();
@@ -39,9 +39,11 @@
 #include "unicode/ustring.h"
 #include "unicode/utext.h"
 #include "unicode/utf16.h"
+#include "unicode/utf8.h"
 #include "cstr.h"
 #include "regextst.h"
 #include "regexcmp.h"
+#include "regeximp.h"
 #include "uvector.h"
 #include "util.h"
 #include "cmemory.h"
@@ -106,6 +108,11 @@ void RegexTest::runIndexedTest( int32_t index, UBool exec, const char* &name, ch
     TESTCASE_AUTO(TestBug13632);
     TESTCASE_AUTO(TestBug20359);
     TESTCASE_AUTO(TestBug20863);
+    TESTCASE_AUTO(TestBacktrackMemo);
+    TESTCASE_AUTO(TestRequiredString);
+    TESTCASE_AUTO(TestRegexSet);
+    TESTCASE_AUTO(TestUTF8Input);
+    TESTCASE_AUTO(TestSerialize);
     TESTCASE_AUTO_END;
 }
 
@@ -1223,16 +1230,16 @@ void RegexTest::API_Match() {
 
     //
     //  Time Outs.
-    //       Note:  These tests will need to be changed when the regexp engine is
-    //              able to detect and cut short the exponential time behavior on
-    //              this type of match.
+    //       Note:  The matcher cuts short the exponential time behavior of "(a+)+b",
+    //              but not when the pattern uses look-around or back references,
+    //              as "(a+)+(?=b)" does.
     //
     {
         UErrorCode status = U_ZERO_ERROR;
         //    Enough 'a's in the string to cause the match to time out.
         //       (Each on additonal 'a' doubles the time)
         UnicodeString testString("aaaaaaaaaaaaaaaaaaaaa");
-        RegexMatcher matcher("(a+)+b", testString, 0, status);
+        RegexMatcher matcher("(a+)+(?=b)", testString, 0, status);
         REGEX_CHECK_STATUS;
         REGEX_ASSERT(matcher.getTimeLimit() == 0);
         matcher.setTimeLimit(100, status);
@@ -1244,6 +1251,16 @@ void RegexTest::API_Match() {
         UErrorCode status = U_ZERO_ERROR;
         //   Few enough 'a's to slip in under the time limit.
         UnicodeString testString("aaaaaaaaaaaaaaaaaa");
+        RegexMatcher matcher("(a+)+(?=b)", testString, 0, status);
+        REGEX_CHECK_STATUS;
+        matcher.setTimeLimit(100, status);
+        REGEX_ASSERT(matcher.lookingAt(status) == FALSE);
+        REGEX_CHECK_STATUS;
+    }
+    {
+        UErrorCode status = U_ZERO_ERROR;
+        //   Without the look-ahead, many more 'a's finish within the limit.
+        UnicodeString testString(1000, 0x61, 1000);
         RegexMatcher matcher("(a+)+b", testString, 0, status);
         REGEX_CHECK_STATUS;
         matcher.setTimeLimit(100, status);
@@ -4869,9 +4886,11 @@ void RegexTest::Callbacks() {
         REGEX_ASSERT(cbInfo.numCalls == 4);
 
         // A longer running find that the callback function will abort.
+        //   The input contains the x that every match needs, so find() does try
+        //   matching at each position.
         status = U_ZERO_ERROR;
         cbInfo.reset(4);
-        s = "aaaaaaaaaaaaaaaaaaaaaaab";
+        s = "aaaaaaaaaaaaaaaaaaaaaaabx";
         matcher.reset(s);
         REGEX_ASSERT(matcher.find(status)==FALSE);
         REGEX_ASSERT(status == U_REGEX_STOPPED_BY_CALLER);
@@ -4958,8 +4977,10 @@ void RegexTest::FindProgressCallbacks() {
 
         // A medium running find() that causes matcher.find() to invoke our callback for each index,
         //   but not so many times that we interrupt the operation.
+        //   The input contains the x that every match needs, so find() does try
+        //   matching at each position.
         status = U_ZERO_ERROR;
-        s = "aaaaaaaaaaaaaaaaaaab";
+        s = "aaaaaaaaaaaaaaaaaaabx";
         cbInfo.reset(s.length()); //  Some upper limit for number of calls that is greater than size of our input string
         matcher.reset(s);
         REGEX_ASSERT(matcher.find(0, status)==FALSE);
@@ -4968,7 +4989,7 @@ void RegexTest::FindProgressCallbacks() {
 
         // A longer running match that causes matcher.find() to invoke our callback which we cancel/interrupt at some point.
         status = U_ZERO_ERROR;
-        UnicodeString s1 = "aaaaaaaaaaaaaaaaaaaaaaab";
+        UnicodeString s1 = "aaaaaaaaaaaaaaaaaaaaaaabx";
         cbInfo.reset(s1.length() - 5); //  Bail early somewhere near the end of input string
         matcher.reset(s1);
         REGEX_ASSERT(matcher.find(0, status)==FALSE);
@@ -6005,4 +6026,658 @@ void RegexTest::TestBug20863() {
 }
 
 
+// Random pattern and input generation for TestBacktrackMemo().
+static int32_t memoTestRand(uint32_t &seed, int32_t limit) {
+    seed = seed * 1103515245 + 12345;
+    return (int32_t)((seed >> 16) % limit);
+}
+
+static void memoTestPattern(uint32_t &seed, int32_t depth, UnicodeString &dest) {
+    static const char16_t *const atoms[] = {u"a", u"b", u".", u"[ab]", u"$", u"\\b"};
+    static const char16_t *const quantifiers[] = {u"", u"", u"*", u"+", u"?", u"*?", u"+?", u"??"};
+    int32_t atomCount = 1 + memoTestRand(seed, 3);
+    for (int32_t i = 0; i < atomCount; i++) {
+        int32_t kind = depth > 0 ? memoTestRand(seed, 4) : 0;
+        if (kind == 0) {
+            int32_t atom = memoTestRand(seed, UPRV_LENGTHOF(atoms));
+            dest.append(atoms[atom]);
+            if (atom >= 4) {
+                continue;   // Anchors take no quantifier.
+            }
+        } else {
+            dest.append(kind == 1 ? u"(?:" : u"(");
+            memoTestPattern(seed, depth - 1, dest);
+            if (kind != 2) {
+                dest.append(u'|');
+                memoTestPattern(seed, depth - 1, dest);
+            }
+            dest.append(u')');
+        }
+        dest.append(quantifiers[memoTestRand(seed, UPRV_LENGTHOF(quantifiers))]);
+    }
+}
+
+// Describe the results of every find(), then of matches() and of lookingAt(),
+// including the capture groups and the hitEnd() and requireEnd() flags.
+// If indexMap is not NULL, each input index is mapped through it.
+static void memoTestResults(RegexMatcher &m, UnicodeString &dest, UErrorCode &status,
+                            const int32_t *indexMap = nullptr) {
+    for (int32_t op = 0; op < 3 && U_SUCCESS(status); op++) {
+        m.reset();
+        UBool found;
+        do {
+            found = op == 0 ? m.find(status) : op == 1 ? m.matches(status) : m.lookingAt(status);
+            dest.append(found ? u" T" : u" F");
+            for (int32_t group = 0; found && group <= m.groupCount(); group++) {
+                int64_t start = m.start64(group, status);
+                int64_t end = m.end64(group, status);
+                if (indexMap != nullptr && start >= 0) {
+                    start = indexMap[start];
+                    end = indexMap[end];
+                }
+                dest.append(u' ').append(Int64ToUnicodeString(start));
+                dest.append(u'-').append(Int64ToUnicodeString(end));
+            }
+            dest.append(m.hitEnd() ? u" H" : u" -").append(m.requireEnd() ? u"R;" : u"-;");
+        } while (found && op == 0 && U_SUCCESS(status));
+    }
+}
+
+void RegexTest::TestBacktrackMemo() {
+    // Patterns without back references or look-around get a memo of the backtracking
+    // states already tried, which keeps nested and alternated repetitions from
+    // taking exponential time.
+
+    // Pathological patterns finish quickly on long input, in UTF-16 and in UTF-8.
+    static const char16_t *const slowPatterns[] = {
+        u"(a+)+b", u"(a|aa)*c", u"(?:a|a)*$b", u"(.*a)+b", u"(a|b|ab)*?x"};
+    char utf8[4000];
+    uprv_memset(utf8, 'a', sizeof(utf8));
+    UnicodeString longInput(sizeof(utf8), u'a', sizeof(utf8));
+    for (const char16_t *pattern : slowPatterns) {
+        UErrorCode status = U_ZERO_ERROR;
+        RegexMatcher m(pattern, 0, status);
+        m.setTimeLimit(100, status);
+        m.reset(longInput);
+        assertFalse(pattern, m.find(status));
+        assertSuccess(WHERE, status);
+        assertFalse(pattern, m.matches(status));
+        assertSuccess(WHERE, status);
+
+        UText *ut = utext_openUTF8(nullptr, utf8, sizeof(utf8), &status);
+        m.reset(ut);
+        assertFalse(pattern, m.find(status));
+        assertSuccess(WHERE, status);
+        assertFalse(pattern, m.matches(status));
+        assertSuccess(WHERE, status);
+        utext_close(ut);
+    }
+
+    // Random patterns give the same results as with the memo turned off, which
+    // an empty look-ahead at the end of the pattern does.
+    uint32_t seed = 1;
+    for (int32_t i = 0; i < 400; i++) {
+        UnicodeString pattern;
+        memoTestPattern(seed, 2, pattern);
+        UnicodeString input;
+        int32_t length = 8 + memoTestRand(seed, 24);
+        for (int32_t j = 0; j < length; j++) {
+            static const char16_t inputChars[] = u"aab\u00e9";
+            input.append(inputChars[memoTestRand(seed, 4)]);
+        }
+        UErrorCode status = U_ZERO_ERROR;
+        RegexMatcher m(pattern, 0, status);
+        RegexMatcher reference(pattern + u"(?=)", 0, status);
+        if (!assertSuccess(UnicodeString(WHERE) + u" " + pattern, status)) {
+            return;
+        }
+        m.setTimeLimit(5, status);
+        reference.setTimeLimit(5, status);
+
+        char inputUTF8[200];
+        int32_t lengthUTF8 = 0;
+        u_strToUTF8(inputUTF8, sizeof(inputUTF8), &lengthUTF8, input.getBuffer(), input.length(), &status);
+        for (int32_t utf8Pass = 0; utf8Pass < 2; utf8Pass++) {
+            UText *ut = nullptr;
+            if (utf8Pass) {
+                ut = utext_openUTF8(nullptr, inputUTF8, lengthUTF8, &status);
+                m.reset(ut);
+                reference.reset(ut);
+            } else {
+                m.reset(input);
+                reference.reset(input);
+            }
+            UnicodeString expected, actual;
+            memoTestResults(reference, expected, status);
+            if (status == U_REGEX_TIME_OUT || status == U_REGEX_STACK_OVERFLOW) {
+                // The reference took too long; nothing to compare with.
+                status = U_ZERO_ERROR;
+            } else {
+                memoTestResults(m, actual, status);
+                if (assertSuccess(UnicodeString(WHERE) + u" " + pattern, status) && expected != actual) {
+                    errln("%s:%d pattern \"%s\" input \"%s\"%s: got%s expected%s", __FILE__, __LINE__,
+                          CStr(pattern)(), CStr(input)(), utf8Pass ? " (UTF-8)" : "",
+                          CStr(actual)(), CStr(expected)());
+                }
+            }
+            utext_close(ut);
+        }
+    }
+}
+
+// Patterns with required strings, and pieces of input in UTF-16 and as UTF-8 bytes,
+// including ill-formed sequences; for TestRequiredString() and TestRegexSet().
+static const char16_t *const requiredStringPatterns[] = {
+    u"ab", u"a.{0,3}ab", u"\\w+\\s+ab\\s+\\w+", u"(?m)^.*ab.*$", u"(?d)^.*ab.*$",
+    u"x(a|bb)ab", u"(ab)+c", u"[ab]\\U0001F600a", u"\\U0001F600{2}a", u"\\uFFFDa",
+    u"b(?:a|\u00e9){1,3}ab", u"a\\b.ab", u"ab$", u"\\Rab", u"\\Xab", u"(?i)ab",
+    u"(?:ab|\u00e9a)b", u"\u00e9.?\u00e9", u"\\ud83d", u".*b\\ud83d",
+    u"[^\\n]*ab", u"[ab\\u2028]+ab", u"\\S+ab", u"\\D*ab", u"\\h*ab", u"(?s).*ab",
+    u"[a\u00e9 ]+ab", u"\\W*ab", u"(?:\\U0001F600|x)+ab", u"\\d*ab",
+    u"(?m)a$\\s*ab", u"\\w\\Z\\s*ab", u"(?d)a\\z\\s*ab"};
+static const char16_t requiredStringLoneLead[] = {0xd83d, 0};
+static const char16_t *const requiredStringPieces16[] = {
+    u"a", u"b", u"ab", u" ", u"\n", u"\r\n", u"\u00e9", u"x", u"\U0001F600", u"\uFFFD",
+    requiredStringLoneLead, u"\u0085", u"\u2028"};
+static const char *const requiredStringPieces8[] = {
+    "a", "b", "ab", " ", "\n", "\r\n", "\xC3\xA9", "x", "\xF0\x9F\x98\x80", "\xEF\xBF\xBD",
+    "\x80", "\xE0\x80", "\xF0\x9F\x98", "\xC2\x85", "\xE2\x80\xA8"};
+
+void RegexTest::TestRequiredString() {
+    // find() searches ahead for a literal string that every match contains, and skips
+    // the start positions from which no match could reach it.  The results are the
+    // same as for the pattern with an empty look-ahead appended, which turns the
+    // search off; in UTF-16 and UTF-8, with and without a region.
+    uint32_t seed = 1;
+    for (const char16_t *pattern : requiredStringPatterns) {
+        UErrorCode status = U_ZERO_ERROR;
+        RegexMatcher m(pattern, 0, status);
+        RegexMatcher reference(UnicodeString(pattern) + u"(?=)", 0, status);
+        if (!assertSuccess(UnicodeString(WHERE) + u" " + pattern, status)) {
+            continue;
+        }
+        for (int32_t i = 0; i < 100; i++) {
+            UnicodeString input;
+            char inputUTF8[400] = "";
+            int32_t length = memoTestRand(seed, 40);
+            for (int32_t j = 0; j < length; j++) {
+                input.append(requiredStringPieces16[memoTestRand(seed, UPRV_LENGTHOF(requiredStringPieces16))]);
+                uprv_strcat(inputUTF8, requiredStringPieces8[memoTestRand(seed, UPRV_LENGTHOF(requiredStringPieces8))]);
+            }
+            int32_t lengthUTF8 = (int32_t)uprv_strlen(inputUTF8);
+            for (int32_t utf8Pass = 0; utf8Pass < 2; utf8Pass++) {
+                UText *ut = nullptr;
+                int32_t inputLength;
+                if (utf8Pass) {
+                    ut = utext_openUTF8(nullptr, inputUTF8, lengthUTF8, &status);
+                    m.reset(ut);
+                    reference.reset(ut);
+                    inputLength = lengthUTF8;
+                } else {
+                    m.reset(input);
+                    reference.reset(input);
+                    inputLength = input.length();
+                }
+                UnicodeString expected, actual;
+                memoTestResults(reference, expected, status);
+                memoTestResults(m, actual, status);
+
+                int32_t regionStart = memoTestRand(seed, inputLength + 1);
+                int32_t regionLimit = regionStart + memoTestRand(seed, inputLength - regionStart + 1);
+                // The region must not begin or end inside a character.
+                if (utf8Pass) {
+                    U8_SET_CP_START((const uint8_t *)inputUTF8, 0, regionStart);
+                    U8_SET_CP_START((const uint8_t *)inputUTF8, 0, regionLimit);
+                } else {
+                    U16_SET_CP_START(input.getBuffer(), 0, regionStart);
+                    U16_SET_CP_START(input.getBuffer(), 0, regionLimit);
+                }
+                reference.region(regionStart, regionLimit, status);
+                m.region(regionStart, regionLimit, status);
+                for (RegexMatcher *matcher : {&reference, &m}) {
+                    UnicodeString &dest = matcher == &m ? actual : expected;
+                    dest.append(u" region");
+                    while (matcher->find(status)) {
+                        dest.append(u' ').append(Int64ToUnicodeString(matcher->start64(status)));
+                        dest.append(u'-').append(Int64ToUnicodeString(matcher->end64(status)));
+                    }
+                    dest.append(matcher->hitEnd() ? u" H" : u" -");
+                }
+                if (assertSuccess(UnicodeString(WHERE) + u" " + pattern, status) && expected != actual) {
+                    errln("%s:%d pattern \"%s\" input #%d%s: got%s expected%s", __FILE__, __LINE__,
+                          CStr(pattern)(), i, utf8Pass ? " (UTF-8)" : "",
+                          CStr(actual)(), CStr(expected)());
+                }
+                utext_close(ut);
+            }
+        }
+    }
+}
+
+
+void RegexTest::TestRegexSet() {
+    // RegexSet::find() reports the same first match for each pattern as a
+    // RegexMatcher::find() with that pattern alone, in UTF-16 and in UTF-8.
+    // The patterns of TestRequiredString(), and more with anchors, empty matches
+    // and single characters.
+    static const char16_t *const morePatterns[] = {
+        u"(?m)^b", u"^ab", u"\\Ab", u"\\U0001F600", u"\u00e9", u"[\u00e9x]b", u"(?i)AB", u"x*",
+        u"b?", u"\\bb\\b", u"\\d+", u"zz", u"\\u2028"};
+    const char16_t *patterns[UPRV_LENGTHOF(requiredStringPatterns) + UPRV_LENGTHOF(morePatterns)];
+    int32_t patternCount = 0;
+    for (const char16_t *pattern : requiredStringPatterns) {
+        patterns[patternCount++] = pattern;
+    }
+    for (const char16_t *pattern : morePatterns) {
+        patterns[patternCount++] = pattern;
+    }
+    UErrorCode status = U_ZERO_ERROR;
+    RegexSet set(status);
+    LocalPointer<RegexMatcher> matchers[UPRV_LENGTHOF(patterns)];
+    for (int32_t i = 0; i < UPRV_LENGTHOF(patterns); i++) {
+        assertEquals(UnicodeString(WHERE) + u" " + patterns[i], i, set.add(patterns[i], 0, status));
+        matchers[i].adoptInsteadAndCheckErrorCode(new RegexMatcher(patterns[i], 0, status), status);
+    }
+    if (!assertSuccess(WHERE, status)) {
+        return;
+    }
+
+    // API behavior.
+    RegexSet small(status);
+    small.add(u"ab", 0, status);
+    small.add(u"c", 0, status);
+    small.add(u"x*", 0, status);
+    small.add(u"zz", 0, status);
+    UParseError pe;
+    assertEquals(WHERE, -1, small.add(u"a(", 0, pe, status));
+    assertEquals(WHERE, U_REGEX_MISMATCHED_PAREN, status);
+    status = U_ZERO_ERROR;
+    assertEquals(WHERE, 4, small.size());
+    assertEquals(WHERE, u"ab", small.getPattern(0)->pattern());
+    assertTrue(WHERE, small.getPattern(-1) == nullptr && small.getPattern(4) == nullptr);
+    int32_t indexes[UPRV_LENGTHOF(patterns)];
+    int32_t starts[UPRV_LENGTHOF(patterns)];
+    int32_t limits[UPRV_LENGTHOF(patterns)];
+    assertEquals(WHERE, 3, small.find(u"zzab\n", nullptr, nullptr, nullptr, 0, status));
+    assertEquals(WHERE, U_BUFFER_OVERFLOW_ERROR, status);
+    status = U_ZERO_ERROR;
+    assertEquals(WHERE, 3, small.find(u"zzab\n", indexes, starts, limits, 3, status));
+    assertSuccess(WHERE, status);
+    assertEquals(WHERE, 0, indexes[0]);     // ab
+    assertEquals(WHERE, 2, starts[0]);
+    assertEquals(WHERE, 4, limits[0]);
+    assertEquals(WHERE, 2, indexes[1]);     // x*, empty at the start
+    assertEquals(WHERE, 0, starts[1]);
+    assertEquals(WHERE, 0, limits[1]);
+    assertEquals(WHERE, 3, indexes[2]);     // zz
+    assertEquals(WHERE, 0, starts[2]);
+    assertEquals(WHERE, 2, limits[2]);
+    assertEquals(WHERE, 3, small.find(u"cab", indexes, nullptr, nullptr, 3, status));
+    assertEquals(WHERE, 1, indexes[1]);     // c
+    assertSuccess(WHERE, status);
+
+    // Random input.
+    uint32_t seed = 1;
+    int64_t starts64[UPRV_LENGTHOF(patterns)];
+    int64_t limits64[UPRV_LENGTHOF(patterns)];
+    for (int32_t i = 0; i < 300; i++) {
+        UnicodeString input;
+        char inputUTF8[400] = "";
+        int32_t length = memoTestRand(seed, 30);
+        for (int32_t j = 0; j < length; j++) {
+            input.append(requiredStringPieces16[memoTestRand(seed, UPRV_LENGTHOF(requiredStringPieces16))]);
+            uprv_strcat(inputUTF8, requiredStringPieces8[memoTestRand(seed, UPRV_LENGTHOF(requiredStringPieces8))]);
+        }
+        for (int32_t utf8Pass = 0; utf8Pass < 2; utf8Pass++) {
+            UText *ut = utf8Pass ? utext_openUTF8(nullptr, inputUTF8, -1, &status) :
+                                   utext_openConstUnicodeString(nullptr, &input, &status);
+            UnicodeString expected, actual;
+            for (int32_t p = 0; p < UPRV_LENGTHOF(patterns); p++) {
+                matchers[p]->reset(ut);
+                if (matchers[p]->find(status)) {
+                    expected.append(u' ').append(Int64ToUnicodeString(p));
+                    expected.append(u':').append(Int64ToUnicodeString(matchers[p]->start64(status)));
+                    expected.append(u'-').append(Int64ToUnicodeString(matchers[p]->end64(status)));
+                }
+            }
+            int32_t count = set.find(ut, indexes, starts64, limits64, UPRV_LENGTHOF(indexes), status);
+            for (int32_t k = 0; k < count; k++) {
+                actual.append(u' ').append(Int64ToUnicodeString(indexes[k]));
+                actual.append(u':').append(Int64ToUnicodeString(starts64[k]));
+                actual.append(u'-').append(Int64ToUnicodeString(limits64[k]));
+            }
+            if (assertSuccess(WHERE, status) && expected != actual) {
+                errln("%s:%d input #%d%s: got%s expected%s", __FILE__, __LINE__,
+                      i, utf8Pass ? " (UTF-8)" : "", CStr(actual)(), CStr(expected)());
+            }
+            utext_close(ut);
+        }
+    }
+}
+
+
+void RegexTest::TestUTF8Input() {
+    // UTF-8 input is matched directly on its bytes.  The results are those for the same
+    // text in UTF-16, with each ill-formed sequence read as U+FFFD, and with the
+    // indexes mapped from bytes to UTF-16 code units.
+    static const char16_t *const patterns[] = {
+        u"ab", u"\u00e9\U0001F600", u"(?i)\u00c9A", u"(?i)(a|\u00e9)\\1", u"(.)\\1", u"(\\w+)\\s+\\1",
+        u"(?i)(\\w)\\1", u"a$", u"$", u"(?m)$", u"(?m)^.", u"(?d)^.*$", u"(?m)^.*a.*$", u"\\b\\w",
+        u"\\B.", u"(?w)\\b.", u"\\R", u"\\X", u"\\v\\V", u"\\h", u"\\d", u"[^a]+", u"\\S*?b",
+        u"(?s).*?\\n", u".*a", u"[\u00e9\U0001F600]+", u"[\u00e9\U0001F600]*a", u"(?<=\u00e9)a",
+        u"(?<!\U0001F600)a", u"(?<=a.)b", u"(?<!\\uFFFD)b", u"\\uFFFD+", u"\\Ga", u"a\\z", u"\\Z",
+        u"a(?=\\u2028)", u"(?s)a.", u".\\u0085", u"(a|\u00e9x|\U0001F600)+?b", u"a\\p{L}*"};
+    static const char *const pieces[] = {
+        "a", "b", "ab", " ", "\n", "\r\n", "\r", "\xC3\xA9", "\xC3\x89", "x", "\xF0\x9F\x98\x80",
+        "\xEF\xBF\xBD", "\x80", "\xE0\x80", "\xF0\x9F\x98", "\xC3", "\xC2\x85", "\xE2\x80\xA8",
+        "\xCC\x81", "1"};
+    uint32_t seed = 1;
+    for (const char16_t *pattern : patterns) {
+        UErrorCode status = U_ZERO_ERROR;
+        RegexMatcher m(pattern, 0, status);
+        if (!assertSuccess(UnicodeString(WHERE) + u" " + pattern, status)) {
+            continue;
+        }
+        for (int32_t i = 0; i < 100; i++) {
+            char inputUTF8[400] = "";
+            int32_t length = memoTestRand(seed, 30);
+            for (int32_t j = 0; j < length; j++) {
+                uprv_strcat(inputUTF8, pieces[memoTestRand(seed, UPRV_LENGTHOF(pieces))]);
+            }
+            int32_t lengthUTF8 = (int32_t)uprv_strlen(inputUTF8);
+            UnicodeString input = UnicodeString::fromUTF8(inputUTF8);
+            int32_t indexMap[401];
+            int32_t index16 = 0;
+            for (int32_t index8 = 0; index8 < lengthUTF8;) {
+                int32_t start = index8;
+                UChar32 c;
+                U8_NEXT_OR_FFFD((const uint8_t *)inputUTF8, index8, lengthUTF8, c);
+                indexMap[start] = index16;
+                while (++start < index8) {
+                    indexMap[start] = -2;       // Not a character boundary.
+                }
+                index16 += U16_LENGTH(c);
+            }
+            indexMap[lengthUTF8] = index16;
+
+            UnicodeString expected, actual;
+            m.reset(input);
+            memoTestResults(m, expected, status);
+            UText *ut = utext_openUTF8(nullptr, inputUTF8, lengthUTF8, &status);
+            m.reset(ut);
+            memoTestResults(m, actual, status, indexMap);
+            if (assertSuccess(UnicodeString(WHERE) + u" " + pattern, status) && expected != actual) {
+                errln("%s:%d pattern \"%s\" input #%d: got%s expected%s", __FILE__, __LINE__,
+                      CStr(pattern)(), i, CStr(actual)(), CStr(expected)());
+            }
+            utext_close(ut);
+        }
+    }
+}
+
+
+void RegexTest::TestSerialize() {
+    // A pattern loaded from its serialized form matches exactly like the compiled one.
+    static const char16_t *const patterns[] = {
+        u"abc", u"(?i)stra\\u00DFe", u"(?<first>\\w+)\\s+(?<second>\\w+)", u"[a-c\\u00E9]+x",
+        u"(.)\\1", u"(?i)(a|\\u00E9)\\1", u"(?<=\\u00E9)a", u"(?<!\\d)\\d{2,3}", u"\\p{Lu}\\p{Ll}*", u"(?m)^.*$",
+        u"(a+)+b", u"(?x) a b # comment", u"[^\\s]+?\\.", u"\\bfoo\\b", u"\\Qa.b\\E|x",
+        u"(?s)a.*?z", u"a(?=b)", u"[[:alpha:]&&[^aeiou]]{2}", u"\\R\\X", u"", u"b.$"};
+    static const char16_t *const pieces[] = {
+        u"a", u"b", u"ab", u"Abc", u" ", u"\n", u"\u00E9", u"\u00C9", u"x", u"z", u".", u"12", u"SS",
+        u"\u00DF",
+        u"\U0001F600", u"foo"};
+    uint32_t seed = 1;
+    for (int32_t patternIndex = 0; patternIndex < UPRV_LENGTHOF(patterns); patternIndex++) {
+        const char16_t *pattern = patterns[patternIndex];
+        UErrorCode status = U_ZERO_ERROR;
+        uint32_t flags = patternIndex % 4 == 3 ? UREGEX_CASE_INSENSITIVE | UREGEX_MULTILINE : 0;
+        LocalPointer<RegexPattern> compiled(RegexPattern::compile(pattern, flags, status));
+        if (!assertSuccess(UnicodeString(WHERE) + u" " + pattern, status)) {
+            continue;
+        }
+        int32_t length = compiled->serialize(nullptr, 0, status);
+        assertEquals(WHERE, U_BUFFER_OVERFLOW_ERROR, status);
+        assertEquals(WHERE, 0, length & 3);
+        status = U_ZERO_ERROR;
+        MaybeStackArray<int32_t, 256> data;
+        if (data.resize(length / 4) == nullptr) {
+            errln("%s:%d out of memory", __FILE__, __LINE__);
+            return;
+        }
+        uint8_t *bytes = (uint8_t *)data.getAlias();
+        assertEquals(WHERE, length, compiled->serialize(bytes, length, status));
+        LocalPointer<RegexPattern> loaded(RegexPattern::createFromSerialized(bytes, length, status));
+        if (!assertSuccess(UnicodeString(WHERE) + u" " + pattern, status)) {
+            continue;
+        }
+        assertEquals(WHERE, compiled->pattern(), loaded->pattern());
+        assertEquals(WHERE, (int32_t)compiled->flags(), (int32_t)loaded->flags());
+        UErrorCode nameStatus = U_ZERO_ERROR, loadedNameStatus = U_ZERO_ERROR;
+        assertEquals(WHERE, compiled->groupNumberFromName(UnicodeString(u"second"), nameStatus),
+                     loaded->groupNumberFromName(UnicodeString(u"second"), loadedNameStatus));
+        assertEquals(WHERE, nameStatus, loadedNameStatus);
+        assertTrue(WHERE, *compiled == *loaded);
+
+        LocalPointer<RegexMatcher> reference(compiled->matcher(status));
+        LocalPointer<RegexMatcher> m(loaded->matcher(status));
+        for (int32_t i = 0; i < 50 && U_SUCCESS(status); i++) {
+            UnicodeString input;
+            int32_t count = memoTestRand(seed, 20);
+            for (int32_t j = 0; j < count; j++) {
+                input.append(pieces[memoTestRand(seed, UPRV_LENGTHOF(pieces))]);
+            }
+            UnicodeString expected, actual;
+            reference->reset(input);
+            memoTestResults(*reference, expected, status);
+            m->reset(input);
+            memoTestResults(*m, actual, status);
+            if (assertSuccess(UnicodeString(WHERE) + u" " + pattern, status) && expected != actual) {
+                errln("%s:%d pattern \"%s\" input \"%s\": got%s expected%s", __FILE__, __LINE__,
+                      CStr(pattern)(), CStr(input)(), CStr(actual)(), CStr(expected)());
+            }
+        }
+    }
+
+    // Bad arguments and bad data are rejected.
+    UErrorCode status = U_ZERO_ERROR;
+    LocalPointer<RegexPattern> compiled(RegexPattern::compile(u"(?<word>[a-z]+)[0-9]", 0, status));
+    if (!assertSuccess(WHERE, status)) {
+        return;
+    }
+    int32_t data[200];
+    uint8_t *bytes = (uint8_t *)data;
+    int32_t length = compiled->serialize(bytes, (int32_t)sizeof(data), status);
+    if (!assertSuccess(WHERE, status)) {
+        return;
+    }
+    LocalPointer<RegexPattern> loaded(RegexPattern::createFromSerialized(bytes + 2, length - 4, status));
+    assertEquals(WHERE, U_ILLEGAL_ARGUMENT_ERROR, status);
+    status = U_ZERO_ERROR;
+    loaded.adoptInstead(RegexPattern::createFromSerialized(bytes, length - 8, status));
+    assertEquals(WHERE, U_INVALID_FORMAT_ERROR, status);
+    assertTrue(WHERE, loaded.isNull());
+    status = U_ZERO_ERROR;
+    bytes[12] = 'X';        // dataFormat
+    loaded.adoptInstead(RegexPattern::createFromSerialized(bytes, length, status));
+    assertEquals(WHERE, U_INVALID_FORMAT_ERROR, status);
+    bytes[12] = 'R';
+    status = U_ZERO_ERROR;
+    int32_t capacity = length - 4;
+    assertEquals(WHERE, length, compiled->serialize(bytes, capacity, status));
+    assertEquals(WHERE, U_BUFFER_OVERFLOW_ERROR, status);
+
+    // Data written with other Unicode data is compiled again from its regular expression.
+    status = U_ZERO_ERROR;
+    compiled->serialize(bytes, (int32_t)sizeof(data), status);
+    bytes[20] ^= 0x7f;      // dataVersion
+    loaded.adoptInstead(RegexPattern::createFromSerialized(bytes, length, status));
+    if (assertSuccess(WHERE, status)) {
+        assertTrue(WHERE, *compiled == *loaded);
+        assertEquals(WHERE, 1, loaded->groupNumberFromName(UnicodeString(u"word"), status));
+        UnicodeString input(u"-- abc7 --");
+        LocalPointer<RegexMatcher> m(loaded->matcher(input, status));
+        assertTrue(WHERE, m->find(status));
+        assertEquals(WHERE, u"abc7", m->group(status));
+    }
+    // So is data written by another version of ICU.
+    //   The indexes follow the header; see the IX_ constants in repattrn.cpp.
+    status = U_ZERO_ERROR;
+    compiled->serialize(bytes, (int32_t)sizeof(data), status);
+    int32_t *indexes = (int32_t *)(bytes + *(const uint16_t *)bytes);
+    indexes[1] ^= 0x7f;     // IX_ICU_VERSION
+    loaded.adoptInstead(RegexPattern::createFromSerialized(bytes, length, status));
+    if (assertSuccess(WHERE, status)) {
+        assertTrue(WHERE, *compiled == *loaded);
+    }
+
+    // Inconsistent content is rejected, rather than trusted by the matcher.
+    checkSerializedContent();
+}
+
+void RegexTest::checkSerializedContent() {
+    // The indexes, from repattrn.cpp.
+    enum {
+        IX_FRAME_SIZE = 4,
+        IX_DATA_SIZE = 5,
+        IX_START_TYPE = 6,
+        IX_INITIAL_STRING_IDX = 7,
+        IX_INITIAL_STRING_LEN = 8,
+        IX_REQUIRED_STRING_IDX = 11,
+        IX_REQUIRED_STRING_LEN = 12,
+        IX_REQUIRED_PREFIX_SET = 15,
+        IX_MEMO_SLOT_COUNT = 16,
+        IX_COMPILED_PAT_OFFSET = 17,
+        IX_GROUP_MAP_OFFSET = 18,
+        IX_MEMO_SLOTS_OFFSET = 19,
+        IX_SETS_OFFSET = 26
+    };
+    UErrorCode status = U_ZERO_ERROR;
+    LocalPointer<RegexPattern> compiled(RegexPattern::compile(u"(xy)[b-d]+\\w+abc", 0, status));
+    if (!assertSuccess(WHERE, status)) {
+        return;
+    }
+    int32_t length = compiled->serialize(nullptr, 0, status);
+    status = U_ZERO_ERROR;
+    MaybeStackArray<int32_t, 256> original, data;
+    if (original.resize(length / 4) == nullptr || data.resize(length / 4) == nullptr) {
+        errln("%s:%d out of memory", __FILE__, __LINE__);
+        return;
+    }
+    uint8_t *bytes = (uint8_t *)data.getAlias();
+    compiled->serialize((uint8_t *)original.getAlias(), length, status);
+    if (!assertSuccess(WHERE, status)) {
+        return;
+    }
+    int32_t indexesStart = *(const uint16_t *)original.getAlias() / 4;
+    const int32_t *indexes = original.getAlias() + indexesStart;
+    assertTrue(WHERE " has a required string", indexes[IX_REQUIRED_STRING_LEN] > 0);
+    assertTrue(WHERE " has a required prefix set", indexes[IX_REQUIRED_PREFIX_SET] > 0);
+    assertTrue(WHERE " has memo slots", indexes[IX_MEMO_SLOT_COUNT] > 0);
+
+    // Find the ops whose operands to change, by their positions in the data.
+    int32_t opsStart = indexesStart + indexes[IX_COMPILED_PAT_OFFSET] / 4;
+    int32_t opsLimit = indexesStart + indexes[IX_GROUP_MAP_OFFSET] / 4;
+    int32_t captureOp = -1, stringOp = -1, setOp = -1, jumpOp = -1, loopOp = -1;
+    for (int32_t i = opsStart; i < opsLimit; i++) {
+        int32_t *op = nullptr;
+        switch (URX_TYPE(original[i])) {
+        case URX_START_CAPTURE: op = &captureOp; break;
+        case URX_STRING:        op = &stringOp; break;
+        case URX_SETREF:
+        case URX_LOOP_SR_I:     op = &setOp; break;
+        case URX_STATE_SAVE:
+        case URX_JMP_SAV:       op = &jumpOp; break;
+        case URX_LOOP_C:        op = &loopOp; break;
+        }
+        if (op != nullptr && *op < 0) {
+            *op = i;
+        }
+    }
+    if (!assertTrue(WHERE " has the ops",
+                    captureOp >= 0 && stringOp >= 0 && setOp >= 0 && jumpOp >= 0 && loopOp >= 0)) {
+        return;
+    }
+    int32_t memoSlot = indexesStart + indexes[IX_MEMO_SLOTS_OFFSET] / 4;
+    while (original[memoSlot] < 0) {
+        ++memoSlot;
+    }
+
+    // The data as written, and with one word changed, each of which must be rejected.
+    struct {
+        const char *name;
+        int32_t     position;   // In int32_t units from the start of the data, -1 for none.
+        int32_t     value;
+    } const changes[] = {
+        { "unchanged",            -1, 0 },
+        { "frame size",           indexesStart + IX_FRAME_SIZE, 1 },
+        { "data size",            indexesStart + IX_DATA_SIZE, -1 },
+        { "start type",           indexesStart + IX_START_TYPE, 99 },
+        { "initial string index", indexesStart + IX_INITIAL_STRING_IDX, 0x10000000 },
+        { "initial string length", indexesStart + IX_INITIAL_STRING_LEN, 0x10000000 },
+        { "required string index", indexesStart + IX_REQUIRED_STRING_IDX, 0x10000000 },
+        { "required string length", indexesStart + IX_REQUIRED_STRING_LEN, 0x10000000 },
+        { "required prefix set",  indexesStart + IX_REQUIRED_PREFIX_SET, 99 },
+        { "memo slot count",      indexesStart + IX_MEMO_SLOT_COUNT, -1 },
+        { "memo slot",            memoSlot, 0x1000 },
+        { "group map",            indexesStart + indexes[IX_GROUP_MAP_OFFSET] / 4, 0x7fff },
+        { "capture frame slot",   captureOp, URX_START_CAPTURE << 24 | 0xfff },
+        { "literal text offset",  stringOp, URX_STRING << 24 | 0xfff },
+        { "set index",            setOp, (int32_t)URX_TYPE(original[setOp]) << 24 | 99 },
+        { "jump target",          jumpOp, (int32_t)URX_TYPE(original[jumpOp]) << 24 | 0xffff },
+        { "loop frame slot",      loopOp, URX_LOOP_C << 24 | 0xfff },
+        { "op code",              loopOp, 0x7f << 24 },
+        { "last op",              opsLimit - 1, URX_NOP << 24 },
+    };
+    for (int32_t i = 0; i < UPRV_LENGTHOF(changes); i++) {
+        const char *name = changes[i].name;
+        int32_t position = changes[i].position;
+        uprv_memcpy(bytes, original.getAlias(), length);
+        if (position >= 0) {
+            data[position] = changes[i].value;
+        }
+        status = U_ZERO_ERROR;
+        LocalPointer<RegexPattern> loaded(RegexPattern::createFromSerialized(bytes, length, status));
+        if (position < 0) {
+            if (assertSuccess(WHERE, status)) {
+                UnicodeString input(u"-- xybbw_abc --");
+                LocalPointer<RegexMatcher> m(loaded->matcher(input, status));
+                assertTrue(WHERE, m->find(status));
+                assertEquals(WHERE, u"xybbw_abc", m->group(status));
+            }
+        } else if (status != U_INVALID_FORMAT_ERROR || loaded.isValid()) {
+            errln("%s:%d changed %s: got %s, expected U_INVALID_FORMAT_ERROR",
+                  __FILE__, __LINE__, name, u_errorName(status));
+        }
+    }
+
+    // The first serialized set, the initial chars [x], with its length not matching
+    // its header, and with its boundaries out of order.
+    const uint16_t *original16 = (const uint16_t *)original.getAlias();
+    uint16_t *data16 = (uint16_t *)bytes;
+    int32_t setStart = indexesStart * 2 + indexes[IX_SETS_OFFSET] / 2;
+    if (!assertEquals(WHERE " set header", 2, original16[setStart])) {
+        return;
+    }
+    struct {
+        const char *name;
+        int32_t     position;   // In uint16_t units from the start of the data.
+        uint16_t    value;
+    } const setChanges[] = {
+        { "set length",           setStart, 0x7fff },
+        { "set with supplementary code points", setStart, 0x8002 },
+        { "set boundaries",       setStart + 2, original16[setStart + 1] },
+    };
+    for (int32_t i = 0; i < UPRV_LENGTHOF(setChanges); i++) {
+        uprv_memcpy(bytes, original.getAlias(), length);
+        data16[setChanges[i].position] = setChanges[i].value;
+        status = U_ZERO_ERROR;
+        LocalPointer<RegexPattern> loaded(RegexPattern::createFromSerialized(bytes, length, status));
+        if (status != U_INVALID_FORMAT_ERROR || loaded.isValid()) {
+            errln("%s:%d changed %s: got %s, expected U_INVALID_FORMAT_ERROR",
+                  __FILE__, __LINE__, setChanges[i].name, u_errorName(status));
+        }
+    }
+}
+
 #endif  /* !UCONFIG_NO_REGULAR_EXPRESSIONS  */
@@ -61,6 +61,11 @@ class RegexTest: public IntlTest {
     virtual void TestBug13632();
     virtual void TestBug20359();
     virtual void TestBug20863();
+    virtual void TestBacktrackMemo();
+    virtual void TestRequiredString();
+    virtual void TestRegexSet();
+    virtual void TestUTF8Input();
+    virtual void TestSerialize();
 
     // The following functions are internal to the regexp tests.
     virtual void assertUText(const char *expected, UText *actual, const char *file, int line);
@@ -75,6 +80,7 @@ class RegexTest: public IntlTest {
     virtual const char *getPath(char buffer[2048], const char *filename);
 
     virtual void TestCase11049(const char *pattern, const char *data, UBool expectMatch, int32_t lineNumber);
+    virtual void checkSerializedContent();
 
     static const char* extractToAssertBuf(const UnicodeString& message);
     
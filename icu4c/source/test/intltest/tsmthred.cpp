@@ -19,6 +19,7 @@
 #include "unicode/resbund.h"
 #include "unicode/udata.h"
 #include "unicode/uloc.h"
+#include "unicode/ures.h"
 #include "unicode/locid.h"
 #include "putilimp.h"
 #include "intltest.h"
@@ -27,6 +28,7 @@
 #include "unicode/translit.h"
 #include "sharedobject.h"
 #include "unifiedcache.h"
+#include "uresimp.h"
 #include "uassert.h"
 
 
@@ -67,11 +69,13 @@ void MultithreadTest::runIndexedTest( int32_t index, UBool exec,
 #endif
 #if !UCONFIG_NO_COLLATION
     TESTCASE_AUTO(TestCollators);
+    TESTCASE_AUTO(TestCollatorSortKeys);
 #endif /* #if !UCONFIG_NO_COLLATION */
     TESTCASE_AUTO(TestString);
     TESTCASE_AUTO(TestArabicShapingThreads);
     TESTCASE_AUTO(TestAnyTranslit);
     TESTCASE_AUTO(TestUnifiedCache);
+    TESTCASE_AUTO(TestResourceBundleThreads);
 #if !UCONFIG_NO_TRANSLITERATION
     TESTCASE_AUTO(TestBreakTranslit);
     TESTCASE_AUTO(TestIncDec);
@@ -916,6 +920,109 @@ void MultithreadTest::TestCollators()
     }
 }
 
+//-------------------------------------------------------------------------------------------
+//
+//   TestCollatorSortKeys -- build the sort keys for one array of strings in parallel,
+//                           each thread writing its range into its own segment of one buffer.
+//
+//-------------------------------------------------------------------------------------------
+
+static const int32_t kSortKeysThreads = 8;
+static const int32_t kSortKeysStrings = 1000;
+
+class SortKeysThread : public SimpleThread {
+public:
+    SortKeysThread() : coll(nullptr), strings(nullptr), startIndex(0), limitIndex(0),
+                       dest(nullptr), destStart(0), destCapacity(0),
+                       length(0), errorCode(U_ZERO_ERROR) {}
+    virtual void run() {
+        errorCode = U_ZERO_ERROR;
+        length = coll->getSortKeys(strings + startIndex, nullptr, limitIndex - startIndex,
+                                   dest != nullptr ? dest + destStart : nullptr, destCapacity,
+                                   offsets, errorCode);
+        if (dest == nullptr && errorCode == U_BUFFER_OVERFLOW_ERROR) {
+            errorCode = U_ZERO_ERROR;  // preflighting
+        }
+    }
+
+    const Collator *coll;
+    const char16_t *const *strings;
+    int32_t startIndex, limitIndex;
+    uint8_t *dest;
+    int32_t destStart, destCapacity;
+    int32_t offsets[kSortKeysStrings + 1];  // Own array: offsets[count] would overlap the next range.
+    int32_t length;
+    UErrorCode errorCode;
+};
+
+void MultithreadTest::TestCollatorSortKeys() {
+    IcuTestErrorCode errorCode(*this, "TestCollatorSortKeys");
+    LocalPointer<Collator> coll(Collator::createInstance("de", errorCode));
+    if (errorCode.errDataIfFailureAndReset("Collator::createInstance(de)")) {
+        return;
+    }
+    UnicodeString storage[kSortKeysStrings];
+    const char16_t *strings[kSortKeysStrings];
+    for (int32_t i = 0; i < kSortKeysStrings; ++i) {
+        storage[i].append(u"Stra\u00DFe ").append((UChar32)(0x41 + (i * 7) % 26)).append(
+            (UChar32)(0x3b1 + i % 17)).append((UChar32)(0x4e00 + i * 13));
+        strings[i] = storage[i].getTerminatedBuffer();
+    }
+
+    // Single-threaded reference.
+    int32_t expectedOffsets[kSortKeysStrings + 1];
+    int32_t totalLength = coll->getSortKeys(strings, nullptr, kSortKeysStrings,
+                                            nullptr, 0, expectedOffsets, errorCode);
+    errorCode.expectErrorAndReset(U_BUFFER_OVERFLOW_ERROR);
+    LocalArray<uint8_t> expected(new uint8_t[totalLength]);
+    LocalArray<uint8_t> keys(new uint8_t[totalLength]);
+    coll->getSortKeys(strings, nullptr, kSortKeysStrings,
+                      expected.getAlias(), totalLength, expectedOffsets, errorCode);
+    if (errorCode.errIfFailureAndReset("getSortKeys()")) { return; }
+
+    // Each thread preflights its range, then writes it into its segment.
+    int32_t offsets[kSortKeysStrings + 1];
+    SortKeysThread threads[kSortKeysThreads];
+    for (int32_t t = 0; t < kSortKeysThreads; ++t) {
+        threads[t].coll = coll.getAlias();
+        threads[t].strings = strings;
+        threads[t].startIndex = t * kSortKeysStrings / kSortKeysThreads;
+        threads[t].limitIndex = (t + 1) * kSortKeysStrings / kSortKeysThreads;
+    }
+    for (int32_t pass = 0; pass < 2; ++pass) {
+        int32_t destStart = 0;
+        for (auto &thread : threads) {
+            if (pass == 1) {
+                thread.dest = keys.getAlias();
+                thread.destStart = destStart;
+                thread.destCapacity = thread.length;
+                destStart += thread.length;
+            }
+            thread.start();
+        }
+        for (auto &thread : threads) {
+            thread.join();
+            assertSuccess(WHERE, thread.errorCode);
+        }
+    }
+    // Rebase the per-thread offsets onto the whole buffer.
+    for (const auto &thread : threads) {
+        for (int32_t i = thread.startIndex; i < thread.limitIndex; ++i) {
+            offsets[i] = thread.offsets[i - thread.startIndex] + thread.destStart;
+        }
+    }
+    offsets[kSortKeysStrings] = threads[kSortKeysThreads - 1].destStart +
+                                threads[kSortKeysThreads - 1].length;
+    for (int32_t i = 0; i <= kSortKeysStrings; ++i) {
+        if (offsets[i] != expectedOffsets[i]) {
+            errln("TestCollatorSortKeys: offsets[%d]=%d != %d", (int)i, (int)offsets[i],
+                  (int)expectedOffsets[i]);
+            return;
+        }
+    }
+    assertTrue(WHERE, uprv_memcmp(keys.getAlias(), expected.getAlias(), totalLength) == 0);
+}
+
 #endif /* #if !UCONFIG_NO_COLLATION */
 
 
@@ -1084,6 +1191,11 @@ U_NAMESPACE_BEGIN
 static std::mutex *gCTMutex = nullptr;
 static std::condition_variable *gCTConditionVar = nullptr;
 
+template<> U_EXPORT
+const char *CacheKey<UCTMultiThreadItem>::getValueTypeName() const {
+    return "UCTMultiThreadItem";
+}
+
 template<> U_EXPORT
 const UCTMultiThreadItem *LocaleCacheKey<UCTMultiThreadItem>::createObject(
         const void *context, UErrorCode &status) const {
@@ -1333,6 +1445,75 @@ void MultithreadTest::TestIncDec()
     assertEquals(WHERE, NUM_THREADS, gIncDecCounter);
 }
 
+//-------------------------------------------------------------------------------------------
+//
+//    TestResourceBundleThreads  Open the bundles of all available locales
+//                               from several threads at once, pairs of threads in the same order,
+//                               and look up values with fallback, one of them usually from root.
+//                               Check the results against single-threaded lookups.
+//
+//-------------------------------------------------------------------------------------------
+
+static UnicodeString lookUpDecimalSymbol(const char *localeID) {
+    UErrorCode status = U_ZERO_ERROR;
+    LocalUResourceBundlePointer bundle(ures_open(NULL, localeID, &status));
+    StackUResourceBundle decimal, moreInfo;
+    ures_getByKeyWithFallback(bundle.getAlias(), "NumberElements/latn/symbols/decimal",
+                              decimal.getAlias(), &status);
+    int32_t length = 0;
+    const UChar *s = ures_getString(decimal.getAlias(), &length, &status);
+    UnicodeString result(s, length);
+    // Most locales inherit this one from root.
+    ures_getByKeyWithFallback(bundle.getAlias(), "MoreInformation", moreInfo.getAlias(), &status);
+    s = ures_getString(moreInfo.getAlias(), &length, &status);
+    if (U_FAILURE(status)) {
+        return UnicodeString("failure: ").append(UnicodeString(u_errorName(status), -1, US_INV));
+    }
+    return result.append(u' ').append(s, length);
+}
+
+class ResourceBundleThread : public SimpleThread {
+public:
+    ResourceBundleThread() : fOffset(0), fResults(NULL) {}
+    virtual void run();
+    int32_t fOffset;
+    UnicodeString *fResults;
+};
+
+void ResourceBundleThread::run() {
+    int32_t count = uloc_countAvailable();
+    for (int32_t i = 0; i < count; ++i) {
+        int32_t index = (i + fOffset) % count;
+        fResults[index] = lookUpDecimalSymbol(uloc_getAvailable(index));
+    }
+}
+
+void MultithreadTest::TestResourceBundleThreads() {
+    static constexpr int NUM_THREADS = 8;
+    int32_t count = uloc_countAvailable();
+    ResourceBundleThread threads[NUM_THREADS];
+    std::unique_ptr<UnicodeString[]> results(new UnicodeString[NUM_THREADS * count]);
+    for (int32_t i = 0; i < NUM_THREADS; ++i) {
+        threads[i].fOffset = (i / 2) * count / (NUM_THREADS / 2);
+        threads[i].fResults = results.get() + i * count;
+        threads[i].start();
+    }
+    for (auto &thread:threads) {
+        thread.join();
+    }
+    assertEquals("en decimal symbol", u". ?", lookUpDecimalSymbol("en"));
+    for (int32_t index = 0; index < count; ++index) {
+        const char *localeID = uloc_getAvailable(index);
+        UnicodeString expected = lookUpDecimalSymbol(localeID);
+        for (int32_t i = 0; i < NUM_THREADS; ++i) {
+            if (results[i * count + index] != expected) {
+                errln(UnicodeString("TestResourceBundleThreads: thread ") + i + " locale " + localeID +
+                      " got \"" + results[i * count + index] + "\" expected \"" + expected + "\"");
+            }
+        }
+    }
+}
+
 #if !UCONFIG_NO_FORMATTING
 static Calendar  *gSharedCalendar = {};
 
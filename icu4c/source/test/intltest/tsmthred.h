@@ -43,11 +43,13 @@ class MultithreadTest : public IntlTest
     void TestThreadedIntl(void);
 #endif
     void TestCollators(void);
+    void TestCollatorSortKeys();
     void TestString();
     void TestAnyTranslit();
     void TestUnifiedCache();
     void TestBreakTranslit();
     void TestIncDec();
+    void TestResourceBundleThreads();
     void Test20104();
 };
 
@@ -10,6 +10,7 @@
 
 #if !UCONFIG_NO_NORMALIZATION
 
+#include "unicode/appendable.h"
 #include "unicode/uchar.h"
 #include "unicode/errorcode.h"
 #include "unicode/normlzr.h"
@@ -60,6 +61,9 @@ void BasicNormalizerTest::runIndexedTest(int32_t index, UBool exec,
     TESTCASE_AUTO(TestNormalizeIllFormedText);
     TESTCASE_AUTO(TestComposeJamoTBase);
     TESTCASE_AUTO(TestComposeBoundaryAfter);
+    TESTCASE_AUTO(TestStreamingNormalizer2);
+    TESTCASE_AUTO(TestIsNormalizedBatch);
+    TESTCASE_AUTO(TestComposeLowRuns);
     TESTCASE_AUTO_END;
 }
 
@@ -1805,4 +1809,162 @@ BasicNormalizerTest::TestComposeBoundaryAfter() {
     assertFalse("U+FB2C boundary-after", nfkc->hasBoundaryAfter(0xFB2C));
 }
 
+void
+BasicNormalizerTest::TestStreamingNormalizer2() {
+    IcuTestErrorCode errorCode(*this, "TestStreamingNormalizer2");
+    const Normalizer2 *nfc = Normalizer2::getNFCInstance(errorCode);
+    const Normalizer2 *nfd = Normalizer2::getNFDInstance(errorCode);
+    const Normalizer2 *nfkc_cf = Normalizer2::getNFKCCasefoldInstance(errorCode);
+    if(errorCode.errDataIfFailureAndReset("Normalizer2::getInstance() call failed")) {
+        return;
+    }
+    // Combining sequences, Hangul Jamo, a supplementary character with
+    // a combining mark, a lone surrogate, and text without boundaries.
+    UnicodeString src(u"  A\u0308\u0323bc\u1100\u1161\u11A8\u1100 \u00C5\u0301\u0327");
+    src.append(u"\U0001D15E\U0001D165x\u0323\u0307\u0323\u0307\u0323\u0307Ä,\u00ad");
+    src.append((char16_t)0xDC00).append(u"\u1161Ω\u0345\u0301 end");
+    std::string src8;
+    src.toUTF8String(src8);
+    src8.append("\xE2\x82").append(u8"\u0308x");  // truncated sequence
+    const Normalizer2 *norms[] = { nfc, nfd, nfkc_cf };
+    const char *const names[] = { "NFC", "NFD", "NFKC_CF" };
+    for(int32_t n=0; n<UPRV_LENGTHOF(norms); ++n) {
+        StreamingNormalizer2 stream(*norms[n]);
+        UnicodeString expected=norms[n]->normalize(src, errorCode);
+        std::string expected8;
+        StringByteSink<std::string> expectedSink(&expected8);
+        norms[n]->normalizeUTF8(0, src8, expectedSink, nullptr, errorCode);
+        // Split the text into chunks of each length, which puts chunk
+        // boundaries inside combining sequences, surrogate pairs and UTF-8 sequences.
+        for(int32_t chunkLength=1; chunkLength<=8; ++chunkLength) {
+            UnicodeString result;
+            UnicodeStringAppendable appendable(result);
+            for(int32_t i=0; i<src.length(); i+=chunkLength) {
+                stream.normalize(src.tempSubString(i, chunkLength), appendable, errorCode);
+            }
+            stream.finish(appendable, errorCode);
+            assertEquals(UnicodeString(names[n])+" UTF-16 chunks of "+chunkLength, expected, result);
+            assertEquals("nothing pending after finish()", 0, stream.getPendingLength());
+
+            std::string result8;
+            StringByteSink<std::string> sink(&result8);
+            for(size_t i=0; i<src8.length(); i+=chunkLength) {
+                stream.normalizeUTF8(StringPiece(src8).substr((int32_t)i, chunkLength), sink, errorCode);
+            }
+            stream.finishUTF8(sink, errorCode);
+            assertEquals(UnicodeString(names[n])+" UTF-8 chunks of "+chunkLength,
+                         expected8.c_str(), result8.c_str());
+        }
+    }
+    errorCode.assertSuccess();
+
+    // Only the text after the last boundary is retained.
+    StreamingNormalizer2 stream(*nfc);
+    UnicodeString result;
+    UnicodeStringAppendable appendable(result);
+    stream.normalize(u"abcA\u0308", appendable, errorCode);
+    assertEquals("normalized up to the last boundary", u"abc", result);
+    assertEquals("pending A+U+0308", 2, stream.getPendingLength());
+    stream.normalize(u"\u0323", appendable, errorCode);
+    assertEquals("pending A+U+0308+U+0323", 3, stream.getPendingLength());
+
+    // Mixing UTF-8 and UTF-16 requires finish() or reset().
+    std::string result8;
+    StringByteSink<std::string> sink(&result8);
+    stream.normalizeUTF8("abc", sink, errorCode);
+    assertEquals("mixed UTF-8/UTF-16", U_ILLEGAL_ARGUMENT_ERROR, errorCode.reset());
+    stream.finish(appendable, errorCode);
+    assertEquals("finish", u"abc\u1EA0\u0308", result);
+    stream.normalizeUTF8("abc", sink, errorCode);
+    stream.finishUTF8(sink, errorCode);
+    assertSuccess("UTF-8 after finish()", errorCode.get());
+    assertEquals("UTF-8 after finish()", "abc", result8.c_str());
+}
+
+void
+BasicNormalizerTest::TestIsNormalizedBatch() {
+    IcuTestErrorCode errorCode(*this, "TestIsNormalizedBatch");
+    const Normalizer2 *nfc = Normalizer2::getNFCInstance(errorCode);
+    const Normalizer2 *nfd = Normalizer2::getNFDInstance(errorCode);
+    const Normalizer2 *fcd = Normalizer2::getInstance(nullptr, "nfc", UNORM2_FCD, errorCode);
+    if(errorCode.errDataIfFailureAndReset("Normalizer2::getInstance() call failed")) {
+        return;
+    }
+    UnicodeSet filter(u"[^\\u00E0]", errorCode);
+    filter.freeze();
+    FilteredNormalizer2 fn2(*nfc, filter);
+    // The UTF-16 batch functions are also tested via the C API in cintltst.
+    // Here: UTF-8, and the default implementations (FilteredNormalizer2, and UTF-8 for non-compose modes).
+    static const char16_t *const strings[] = {
+        u"abc", u"\u00E0", u"a\u0300", u"q\u0300", u"", u"A\u0323\u0308", u"A\u0308\u0323",
+        u"\u1100\u1161", u"\uAC00\u11A8", u"\uAC01", u"\u2126", u"\U0001D15E", u"\U0001D157\U0001D165"
+    };
+    UnicodeString text;
+    std::string text8;
+    int32_t offsets[UPRV_LENGTHOF(strings) + 1] = { 0 };
+    int32_t offsets8[UPRV_LENGTHOF(strings) + 1] = { 0 };
+    int32_t count = UPRV_LENGTHOF(strings);
+    for(int32_t i=0; i<count; ++i) {
+        text.append(strings[i]);
+        UnicodeString(strings[i]).toUTF8String(text8);
+        offsets[i + 1] = text.length();
+        offsets8[i + 1] = (int32_t)text8.length();
+    }
+    const Normalizer2 *norms[] = { nfc, nfd, fcd, &fn2 };
+    const char *const names[] = { "NFC", "NFD", "FCD", "filtered NFC" };
+    for(int32_t n=0; n<UPRV_LENGTHOF(norms); ++n) {
+        uint8_t results[2], results8[2];
+        int32_t numNormalized = norms[n]->isNormalizedBatch(
+            text.getBuffer(), offsets, count, results, errorCode);
+        int32_t numNormalized8 = norms[n]->isNormalizedBatchUTF8(
+            text8.data(), offsets8, count, results8, errorCode);
+        int32_t expectedNumNormalized = 0;
+        for(int32_t i=0; i<count; ++i) {
+            UBool expected = norms[n]->isNormalized(UnicodeString(strings[i]), errorCode);
+            expectedNumNormalized += expected;
+            UnicodeString message = UnicodeString(names[n]) + " string " + i;
+            assertEquals(message, expected, (UBool)((results[i >> 3] >> (i & 7)) & 1));
+            assertEquals(message + " UTF-8", expected, (UBool)((results8[i >> 3] >> (i & 7)) & 1));
+        }
+        assertEquals(UnicodeString(names[n]) + " count", expectedNumNormalized, numNormalized);
+        assertEquals(UnicodeString(names[n]) + " count UTF-8", expectedNumNormalized, numNormalized8);
+    }
+    errorCode.assertSuccess();
+}
+
+void
+BasicNormalizerTest::TestComposeLowRuns() {
+    IcuTestErrorCode errorCode(*this, "TestComposeLowRuns");
+    const Normalizer2 *nfc = Normalizer2::getNFCInstance(errorCode);
+    if(errorCode.errDataIfFailureAndReset("Normalizer2::getNFCInstance() call failed")) {
+        return;
+    }
+    // Composition skips runs of code units below the first one that might need
+    // normalization block by block.  Put a combining sequence after runs of each
+    // length up to several blocks, and follow it with more such text.
+    static const char16_t low[] = u"abcdefgh\u00E7ijklmnopqrstuvwxyz\u00E9ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+    for(int32_t n=0; n<=40; ++n) {
+        for(int32_t m=0; m<=20; m+=5) {
+            UnicodeString s(low, n);
+            s.append(u"e\u0301").append(low, m);
+            UnicodeString expected(low, n);
+            expected.append(u'\u00E9').append(low, m);
+            UnicodeString message = UnicodeString("low run ") + n + " then " + m;
+            assertEquals(message, expected, nfc->normalize(s, errorCode));
+            assertFalse(message + " isNormalized", nfc->isNormalized(s, errorCode));
+            assertEquals(message + " quickCheck", UNORM_MAYBE, nfc->quickCheck(s, errorCode));
+            assertEquals(message + " spanQuickCheckYes", n, nfc->spanQuickCheckYes(s, errorCode));
+            assertTrue(message + " NFC isNormalized", nfc->isNormalized(expected, errorCode));
+            assertEquals(message + " NFC quickCheck", UNORM_YES, nfc->quickCheck(expected, errorCode));
+            std::string s8, expected8, result8;
+            s.toUTF8String(s8);
+            expected.toUTF8String(expected8);
+            StringByteSink<std::string> sink(&result8);
+            nfc->normalizeUTF8(0, s8, sink, nullptr, errorCode);
+            assertEquals(message + " UTF-8", expected8.c_str(), result8.c_str());
+        }
+    }
+    errorCode.assertSuccess();
+}
+
 #endif /* #if !UCONFIG_NO_NORMALIZATION */
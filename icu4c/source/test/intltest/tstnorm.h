@@ -53,6 +53,9 @@ class BasicNormalizerTest : public IntlTest {
     void TestNormalizeIllFormedText();
     void TestComposeJamoTBase();
     void TestComposeBoundaryAfter();
+    void TestStreamingNormalizer2();
+    void TestIsNormalizedBatch();
+    void TestComposeLowRuns();
 
 private:
     UnicodeString canonTests[24][3];
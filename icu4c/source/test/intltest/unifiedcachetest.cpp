@@ -31,6 +31,11 @@ class UCTItem2 : public SharedObject {
 
 U_NAMESPACE_BEGIN
 
+template<> U_EXPORT
+const char *CacheKey<UCTItem>::getValueTypeName() const {
+    return "UCTItem";
+}
+
 template<> U_EXPORT
 const UCTItem *LocaleCacheKey<UCTItem>::createObject(
         const void *context, UErrorCode &status) const {
@@ -56,6 +61,11 @@ const UCTItem *LocaleCacheKey<UCTItem>::createObject(
     return result;
 }
 
+template<> U_EXPORT
+const char *CacheKey<UCTItem2>::getValueTypeName() const {
+    return "UCTItem2";
+}
+
 template<> U_EXPORT
 const UCTItem2 *LocaleCacheKey<UCTItem2>::createObject(
         const void * /*unused*/, UErrorCode & /*status*/) const {
@@ -77,6 +87,7 @@ class UnifiedCacheTest : public IntlTest {
     void TestError();
     void TestHashEquals();
     void TestEvictionUnderStress();
+    void TestStatistics();
 };
 
 void UnifiedCacheTest::runIndexedTest(int32_t index, UBool exec, const char* &name, char* /*par*/) {
@@ -87,6 +98,7 @@ void UnifiedCacheTest::runIndexedTest(int32_t index, UBool exec, const char* &na
   TESTCASE_AUTO(TestError);
   TESTCASE_AUTO(TestHashEquals);
   TESTCASE_AUTO(TestEvictionUnderStress);
+  TESTCASE_AUTO(TestStatistics);
   TESTCASE_AUTO_END;
 }
 
@@ -396,6 +408,57 @@ void UnifiedCacheTest::TestHashEquals() {
     assertTrue("", diffKey1 != diffKey2);
 }
 
+void UnifiedCacheTest::TestStatistics() {
+    UErrorCode status = U_ZERO_ERROR;
+    UnifiedCache::getInstance(status);
+    UnifiedCache cache(status);
+    assertSuccess("T0", status);
+
+    const UCTItem *enUs = NULL;
+    const UCTItem *en = NULL;
+    const UCTItem *zh = NULL;
+    // en_US is created from en: two misses.
+    cache.get(LocaleCacheKey<UCTItem>("en_US"), &cache, enUs, status);
+    cache.get(LocaleCacheKey<UCTItem>("en"), &cache, en, status);
+    UErrorCode zhStatus = U_ZERO_ERROR;
+    cache.get(LocaleCacheKey<UCTItem>("zh"), &cache, zh, zhStatus);
+    assertSuccess("T1", status);
+
+    UnifiedCacheStatistics stats;
+    cache.getStatistics(stats, status);
+    assertSuccess("T2", status);
+    assertEquals("T3 hits", (int64_t)1, stats.hits);
+    assertEquals("T4 misses", (int64_t)3, stats.misses);
+    assertEquals("T5 waits", (int64_t)0, stats.inProgressWaits);
+    assertEquals("T6 keyCount", 3, stats.keyCount);
+    assertEquals("T7 typeCount", 1, stats.typeCount);
+    const UnifiedCacheTypeStatistics &itemStats = stats.types[0];
+    assertEquals("T8 typeName", "UCTItem", itemStats.typeName);
+    assertEquals("T9 type keyCount", 3, itemStats.keyCount);
+    assertEquals("T10 type valueCount", 1, itemStats.valueCount);
+    assertEquals("T11 memoryEstimate", (int64_t)sizeof(UCTItem), itemStats.memoryEstimate);
+    assertEquals("T12 evicted", (int64_t)0, itemStats.autoEvictedCount);
+
+    // With no unused entries allowed,
+    // releasing the last reference lets the cache evict everything.
+    cache.setEvictionPolicy(0, 0, status);
+    SharedObject::clearPtr(enUs);
+    SharedObject::clearPtr(en);
+    cache.getStatistics(stats, status);
+    assertEquals("T13 keyCount", 0, stats.keyCount);
+    assertEquals("T14 evicted", (int64_t)3, stats.autoEvictedCount);
+    assertEquals("T15 type evicted", (int64_t)3, stats.types[0].autoEvictedCount);
+    assertEquals("T16 type keyCount", 0, stats.types[0].keyCount);
+
+    cache.resetStatistics();
+    cache.getStatistics(stats, status);
+    assertSuccess("T17", status);
+    assertEquals("T18 hits", (int64_t)0, stats.hits);
+    assertEquals("T19 misses", (int64_t)0, stats.misses);
+    assertEquals("T20 evicted", (int64_t)0, stats.autoEvictedCount);
+    assertEquals("T21 typeCount", 0, stats.typeCount);
+}
+
 extern IntlTest *createUnifiedCacheTest() {
     return new UnifiedCacheTest();
 }
@@ -60,6 +60,10 @@ UPerfFunction* DateFormatPerfTest::runIndexedTest(int32_t index, UBool exec,cons
         TESTCASE(22,DateFmtCopy10000);
         TESTCASE(23,DateFmtCreate250);
         TESTCASE(24,DateFmtCreate10000);
+        TESTCASE(25,CacheContention1Thread);
+        TESTCASE(26,CacheContention8Threads);
+        TESTCASE(27,FormatterCreate2000);
+        TESTCASE(28,FormatterCreateNoIndex2000);
 
 
         default: 
@@ -184,6 +188,22 @@ UPerfFunction* DateFormatPerfTest::DateFmtCreate10000(){
     return new DateFmtCreateFunction(10000, locale);
 }
 
+UPerfFunction* DateFormatPerfTest::CacheContention1Thread(){
+    return new CacheContentionFunction(2000, 1);
+}
+
+UPerfFunction* DateFormatPerfTest::CacheContention8Threads(){
+    return new CacheContentionFunction(2000, 8);
+}
+
+UPerfFunction* DateFormatPerfTest::FormatterCreate2000(){
+    return new FormatterCreateFunction(2000, TRUE);
+}
+
+UPerfFunction* DateFormatPerfTest::FormatterCreateNoIndex2000(){
+    return new FormatterCreateFunction(2000, FALSE);
+}
+
 
 int main(int argc, const char* argv[]){
 
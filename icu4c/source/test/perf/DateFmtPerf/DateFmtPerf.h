@@ -26,7 +26,9 @@
 #include "unicode/brkiter.h"
 #include "unicode/numfmt.h"
 #include "unicode/coll.h"
+#include "unicode/dcfmtsym.h"
 #include "util.h"
+#include "uresimp.h"
 
 #include "datedata.h"
 #include "breakdata.h"
@@ -36,6 +38,8 @@
 #include <string.h>
 
 #include <fstream>
+#include <thread>
+#include <vector>
 
 #include <iostream>
 using namespace std;
@@ -809,6 +813,97 @@ class CollationFunction : public UPerfFunction
 	}
 };
 
+// Creates date and number formatters for a mix of locales from several threads at once.
+// Most of the time is spent fetching shared data from the UnifiedCache,
+// so this measures how well cache lookups scale with concurrent threads.
+class CacheContentionFunction : public UPerfFunction
+{
+
+private:
+        int num;
+        int threadCount;
+
+        void createFormatters(int threadIndex)
+        {
+                static const char *const locales[] = {
+                    "en_US", "de_DE", "fr_FR", "ja_JP", "ru_RU", "ar_EG", "zh_Hans_CN", "es_MX"
+                };
+                const int32_t localeCount = UPRV_LENGTHOF(locales);
+                for(int j = 0; j < num; j++) {
+                    Locale loc(locales[(threadIndex + j) % localeCount]);
+                    UErrorCode status = U_ZERO_ERROR;
+                    delete DateFormat::createDateInstance(DateFormat::kMedium, loc);
+                    delete NumberFormat::createInstance(loc, status);
+                }
+        }
+
+public:
+
+        CacheContentionFunction(int a, int threads)
+        {
+                num = a;
+                threadCount = threads;
+        }
+
+        virtual void call(UErrorCode* /* status */)
+        {
+                std::vector<std::thread> threads;
+                for(int i = 0; i < threadCount; i++) {
+                    threads.push_back(std::thread(&CacheContentionFunction::createFormatters, this, i));
+                }
+                for(int i = 0; i < threadCount; i++) {
+                    threads[i].join();
+                }
+        }
+
+        virtual long getOperationsPerIteration()
+        {
+                return (long)num * threadCount;
+        }
+
+};
+
+// Creates number formatters and symbols, which are not cached in the UnifiedCache,
+// for locales whose data is mostly inherited from parent bundles.
+// Most of the time is spent in resource bundle lookups with fallback,
+// with or without the fallback-resolved index of those lookups.
+class FormatterCreateFunction : public UPerfFunction
+{
+
+private:
+        int num;
+        UBool useFallbackIndex;
+
+public:
+
+        FormatterCreateFunction(int a, UBool useIndex)
+        {
+                num = a;
+                useFallbackIndex = useIndex;
+        }
+
+        virtual void call(UErrorCode* status)
+        {
+                static const char *const locales[] = {
+                    "de_CH", "fr_CA", "en_GB", "es_MX", "pt_PT", "sr_Latn_BA", "zh_Hant_HK", "ar_EG"
+                };
+                const int32_t localeCount = UPRV_LENGTHOF(locales);
+                ures_setFallbackIndexEnabled(useFallbackIndex);
+                for(int j = 0; j < num; j++) {
+                    Locale loc(locales[j % localeCount]);
+                    delete NumberFormat::createInstance(loc, UNUM_CURRENCY, *status);
+                    DecimalFormatSymbols symbols(loc, *status);
+                }
+                ures_setFallbackIndexEnabled(TRUE);
+        }
+
+        virtual long getOperationsPerIteration()
+        {
+                return num;
+        }
+
+};
+
 class DateFormatPerfTest : public UPerfTest
 {
 private:
@@ -844,6 +939,10 @@ class DateFormatPerfTest : public UPerfTest
     UPerfFunction* DTPatternGeneratorCopy10000();
     UPerfFunction* DTPatternGeneratorBestValue250();
     UPerfFunction* DTPatternGeneratorBestValue10000();
+    UPerfFunction* CacheContention1Thread();
+    UPerfFunction* CacheContention8Threads();
+    UPerfFunction* FormatterCreate2000();
+    UPerfFunction* FormatterCreateNoIndex2000();
 };
 
 #endif // DateFmtPerf
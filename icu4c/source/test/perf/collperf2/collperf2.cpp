@@ -163,6 +163,65 @@ long Strcoll_2::getOperationsPerIteration()
     return source->count;
 }
 
+//
+// Test case taking two test data arrays, calling ucol_strcollBatch once for all strings at the same indexes
+//
+class StrcollBatch : public UPerfFunction
+{
+public:
+    StrcollBatch(const UCollator* coll, const CA_uchar* source, const CA_uchar* target);
+    ~StrcollBatch();
+    virtual void call(UErrorCode* status);
+    virtual long getOperationsPerIteration();
+
+private:
+    const UCollator *coll;
+    int32_t count;
+    const UChar **sources;
+    int32_t *sourceLengths;
+    const UChar **targets;
+    int32_t *targetLengths;
+    UCollationResult *results;
+};
+
+StrcollBatch::StrcollBatch(const UCollator* coll, const CA_uchar* source, const CA_uchar* target)
+    :   coll(coll),
+        count(source->count < target->count ? source->count : target->count),
+        sources(new const UChar*[count]),
+        sourceLengths(new int32_t[count]),
+        targets(new const UChar*[count]),
+        targetLengths(new int32_t[count]),
+        results(new UCollationResult[count])
+{
+    for (int32_t i = 0; i < count; i++) {
+        sources[i] = source->dataOf(i);
+        sourceLengths[i] = source->lengthOf(i);
+        targets[i] = target->dataOf(i);
+        targetLengths[i] = target->lengthOf(i);
+    }
+}
+
+StrcollBatch::~StrcollBatch()
+{
+    delete[] sources;
+    delete[] sourceLengths;
+    delete[] targets;
+    delete[] targetLengths;
+    delete[] results;
+}
+
+void StrcollBatch::call(UErrorCode* status)
+{
+    if (U_FAILURE(*status)) return;
+
+    ucol_strcollBatch(coll, sources, sourceLengths, targets, targetLengths, count, results, status);
+}
+
+long StrcollBatch::getOperationsPerIteration()
+{
+    return count;
+}
+
 
 //
 // Test case taking a single test data array, calling ucol_strcollUTF8 by permuting the test data
@@ -328,6 +387,66 @@ long GetSortKey::getOperationsPerIteration()
     return source->count;
 }
 
+//
+// Test case taking a single test data array in UTF-16, calling ucol_getSortKeys once
+// to write all of the sort keys into one buffer
+//
+class GetSortKeys : public UPerfFunction
+{
+public:
+    GetSortKeys(const UCollator* coll, const CA_uchar* source);
+    ~GetSortKeys();
+    virtual void call(UErrorCode* status);
+    virtual long getOperationsPerIteration();
+
+private:
+    const UCollator *coll;
+    int32_t count;
+    const UChar **strings;
+    int32_t *lengths;
+    int32_t *offsets;
+    uint8_t *keys;
+    int32_t capacity;
+};
+
+GetSortKeys::GetSortKeys(const UCollator* coll, const CA_uchar* source)
+    :   coll(coll),
+        count(source->count),
+        strings(new const UChar*[count]),
+        lengths(new int32_t[count]),
+        offsets(new int32_t[count + 1]),
+        keys(NULL),
+        capacity(0)
+{
+    for (int32_t i = 0; i < count; i++) {
+        strings[i] = source->dataOf(i);
+        lengths[i] = source->lengthOf(i);
+    }
+    UErrorCode status = U_ZERO_ERROR;
+    capacity = ucol_getSortKeys(coll, strings, lengths, count, NULL, 0, offsets, &status);
+    keys = new uint8_t[capacity];
+}
+
+GetSortKeys::~GetSortKeys()
+{
+    delete[] strings;
+    delete[] lengths;
+    delete[] offsets;
+    delete[] keys;
+}
+
+void GetSortKeys::call(UErrorCode* status)
+{
+    if (U_FAILURE(*status)) return;
+
+    ucol_getSortKeys(coll, strings, lengths, count, keys, capacity, offsets, status);
+}
+
+long GetSortKeys::getOperationsPerIteration()
+{
+    return count;
+}
+
 //
 // Test case taking a single test data array in UTF-16, calling ucol_nextSortKeyPart for each for the
 // given buffer size
@@ -950,6 +1069,44 @@ void StringPieceSortC::call(UErrorCode* status) {
     ops = cc.counter;
 }
 
+//
+// Test case sorting an index array of UTF-8 strings with ucol_sortIndexesUTF8().
+// The number of comparisons is not visible, so this counts one operation per string.
+//
+class StringPieceSortIndexesC : public StringPieceSort {
+public:
+    StringPieceSortIndexesC(const Collator& coll, const UCollator *ucoll, const CA_char* data8)
+            : StringPieceSort(coll, ucoll, data8),
+              strings(new const char*[d8->count]), lengths(new int32_t[d8->count]),
+              indexes(new int32_t[d8->count]) {
+        for (int32_t i = 0; i < d8->count; ++i) {
+            strings[i] = source[i].data();
+            lengths[i] = source[i].length();
+        }
+    }
+    virtual ~StringPieceSortIndexesC();
+    virtual void call(UErrorCode* status);
+
+private:
+    const char** strings;
+    int32_t* lengths;
+    int32_t* indexes;
+};
+
+StringPieceSortIndexesC::~StringPieceSortIndexesC() {
+    delete[] strings;
+    delete[] lengths;
+    delete[] indexes;
+}
+
+void StringPieceSortIndexesC::call(UErrorCode* status) {
+    if (U_FAILURE(*status)) return;
+
+    int32_t count = d8->count;
+    ucol_sortIndexesUTF8(ucoll, strings, lengths, count, indexes, status);
+    ops = count;
+}
+
 //
 // Test case performing binary searches in a sorted array of UnicodeString pointers.
 //
@@ -1086,6 +1243,7 @@ class CollPerf2Test : public UPerfTest
     UPerfFunction* TestStrcoll();
     UPerfFunction* TestStrcollNull();
     UPerfFunction* TestStrcollSimilar();
+    UPerfFunction* TestStrcollBatchSimilar();
 
     UPerfFunction* TestStrcollUTF8();
     UPerfFunction* TestStrcollUTF8Null();
@@ -1093,6 +1251,7 @@ class CollPerf2Test : public UPerfTest
 
     UPerfFunction* TestGetSortKey();
     UPerfFunction* TestGetSortKeyNull();
+    UPerfFunction* TestGetSortKeys();
 
     UPerfFunction* TestNextSortKeyPart_4All();
     UPerfFunction* TestNextSortKeyPart_4x2();
@@ -1122,6 +1281,7 @@ class CollPerf2Test : public UPerfTest
     UPerfFunction* TestUniStrSort();
     UPerfFunction* TestStringPieceSortCpp();
     UPerfFunction* TestStringPieceSortC();
+    UPerfFunction* TestStringPieceSortIndexesC();
 
     UPerfFunction* TestUniStrBinSearch();
     UPerfFunction* TestStringPieceBinSearchCpp();
@@ -1395,6 +1555,7 @@ CollPerf2Test::runIndexedTest(int32_t index, UBool exec, const char *&name, char
     TESTCASE_AUTO(TestStrcoll);
     TESTCASE_AUTO(TestStrcollNull);
     TESTCASE_AUTO(TestStrcollSimilar);
+    TESTCASE_AUTO(TestStrcollBatchSimilar);
 
     TESTCASE_AUTO(TestStrcollUTF8);
     TESTCASE_AUTO(TestStrcollUTF8Null);
@@ -1402,6 +1563,7 @@ CollPerf2Test::runIndexedTest(int32_t index, UBool exec, const char *&name, char
 
     TESTCASE_AUTO(TestGetSortKey);
     TESTCASE_AUTO(TestGetSortKeyNull);
+    TESTCASE_AUTO(TestGetSortKeys);
 
     TESTCASE_AUTO(TestNextSortKeyPart_4All);
     TESTCASE_AUTO(TestNextSortKeyPart_4x4);
@@ -1429,6 +1591,7 @@ CollPerf2Test::runIndexedTest(int32_t index, UBool exec, const char *&name, char
     TESTCASE_AUTO(TestUniStrSort);
     TESTCASE_AUTO(TestStringPieceSortCpp);
     TESTCASE_AUTO(TestStringPieceSortC);
+    TESTCASE_AUTO(TestStringPieceSortIndexesC);
 
     TESTCASE_AUTO(TestUniStrBinSearch);
     TESTCASE_AUTO(TestStringPieceBinSearchCpp);
@@ -1473,6 +1636,17 @@ UPerfFunction* CollPerf2Test::TestStrcollSimilar()
     return testCase;
 }
 
+UPerfFunction* CollPerf2Test::TestStrcollBatchSimilar()
+{
+    UErrorCode status = U_ZERO_ERROR;
+    const CA_uchar *source = getData16(status);
+    const CA_uchar *target = getModData16(status);
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    return new StrcollBatch(coll, source, target);
+}
+
 UPerfFunction* CollPerf2Test::TestStrcollUTF8()
 {
     UErrorCode status = U_ZERO_ERROR;
@@ -1528,6 +1702,16 @@ UPerfFunction* CollPerf2Test::TestGetSortKeyNull()
     return testCase;
 }
 
+UPerfFunction* CollPerf2Test::TestGetSortKeys()
+{
+    UErrorCode status = U_ZERO_ERROR;
+    const CA_uchar *source = getData16(status);
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    return new GetSortKeys(coll, source);
+}
+
 UPerfFunction* CollPerf2Test::TestNextSortKeyPart_4All()
 {
     UErrorCode status = U_ZERO_ERROR;
@@ -1756,6 +1940,16 @@ UPerfFunction* CollPerf2Test::TestStringPieceSortC() {
     return testCase;
 }
 
+UPerfFunction* CollPerf2Test::TestStringPieceSortIndexesC() {
+    UErrorCode status = U_ZERO_ERROR;
+    UPerfFunction *testCase = new StringPieceSortIndexesC(*collObj, coll, getRandomData8(status));
+    if (U_FAILURE(status)) {
+        delete testCase;
+        return NULL;
+    }
+    return testCase;
+}
+
 UPerfFunction* CollPerf2Test::TestUniStrBinSearch() {
     UErrorCode status = U_ZERO_ERROR;
     UPerfFunction *testCase = new UniStrBinSearch(*collObj, coll, getSortedData16(status));
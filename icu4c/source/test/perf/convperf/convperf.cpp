@@ -116,6 +116,11 @@ UPerfFunction* ConverterPerformanceTest::runIndexedTest(int32_t index, UBool exe
         TESTCASE(52,TestWinANSI_ISO2022JP_ToUnicode);
         TESTCASE(53,TestWinANSI_ISO2022JP_FromUnicode);
 
+        TESTCASE(54,TestICU_UTF8_ToUnicode_Offsets);
+        TESTCASE(55,TestICU_UTF8_FromUnicode_Offsets);
+        TESTCASE(56,TestICU_UTF8_ConvertEx_UTF8);
+        TESTCASE(57,TestICU_UTF8_ConvertEx_Latin1);
+
         default: 
             name = ""; 
             return NULL;
@@ -160,6 +165,43 @@ UPerfFunction*  ConverterPerformanceTest::TestICU_UTF8_ToUnicode(){
     return pf;
 }
 
+UPerfFunction* ConverterPerformanceTest::TestICU_UTF8_FromUnicode_Offsets(){
+    UErrorCode status = U_ZERO_ERROR;
+    ICUFromUnicodePerfFunction* pf = new ICUFromUnicodePerfFunction("utf-8", (UChar *)utf8_uniSource, UPRV_LENGTHOF(utf8_uniSource), status, TRUE);
+    if(U_FAILURE(status)){
+        return NULL;
+    }
+    return pf;
+}
+
+UPerfFunction*  ConverterPerformanceTest::TestICU_UTF8_ToUnicode_Offsets(){
+    UErrorCode status = U_ZERO_ERROR;
+    UPerfFunction* pf = new ICUToUnicodePerfFunction("utf-8",(char*)utf8_encSource, UPRV_LENGTHOF(utf8_encSource), status, TRUE);
+    if(U_FAILURE(status)){
+        return NULL;
+    }
+    return pf;
+}
+
+// UTF-8 to UTF-8 uses the direct ucnv_UTF8FromUTF8() conversion.
+UPerfFunction*  ConverterPerformanceTest::TestICU_UTF8_ConvertEx_UTF8(){
+    UErrorCode status = U_ZERO_ERROR;
+    UPerfFunction* pf = new ICUConvertExFromUTF8PerfFunction("utf-8",(char*)utf8_encSource, UPRV_LENGTHOF(utf8_encSource), status);
+    if(U_FAILURE(status)){
+        return NULL;
+    }
+    return pf;
+}
+
+// UTF-8 to an SBCS charset uses the direct ucnv_SBCSFromUTF8() conversion.
+UPerfFunction*  ConverterPerformanceTest::TestICU_UTF8_ConvertEx_Latin1(){
+    UErrorCode status = U_ZERO_ERROR;
+    UPerfFunction* pf = new ICUConvertExFromUTF8PerfFunction("windows-1252",(char*)utf8_encSource, UPRV_LENGTHOF(utf8_encSource), status);
+    if(U_FAILURE(status)){
+        return NULL;
+    }
+    return pf;
+}
 
 UPerfFunction* ConverterPerformanceTest::TestWinIML2_UTF8_FromUnicode(){
     UErrorCode status = U_ZERO_ERROR;
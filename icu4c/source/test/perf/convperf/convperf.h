@@ -32,18 +32,21 @@ class ICUToUnicodePerfFunction : public UPerfFunction{
     int32_t srcLen;
     UChar* target;
     UChar* targetLimit;
+    int32_t* offsets;
     
 public:
-    ICUToUnicodePerfFunction(const char* name,  const char* source, int32_t sourceLen, UErrorCode& status){
+    ICUToUnicodePerfFunction(const char* name,  const char* source, int32_t sourceLen, UErrorCode& status,
+                             UBool withOffsets = FALSE){
         conv = ucnv_open(name,&status);
         src = source;
         srcLen = sourceLen;
+        target = NULL;
+        targetLimit = NULL;
+        offsets = NULL;
         if(U_FAILURE(status)){
             conv = NULL;
             return;
         }
-        target = NULL;
-        targetLimit = NULL;
         int32_t reqdLen = ucnv_toUChars(conv,   target, 0,
                                         source, srcLen, &status);
         if(status==U_BUFFER_OVERFLOW_ERROR) {
@@ -54,18 +57,26 @@ class ICUToUnicodePerfFunction : public UPerfFunction{
                 status = U_MEMORY_ALLOCATION_ERROR;
                 return;
             }
+            if(withOffsets){
+                offsets=(int32_t*)malloc(reqdLen * sizeof(int32_t));
+                if(offsets == NULL){
+                    status = U_MEMORY_ALLOCATION_ERROR;
+                    return;
+                }
+            }
         }
     }
     virtual void call(UErrorCode* status){
         const char* mySrc = src;
         const char* sourceLimit = src + srcLen;
         UChar* myTarget = target;
-        ucnv_toUnicode(conv, &myTarget, targetLimit, &mySrc, sourceLimit, NULL, TRUE, status);
+        ucnv_toUnicode(conv, &myTarget, targetLimit, &mySrc, sourceLimit, offsets, TRUE, status);
     }
     virtual long getOperationsPerIteration(void){
         return srcLen;
     }
     ~ICUToUnicodePerfFunction(){
+        free(offsets);
         free(target);
         ucnv_close(conv);
     }
@@ -78,18 +89,21 @@ class ICUFromUnicodePerfFunction : public UPerfFunction{
     char* target;
     char* targetLimit;
     const char* name;
+    int32_t* offsets;
     
 public:
-    ICUFromUnicodePerfFunction(const char* name,  const UChar* source, int32_t sourceLen, UErrorCode& status){
+    ICUFromUnicodePerfFunction(const char* name,  const UChar* source, int32_t sourceLen, UErrorCode& status,
+                               UBool withOffsets = FALSE){
         conv = ucnv_open(name,&status);
         src = source;
         srcLen = sourceLen;
+        target = NULL;
+        targetLimit = NULL;
+        offsets = NULL;
         if(U_FAILURE(status)){
             conv = NULL;
             return;
         }
-        target = NULL;
-        targetLimit = NULL;
         int32_t reqdLen = ucnv_fromUChars(conv,   target, 0,
                                           source, srcLen, &status);
         if(status==U_BUFFER_OVERFLOW_ERROR) {
@@ -100,23 +114,75 @@ class ICUFromUnicodePerfFunction : public UPerfFunction{
                 status = U_MEMORY_ALLOCATION_ERROR;
                 return;
             }
+            if(withOffsets){
+                offsets=(int32_t*)malloc(reqdLen * sizeof(int32_t));
+                if(offsets == NULL){
+                    status = U_MEMORY_ALLOCATION_ERROR;
+                    return;
+                }
+            }
         }
     }
     virtual void call(UErrorCode* status){
         const UChar* mySrc = src;
         const UChar* sourceLimit = src + srcLen;
         char* myTarget = target;
-        ucnv_fromUnicode(conv,&myTarget, targetLimit, &mySrc, sourceLimit, NULL, TRUE, status);
+        ucnv_fromUnicode(conv,&myTarget, targetLimit, &mySrc, sourceLimit, offsets, TRUE, status);
     }
     virtual long getOperationsPerIteration(void){
         return srcLen;
     }
     ~ICUFromUnicodePerfFunction(){
+        free(offsets);
         free(target);
         ucnv_close(conv);
     }
 };
 
+/* Streaming UTF-8 to charset conversion via ucnv_convertEx() with bounded buffers. */
+class ICUConvertExFromUTF8PerfFunction : public UPerfFunction{
+private:
+    UConverter* utf8Cnv;
+    UConverter* conv;
+    const char* src;
+    int32_t srcLen;
+    char target[MAX_BUF_SIZE];
+    UChar pivot[MAX_BUF_SIZE];
+    
+public:
+    ICUConvertExFromUTF8PerfFunction(const char* name,  const char* source, int32_t sourceLen, UErrorCode& status){
+        utf8Cnv = ucnv_open("UTF-8",&status);
+        conv = ucnv_open(name,&status);
+        src = source;
+        srcLen = sourceLen;
+    }
+    virtual void call(UErrorCode* status){
+        const char* mySrc = src;
+        const char* sourceLimit = src + srcLen;
+        UChar *pivotSource = pivot, *pivotTarget = pivot;
+        UBool reset = TRUE;
+        do {
+            char* myTarget = target;
+            ucnv_convertEx(conv, utf8Cnv, &myTarget, target + MAX_BUF_SIZE, &mySrc, sourceLimit,
+                           pivot, &pivotSource, &pivotTarget, pivot + MAX_BUF_SIZE,
+                           reset, TRUE, status);
+            reset = FALSE;
+            if(*status == U_BUFFER_OVERFLOW_ERROR){
+                *status = U_ZERO_ERROR;
+            } else {
+                break;
+            }
+        } while(U_SUCCESS(*status));
+    }
+    virtual long getOperationsPerIteration(void){
+        return srcLen;
+    }
+    ~ICUConvertExFromUTF8PerfFunction(){
+        ucnv_close(conv);
+        ucnv_close(utf8Cnv);
+    }
+};
+
 class ICUOpenAllConvertersFunction : public UPerfFunction{
 private:
     UBool cleanup;
@@ -507,6 +573,10 @@ class  ConverterPerformanceTest : public UPerfTest{
     UPerfFunction* TestWinANSI_UTF8_FromUnicode();
     UPerfFunction* TestWinIML2_UTF8_ToUnicode();
     UPerfFunction* TestWinIML2_UTF8_FromUnicode();
+    UPerfFunction* TestICU_UTF8_ToUnicode_Offsets();
+    UPerfFunction* TestICU_UTF8_FromUnicode_Offsets();
+    UPerfFunction* TestICU_UTF8_ConvertEx_UTF8();
+    UPerfFunction* TestICU_UTF8_ConvertEx_Latin1();
         
     UPerfFunction* TestICU_Latin1_ToUnicode();
     UPerfFunction* TestICU_Latin1_FromUnicode();
@@ -59,6 +59,10 @@
         "th18057.txt",
         "thesis.txt",
         "vfear11a.txt",
+        "TestRandomWordsUDHR_de.txt",
+        "TestRandomWordsUDHR_fr.txt",
+        "TestRandomWordsUDHR_el.txt",
+        "TestRandomWordsUDHR_ru.txt",
     ]
 };
 
@@ -70,6 +74,8 @@
     "NFD_NFD_Text",  ["$p1,TestICU_NFD_NFD_Text"  ,  "$p2,TestICU_NFD_NFD_Text" ],
     "NFD_NFC_Text",  ["$p1,TestICU_NFD_NFC_Text"  ,  "$p2,TestICU_NFD_NFC_Text" ],
     "NFD_Orig_Text", ["$p1,TestICU_NFD_Orig_Text" ,  "$p2,TestICU_NFD_Orig_Text"],
+    "FCD_NFC_Text",  ["$p1,TestICU_FCD_NFC_Text"  ,  "$p2,TestICU_FCD_NFC_Text" ],
+    "NFC_NFC_UTF8",  ["$p1,TestICU_NFC_NFC_UTF8"  ,  "$p2,TestICU_NFC_NFC_UTF8" ],
     ##
     "QC_NFC_NFD_Text",  ["$p1,TestQC_NFC_NFD_Text"  ,  "$p2,TestQC_NFC_NFD_Text" ],
     "QC_NFC_NFC_Text",  ["$p1,TestQC_NFC_NFC_Text"  ,  "$p2,TestQC_NFC_NFC_Text" ],
@@ -83,7 +89,10 @@
     "IsNormalized_NFC_Orig_Text", ["$p1,TestIsNormalized_NFC_Orig_Text" ,  "$p2,TestIsNormalized_NFC_Orig_Text"],
     "IsNormalized_NFD_NFD_Text",  ["$p1,TestIsNormalized_NFD_NFD_Text"  ,  "$p2,TestIsNormalized_NFD_NFD_Text" ],
     "IsNormalized_NFD_NFC_Text",  ["$p1,TestIsNormalized_NFD_NFC_Text"  ,  "$p2,TestIsNormalized_NFD_NFC_Text" ],
-    "IsNormalized_NFD_Orig_Text", ["$p1,TestIsNormalized_NFD_Orig_Text" ,  "$p2,TestIsNormalized_NFD_Orig_Text"]
+    "IsNormalized_NFD_Orig_Text", ["$p1,TestIsNormalized_NFD_Orig_Text" ,  "$p2,TestIsNormalized_NFD_Orig_Text"],
+    "IsNormalized_NFC_NFC_UTF8",  ["$p1,TestIsNormalized_NFC_NFC_UTF8"  ,  "$p2,TestIsNormalized_NFC_NFC_UTF8" ],
+    "IsNormalizedLoop_NFC_NFC_Text",   ["$p1,TestIsNormalizedLoop_NFC_NFC_Text"   ,  "$p2,TestIsNormalizedLoop_NFC_NFC_Text" ],
+    "IsNormalizedBatch_NFC_NFC_Text",  ["$p1,TestIsNormalizedBatch_NFC_NFC_Text"  ,  "$p2,TestIsNormalizedBatch_NFC_NFC_Text" ]
 };
 
 
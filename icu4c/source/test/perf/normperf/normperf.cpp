@@ -66,6 +66,12 @@ UPerfFunction* NormalizerPerformanceTest::runIndexedTest(int32_t index, UBool ex
         TESTCASE(31,TestIsNormalized_FCD_NFC_Text);
         TESTCASE(32,TestIsNormalized_FCD_Orig_Text);
 
+        TESTCASE(33,TestICU_NFC_NFC_UTF8);
+        TESTCASE(34,TestIsNormalized_NFC_NFC_UTF8);
+
+        TESTCASE(35,TestIsNormalizedBatch_NFC_NFC_Text);
+        TESTCASE(36,TestIsNormalizedLoop_NFC_NFC_Text);
+
         default: 
             name = ""; 
             return NULL;
@@ -124,6 +130,7 @@ NormalizerPerformanceTest::NormalizerPerformanceTest(int32_t argc, const char* a
     NFCBufferLen = 0;
     NFDFileLines = NULL;
     NFCFileLines = NULL;
+    NFCUTF8Units = 0;
 
     if(status== U_ILLEGAL_ARGUMENT_ERROR){
        fprintf(stderr,gUsageString, "normperf");
@@ -153,6 +160,12 @@ NormalizerPerformanceTest::NormalizerPerformanceTest(int32_t argc, const char* a
             normalizeInput(&NFDFileLines[i],filelines[i].name,filelines[i].len,UNORM_NFD, options);
             normalizeInput(&NFCFileLines[i],filelines[i].name,filelines[i].len,UNORM_NFC, options);
 
+            NFCUTF8Text.push_back(std::string());
+            icu::UnicodeString(FALSE, NFCFileLines[i].name, NFCFileLines[i].len).toUTF8String(NFCUTF8Text.back());
+            NFCUTF8Units += NFCFileLines[i].len;
+
+            NFCBatchOffsets.push_back(NFCBatchText.length());
+            NFCBatchText.append(NFCFileLines[i].name, NFCFileLines[i].len);
         }
     }else if(bulk_mode){
         int32_t srcLen = 0;
@@ -167,8 +180,15 @@ NormalizerPerformanceTest::NormalizerPerformanceTest(int32_t argc, const char* a
          
         NFDBuffer = normalizeInput(NFDBufferLen,src,srcLen,UNORM_NFD, options);
         NFCBuffer = normalizeInput(NFCBufferLen,src,srcLen,UNORM_NFC, options);
+
+        NFCUTF8Text.push_back(std::string());
+        icu::UnicodeString(FALSE, NFCBuffer, NFCBufferLen).toUTF8String(NFCUTF8Text.back());
+        NFCUTF8Units = NFCBufferLen;
+
+        NFCBatchOffsets.push_back(0);
+        NFCBatchText.setTo(FALSE, NFCBuffer, NFCBufferLen);
     }
-    
+    NFCBatchOffsets.push_back(NFCBatchText.length());
 }
 
 NormalizerPerformanceTest::~NormalizerPerformanceTest(){
@@ -494,6 +514,42 @@ UPerfFunction* NormalizerPerformanceTest::TestIsNormalized_FCD_Orig_Text(){
     }
 }
 
+// Test UTF-8 NFC Performance
+UPerfFunction* NormalizerPerformanceTest::TestICU_NFC_NFC_UTF8(){
+    UErrorCode errorCode = U_ZERO_ERROR;
+    const icu::Normalizer2 *nfc = icu::Normalizer2::getNFCInstance(errorCode);
+    if(U_FAILURE(errorCode)){
+        return NULL;
+    }
+    return new NormUTF8PerfFunction(nfc, NFCUTF8Text, NFCUTF8Units, FALSE);
+}
+UPerfFunction* NormalizerPerformanceTest::TestIsNormalized_NFC_NFC_UTF8(){
+    UErrorCode errorCode = U_ZERO_ERROR;
+    const icu::Normalizer2 *nfc = icu::Normalizer2::getNFCInstance(errorCode);
+    if(U_FAILURE(errorCode)){
+        return NULL;
+    }
+    return new NormUTF8PerfFunction(nfc, NFCUTF8Text, NFCUTF8Units, TRUE);
+}
+
+// Test isNormalized() batch vs. per-string Performance
+UPerfFunction* NormalizerPerformanceTest::TestIsNormalizedBatch_NFC_NFC_Text(){
+    UErrorCode errorCode = U_ZERO_ERROR;
+    const icu::Normalizer2 *nfc = icu::Normalizer2::getNFCInstance(errorCode);
+    if(U_FAILURE(errorCode)){
+        return NULL;
+    }
+    return new NormBatchPerfFunction(nfc, NFCBatchText, NFCBatchOffsets, TRUE);
+}
+UPerfFunction* NormalizerPerformanceTest::TestIsNormalizedLoop_NFC_NFC_Text(){
+    UErrorCode errorCode = U_ZERO_ERROR;
+    const icu::Normalizer2 *nfc = icu::Normalizer2::getNFCInstance(errorCode);
+    if(U_FAILURE(errorCode)){
+        return NULL;
+    }
+    return new NormBatchPerfFunction(nfc, NFCBatchText, NFCBatchOffsets, FALSE);
+}
+
 int main(int argc, const char* argv[]){
     UErrorCode status = U_ZERO_ERROR;
     NormalizerPerformanceTest test(argc, argv, status);
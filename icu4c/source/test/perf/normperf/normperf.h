@@ -12,11 +12,16 @@
 #ifndef _NORMPERF_H
 #define _NORMPERF_H
 
+#include "unicode/bytestream.h"
+#include "unicode/normalizer2.h"
+#include "unicode/unistr.h"
 #include "unicode/unorm.h"
 #include "unicode/ustring.h"
 
 #include "unicode/uperf.h"
 #include <stdlib.h>
+#include <string>
+#include <vector>
 
 //  Stubs for Windows API functions when building on UNIXes.
 //
@@ -178,6 +183,74 @@ class NormPerfFunction : public UPerfFunction{
 
 
 
+// Normalizes or checks UTF-8 text with a Normalizer2.
+// Counts the UTF-16 code units of the text, like the UTF-16 tests.
+class NormUTF8PerfFunction : public UPerfFunction{
+private:
+    const icu::Normalizer2 *norm2;
+    const std::vector<std::string> &texts;
+    int32_t numUnits;
+    UBool checkOnly;
+    std::string dest;
+    UBool retVal;
+
+public:
+    virtual void call(UErrorCode* status){
+        for(size_t i = 0; i < texts.size(); i++){
+            if(checkOnly){
+                retVal = norm2->isNormalizedUTF8(texts[i], *status);
+            }else{
+                dest.clear();
+                icu::StringByteSink<std::string> sink(&dest, (int32_t)texts[i].length());
+                norm2->normalizeUTF8(0, texts[i], sink, NULL, *status);
+            }
+        }
+    }
+    virtual long getOperationsPerIteration(){
+        return numUnits;
+    }
+    NormUTF8PerfFunction(const icu::Normalizer2 *n2, const std::vector<std::string> &srcTexts,
+                         int32_t srcNumUnits, UBool _checkOnly)
+            : norm2(n2), texts(srcTexts), numUnits(srcNumUnits), checkOnly(_checkOnly), retVal(FALSE) {}
+};
+
+
+// Checks whether each of many strings is NFC, either with one
+// Normalizer2::isNormalizedBatch() call or with one isNormalized() call per string.
+class NormBatchPerfFunction : public UPerfFunction{
+private:
+    const icu::Normalizer2 *norm2;
+    const icu::UnicodeString &text;
+    const std::vector<int32_t> &offsets;
+    UBool batch;
+    std::vector<uint8_t> results;
+    int32_t numNormalized;
+
+public:
+    virtual void call(UErrorCode* status){
+        int32_t count = (int32_t)offsets.size() - 1;
+        if(batch){
+            numNormalized = norm2->isNormalizedBatch(text.getBuffer(), offsets.data(), count,
+                                                     results.data(), *status);
+        }else{
+            numNormalized = 0;
+            for(int32_t i = 0; i < count; i++){
+                numNormalized += norm2->isNormalized(
+                    icu::UnicodeString(FALSE, text.getBuffer() + offsets[i], offsets[i+1] - offsets[i]),
+                    *status);
+            }
+        }
+    }
+    virtual long getOperationsPerIteration(){
+        return text.length();
+    }
+    NormBatchPerfFunction(const icu::Normalizer2 *n2, const icu::UnicodeString &srcText,
+                          const std::vector<int32_t> &srcOffsets, UBool _batch)
+            : norm2(n2), text(srcText), offsets(srcOffsets), batch(_batch),
+              results((srcOffsets.size() + 7) / 8), numNormalized(0) {}
+};
+
+
 class  NormalizerPerformanceTest : public UPerfTest{
 private:
     ULine* NFDFileLines;
@@ -189,6 +262,12 @@ class  NormalizerPerformanceTest : public UPerfTest{
     int32_t NFDBufferLen;
     int32_t NFCBufferLen;
     int32_t options;
+    // NFC text (the lines or the buffer) in UTF-8, and its length in UTF-16 code units
+    std::vector<std::string> NFCUTF8Text;
+    int32_t NFCUTF8Units;
+    // NFC text (the lines or the buffer) back to back, with the start offset of each string
+    icu::UnicodeString NFCBatchText;
+    std::vector<int32_t> NFCBatchOffsets;
 
     void normalizeInput(ULine* dest,const UChar* src ,int32_t srcLen,UNormalizationMode mode, int32_t options);
     UChar* normalizeInput(int32_t& len, const UChar* src ,int32_t srcLen,UNormalizationMode mode, int32_t options);
@@ -249,6 +328,14 @@ class  NormalizerPerformanceTest : public UPerfTest{
     UPerfFunction* TestIsNormalized_FCD_NFC_Text();
     UPerfFunction* TestIsNormalized_FCD_Orig_Text();
 
+    /* UTF-8 NFC performance */
+    UPerfFunction* TestICU_NFC_NFC_UTF8();
+    UPerfFunction* TestIsNormalized_NFC_NFC_UTF8();
+
+    /* isNormalized() batch vs. per-string performance */
+    UPerfFunction* TestIsNormalizedBatch_NFC_NFC_Text();
+    UPerfFunction* TestIsNormalizedLoop_NFC_NFC_Text();
+
 };
 
 //---------------------------------------------------------------------------------------
@@ -59,6 +59,12 @@
 my $tests = {
     "ICU Forward Search", [ "$p1 Test_ICU_Forward_Search", "$p2 Test_ICU_Forward_Search" ],
     "ICU Backward Search",[ "$p1 Test_ICU_Backward_Search", "$p2 Test_ICU_Backward_Search" ],
+    "ICU Regex Find Literal",[ "$p1 Test_ICU_Regex_Find_Literal", "$p2 Test_ICU_Regex_Find_Literal" ],
+    "ICU Regex Find Words",[ "$p1 Test_ICU_Regex_Find_Words", "$p2 Test_ICU_Regex_Find_Words" ],
+    "ICU Regex Find Line",[ "$p1 Test_ICU_Regex_Find_Line", "$p2 Test_ICU_Regex_Find_Line" ],
+    "ICU Regex Find Literal UTF-8",[ "$p1 Test_ICU_Regex_Find_Literal_UTF8", "$p2 Test_ICU_Regex_Find_Literal_UTF8" ],
+    "ICU Regex Find Words UTF-8",[ "$p1 Test_ICU_Regex_Find_Words_UTF8", "$p2 Test_ICU_Regex_Find_Words_UTF8" ],
+    "ICU Regex Find Line UTF-8",[ "$p1 Test_ICU_Regex_Find_Line_UTF8", "$p2 Test_ICU_Regex_Find_Line_UTF8" ],
 };
 
 runTests( $options, $tests, $dataFiles );
@@ -87,6 +87,12 @@ UPerfFunction* StringSearchPerformanceTest::runIndexedTest(int32_t index, UBool
     switch (index) {
         TESTCASE(0,Test_ICU_Forward_Search);
         TESTCASE(1,Test_ICU_Backward_Search);
+        TESTCASE(2,Test_ICU_Regex_Find_Literal);
+        TESTCASE(3,Test_ICU_Regex_Find_Words);
+        TESTCASE(4,Test_ICU_Regex_Find_Line);
+        TESTCASE(5,Test_ICU_Regex_Find_Literal_UTF8);
+        TESTCASE(6,Test_ICU_Regex_Find_Words_UTF8);
+        TESTCASE(7,Test_ICU_Regex_Find_Line_UTF8);
 
         default: 
             name = ""; 
@@ -105,6 +111,55 @@ UPerfFunction* StringSearchPerformanceTest::Test_ICU_Backward_Search(){
     return func;
 }
 
+/* A regular expression that contains the search pattern, quoted, between prefix and suffix. */
+UPerfFunction* StringSearchPerformanceTest::regexFind(const char* prefix, const char* suffix, UBool utf8){
+    UErrorCode status = U_ZERO_ERROR;
+    UChar regex[200];
+    int32_t length = 0;
+    u_uastrcpy(regex, prefix);
+    u_strcat(regex, u"\\Q");
+    length = u_strlen(regex);
+    if (length + pttrnLen + 40 > (int32_t)(sizeof(regex)/sizeof(regex[0]))) {
+        fprintf(stderr, "FAILED: search pattern too long for the regular expression tests.\n");
+        return NULL;
+    }
+    u_strncpy(regex + length, pttrn, pttrnLen);
+    regex[length + pttrnLen] = 0;
+    u_strcat(regex, u"\\E");
+    u_uastrcpy(regex + u_strlen(regex), suffix);
+    RegexFindPerfFunction* func = new RegexFindPerfFunction(regex, -1, src, srcLen, utf8, &status);
+    if (U_FAILURE(status)) {
+        fprintf(stderr, "FAILED to create the regular expression test. Error: %s\n", u_errorName(status));
+        delete func;
+        return NULL;
+    }
+    return func;
+}
+
+UPerfFunction* StringSearchPerformanceTest::Test_ICU_Regex_Find_Literal(){
+    return regexFind("", "", FALSE);
+}
+
+UPerfFunction* StringSearchPerformanceTest::Test_ICU_Regex_Find_Words(){
+    return regexFind("\\w+\\s+", "\\s+\\w+", FALSE);
+}
+
+UPerfFunction* StringSearchPerformanceTest::Test_ICU_Regex_Find_Line(){
+    return regexFind("(?m)^.*", ".*$", FALSE);
+}
+
+UPerfFunction* StringSearchPerformanceTest::Test_ICU_Regex_Find_Literal_UTF8(){
+    return regexFind("", "", TRUE);
+}
+
+UPerfFunction* StringSearchPerformanceTest::Test_ICU_Regex_Find_Words_UTF8(){
+    return regexFind("\\w+\\s+", "\\s+\\w+", TRUE);
+}
+
+UPerfFunction* StringSearchPerformanceTest::Test_ICU_Regex_Find_Line_UTF8(){
+    return regexFind("(?m)^.*", ".*$", TRUE);
+}
+
 int main (int argc, const char* argv[]) {
     UErrorCode status = U_ZERO_ERROR;
     StringSearchPerformanceTest test(argc, argv, status);
@@ -12,6 +12,9 @@
 #define _STRSRCHPERF_H
 
 #include "unicode/usearch.h"
+#include "unicode/uregex.h"
+#include "unicode/ustring.h"
+#include "unicode/utext.h"
 #include "unicode/uperf.h"
 #include <stdlib.h>
 #include <stdio.h>
@@ -46,6 +49,52 @@ class StringSearchPerfFunction : public UPerfFunction {
     }
 };
 
+/* Finds all matches of a regular expression, in the UTF-16 text or in a UTF-8 copy of it. */
+class RegexFindPerfFunction : public UPerfFunction {
+private:
+    URegularExpression* regex;
+    UText* text;
+    char* src8;
+    int32_t srcLen;
+
+public:
+    virtual void call(UErrorCode* status) {
+        uregex_reset(regex, 0, status);
+        while (uregex_findNext(regex, status)) {
+        }
+    }
+
+    virtual long getOperationsPerIteration() {
+        return (long) srcLen;
+    }
+
+    RegexFindPerfFunction(const UChar* pattern, int32_t patternLen, const UChar* source, int32_t sourceLen, UBool utf8, UErrorCode* status) {
+        regex = uregex_open(pattern, patternLen, 0, NULL, status);
+        text = NULL;
+        src8 = NULL;
+        srcLen = sourceLen;
+        if (utf8) {
+            int32_t src8Len = 0;
+            u_strToUTF8(NULL, 0, &src8Len, source, sourceLen, status);
+            if (*status == U_BUFFER_OVERFLOW_ERROR) {
+                *status = U_ZERO_ERROR;
+            }
+            src8 = (char*)malloc(src8Len + 1);
+            u_strToUTF8(src8, src8Len + 1, NULL, source, sourceLen, status);
+            text = utext_openUTF8(NULL, src8, src8Len, status);
+            uregex_setUText(regex, text, status);
+        } else {
+            uregex_setText(regex, source, sourceLen, status);
+        }
+    }
+
+    ~RegexFindPerfFunction() {
+        uregex_close(regex);
+        utext_close(text);
+        free(src8);
+    }
+};
+
 class StringSearchPerformanceTest : public UPerfTest {
 private:
     const UChar* src;
@@ -60,6 +109,15 @@ class StringSearchPerformanceTest : public UPerfTest {
     virtual UPerfFunction* runIndexedTest(int32_t index, UBool exec, const char *&name, char *par = NULL);
     UPerfFunction* Test_ICU_Forward_Search();
     UPerfFunction* Test_ICU_Backward_Search();
+    UPerfFunction* Test_ICU_Regex_Find_Literal();
+    UPerfFunction* Test_ICU_Regex_Find_Words();
+    UPerfFunction* Test_ICU_Regex_Find_Line();
+    UPerfFunction* Test_ICU_Regex_Find_Literal_UTF8();
+    UPerfFunction* Test_ICU_Regex_Find_Words_UTF8();
+    UPerfFunction* Test_ICU_Regex_Find_Line_UTF8();
+
+private:
+    UPerfFunction* regexFind(const char* prefix, const char* suffix, UBool utf8);
 };
 
 
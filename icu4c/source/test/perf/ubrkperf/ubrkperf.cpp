@@ -24,6 +24,7 @@
 #include "ubrkperf.h"
 #include "uoptions.h"
 #include <stdio.h>
+#include <stdlib.h>
 
 
 #if 0
@@ -160,6 +161,16 @@ UPerfFunction* BreakIteratorPerformanceTest::TestICUIsBound()
   return new ICUIsBound(locale, m_mode_, m_file_, m_fileLen_);
 }
 
+UPerfFunction* BreakIteratorPerformanceTest::TestICUGetBoundaries()
+{
+  return new ICUGetBoundaries(locale, m_mode_, m_file_, m_fileLen_, 1);
+}
+
+UPerfFunction* BreakIteratorPerformanceTest::TestICUGetBoundariesParallel()
+{
+  return new ICUGetBoundaries(locale, m_mode_, m_file_, m_fileLen_, m_threads_);
+}
+
 UPerfFunction* BreakIteratorPerformanceTest::TestDarwinForward()
 {
   return NULL;
@@ -179,6 +190,8 @@ UPerfFunction* BreakIteratorPerformanceTest::runIndexedTest(int32_t index, UBool
 		TESTCASE(1, TestICUIsBound);
 		TESTCASE(2, TestDarwinForward);
 		TESTCASE(3, TestDarwinIsBound);
+		TESTCASE(4, TestICUGetBoundaries);
+		TESTCASE(5, TestICUGetBoundariesParallel);
         default: 
             name = ""; 
             return NULL;
@@ -187,20 +200,19 @@ UPerfFunction* BreakIteratorPerformanceTest::runIndexedTest(int32_t index, UBool
 }
 
 UOption options[]={
-                      UOPTION_DEF( "mode",        'm', UOPT_REQUIRES_ARG)
+                      UOPTION_DEF( "mode",        'm', UOPT_REQUIRES_ARG),
+                      UOPTION_DEF( "threads",     'n', UOPT_REQUIRES_ARG)
                   };
 
 
 BreakIteratorPerformanceTest::BreakIteratorPerformanceTest(int32_t argc, const char* argv[], UErrorCode& status)
-: UPerfTest(argc,argv,status),
+: UPerfTest(argc,argv,options,UPRV_LENGTHOF(options),NULL,status),
 m_mode_(NULL),
 m_file_(NULL),
-m_fileLen_(0)
+m_fileLen_(0),
+m_threads_(4)
 {
 
-    _remainingArgc = u_parseArgs(_remainingArgc, (char**)argv, UPRV_LENGTHOF(options), options);
-
-
     if(options[0].doesOccur) {
       m_mode_ = options[0].value;
       switch(options[0].value[0]) {
@@ -217,11 +229,19 @@ m_fileLen_(0)
       status = U_ILLEGAL_ARGUMENT_ERROR;
     }
 
+    if(options[1].doesOccur) {
+      m_threads_ = atoi(options[1].value);
+      if(m_threads_ < 1) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+      }
+    }
+
     m_file_ = getBuffer(m_fileLen_, status);
 
     if(status== U_ILLEGAL_ARGUMENT_ERROR){
        fprintf(stderr, gUsageString, "ubrkperf");
        fprintf(stderr, "\t-m or --mode        Required mode for breakiterator: char, word, line or sentence\n");
+       fprintf(stderr, "\t-n or --threads     Number of threads for TestICUGetBoundariesParallel, default 4\n");
 
        return;
     }
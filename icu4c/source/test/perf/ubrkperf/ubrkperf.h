@@ -15,6 +15,10 @@
 #include "unicode/uperf.h"
 
 #include <unicode/brkiter.h>
+#include <unicode/rbbi.h>
+
+#include <thread>
+#include <vector>
 
 class ICUBreakFunction : public UPerfFunction {
 protected:
@@ -107,6 +111,99 @@ class ICUForward : public ICUBreakFunction {
   }
 };
 
+// Gets all boundaries with RuleBasedBreakIterator::getBoundaries(),
+// splitting the text into one range per thread.
+// Each thread uses its own clone of the iterator; the per-range results are
+// concatenated into one boundary vector and one rule status vector.
+class ICUGetBoundaries : public ICUBreakFunction {
+  UnicodeString m_text_;  // The iterators reference it; it must outlive them.
+  int32_t m_threads_;
+  std::vector<RuleBasedBreakIterator *> m_clones_;
+  std::vector<std::vector<int32_t> > m_rangeBoundaries_;
+  std::vector<std::vector<int32_t> > m_rangeStatuses_;
+  std::vector<int32_t> m_boundaries_;
+  std::vector<int32_t> m_statuses_;
+
+  void getRange(int32_t i, UErrorCode &status) {
+    int32_t start = (int32_t)(((int64_t)m_fileLen_ * i) / m_threads_);
+    int32_t limit = (int32_t)(((int64_t)m_fileLen_ * (i + 1)) / m_threads_);
+    std::vector<int32_t> &boundaries = m_rangeBoundaries_[i];
+    std::vector<int32_t> &statuses = m_rangeStatuses_[i];
+    // At most one boundary per code unit, plus the end of the text.
+    boundaries.resize(limit - start + 1);
+    statuses.resize(limit - start + 1);
+    int32_t length = m_clones_[i]->getBoundaries(start, limit, boundaries.data(), statuses.data(),
+                                                 (int32_t)boundaries.size(), status);
+    boundaries.resize(length);
+    statuses.resize(length);
+  }
+
+public:
+  ICUGetBoundaries(const char *locale, const char *mode, const UChar *file, int32_t file_len,
+                   int32_t threads) :
+      ICUBreakFunction(locale, mode, file, file_len),
+      m_text_(FALSE, file, file_len),
+      m_threads_(threads), m_rangeBoundaries_(threads), m_rangeStatuses_(threads)
+  {
+    if (U_FAILURE(m_status_)) {
+      return;
+    }
+    m_brkIt_->setText(m_text_);
+    for (int32_t i = 0; i < m_threads_; ++i) {
+      m_clones_.push_back(dynamic_cast<RuleBasedBreakIterator *>(m_brkIt_->clone()));
+    }
+    call(&m_status_);
+    // Check against forward iteration over the whole text.
+    int32_t n = 0;
+    for (int32_t b = m_brkIt_->first(); b != BreakIterator::DONE; b = m_brkIt_->next(), ++n) {
+      if (n >= (int32_t)m_boundaries_.size() || m_boundaries_[n] != b ||
+          m_statuses_[n] != m_brkIt_->getRuleStatus()) {
+        fprintf(stderr, "getBoundaries() with %d threads differs from next() at boundary %d\n",
+                (int)m_threads_, (int)n);
+        m_status_ = U_INTERNAL_PROGRAM_ERROR;
+        return;
+      }
+    }
+    if (n != (int32_t)m_boundaries_.size()) {
+      fprintf(stderr, "getBoundaries() found %d boundaries, next() %d\n",
+              (int)m_boundaries_.size(), (int)n);
+      m_status_ = U_INTERNAL_PROGRAM_ERROR;
+    }
+  }
+
+  ~ICUGetBoundaries() {
+    for (size_t i = 0; i < m_clones_.size(); ++i) {
+      delete m_clones_[i];
+    }
+  }
+
+  virtual void call(UErrorCode *status)
+  {
+    if (m_threads_ == 1) {
+      getRange(0, *status);
+    } else {
+      std::vector<std::thread> threads;
+      std::vector<UErrorCode> statuses(m_threads_, U_ZERO_ERROR);
+      for (int32_t i = 0; i < m_threads_; ++i) {
+        threads.push_back(std::thread(&ICUGetBoundaries::getRange, this, i, std::ref(statuses[i])));
+      }
+      for (int32_t i = 0; i < m_threads_; ++i) {
+        threads[i].join();
+        if (U_FAILURE(statuses[i])) {
+          *status = statuses[i];
+        }
+      }
+    }
+    m_boundaries_.clear();
+    m_statuses_.clear();
+    for (int32_t i = 0; i < m_threads_; ++i) {
+      m_boundaries_.insert(m_boundaries_.end(), m_rangeBoundaries_[i].begin(), m_rangeBoundaries_[i].end());
+      m_statuses_.insert(m_statuses_.end(), m_rangeStatuses_[i].begin(), m_rangeStatuses_[i].end());
+    }
+    m_noBreaks_ = (int32_t)m_boundaries_.size();
+  }
+};
+
 class DarwinBreakFunction : public UPerfFunction {
 public:
   virtual void call(UErrorCode *status) {};
@@ -117,6 +214,7 @@ class BreakIteratorPerformanceTest : public UPerfTest {
   const char* m_mode_;
   const UChar* m_file_;
   int32_t m_fileLen_;
+  int32_t m_threads_;
 
 public:
   BreakIteratorPerformanceTest(int32_t argc, const char* argv[], UErrorCode& status);
@@ -127,6 +225,8 @@ class BreakIteratorPerformanceTest : public UPerfTest {
 
   UPerfFunction* TestICUForward();
   UPerfFunction* TestICUIsBound();
+  UPerfFunction* TestICUGetBoundaries();
+  UPerfFunction* TestICUGetBoundariesParallel();
 
   UPerfFunction* TestDarwinForward();
   UPerfFunction* TestDarwinIsBound();
@@ -91,3 +91,43 @@
 };
 
 runTests($options, $tests, $dataFiles);
+
+# Spans over web text with frozen sets for typical tokenizer patterns:
+# letters, white space and a custom identifier-like set.
+$options = {
+    "title"=>"UnicodeSet span() performance on web text",
+    "headers"=>"L WS custom",
+    "operationIs"=>"tested Unicode code point",
+    "passes"=>"3",
+    "time"=>"2",
+    #"outputType"=>"HTML",
+    "dataDir"=>$UDHRDataPath,
+    "outputDir"=>"../results"
+};
+
+$tests = {
+    "SpanUTF16",
+    [
+        "$p,SpanUTF16 --type fast --pattern [:L:]",
+        "$p,SpanUTF16 --type fast --pattern [:White_Space:]",
+        "$p,SpanUTF16 --type fast --pattern [-.0-9A-Z_a-z]"
+    ],
+    "SpanUTF8",
+    [
+        "$p,SpanUTF8 --type fast --pattern [:L:]",
+        "$p,SpanUTF8 --type fast --pattern [:White_Space:]",
+        "$p,SpanUTF8 --type fast --pattern [-.0-9A-Z_a-z]"
+    ]
+};
+
+$dataFiles = {
+    "",
+    [
+        "udhr_eng.html",
+        "udhr_deu_1996.html",
+        "udhr_rus.html",
+        "udhr_jpn.html"
+    ]
+};
+
+runTests($options, $tests, $dataFiles);
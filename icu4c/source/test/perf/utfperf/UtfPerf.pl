@@ -45,6 +45,11 @@
     "Roundtrip",      ["$p1,Roundtrip",        "$p2,Roundtrip"],
     "FromUnicode",    ["$p1,FromUnicode",      "$p2,FromUnicode"],
     "FromUTF8",       ["$p1,FromUTF8",         "$p2,FromUTF8"],
+    "StrFromUTF8",    ["$p1,StrFromUTF8",      "$p2,StrFromUTF8"],
+    "StrFromUTF8Preflight", ["$p1,StrFromUTF8Preflight", "$p2,StrFromUTF8Preflight"],
+    "StrFromUTF8Lenient",   ["$p1,StrFromUTF8Lenient",   "$p2,StrFromUTF8Lenient"],
+    "StrToUTF8",      ["$p1,StrToUTF8",        "$p2,StrToUTF8"],
+    "StrToUTF8Preflight",   ["$p1,StrToUTF8Preflight",   "$p2,StrToUTF8Preflight"],
 };
 
 my $dataFiles = {
@@ -22,6 +22,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "unicode/uperf.h"
+#include "unicode/ustring.h"
 #include "cmemory.h" // for UPRV_LENGTHOF
 #include "uoptions.h"
 
@@ -328,11 +329,101 @@ class FromUTF8 : public Command {
     int32_t input8Length;
 };
 
+// Base class for the u_strFromUTF8*() and u_strToUTF8*() string transcoding tests.
+// These do not use the --charset converter.
+// The operations are UTF-8 bytes, so the min/op time in ns is the inverse of
+// the throughput in GB/s; the best throughput is also printed after each test.
+// Use input files with different character mixes (ASCII, Latin-1-heavy,
+// CJK, emoji) to compare the input profiles.
+class StrCommand : public UPerfFunction {
+protected:
+    StrCommand(const UtfPerformanceTest &testcase, const char *name)
+            : input(testcase.getBuffer()), inputLength(testcase.getBufferLen()),
+              input8(utf8), input8Length(utf8Length),
+              name(name), maxGBps(0.) {}
+public:
+    virtual ~StrCommand() {
+        printf("= %s throughput: %.3f GB/s\n", name, maxGBps);
+    }
+    virtual double time(int32_t n, UErrorCode* pErrorCode) {
+        double t = UPerfFunction::time(n, pErrorCode);
+        if (t > 0.) {
+            double gbps = ((double)input8Length * n) / t / 1e9;
+            if (gbps > maxGBps) {
+                maxGBps = gbps;
+            }
+        }
+        return t;
+    }
+    virtual long getOperationsPerIteration() {
+        return input8Length;
+    }
+
+    const UChar *input;
+    int32_t inputLength;
+    const char *input8;
+    int32_t input8Length;
+    const char *name;
+    double maxGBps;
+};
+
+// Test u_strFromUTF8WithSub(), optionally only preflighting.
+class StrFromUTF8 : public StrCommand {
+public:
+    StrFromUTF8(const UtfPerformanceTest &testcase, const char *name, UBool preflight)
+            : StrCommand(testcase, name), preflight(preflight) {}
+    virtual void call(UErrorCode* pErrorCode) {
+        int32_t length;
+        u_strFromUTF8WithSub(preflight ? NULL : output, preflight ? 0 : OUTPUT_CAPACITY, &length,
+                             input8, input8Length, 0xfffd, NULL, pErrorCode);
+        if (*pErrorCode == U_BUFFER_OVERFLOW_ERROR && preflight) {
+            *pErrorCode = U_ZERO_ERROR;
+        }
+        outputLength = length;
+    }
+private:
+    UBool preflight;
+};
+
+// Test u_strFromUTF8Lenient().
+class StrFromUTF8Lenient : public StrCommand {
+public:
+    StrFromUTF8Lenient(const UtfPerformanceTest &testcase, const char *name)
+            : StrCommand(testcase, name) {}
+    virtual void call(UErrorCode* pErrorCode) {
+        u_strFromUTF8Lenient(output, OUTPUT_CAPACITY, &outputLength, input8, input8Length, pErrorCode);
+    }
+};
+
+// Test u_strToUTF8WithSub(), optionally only preflighting.
+class StrToUTF8 : public StrCommand {
+public:
+    StrToUTF8(const UtfPerformanceTest &testcase, const char *name, UBool preflight)
+            : StrCommand(testcase, name), preflight(preflight) {}
+    virtual void call(UErrorCode* pErrorCode) {
+        u_strToUTF8WithSub(preflight ? NULL : intermediate, preflight ? 0 : OUTPUT_CAPACITY, &encodedLength,
+                           input, inputLength, 0xfffd, NULL, pErrorCode);
+        if (*pErrorCode == U_BUFFER_OVERFLOW_ERROR && preflight) {
+            *pErrorCode = U_ZERO_ERROR;
+        }
+    }
+private:
+    UBool preflight;
+};
+
 UPerfFunction* UtfPerformanceTest::runIndexedTest(int32_t index, UBool exec, const char* &name, char* par) {
     switch (index) {
         case 0: name = "Roundtrip";     if (exec) return Roundtrip::get(*this); break;
         case 1: name = "FromUnicode";   if (exec) return FromUnicode::get(*this); break;
         case 2: name = "FromUTF8";      if (exec) return FromUTF8::get(*this); break;
+        case 3: name = "StrFromUTF8";   if (exec) return new StrFromUTF8(*this, name, FALSE); break;
+        case 4: name = "StrFromUTF8Preflight";
+            if (exec) return new StrFromUTF8(*this, name, TRUE); break;
+        case 5: name = "StrFromUTF8Lenient";
+            if (exec) return new StrFromUTF8Lenient(*this, name); break;
+        case 6: name = "StrToUTF8";     if (exec) return new StrToUTF8(*this, name, FALSE); break;
+        case 7: name = "StrToUTF8Preflight";
+            if (exec) return new StrToUTF8(*this, name, TRUE); break;
         default: name = ""; break;
     }
     return NULL;
@@ -67,8 +67,30 @@ static RBBIStateTable get(ByteBuffer bytes, int length) throws IOException {
             This.fRowLen    = bytes.getInt();
             This.fFlags     = bytes.getInt();
             This.fReserved  = bytes.getInt();
-            int lengthOfShorts = length - 16;   // length in bytes.
-            This.fTable     = ICUBinary.getShorts(bytes, lengthOfShorts / 2, lengthOfShorts & 1);
+            if ((This.fFlags & RBBI_8BITS_ROWS) != 0) {
+                // Format version 6 tables with 8-bit rows are widened into the
+                //   16-bit rows that the rest of ICU4J works with.
+                //   An unconditional accept is all ones, which becomes -1.
+                int rowLen = This.fRowLen;
+                int tableLen = This.fNumStates * rowLen;
+                if (rowLen <= NEXTSTATES || tableLen > length - 16) {
+                    throw new IOException("Invalid RBBI state table length.");
+                }
+                This.fTable = new short[tableLen];
+                for (int i = 0; i < tableLen; i++) {
+                    int value = bytes.get() & 0xff;
+                    if (i % rowLen == ACCEPTING && value == 0xff) {
+                        value = -1;
+                    }
+                    This.fTable[i] = (short)value;
+                }
+                ICUBinary.skipBytes(bytes, length - 16 - tableLen);
+                This.fRowLen = rowLen * 2;
+                This.fFlags &= ~RBBI_8BITS_ROWS;
+            } else {
+                int lengthOfShorts = length - 16;   // length in bytes.
+                This.fTable     = ICUBinary.getShorts(bytes, lengthOfShorts / 2, lengthOfShorts & 1);
+            }
             return This;
         }
 
@@ -140,12 +162,17 @@ static public boolean equals(RBBIStateTable left, RBBIStateTable right) {
 
     public static final int DATA_FORMAT = 0x42726b20;     // "Brk "
     public static final int FORMAT_VERSION = 0x05000000;  // 4.0.0.0
+    /**
+     * Format version 6 adds state tables with 8-bit rows, written by ICU4C.
+     * It is read, but the rule builder writes FORMAT_VERSION.
+     */
+    public static final int FORMAT_VERSION_8BITS_ROWS = 0x06000000;
 
     private static final class IsAcceptable implements Authenticate {
         @Override
         public boolean isDataVersionAcceptable(byte version[]) {
             int intVersion = (version[0] << 24) + (version[1] << 16) + (version[2] << 8) + version[3];
-            return intVersion == FORMAT_VERSION;
+            return intVersion == FORMAT_VERSION || intVersion == FORMAT_VERSION_8BITS_ROWS;
         }
     }
     private static final IsAcceptable IS_ACCEPTABLE = new IsAcceptable();
@@ -200,6 +227,7 @@ public boolean isDataVersionAcceptable(byte version[]) {
     //
     public final static int      RBBI_LOOKAHEAD_HARD_BREAK = 1;
     public final static int      RBBI_BOF_REQUIRED         = 2;
+    public final static int      RBBI_8BITS_ROWS           = 4;
 
     /**
      * Data Header.  A struct-like class with the fields from the RBBI data file header.